@@ -33,6 +33,40 @@ Macros for function logging
 #define FUNCTION_LOG_WAL_SEGMENT_FIND_FORMAT(value, buffer, bufferSize)                                                            \
     objNameToLog(value, "WalSegmentFind", buffer, bufferSize)
 
+/***********************************************************************************************************************************
+Helpers to build the expression that matches a WAL segment and to throw an error when duplicates are found
+***********************************************************************************************************************************/
+static String *
+walSegmentFindExpression(const String *const walSegment)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRING, walSegment);
+    FUNCTION_TEST_END();
+
+    FUNCTION_TEST_RETURN(
+        STRING,
+        strNewFmt(
+            "^%.24s%s-[0-f]{40}" COMPRESS_TYPE_REGEXP "{0,1}$", strZ(walSegment),
+            walIsPartial(walSegment) ? WAL_SEGMENT_PARTIAL_EXT : ""));
+}
+
+static FN_NO_RETURN void
+walSegmentFindDuplicate(const String *const walSegment, const StringList *const matchList)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRING, walSegment);
+        FUNCTION_TEST_PARAM(STRING_LIST, matchList);
+    FUNCTION_TEST_END();
+
+    THROW_FMT(
+        ArchiveDuplicateError,
+        "duplicates found in archive for WAL segment %s: %s\n"
+        "HINT: are multiple primaries archiving to this stanza?",
+        strZ(walSegment), strZ(strLstJoin(matchList, ", ")));
+
+    FUNCTION_TEST_NO_RETURN();
+}
+
 /**********************************************************************************************************************************/
 FN_EXTERN WalSegmentFind *
 walSegmentFindNew(const Storage *const storage, const String *const archiveId, const bool single, const TimeMSec timeout)
@@ -81,9 +115,7 @@ walSegmentFind(WalSegmentFind *const this, const String *const walSegment)
         Wait *const wait = waitNew(this->timeout);
         const String *const prefix = strSubN(walSegment, 0, 16);
         const String *const path = strNewFmt(STORAGE_REPO_ARCHIVE "/%s/%s", strZ(this->archiveId), strZ(prefix));
-        const String *const expression = strNewFmt(
-            "^%s%s-[0-f]{40}" COMPRESS_TYPE_REGEXP "{0,1}$", strZ(strSubN(walSegment, 0, 24)),
-            walIsPartial(walSegment) ? WAL_SEGMENT_PARTIAL_EXT : "");
+        const String *const expression = walSegmentFindExpression(walSegment);
         RegExp *regExp = NULL;
 
         do
@@ -147,11 +179,7 @@ walSegmentFind(WalSegmentFind *const this, const String *const walSegment)
                     strLstFree(this->list);
                     this->list = NULL;
 
-                    THROW_FMT(
-                        ArchiveDuplicateError,
-                        "duplicates found in archive for WAL segment %s: %s\n"
-                        "HINT: are multiple primaries archiving to this stanza?",
-                        strZ(walSegment), strZ(strLstJoin(matchList, ", ")));
+                    walSegmentFindDuplicate(walSegment, matchList);
                 }
 
                 // On match copy file name of WAL segment found into the prior context
@@ -228,3 +256,49 @@ walSegmentFindOne(
 
     FUNCTION_LOG_RETURN(STRING, result);
 }
+
+/**********************************************************************************************************************************/
+FN_EXTERN String *
+walSegmentFindList(const StringList *const list, const String *const walSegment)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STRING_LIST, list);
+        FUNCTION_LOG_PARAM(STRING, walSegment);
+    FUNCTION_LOG_END();
+
+    ASSERT(list != NULL);
+    ASSERT(walSegment != NULL);
+    ASSERT(walIsSegment(walSegment));
+
+    String *result = NULL;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        // Find all matches in the list
+        RegExp *const regExp = regExpNew(walSegmentFindExpression(walSegment));
+        StringList *const matchList = strLstNew();
+
+        for (unsigned int listIdx = 0; listIdx < strLstSize(list); listIdx++)
+        {
+            if (regExpMatch(regExp, strLstGet(list, listIdx)))
+                strLstAdd(matchList, strLstGet(list, listIdx));
+        }
+
+        // Error if there is more than one match
+        if (strLstSize(matchList) > 1)
+            walSegmentFindDuplicate(walSegment, matchList);
+
+        // On match copy file name of WAL segment found into the prior context
+        if (strLstSize(matchList) == 1)
+        {
+            MEM_CONTEXT_PRIOR_BEGIN()
+            {
+                result = strDup(strLstGet(matchList, 0));
+            }
+            MEM_CONTEXT_PRIOR_END();
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN(STRING, result);
+}
@@ -33,4 +33,8 @@ Helper functions
 // Find a single WAL segment (see walSegmentFind() for details)
 FN_EXTERN String *walSegmentFindOne(const Storage *storage, const String *archiveId, const String *walSegment, TimeMSec timeout);
 
+// Find a WAL segment in a list of files previously read from the archive path of the segment (see walSegmentFind() for details).
+// This allows a single list to be used to find many segments.
+FN_EXTERN String *walSegmentFindList(const StringList *list, const String *walSegment);
+
 #endif
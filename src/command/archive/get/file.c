@@ -3,29 +3,334 @@ Archive Get File
 ***********************************************************************************************************************************/
 #include "build.auto.h"
 
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include "command/archive/common.h"
 #include "command/archive/get/file.h"
+#include "command/archive/walTrim.h"
 #include "command/control/common.h"
 #include "common/compress/helper.h"
 #include "common/crypto/cipherBlock.h"
+#include "common/crypto/hash.h"
 #include "common/debug.h"
 #include "common/io/filter/group.h"
 #include "common/log.h"
+#include "common/regExp.h"
 #include "config/config.h"
 #include "info/infoArchive.h"
 #include "postgres/interface.h"
 #include "storage/helper.h"
+#include "storage/posix/storage.h"
+#include "storage/write.intern.h"
+
+/***********************************************************************************************************************************
+Shared WAL segment cache
+
+WAL segments are stored decompressed and decrypted in <archive-get-cache-path>/<stanza>/<archive-id>/<segment> so they can be used
+by any archive-get on the host. A lock file is held while a segment is added to the cache so a segment requested by multiple
+processes at the same time is only fetched from the repo once. The cache is kept within archive-get-cache-max after the lock has
+been released so other processes requesting the segment are not blocked by eviction.
+***********************************************************************************************************************************/
+#define ARCHIVE_GET_CACHE_LOCK_EXT                                  ".lock"
+
+typedef struct ArchiveGetCacheFile
+{
+    const String *name;                                             // Segment name (with path) in the cache
+    uint64_t size;                                                  // Segment size
+    time_t timeModified;                                            // Time the segment was added to the cache
+} ArchiveGetCacheFile;
+
+// Lock a segment in the cache. If wait is false then -1 is returned when another process holds the lock. The lock file may be
+// removed (or removed and recreated) by a process evicting the segment while this process is waiting for the lock so the lock is
+// retried until the lock file held is the lock file in the cache.
+static int
+archiveGetCacheLock(const Storage *const cache, const String *const cacheFile, const bool wait)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE, cache);
+        FUNCTION_TEST_PARAM(STRING, cacheFile);
+        FUNCTION_TEST_PARAM(BOOL, wait);
+    FUNCTION_TEST_END();
+
+    int result = -1;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        const String *const lockFile = storagePathP(cache, strNewFmt("%s" ARCHIVE_GET_CACHE_LOCK_EXT, strZ(cacheFile)));
+        bool retry;
+
+        do
+        {
+            // Assume there will be no retry
+            retry = false;
+
+            const int fd = open(strZ(lockFile), O_WRONLY | O_CREAT, STORAGE_MODE_FILE_DEFAULT);
+            THROW_ON_SYS_ERROR_FMT(fd == -1, FileOpenError, "unable to open cache lock file '%s'", strZ(lockFile));
+
+            // Attempt to lock the file
+            if (flock(fd, wait ? LOCK_EX : LOCK_EX | LOCK_NB) == -1)
+            {
+                const int errNo = errno;
+                close(fd);
+
+                errno = errNo;
+                THROW_ON_SYS_ERROR_FMT(errNo != EWOULDBLOCK, LockAcquireError, "unable to lock cache file '%s'", strZ(lockFile));
+            }
+            else
+            {
+                // Retry if the lock file was removed or replaced while waiting for the lock
+                struct stat statFd;
+                struct stat statFile;
+
+                THROW_ON_SYS_ERROR_FMT(
+                    fstat(fd, &statFd) == -1, FileInfoError, "unable to stat cache lock file '%s'", strZ(lockFile));
+
+                if (stat(strZ(lockFile), &statFile) == 0 && statFile.st_ino == statFd.st_ino)
+                {
+                    result = fd;
+                }
+                else
+                {
+                    close(fd);
+                    retry = true;
+                }
+            }
+        }
+        while (retry);
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_TEST_RETURN(INT, result);
+}
+
+// Comparator to order cached segments from oldest to newest
+static int
+archiveGetCacheFileComparator(const void *const item1, const void *const item2)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, item1);
+        FUNCTION_TEST_PARAM_P(VOID, item2);
+    FUNCTION_TEST_END();
+
+    ASSERT(item1 != NULL);
+    ASSERT(item2 != NULL);
+
+    const ArchiveGetCacheFile *const file1 = item1;
+    const ArchiveGetCacheFile *const file2 = item2;
+
+    if (file1->timeModified == file2->timeModified)
+        FUNCTION_TEST_RETURN(INT, strCmp(file1->name, file2->name));
+
+    FUNCTION_TEST_RETURN(INT, file1->timeModified < file2->timeModified ? -1 : 1);
+}
+
+// Remove the oldest segments until the cache is no larger than archive-get-cache-max. Locked segments are skipped since they are
+// being added to the cache by another process, as is the segment just added by this process. Temp files and lock files left behind
+// by processes that failed while adding a segment are removed when the segment is not locked.
+static void
+archiveGetCacheEvict(const Storage *const cache, const String *const cacheFileKeep)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STORAGE, cache);
+        FUNCTION_LOG_PARAM(STRING, cacheFileKeep);
+    FUNCTION_LOG_END();
+
+    ASSERT(cacheFileKeep != NULL);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        // Get all segments in the cache and the segments that may have stale temp or lock files
+        List *const fileList = lstNewP(sizeof(ArchiveGetCacheFile), .comparator = archiveGetCacheFileComparator);
+        StringList *const staleList = strLstNew();
+        RegExp *const walSegmentExp = regExpNew(WAL_SEGMENT_REGEXP_STR);
+        uint64_t cacheSize = 0;
+
+        StorageIterator *const storageItr = storageNewItrP(cache, NULL, .recurse = true);
+
+        while (storageItrMore(storageItr))
+        {
+            const StorageInfo info = storageItrNext(storageItr);
+
+            if (info.type != storageTypeFile)
+                continue;
+
+            if (regExpMatch(walSegmentExp, strBase(info.name)))
+            {
+                cacheSize += info.size;
+
+                if (!strEq(info.name, cacheFileKeep))
+                {
+                    lstAdd(
+                        fileList,
+                        &(ArchiveGetCacheFile){.name = strDup(info.name), .size = info.size, .timeModified = info.timeModified});
+                }
+            }
+            else if (strEndsWithZ(info.name, STORAGE_FILE_TEMP_EXT))
+                strLstAddIfMissing(staleList, strSubN(info.name, 0, strSize(info.name) - (sizeof(STORAGE_FILE_TEMP_EXT) - 1)));
+            else if (strEndsWithZ(info.name, ARCHIVE_GET_CACHE_LOCK_EXT))
+            {
+                strLstAddIfMissing(
+                    staleList, strSubN(info.name, 0, strSize(info.name) - (sizeof(ARCHIVE_GET_CACHE_LOCK_EXT) - 1)));
+            }
+        }
+
+        // Remove temp files and lock files without a segment when the segment is not locked
+        for (unsigned int staleIdx = 0; staleIdx < strLstSize(staleList); staleIdx++)
+        {
+            const String *const cacheFile = strLstGet(staleList, staleIdx);
+            const int fd = archiveGetCacheLock(cache, cacheFile, false);
+
+            if (fd != -1)
+            {
+                storageRemoveP(cache, strNewFmt("%s" STORAGE_FILE_TEMP_EXT, strZ(cacheFile)));
+
+                if (!storageExistsP(cache, cacheFile))
+                    storageRemoveP(cache, strNewFmt("%s" ARCHIVE_GET_CACHE_LOCK_EXT, strZ(cacheFile)));
+
+                close(fd);
+            }
+        }
+
+        // Remove the oldest segments until the cache is small enough
+        const uint64_t cacheSizeMax = cfgOptionUInt64(cfgOptArchiveGetCacheMax);
+
+        lstSort(fileList, sortOrderAsc);
+
+        for (unsigned int fileIdx = 0; fileIdx < lstSize(fileList) && cacheSize > cacheSizeMax; fileIdx++)
+        {
+            const ArchiveGetCacheFile *const file = lstGet(fileList, fileIdx);
+            const int fd = archiveGetCacheLock(cache, file->name, false);
+
+            if (fd != -1)
+            {
+                storageRemoveP(cache, file->name);
+                storageRemoveP(cache, strNewFmt("%s" ARCHIVE_GET_CACHE_LOCK_EXT, strZ(file->name)));
+                close(fd);
+
+                cacheSize -= file->size;
+            }
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Copy a file from the repo to the destination, decrypting, decompressing, and expanding trimmed WAL segments as required. When
+validate is true the checksum of the WAL segment is verified against the checksum in the repo file name.
+***********************************************************************************************************************************/
+static void
+archiveGetFileCopy(
+    const ArchiveGetFile *const actual, StorageWrite *const destination, const bool segment, const unsigned int walSegmentSize,
+    const bool validate)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM_P(VOID, actual);
+        FUNCTION_LOG_PARAM(STORAGE_WRITE, destination);
+        FUNCTION_LOG_PARAM(BOOL, segment);
+        FUNCTION_LOG_PARAM(UINT, walSegmentSize);
+        FUNCTION_LOG_PARAM(BOOL, validate);
+    FUNCTION_LOG_END();
+
+    ASSERT(actual != NULL);
+    ASSERT(destination != NULL);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        // Is the file compressible during the copy?
+        bool compressible = true;
+
+        // If there is a cipher then add the decrypt filter
+        if (actual->cipherType != cipherTypeNone)
+        {
+            ioFilterGroupAdd(
+                ioWriteFilterGroup(storageWriteIo(destination)),
+                cipherBlockNewP(cipherModeDecrypt, actual->cipherType, BUFSTR(actual->cipherPassArchive)));
+            compressible = false;
+        }
+
+        // If file is compressed then add the decompression filter
+        CompressType compressType = compressTypeFromName(actual->file);
+
+        if (compressType != compressTypeNone)
+        {
+            ioFilterGroupAdd(ioWriteFilterGroup(storageWriteIo(destination)), decompressFilterP(compressType));
+            compressible = false;
+        }
+
+        // If the file is a WAL segment then add the filter to expand a trimmed segment
+        if (segment)
+            ioFilterGroupAdd(ioWriteFilterGroup(storageWriteIo(destination)), walExpandNew(walSegmentSize));
+
+        // If the file will be validated then add the hash filter
+        if (validate)
+            ioFilterGroupAdd(ioWriteFilterGroup(storageWriteIo(destination)), cryptoHashNew(hashTypeSha1));
+
+        // Copy the file
+        storageCopyP(
+            storageNewReadP(
+                storageRepoIdx(actual->repoIdx), strNewFmt(STORAGE_REPO_ARCHIVE "/%s", strZ(actual->file)),
+                .compressible = compressible),
+            destination);
+
+        // Check that the checksum matches the checksum in the file name
+        if (validate)
+        {
+            const String *const fileName = strBase(actual->file);
+            const String *const checksumExpected = strSubN(
+                fileName, (size_t)strChr(fileName, '-') + 1, HASH_TYPE_SHA1_SIZE_HEX);
+            const String *const checksum = strNewEncode(
+                encodingHex,
+                pckReadBinP(ioFilterGroupResultP(ioWriteFilterGroup(storageWriteIo(destination)), CRYPTO_HASH_FILTER_TYPE)));
+
+            if (!strEq(checksum, checksumExpected))
+            {
+                THROW_FMT(
+                    ChecksumError, "actual checksum '%s' does not match expected checksum '%s'", strZ(checksum),
+                    strZ(checksumExpected));
+            }
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN String *
+archiveGetFileTemp(const String *const request, const unsigned int actualOffset)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRING, request);
+        FUNCTION_TEST_PARAM(UINT, actualOffset);
+    FUNCTION_TEST_END();
+
+    ASSERT(request != NULL);
+
+    if (actualOffset == 0)
+        FUNCTION_TEST_RETURN(STRING, strNewFmt(STORAGE_SPOOL_ARCHIVE_IN "/%s." STORAGE_FILE_TEMP_EXT, strZ(request)));
+
+    FUNCTION_TEST_RETURN(STRING, strNewFmt(STORAGE_SPOOL_ARCHIVE_IN "/%s.%u." STORAGE_FILE_TEMP_EXT, strZ(request), actualOffset));
+}
 
 /**********************************************************************************************************************************/
 FN_EXTERN ArchiveGetFileResult
 archiveGetFile(
-    const Storage *const storage, const String *const request, const List *const actualList, const String *const walDestination)
+    const Storage *const storage, const String *const request, const List *const actualList, const String *const walDestination,
+    const unsigned int walSegmentSize, const bool validate)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(STORAGE, storage);
         FUNCTION_LOG_PARAM(STRING, request);
         FUNCTION_LOG_PARAM(LIST, actualList);
         FUNCTION_LOG_PARAM(STRING, walDestination);
+        FUNCTION_LOG_PARAM(UINT, walSegmentSize);
+        FUNCTION_LOG_PARAM(BOOL, validate);
     FUNCTION_LOG_END();
 
     FUNCTION_AUDIT_STRUCT();
@@ -36,6 +341,12 @@ archiveGetFile(
 
     ArchiveGetFileResult result = {.warnList = strLstNew()};
 
+    // WAL segments may have been trimmed when pushed
+    const bool segment = walIsSegment(request);
+
+    // WAL segments are shared through the cache when enabled. Partial segments and other files are always copied from the repo.
+    const bool cacheable = cfgOptionTest(cfgOptArchiveGetCachePath) && regExpMatchOne(WAL_SEGMENT_REGEXP_STR, request);
+
     // Check all files in the actual list and return as soon as one is copied
     bool copied = false;
 
@@ -43,9 +354,6 @@ archiveGetFile(
     {
         const ArchiveGetFile *const actual = lstGet(actualList, actualIdx);
 
-        // Is the file compressible during the copy?
-        bool compressible = true;
-
         TRY_BEGIN()
         {
             MEM_CONTEXT_TEMP_BEGIN()
@@ -53,30 +361,50 @@ archiveGetFile(
                 StorageWrite *const destination = storageNewWriteP(
                     storage, walDestination, .noCreatePath = true, .noSyncFile = true, .noSyncPath = true, .noAtomic = true);
 
-                // If there is a cipher then add the decrypt filter
-                if (actual->cipherType != cipherTypeNone)
+                // If the segment can be cached then get it from the cache, adding it to the cache first if needed
+                if (cacheable)
                 {
-                    ioFilterGroupAdd(
-                        ioWriteFilterGroup(storageWriteIo(destination)),
-                        cipherBlockNewP(cipherModeDecrypt, actual->cipherType, BUFSTR(actual->cipherPassArchive)));
-                    compressible = false;
-                }
+                    const Storage *const cache = storagePosixNewP(cfgOptionStr(cfgOptArchiveGetCachePath), .write = true);
+                    const String *const cacheFile = strNewFmt(
+                        "%s/%s/%s", strZ(cfgOptionStr(cfgOptStanza)), strZ(actual->archiveId), strZ(request));
 
-                // If file is compressed then add the decompression filter
-                CompressType compressType = compressTypeFromName(actual->file);
+                    // Copy from the cache if the segment is already cached. Once the segment is open for read it can be removed
+                    // from the cache without affecting the copy.
+                    if (!storageCopyP(storageNewReadP(cache, cacheFile, .ignoreMissing = true), destination))
+                    {
+                        // Lock the segment so only one process adds it to the cache
+                        storagePathCreateP(cache, strPath(cacheFile));
+                        const int fd = archiveGetCacheLock(cache, cacheFile, true);
+                        bool added = false;
 
-                if (compressType != compressTypeNone)
-                {
-                    ioFilterGroupAdd(ioWriteFilterGroup(storageWriteIo(destination)), decompressFilterP(compressType));
-                    compressible = false;
-                }
+                        TRY_BEGIN()
+                        {
+                            // Add the segment to the cache unless another process added it while waiting for the lock
+                            if (!storageExistsP(cache, cacheFile))
+                            {
+                                archiveGetFileCopy(
+                                    actual, storageNewWriteP(cache, cacheFile, .noSyncFile = true, .noSyncPath = true), segment,
+                                    walSegmentSize, validate);
+                                added = true;
+                            }
+
+                            // Copy from the cache to the destination
+                            storageCopyP(storageNewReadP(cache, cacheFile), destination);
+                        }
+                        FINALLY()
+                        {
+                            close(fd);
+                        }
+                        TRY_END();
 
-                // Copy the file
-                storageCopyP(
-                    storageNewReadP(
-                        storageRepoIdx(actual->repoIdx), strNewFmt(STORAGE_REPO_ARCHIVE "/%s", strZ(actual->file)),
-                        .compressible = compressible),
-                    destination);
+                        // Keep the cache within the configured size when a segment was added
+                        if (added)
+                            archiveGetCacheEvict(cache, cacheFile);
+                    }
+                }
+                // Else copy directly from the repo
+                else
+                    archiveGetFileCopy(actual, destination, segment, walSegmentSize, validate);
             }
             MEM_CONTEXT_TEMP_END();
 
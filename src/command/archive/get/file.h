@@ -27,7 +27,13 @@ typedef struct ArchiveGetFileResult
     StringList *warnList;                                           // Warnings from a successful operation
 } ArchiveGetFileResult;
 
+// Temp file in the spool used as the destination for a request. Jobs racing the repos for a request pass the offset of their part of
+// the actual list so each job gets a separate temp file.
+FN_EXTERN String *archiveGetFileTemp(const String *request, unsigned int actualOffset);
+
+// Copy the first file in the actual list that can be retrieved. When validate is true the checksum of WAL segments is verified.
 FN_EXTERN ArchiveGetFileResult archiveGetFile(
-    const Storage *storage, const String *request, const List *actualList, const String *walDestination);
+    const Storage *storage, const String *request, const List *actualList, const String *walDestination,
+    unsigned int walSegmentSize, bool validate);
 
 #endif
@@ -18,6 +18,8 @@ Archive Get Command
 #include "common/log.h"
 #include "common/memContext.h"
 #include "common/regExp.h"
+#include "common/time.h"
+#include "common/type/json.h"
 #include "common/wait.h"
 #include "config/config.h"
 #include "config/exec.h"
@@ -46,11 +48,16 @@ typedef struct ArchiveFileMap
     const String *request;                                          // Archive file requested by archive_command
     List *actualList;                                               // Actual files in various repos/archiveIds
     StringList *warnList;                                           // Warnings that need to be reported by the async process
+    unsigned int actualNext;                                        // Next actual file to be sent to a job (async only)
+    unsigned int jobTotal;                                          // Jobs sent that have not completed (async only)
+    bool race;                                                      // Is each actual file sent to a separate job? (async only)
+    bool done;                                                      // Has a job retrieved the file? (async only)
 } ArchiveFileMap;
 
 typedef struct ArchiveGetCheckResult
 {
     List *archiveFileMapList;                                       // List of mapped archive files, i.e. found in the repo
+    unsigned int walSegmentSize;                                    // WAL segment size from pg_control
 
     // Global error that affects all repos
     const ErrorType *errorType;                                     // Error type if there was an error
@@ -390,6 +397,8 @@ archiveGetCheck(const StringList *const archiveRequestList)
                 "HINT: was the backup_label file removed?");
         }
 
+        result.walSegmentSize = controlInfo.walSegmentSize;
+
         // Build list of repos/archiveIds where WAL may be found
         List *const cacheRepoList = lstNewP(sizeof(ArchiveGetFindCacheRepo));
 
@@ -533,22 +542,165 @@ archiveGetCheck(const StringList *const archiveRequestList)
 }
 
 /***********************************************************************************************************************************
-Clean the queue and prepare a list of WAL segments that the async process should get
+Replay and fetch statistics used to size the queue. These are stored in the spool between executions of archive-get since each WAL
+segment is requested by PostgreSQL with a new process. The stats are stored as JSON with a version so a change in format will
+reset the stats rather than misinterpret them.
+***********************************************************************************************************************************/
+#define ARCHIVE_GET_STAT_FILE                                       STORAGE_SPOOL_ARCHIVE "/get.stat"
+#define ARCHIVE_GET_STAT_VERSION                                    1
+
+#define ARCHIVE_GET_STAT_KEY_FETCH                                  "fetch"
+#define ARCHIVE_GET_STAT_KEY_REPLAY                                 "replay"
+#define ARCHIVE_GET_STAT_KEY_TIME_LAST                              "timeLast"
+#define ARCHIVE_GET_STAT_KEY_VERSION                                "version"
+
+typedef struct ArchiveGetStat
+{
+    TimeMSec timeLast;                                              // Time the last WAL segment was found in the queue
+    TimeMSec replay;                                                // Average time between WAL segment requests
+    TimeMSec fetch;                                                 // Average time for async process to get a missing segment
+} ArchiveGetStat;
+
+// Load stats. If the file is missing or invalid then the stats are reset and the full queue will be used until they are measured.
+static ArchiveGetStat
+archiveGetStatLoad(void)
+{
+    FUNCTION_TEST_VOID();
+
+    ArchiveGetStat result = {0};
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        const Buffer *const stat = storageGetP(
+            storageNewReadP(storageSpool(), STRDEF(ARCHIVE_GET_STAT_FILE), .ignoreMissing = true));
+
+        if (stat != NULL)
+        {
+            TRY_BEGIN()
+            {
+                JsonRead *const json = jsonReadNew(strNewBuf(stat));
+                jsonReadObjectBegin(json);
+
+                const TimeMSec fetch = jsonReadUInt64(jsonReadKeyRequireZ(json, ARCHIVE_GET_STAT_KEY_FETCH));
+                const TimeMSec replay = jsonReadUInt64(jsonReadKeyRequireZ(json, ARCHIVE_GET_STAT_KEY_REPLAY));
+                const TimeMSec timeLast = jsonReadUInt64(jsonReadKeyRequireZ(json, ARCHIVE_GET_STAT_KEY_TIME_LAST));
+
+                if (jsonReadUInt(jsonReadKeyRequireZ(json, ARCHIVE_GET_STAT_KEY_VERSION)) == ARCHIVE_GET_STAT_VERSION)
+                    result = (ArchiveGetStat){.timeLast = timeLast, .replay = replay, .fetch = fetch};
+            }
+            CATCH_ANY()
+            {
+                result = (ArchiveGetStat){0};
+            }
+            TRY_END();
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_TEST_RETURN_TYPE(ArchiveGetStat, result);
+}
+
+// Save stats. The file is only a hint so there is no need to sync it.
+static void
+archiveGetStatSave(const ArchiveGetStat *const stat)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, stat);
+    FUNCTION_TEST_END();
+
+    ASSERT(stat != NULL);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        JsonWrite *const json = jsonWriteNewP();
+        jsonWriteObjectBegin(json);
+
+        jsonWriteUInt64(jsonWriteKeyZ(json, ARCHIVE_GET_STAT_KEY_FETCH), stat->fetch);
+        jsonWriteUInt64(jsonWriteKeyZ(json, ARCHIVE_GET_STAT_KEY_REPLAY), stat->replay);
+        jsonWriteUInt64(jsonWriteKeyZ(json, ARCHIVE_GET_STAT_KEY_TIME_LAST), stat->timeLast);
+        jsonWriteUInt(jsonWriteKeyZ(json, ARCHIVE_GET_STAT_KEY_VERSION), ARCHIVE_GET_STAT_VERSION);
+
+        jsonWriteObjectEnd(json);
+
+        storagePutP(
+            storageNewWriteP(storageSpoolWrite(), STRDEF(ARCHIVE_GET_STAT_FILE), .noSyncFile = true, .noSyncPath = true),
+            BUFSTR(jsonWriteResult(json)));
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+// Add a sample to a moving average that favors recent samples so the queue adapts quickly when the replay rate changes
+static TimeMSec
+archiveGetStatAvg(const TimeMSec avg, const TimeMSec sample)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(TIME_MSEC, avg);
+        FUNCTION_TEST_PARAM(TIME_MSEC, sample);
+    FUNCTION_TEST_END();
+
+    FUNCTION_TEST_RETURN(TIME_MSEC, avg == 0 ? sample : (avg * 3 + sample) / 4);
+}
+
+/***********************************************************************************************************************************
+Determine the queue size based on replay rate and fetch latency. If the requested WAL segment was not found in the queue then replay
+is faster than the queue is being filled so the full queue is used. Otherwise the queue only needs to hold enough WAL segments to
+cover replay while the async process fetches segments twice, which avoids fetching segments that may never be needed on a standby
+that is replaying slowly.
+***********************************************************************************************************************************/
+static uint64_t
+queueSizeAdaptive(const bool found, const uint64_t queueSizeMax, const size_t walSegmentSize, const ArchiveGetStat *const stat)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(BOOL, found);
+        FUNCTION_LOG_PARAM(UINT64, queueSizeMax);
+        FUNCTION_LOG_PARAM(SIZE, walSegmentSize);
+        FUNCTION_LOG_PARAM_P(VOID, stat);
+    FUNCTION_LOG_END();
+
+    ASSERT(stat != NULL);
+
+    uint64_t result = queueSizeMax;
+
+    if (found && stat->replay != 0 && stat->fetch != 0)
+    {
+        // Segments that will be replayed while the async process fetches twice, but at least two segments
+        uint64_t walSegmentTotal = (stat->fetch * 2 + stat->replay - 1) / stat->replay;
+
+        if (walSegmentTotal < 2)
+            walSegmentTotal = 2;
+
+        if (walSegmentTotal * walSegmentSize < queueSizeMax)
+            result = walSegmentTotal * walSegmentSize;
+    }
+
+    FUNCTION_LOG_RETURN(UINT64, result);
+}
+
+/***********************************************************************************************************************************
+Clean the queue and prepare a list of WAL segments that the async process should get. The list of files in the queue is passed by
+the caller so the queue does not need to be listed again. WAL segments that have already been fetched are kept up to queueSizeMax,
+even when queueSize has been reduced, so they are not fetched again.
 ***********************************************************************************************************************************/
 static StringList *
 queueNeed(
-    const String *const walSegment, const bool found, const uint64_t queueSize, const size_t walSegmentSize,
-    const unsigned int pgVersion)
+    const String *const walSegment, const bool found, const uint64_t queueSize, const uint64_t queueSizeMax,
+    const size_t walSegmentSize, const unsigned int pgVersion, const StringList *const queueList)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(STRING, walSegment);
         FUNCTION_LOG_PARAM(BOOL, found);
         FUNCTION_LOG_PARAM(UINT64, queueSize);
+        FUNCTION_LOG_PARAM(UINT64, queueSizeMax);
         FUNCTION_LOG_PARAM(SIZE, walSegmentSize);
         FUNCTION_LOG_PARAM(UINT, pgVersion);
+        FUNCTION_LOG_PARAM(STRING_LIST, queueList);
     FUNCTION_LOG_END();
 
     ASSERT(walSegment != NULL);
+    ASSERT(queueSize <= queueSizeMax);
+    ASSERT(queueList != NULL);
 
     StringList *const result = strLstNew();
 
@@ -570,9 +722,17 @@ queueNeed(
         const StringList *const idealQueue = strLstSort(
             walSegmentRange(walSegmentFirst, walSegmentSize, pgVersion, walSegmentQueueTotal), sortOrderAsc);
 
+        // Build the list of WAL segments that may be kept if they are already in the queue
+        unsigned int walSegmentKeepTotal = (unsigned int)(queueSizeMax / walSegmentSize);
+
+        if (walSegmentKeepTotal < walSegmentQueueTotal)
+            walSegmentKeepTotal = walSegmentQueueTotal;
+
+        const StringList *const allowQueue = strLstSort(
+            walSegmentRange(walSegmentFirst, walSegmentSize, pgVersion, walSegmentKeepTotal), sortOrderAsc);
+
         // Get the list of files actually in the queue
-        const StringList *const actualQueue = strLstSort(
-            storageListP(storageSpool(), STORAGE_SPOOL_ARCHIVE_IN_STR, .errorOnMissing = true), sortOrderAsc);
+        const StringList *const actualQueue = strLstSort(strLstDup(queueList), sortOrderAsc);
 
         // Build a list of WAL segments that are being kept so we can later make a list of what is needed
         StringList *const keepQueue = strLstNew();
@@ -583,7 +743,7 @@ queueNeed(
             const String *const file = strLstGet(actualQueue, actualQueueIdx);
 
             // Does this match a file we want to preserve?
-            if (strLstExists(idealQueue, file))
+            if (strLstExists(allowQueue, file))
             {
                 strLstAdd(keepQueue, file);
             }
@@ -654,14 +814,23 @@ cmdArchiveGet(void)
             bool foundOk = false;                                       // Was an OK file found which confirms the file was missing?
             bool queueFull = false;                                     // Is the queue half or more full?
             bool forked = false;                                        // Has the async process been forked yet?
+            TimeMSec forkTime = 0;                                      // When was the async process forked?
+            ArchiveGetStat stat = archiveGetStatLoad();                 // Replay and fetch stats used to size the queue
+
+            // Create the queue so it can be listed. The queue is required to exist from here on so a queue that is removed while
+            // archive-get is running will be reported as an error.
+            storagePathCreateP(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN_STR);
 
             // Loop and wait for the WAL segment to be pushed
             Wait *const wait = waitNew(cfgOptionUInt64(cfgOptArchiveTimeout));
 
             do
             {
+                // Get the list of files in the queue, which is used for all queue checks in this pass
+                StringList *const queueList = storageListP(storageSpool(), STORAGE_SPOOL_ARCHIVE_IN_STR, .errorOnMissing = true);
+
                 // Check if the WAL segment is already in the queue
-                found = storageExistsP(storageSpool(), strNewFmt(STORAGE_SPOOL_ARCHIVE_IN "/%s", strZ(walSegment)));
+                found = strLstExists(queueList, walSegment);
 
                 // Determine whether a missing WAL segment will be retried. Retrying is safer, but not retrying lets PostgreSQL
                 // know that there are probably no more WAL segments in the archive which means it can switch to streaming.
@@ -673,9 +842,11 @@ cmdArchiveGet(void)
                 // process can be spawned to check for the file again.
                 if (archiveAsyncStatus(archiveModeGet, walSegment, !first, found || !missingRetry))
                 {
+                    const String *const okFile = strNewFmt("%s" STATUS_EXT_OK, strZ(walSegment));
+
                     storageRemoveP(
-                        storageSpoolWrite(), strNewFmt(STORAGE_SPOOL_ARCHIVE_IN "/%s" STATUS_EXT_OK, strZ(walSegment)),
-                        .errorOnMissing = true);
+                        storageSpoolWrite(), strNewFmt(STORAGE_SPOOL_ARCHIVE_IN "/%s", strZ(okFile)), .errorOnMissing = true);
+                    strLstRemove(queueList, okFile);
 
                     // Break if an ok file was found but no segment exists, which means the segment was missing. However, don't
                     // break if this is the first time through the loop since this means the ok file was written by an async process
@@ -714,17 +885,39 @@ cmdArchiveGet(void)
                     LOG_INFO_FMT(FOUND_IN_ARCHIVE_MSG " asynchronously", strZ(walSegment));
                     result = 0;
 
-                    // Get a list of WAL segments left in the queue
-                    const StringList *const queue = storageListP(
-                        storageSpool(), STORAGE_SPOOL_ARCHIVE_IN_STR, .expression = WAL_SEGMENT_REGEXP_STR, .errorOnMissing = true);
+                    // Update replay stats. If the async process was forked to get the segment then also update fetch stats.
+                    const TimeMSec timeFound = timeMSec();
+
+                    if (stat.timeLast != 0 && timeFound > stat.timeLast)
+                        stat.replay = archiveGetStatAvg(stat.replay, timeFound - stat.timeLast);
+
+                    if (forked)
+                        stat.fetch = archiveGetStatAvg(stat.fetch, timeFound - forkTime);
+
+                    stat.timeLast = timeFound;
+                    archiveGetStatSave(&stat);
+
+                    // Count WAL segments left in the queue
+                    strLstRemove(queueList, walSegment);
+
+                    unsigned int queueTotal = 0;
+                    RegExp *const walSegmentExp = regExpNew(WAL_SEGMENT_REGEXP_STR);
+
+                    for (unsigned int queueIdx = 0; queueIdx < strLstSize(queueList); queueIdx++)
+                    {
+                        if (regExpMatch(walSegmentExp, strLstGet(queueList, queueIdx)))
+                            queueTotal++;
+                    }
 
-                    if (!strLstEmpty(queue))
+                    if (queueTotal > 0)
                     {
                         // Get size of the WAL segment
                         const uint64_t walSegmentSize = storageInfoP(storageLocal(), walDestination).size;
 
                         // Use WAL segment size to estimate queue size and determine if the async process should be launched
-                        queueFull = strLstSize(queue) * walSegmentSize > cfgOptionUInt64(cfgOptArchiveGetQueueMax) / 2;
+                        queueFull =
+                            queueTotal * walSegmentSize >
+                                queueSizeAdaptive(true, cfgOptionUInt64(cfgOptArchiveGetQueueMax), walSegmentSize, &stat) / 2;
                     }
                 }
 
@@ -736,9 +929,6 @@ cmdArchiveGet(void)
                     // Get control info
                     const PgControl pgControl = pgControlFromFile(storagePg(), cfgOptionStrNull(cfgOptPgVersionForce));
 
-                    // Create the queue
-                    storagePathCreateP(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN_STR);
-
                     // The async process should not output on the console at all
                     KeyValue *const optionReplace = kvNew();
 
@@ -751,9 +941,10 @@ cmdArchiveGet(void)
 
                     // Clean the current queue using the list of WAL that we ideally want in the queue. queueNeed() will return the
                     // list of WAL needed to fill the queue and this will be passed to the async process.
+                    const uint64_t queueSizeMax = cfgOptionUInt64(cfgOptArchiveGetQueueMax);
                     const StringList *const queue = queueNeed(
-                        walSegment, found, cfgOptionUInt64(cfgOptArchiveGetQueueMax), pgControl.walSegmentSize,
-                        pgControl.version);
+                        walSegment, found, queueSizeAdaptive(found, queueSizeMax, pgControl.walSegmentSize, &stat), queueSizeMax,
+                        pgControl.walSegmentSize, pgControl.version, queueList);
 
                     for (unsigned int queueIdx = 0; queueIdx < strLstSize(queue); queueIdx++)
                         strLstAdd(commandExec, strLstGet(queue, queueIdx));
@@ -765,6 +956,7 @@ cmdArchiveGet(void)
                     cmdLockReleaseP();
 
                     // Execute the async process
+                    forkTime = timeMSec();
                     archiveAsyncExec(archiveModeGet, commandExec);
 
                     // Mark the async process as forked so it doesn't get forked again. A single run of the async process should be
@@ -822,7 +1014,8 @@ cmdArchiveGet(void)
 
                 // Get the file
                 const ArchiveGetFileResult fileResult = archiveGetFile(
-                    storageLocalWrite(), fileMap->request, fileMap->actualList, walDestination);
+                    storageLocalWrite(), fileMap->request, fileMap->actualList, walDestination, checkResult.walSegmentSize,
+                    false);
 
                 // Output file warnings
                 for (unsigned int warnIdx = 0; warnIdx < strLstSize(fileResult.warnList); warnIdx++)
@@ -851,8 +1044,10 @@ cmdArchiveGet(void)
 /**********************************************************************************************************************************/
 typedef struct ArchiveGetAsyncData
 {
-    const List *const archiveFileMapList;                           // List of wal segments to process
+    List *const archiveFileMapList;                                 // List of wal segments to process
+    const unsigned int walSegmentSize;                              // WAL segment size
     unsigned int archiveFileIdx;                                    // Current index in the list to be processed
+    const bool race;                                                // Send actual files to separate jobs when found more than once
 } ArchiveGetAsyncData;
 
 static ProtocolParallelJob *
@@ -873,17 +1068,41 @@ archiveGetAsyncCallback(void *const data, const unsigned int clientIdx)
         // Get a new job if there are any left
         ArchiveGetAsyncData *const jobData = data;
 
-        if (jobData->archiveFileIdx < lstSize(jobData->archiveFileMapList))
+        while (result == NULL && jobData->archiveFileIdx < lstSize(jobData->archiveFileMapList))
         {
-            const ArchiveFileMap *const archiveFileMap = lstGet(jobData->archiveFileMapList, jobData->archiveFileIdx);
-            jobData->archiveFileIdx++;
+            ArchiveFileMap *const archiveFileMap = lstGet(jobData->archiveFileMapList, jobData->archiveFileIdx);
+            const unsigned int actualTotal = lstSize(archiveFileMap->actualList);
+
+            // Skip to the next file when all actual files have been sent or a racing job has already retrieved the file
+            if (archiveFileMap->actualNext == actualTotal || archiveFileMap->done)
+            {
+                jobData->archiveFileIdx++;
+                continue;
+            }
+
+            // When racing and the file was found more than once send each actual file to a separate job, otherwise send all actual
+            // files to a single job
+            const unsigned int actualBegin = archiveFileMap->actualNext;
+
+            if (jobData->race && actualTotal > 1)
+            {
+                archiveFileMap->race = true;
+                archiveFileMap->actualNext++;
+            }
+            else
+                archiveFileMap->actualNext = actualTotal;
+
+            archiveFileMap->jobTotal++;
 
             PackWrite *const param = protocolPackNew();
 
             pckWriteStrP(param, archiveFileMap->request);
+            pckWriteU32P(param, actualBegin);
+            pckWriteBoolP(param, archiveFileMap->race);
+            pckWriteU32P(param, jobData->walSegmentSize);
 
             // Add actual files to get
-            for (unsigned int actualIdx = 0; actualIdx < lstSize(archiveFileMap->actualList); actualIdx++)
+            for (unsigned int actualIdx = actualBegin; actualIdx < archiveFileMap->actualNext; actualIdx++)
             {
                 const ArchiveGetFile *const actual = lstGet(archiveFileMap->actualList, actualIdx);
 
@@ -941,7 +1160,12 @@ cmdArchiveGetAsync(void)
             if (!lstEmpty(checkResult.archiveFileMapList))
             {
                 // Create the parallel executor
-                ArchiveGetAsyncData jobData = {.archiveFileMapList = checkResult.archiveFileMapList};
+                ArchiveGetAsyncData jobData =
+                {
+                    .archiveFileMapList = checkResult.archiveFileMapList,
+                    .walSegmentSize = checkResult.walSegmentSize,
+                    .race = cfgOptionBool(cfgOptArchiveGetRace),
+                };
 
                 ProtocolParallel *const parallelExec = protocolParallelNew(
                     cfgOptionUInt64(cfgOptProtocolTimeout) / 2, archiveGetAsyncCallback, &jobData);
@@ -964,65 +1188,90 @@ cmdArchiveGetAsync(void)
 
                             // Get wal segment name and archive file map
                             const String *const walSegment = varStr(protocolParallelJobKey(job));
-                            const ArchiveFileMap *const fileMap = lstFind(checkResult.archiveFileMapList, &walSegment);
+                            ArchiveFileMap *const fileMap = lstFind(checkResult.archiveFileMapList, &walSegment);
                             ASSERT(fileMap != NULL);
+                            ASSERT(fileMap->jobTotal > 0);
 
-                            // Build warnings for status file
-                            String *const warning = strNew();
+                            fileMap->jobTotal--;
 
-                            if (!strLstEmpty(fileMap->warnList))
-                                strCatFmt(warning, "%s", strZ(strLstJoin(fileMap->warnList, "\n")));
-
-                            // The job was successful
-                            if (protocolParallelJobErrorCode(job) == 0)
+                            // Results from racing jobs are discarded once another job has retrieved the file
+                            if (!fileMap->done)
                             {
-                                // Get the actual file retrieved
-                                PackRead *const fileResult = protocolParallelJobResult(job);
-                                const ArchiveGetFile *const file = lstGet(fileMap->actualList, pckReadU32P(fileResult));
-                                ASSERT(file != NULL);
+                                // Build warnings for status file
+                                String *const warning = strNew();
+
+                                if (!strLstEmpty(fileMap->warnList))
+                                    strCatFmt(warning, "%s", strZ(strLstJoin(fileMap->warnList, "\n")));
+
+                                // The job was successful
+                                if (protocolParallelJobErrorCode(job) == 0)
+                                {
+                                    // Get the actual file retrieved
+                                    PackRead *const fileResult = protocolParallelJobResult(job);
+                                    const unsigned int actualIdx = pckReadU32P(fileResult);
+                                    const ArchiveGetFile *const file = lstGet(fileMap->actualList, actualIdx);
+                                    ASSERT(file != NULL);
+
+                                    fileMap->done = true;
 
-                                // Output file warnings
-                                const StringList *const fileWarnList = pckReadStrLstP(fileResult);
+                                    // Output file warnings
+                                    const StringList *const fileWarnList = pckReadStrLstP(fileResult);
 
-                                for (unsigned int warnIdx = 0; warnIdx < strLstSize(fileWarnList); warnIdx++)
-                                    LOG_WARN_PID(processId, strZ(strLstGet(fileWarnList, warnIdx)));
+                                    for (unsigned int warnIdx = 0; warnIdx < strLstSize(fileWarnList); warnIdx++)
+                                        LOG_WARN_PID(processId, strZ(strLstGet(fileWarnList, warnIdx)));
 
-                                // Build file warnings for status file
-                                if (!strLstEmpty(fileWarnList))
+                                    // Build file warnings for status file
+                                    if (!strLstEmpty(fileWarnList))
+                                    {
+                                        strCatFmt(
+                                            warning, "%s%s", strSize(warning) == 0 ? "" : "\n",
+                                            strZ(strLstJoin(fileWarnList, "\n")));
+                                    }
+
+                                    if (strSize(warning) != 0)
+                                        archiveAsyncStatusOkWrite(archiveModeGet, walSegment, warning);
+
+                                    LOG_DETAIL_PID_FMT(
+                                        processId, FOUND_IN_REPO_ARCHIVE_MSG, strZ(walSegment),
+                                        cfgOptionGroupName(cfgOptGrpRepo, file->repoIdx), strZ(file->archiveId));
+
+                                    // Rename temp WAL segment to actual name. This is done after the ok file is written so the ok
+                                    // file is guaranteed to exist before the foreground process finds the WAL segment.
+                                    storageMoveP(
+                                        storageSpoolWrite(),
+                                        storageNewReadP(
+                                            storageSpool(), archiveGetFileTemp(walSegment, fileMap->race ? actualIdx : 0)),
+                                        storageNewWriteP(
+                                            storageSpoolWrite(), strNewFmt(STORAGE_SPOOL_ARCHIVE_IN "/%s", strZ(walSegment))));
+                                }
+                                // Else the job errored but other racing jobs may still retrieve the file. The next racing job is
+                                // always sent before results are processed so there are outstanding jobs if any remain to be sent.
+                                else if (fileMap->jobTotal > 0)
                                 {
-                                    strCatFmt(
-                                        warning, "%s%s", strSize(warning) == 0 ? "" : "\n", strZ(strLstJoin(fileWarnList, "\n")));
+                                    LOG_WARN_PID_FMT(
+                                        processId, "[%s] %s", errorTypeName(errorTypeFromCode(protocolParallelJobErrorCode(job))),
+                                        strZ(protocolParallelJobErrorMessage(job)));
+                                }
+                                // Else the job errored
+                                else
+                                {
+                                    LOG_WARN_PID_FMT(
+                                        processId, "[%s] %s", errorTypeName(errorTypeFromCode(protocolParallelJobErrorCode(job))),
+                                        strZ(protocolParallelJobErrorMessage(job)));
+
+                                    archiveAsyncStatusErrorWrite(
+                                        archiveModeGet, walSegment, protocolParallelJobErrorCode(job),
+                                        strNewFmt(
+                                            "%s%s", strZ(protocolParallelJobErrorMessage(job)),
+                                            strSize(warning) == 0 ? "" : zNewFmt("\n%s", strZ(warning))));
                                 }
-
-                                if (strSize(warning) != 0)
-                                    archiveAsyncStatusOkWrite(archiveModeGet, walSegment, warning);
-
-                                LOG_DETAIL_PID_FMT(
-                                    processId, FOUND_IN_REPO_ARCHIVE_MSG, strZ(walSegment),
-                                    cfgOptionGroupName(cfgOptGrpRepo, file->repoIdx), strZ(file->archiveId));
-
-                                // Rename temp WAL segment to actual name. This is done after the ok file is written so the ok file
-                                // is guaranteed to exist before the foreground process finds the WAL segment.
-                                storageMoveP(
-                                    storageSpoolWrite(),
-                                    storageNewReadP(
-                                        storageSpool(),
-                                        strNewFmt(STORAGE_SPOOL_ARCHIVE_IN "/%s." STORAGE_FILE_TEMP_EXT, strZ(walSegment))),
-                                    storageNewWriteP(
-                                        storageSpoolWrite(), strNewFmt(STORAGE_SPOOL_ARCHIVE_IN "/%s", strZ(walSegment))));
                             }
-                            // Else the job errored
-                            else
+
+                            // Remove temp files left by racing jobs once all the jobs for the file have completed
+                            if (fileMap->race && fileMap->jobTotal == 0)
                             {
-                                LOG_WARN_PID_FMT(
-                                    processId, "[%s] %s", errorTypeName(errorTypeFromCode(protocolParallelJobErrorCode(job))),
-                                    strZ(protocolParallelJobErrorMessage(job)));
-
-                                archiveAsyncStatusErrorWrite(
-                                    archiveModeGet, walSegment, protocolParallelJobErrorCode(job),
-                                    strNewFmt(
-                                        "%s%s", strZ(protocolParallelJobErrorMessage(job)),
-                                        strSize(warning) == 0 ? "" : zNewFmt("\n%s", strZ(warning))));
+                                for (unsigned int actualIdx = 0; actualIdx < lstSize(fileMap->actualList); actualIdx++)
+                                    storageRemoveP(storageSpoolWrite(), archiveGetFileTemp(walSegment, actualIdx));
                             }
 
                             protocolParallelJobFree(job);
@@ -27,8 +27,12 @@ archiveGetFileProtocol(PackRead *const param)
 
     MEM_CONTEXT_TEMP_BEGIN()
     {
-        // Get request
+        // Get request, offset of the actual list in the list built by the caller, whether the file should be validated, and WAL
+        // segment size
         const String *const request = pckReadStrP(param);
+        const unsigned int actualOffset = pckReadU32P(param);
+        const bool validate = pckReadBoolP(param);
+        const unsigned int walSegmentSize = pckReadU32P(param);
 
         // Build the actual list
         List *const actualList = lstNewP(sizeof(ArchiveGetFile));
@@ -44,14 +48,14 @@ archiveGetFileProtocol(PackRead *const param)
             lstAdd(actualList, &actual);
         }
 
-        // Get file
+        // Get file. When the actual list is offset the caller is racing the repos for this request so each job gets a separate
+        // temp file.
         const ArchiveGetFileResult fileResult = archiveGetFile(
-            storageSpoolWrite(), request, actualList,
-            strNewFmt(STORAGE_SPOOL_ARCHIVE_IN "/%s." STORAGE_FILE_TEMP_EXT, strZ(request)));
+            storageSpoolWrite(), request, actualList, archiveGetFileTemp(request, actualOffset), walSegmentSize, validate);
 
         // Return result
         PackWrite *const data = protocolServerResultData(result);
-        pckWriteU32P(data, fileResult.actualIdx);
+        pckWriteU32P(data, actualOffset + fileResult.actualIdx);
         pckWriteStrLstP(data, fileResult.warnList);
     }
     MEM_CONTEXT_TEMP_END();
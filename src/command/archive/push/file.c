@@ -6,6 +6,7 @@ Archive Push File
 #include "command/archive/common.h"
 #include "command/archive/find.h"
 #include "command/archive/push/file.h"
+#include "command/archive/walTrim.h"
 #include "command/control/common.h"
 #include "common/crypto/cipherBlock.h"
 #include "common/crypto/hash.h"
@@ -97,7 +98,7 @@ FN_EXTERN ArchivePushFileResult
 archivePushFile(
     const String *const walSource, const bool headerCheck, const bool modeCheck, const unsigned int pgVersion,
     const uint64_t pgSystemId, const String *const archiveFile, const CompressType compressType, const int compressLevel,
-    const List *const repoList, const StringList *const priorErrorList)
+    const bool trim, const List *const repoList, const StringList *const priorErrorList)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(STRING, walSource);
@@ -108,6 +109,7 @@ archivePushFile(
         FUNCTION_LOG_PARAM(STRING, archiveFile);
         FUNCTION_LOG_PARAM(ENUM, compressType);
         FUNCTION_LOG_PARAM(INT, compressLevel);
+        FUNCTION_LOG_PARAM(BOOL, trim);
         FUNCTION_LOG_PARAM_P(VOID, repoList);
         FUNCTION_LOG_PARAM(STRING_LIST, priorErrorList);
     FUNCTION_LOG_END();
@@ -173,12 +175,16 @@ archivePushFile(
             {
                 const ArchivePushFileRepoData *const repoData = lstGet(repoList, repoListIdx);
 
-                // Check if the WAL segment already exists in the repo
+                // Check if the WAL segment already exists in the repo. Use the list of segments when provided to avoid listing the
+                // repo for every segment.
                 const String *walSegmentFile;
 
                 TRY_BEGIN()
                 {
-                    walSegmentFile = walSegmentFindOne(storageRepoIdx(repoData->repoIdx), repoData->archiveId, archiveFile, 0);
+                    if (repoData->walSegmentList != NULL)
+                        walSegmentFile = walSegmentFindList(repoData->walSegmentList, archiveFile);
+                    else
+                        walSegmentFile = walSegmentFindOne(storageRepoIdx(repoData->repoIdx), repoData->archiveId, archiveFile, 0);
                 }
                 CATCH_ANY()
                 {
@@ -241,6 +247,11 @@ archivePushFile(
             // Is the file compressible during the copy?
             bool compressible = true;
 
+            // If the segment will be trimmed then add the trim filter. The checksum calculated above is for the untrimmed segment
+            // since the segment is expanded when it is retrieved.
+            if (isSegment && trim)
+                ioFilterGroupAdd(ioReadFilterGroup(storageReadIo(source)), walTrimNew());
+
             // If the file will be compressed then add compression filter
             if (isSegment && compressType != compressTypeNone)
             {
@@ -7,6 +7,7 @@ Archive Push File
 #include "common/compress/helper.h"
 #include "common/crypto/common.h"
 #include "common/type/string.h"
+#include "common/type/stringList.h"
 #include "storage/storage.h"
 
 /***********************************************************************************************************************************
@@ -19,6 +20,7 @@ typedef struct ArchivePushFileRepoData
     const String *archiveId;
     CipherType cipherType;
     const String *cipherPass;
+    const StringList *walSegmentList;                               // Segments already listed from the repo (NULL to list)
 } ArchivePushFileRepoData;
 
 /***********************************************************************************************************************************
@@ -32,7 +34,7 @@ typedef struct ArchivePushFileResult
 // Copy a file from the source to the archive
 FN_EXTERN ArchivePushFileResult archivePushFile(
     const String *walSource, bool headerCheck, bool modeCheck, unsigned int pgVersion, uint64_t pgSystemId,
-    const String *archiveFile, CompressType compressType, int compressLevel, const List *repoList,
+    const String *archiveFile, CompressType compressType, int compressLevel, bool trim, const List *repoList,
     const StringList *priorErrorList);
 
 #endif
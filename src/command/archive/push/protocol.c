@@ -35,6 +35,7 @@ archivePushFileProtocol(PackRead *const param)
         const String *const archiveFile = pckReadStrP(param);
         const CompressType compressType = pckReadU32P(param);
         const int compressLevel = pckReadI32P(param);
+        const bool trim = pckReadBoolP(param);
         const StringList *const priorErrorList = pckReadStrLstP(param);
 
         // Read repo data
@@ -50,6 +51,7 @@ archivePushFileProtocol(PackRead *const param)
             repo.archiveId = pckReadStrP(param);
             repo.cipherType = pckReadU64P(param);
             repo.cipherPass = pckReadStrP(param);
+            repo.walSegmentList = pckReadStrLstP(param);
             pckReadObjEndP(param);
 
             lstAdd(repoList, &repo);
@@ -59,7 +61,7 @@ archivePushFileProtocol(PackRead *const param)
 
         // Push file
         const ArchivePushFileResult fileResult = archivePushFile(
-            walSource, headerCheck, modeCheck, pgVersion, pgSystemId, archiveFile, compressType, compressLevel, repoList,
+            walSource, headerCheck, modeCheck, pgVersion, pgSystemId, archiveFile, compressType, compressLevel, trim, repoList,
             priorErrorList);
 
         // Return result
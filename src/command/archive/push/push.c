@@ -16,6 +16,7 @@ Archive Push Command
 #include "common/debug.h"
 #include "common/log.h"
 #include "common/memContext.h"
+#include "common/time.h"
 #include "common/wait.h"
 #include "config/config.h"
 #include "config/exec.h"
@@ -38,6 +39,11 @@ Ready file extension constants
 #define STATUS_EXT_READY                                            ".ready"
 #define STATUS_EXT_READY_SIZE                                       (sizeof(STATUS_EXT_READY) - 1)
 
+/***********************************************************************************************************************************
+Time to sleep between checks for ready WAL files while the async process is being kept alive
+***********************************************************************************************************************************/
+#define ARCHIVE_PUSH_ASYNC_KEEP_ALIVE_SLEEP                         100
+
 /***********************************************************************************************************************************
 Format the warning when a file is dropped
 ***********************************************************************************************************************************/
@@ -414,7 +420,8 @@ cmdArchivePush(void)
                 const ArchivePushFileResult fileResult = archivePushFile(
                     walFile, cfgOptionBool(cfgOptArchiveHeaderCheck), cfgOptionBool(cfgOptArchiveModeCheck), archiveInfo.pgVersion,
                     archiveInfo.pgSystemId, archiveFile, compressTypeEnum(cfgOptionStrId(cfgOptCompressType)),
-                    cfgOptionInt(cfgOptCompressLevel), archiveInfo.repoList, archiveInfo.errorList);
+                    cfgOptionInt(cfgOptCompressLevel), cfgOptionBool(cfgOptArchivePushTrim), archiveInfo.repoList,
+                    archiveInfo.errorList);
 
                 // If a warning was returned then log it
                 for (unsigned int warnIdx = 0; warnIdx < strLstSize(fileResult.warnList); warnIdx++)
@@ -434,11 +441,13 @@ cmdArchivePush(void)
 typedef struct ArchivePushAsyncData
 {
     const String *walPath;                                          // Path to pg_wal/pg_xlog
-    const StringList *walFileList;                                  // List of wal files to process
+    StringList *walFileList;                                        // List of wal files to process
     unsigned int walFileIdx;                                        // Current index in the list to be processed
     CompressType compressType;                                      // Type of compression for WAL segments
     int compressLevel;                                              // Compression level for wal files
-    ArchivePushCheckResult archiveInfo;                             // Archive info
+    ArchivePushCheckResult archiveInfo;                             // Archive info for the current list
+    StringList **walSegmentList;                                    // Repo archive segments per repo for the current list
+    bool localStarted;                                              // Have local processes been started?
 } ArchivePushAsyncData;
 
 static ProtocolParallelJob *
@@ -474,6 +483,7 @@ archivePushAsyncCallback(void *const data, const unsigned int clientIdx)
             pckWriteStrP(param, walFile);
             pckWriteU32P(param, jobData->compressType);
             pckWriteI32P(param, jobData->compressLevel);
+            pckWriteBoolP(param, cfgOptionBool(cfgOptArchivePushTrim));
             pckWriteStrLstP(param, jobData->archiveInfo.errorList);
 
             // Add data for each repo to push to
@@ -488,6 +498,25 @@ archivePushAsyncCallback(void *const data, const unsigned int clientIdx)
                 pckWriteStrP(param, data->archiveId);
                 pckWriteU64P(param, data->cipherType);
                 pckWriteStrP(param, data->cipherPass);
+
+                // Add segments in the repo that match the WAL file so the repo does not need to be listed again
+                StringList *walSegmentList = NULL;
+
+                if (jobData->walSegmentList[repoListIdx] != NULL && walIsSegment(walFile))
+                {
+                    const StringList *const repoSegmentList = jobData->walSegmentList[repoListIdx];
+                    const String *const walSegment = strSubN(walFile, 0, 24);
+
+                    walSegmentList = strLstNew();
+
+                    for (unsigned int repoSegmentIdx = 0; repoSegmentIdx < strLstSize(repoSegmentList); repoSegmentIdx++)
+                    {
+                        if (strBeginsWith(strLstGet(repoSegmentList, repoSegmentIdx), walSegment))
+                            strLstAdd(walSegmentList, strLstGet(repoSegmentList, repoSegmentIdx));
+                    }
+                }
+
+                pckWriteStrLstP(param, walSegmentList);
                 pckWriteObjEndP(param);
             }
 
@@ -505,6 +534,193 @@ archivePushAsyncCallback(void *const data, const unsigned int clientIdx)
     FUNCTION_TEST_RETURN(PROTOCOL_PARALLEL_JOB, result);
 }
 
+/***********************************************************************************************************************************
+Push a list of WAL files. Returns true when all files were pushed (or dropped) without errors.
+***********************************************************************************************************************************/
+static bool
+archivePushAsyncProcess(ArchivePushAsyncData *const jobData)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM_P(VOID, jobData);
+    FUNCTION_LOG_END();
+
+    FUNCTION_AUDIT_HELPER();
+
+    ASSERT(jobData != NULL);
+    ASSERT(!strLstEmpty(jobData->walFileList));
+
+    bool result = true;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        LOG_INFO_FMT(
+            "push %u WAL file(s) to archive: %s%s", strLstSize(jobData->walFileList), strZ(strLstGet(jobData->walFileList, 0)),
+            strLstSize(jobData->walFileList) == 1 ?
+                "" : zNewFmt("...%s", strZ(strLstGet(jobData->walFileList, strLstSize(jobData->walFileList) - 1))));
+
+        // Drop files if queue max has been exceeded
+        if (cfgOptionTest(cfgOptArchivePushQueueMax) && archivePushDrop(jobData->walPath, jobData->walFileList))
+        {
+            for (unsigned int walFileIdx = 0; walFileIdx < strLstSize(jobData->walFileList); walFileIdx++)
+            {
+                const String *const walFile = strLstGet(jobData->walFileList, walFileIdx);
+                const String *const warning = archivePushDropWarning(walFile, cfgOptionUInt64(cfgOptArchivePushQueueMax));
+
+                archiveAsyncStatusOkWrite(archiveModePush, walFile, warning);
+                LOG_WARN(strZ(warning));
+            }
+        }
+        // Else continue processing
+        else
+        {
+            // Check archive info for each repo. This is done for each list so a process that is kept alive will see changes to the
+            // archive info, e.g. a stanza upgrade.
+            jobData->archiveInfo = archivePushCheck(true);
+
+            // List segments in the repo archive once for all the WAL files rather than listing for each WAL file. WAL files are
+            // sorted so each archive path only needs to be listed once. If the list fails then the path will be listed (and the
+            // error reported) for each WAL file.
+            jobData->walSegmentList = memNew(sizeof(StringList *) * lstSize(jobData->archiveInfo.repoList));
+
+            for (unsigned int repoListIdx = 0; repoListIdx < lstSize(jobData->archiveInfo.repoList); repoListIdx++)
+            {
+                const ArchivePushFileRepoData *const repoData = lstGet(jobData->archiveInfo.repoList, repoListIdx);
+                StringList *walSegmentList = strLstNew();
+
+                TRY_BEGIN()
+                {
+                    const String *pathLast = NULL;
+
+                    for (unsigned int walFileIdx = 0; walFileIdx < strLstSize(jobData->walFileList); walFileIdx++)
+                    {
+                        const String *const walFile = strLstGet(jobData->walFileList, walFileIdx);
+
+                        if (walIsSegment(walFile) && !strEq(strSubN(walFile, 0, 16), pathLast))
+                        {
+                            pathLast = strSubN(walFile, 0, 16);
+
+                            const StringList *const pathList = storageListP(
+                                storageRepoIdx(repoData->repoIdx),
+                                strNewFmt(STORAGE_REPO_ARCHIVE "/%s/%s", strZ(repoData->archiveId), strZ(pathLast)));
+
+                            for (unsigned int pathIdx = 0; pathIdx < strLstSize(pathList); pathIdx++)
+                                strLstAdd(walSegmentList, strLstGet(pathList, pathIdx));
+                        }
+                    }
+                }
+                CATCH_ANY()
+                {
+                    walSegmentList = NULL;
+                }
+                TRY_END();
+
+                jobData->walSegmentList[repoListIdx] = walSegmentList;
+            }
+
+            // Create the parallel executor. Local processes are cached so they will be reused for subsequent lists.
+            jobData->walFileIdx = 0;
+
+            ProtocolParallel *const parallelExec = protocolParallelNew(
+                cfgOptionUInt64(cfgOptProtocolTimeout) / 2, archivePushAsyncCallback, jobData);
+
+            for (unsigned int processIdx = 1; processIdx <= cfgOptionUInt(cfgOptProcessMax); processIdx++)
+                protocolParallelClientAdd(parallelExec, protocolLocalGet(protocolStorageTypeRepo, 0, processIdx));
+
+            jobData->localStarted = true;
+
+            // Process jobs
+            MEM_CONTEXT_TEMP_RESET_BEGIN()
+            {
+                do
+                {
+                    const unsigned int completed = protocolParallelProcess(parallelExec);
+
+                    for (unsigned int jobIdx = 0; jobIdx < completed; jobIdx++)
+                    {
+                        protocolKeepAlive();
+
+                        // Get the job and job key
+                        ProtocolParallelJob *const job = protocolParallelResult(parallelExec);
+                        const unsigned int processId = protocolParallelJobProcessId(job);
+                        const String *const walFile = varStr(protocolParallelJobKey(job));
+
+                        // The job was successful
+                        if (protocolParallelJobErrorCode(job) == 0)
+                        {
+                            // Output file warnings
+                            const StringList *const fileWarnList = pckReadStrLstP(protocolParallelJobResult(job));
+
+                            for (unsigned int warnIdx = 0; warnIdx < strLstSize(fileWarnList); warnIdx++)
+                                LOG_WARN_PID(processId, strZ(strLstGet(fileWarnList, warnIdx)));
+
+                            // Log success
+                            LOG_DETAIL_PID_FMT(processId, "pushed WAL file '%s' to the archive", strZ(walFile));
+
+                            // Write the status file
+                            archiveAsyncStatusOkWrite(
+                                archiveModePush, walFile, strLstEmpty(fileWarnList) ? NULL : strLstJoin(fileWarnList, "\n"));
+                        }
+                        // Else the job errored
+                        else
+                        {
+                            LOG_WARN_PID_FMT(
+                                processId,
+                                "could not push WAL file '%s' to the archive (will be retried): [%d] %s", strZ(walFile),
+                                protocolParallelJobErrorCode(job), strZ(protocolParallelJobErrorMessage(job)));
+
+                            archiveAsyncStatusErrorWrite(
+                                archiveModePush, walFile, protocolParallelJobErrorCode(job),
+                                protocolParallelJobErrorMessage(job));
+
+                            result = false;
+                        }
+
+                        protocolParallelJobFree(job);
+                    }
+
+                    // Reset the memory context occasionally so we don't use too much memory or slow down processing
+                    MEM_CONTEXT_TEMP_RESET(1000);
+                }
+                while (!protocolParallelDone(parallelExec));
+            }
+            MEM_CONTEXT_TEMP_END();
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    // Archive info and segment lists were allocated in the temp context so clear them
+    jobData->archiveInfo = (ArchivePushCheckResult){0};
+    jobData->walSegmentList = NULL;
+
+    FUNCTION_LOG_RETURN(BOOL, result);
+}
+
+/***********************************************************************************************************************************
+Send a keep alive to the local and remote processes while waiting for more WAL files to be ready. The local processes are idle
+while waiting and will exit after protocol-timeout if nothing is sent to them. A noop sent to a local process also keeps the local
+process' remotes alive.
+***********************************************************************************************************************************/
+static void
+archivePushAsyncKeepAlive(const ArchivePushAsyncData *const jobData)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM_P(VOID, jobData);
+    FUNCTION_LOG_END();
+
+    ASSERT(jobData != NULL);
+
+    if (jobData->localStarted)
+    {
+        for (unsigned int processIdx = 1; processIdx <= cfgOptionUInt(cfgOptProcessMax); processIdx++)
+            protocolClientNoOp(protocolLocalGet(protocolStorageTypeRepo, 0, processIdx));
+    }
+
+    protocolKeepAlive();
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/**********************************************************************************************************************************/
 FN_EXTERN void
 cmdArchivePushAsync(void)
 {
@@ -542,90 +758,38 @@ cmdArchivePushAsync(void)
             if (strLstEmpty(jobData.walFileList))
                 THROW(AssertError, "no WAL files to process");
 
-            LOG_INFO_FMT(
-                "push %u WAL file(s) to archive: %s%s", strLstSize(jobData.walFileList), strZ(strLstGet(jobData.walFileList, 0)),
-                strLstSize(jobData.walFileList) == 1 ?
-                    "" : zNewFmt("...%s", strZ(strLstGet(jobData.walFileList, strLstSize(jobData.walFileList) - 1))));
-
-            // Drop files if queue max has been exceeded
-            if (cfgOptionTest(cfgOptArchivePushQueueMax) && archivePushDrop(jobData.walPath, jobData.walFileList))
-            {
-                for (unsigned int walFileIdx = 0; walFileIdx < strLstSize(jobData.walFileList); walFileIdx++)
-                {
-                    const String *const walFile = strLstGet(jobData.walFileList, walFileIdx);
-                    const String *const warning = archivePushDropWarning(walFile, cfgOptionUInt64(cfgOptArchivePushQueueMax));
+            // Push WAL files. If keep alive is set then wait for more WAL files to be ready and push them with the same process,
+            // which avoids the cost of starting a new async process (and local processes) for each list of WAL files. The wait
+            // stops on error so the next archive-push command can start a new async process to retry.
+            const TimeMSec keepAlive = cfgOptionUInt64(cfgOptArchivePushKeepAlive);
+            const TimeMSec keepAliveNoOp = cfgOptionUInt64(cfgOptProtocolTimeout) / 2;
 
-                    archiveAsyncStatusOkWrite(archiveModePush, walFile, warning);
-                    LOG_WARN(strZ(warning));
-                }
-            }
-            // Else continue processing
-            else
+            while (archivePushAsyncProcess(&jobData) && keepAlive > 0)
             {
-                // Check archive info for each repo
-                jobData.archiveInfo = archivePushCheck(true);
-
-                // Create the parallel executor
-                ProtocolParallel *const parallelExec = protocolParallelNew(
-                    cfgOptionUInt64(cfgOptProtocolTimeout) / 2, archivePushAsyncCallback, &jobData);
+                const TimeMSec keepAliveEnd = timeMSec() + keepAlive;
+                TimeMSec keepAliveNoOpLast = timeMSec();
 
-                for (unsigned int processIdx = 1; processIdx <= cfgOptionUInt(cfgOptProcessMax); processIdx++)
-                    protocolParallelClientAdd(parallelExec, protocolLocalGet(protocolStorageTypeRepo, 0, processIdx));
-
-                // Process jobs
-                MEM_CONTEXT_TEMP_RESET_BEGIN()
+                do
                 {
-                    do
-                    {
-                        const unsigned int completed = protocolParallelProcess(parallelExec);
+                    strLstFree(jobData.walFileList);
+                    sleepMSec(ARCHIVE_PUSH_ASYNC_KEEP_ALIVE_SLEEP);
 
-                        for (unsigned int jobIdx = 0; jobIdx < completed; jobIdx++)
-                        {
-                            protocolKeepAlive();
-
-                            // Get the job and job key
-                            ProtocolParallelJob *const job = protocolParallelResult(parallelExec);
-                            const unsigned int processId = protocolParallelJobProcessId(job);
-                            const String *const walFile = varStr(protocolParallelJobKey(job));
-
-                            // The job was successful
-                            if (protocolParallelJobErrorCode(job) == 0)
-                            {
-                                // Output file warnings
-                                const StringList *const fileWarnList = pckReadStrLstP(protocolParallelJobResult(job));
-
-                                for (unsigned int warnIdx = 0; warnIdx < strLstSize(fileWarnList); warnIdx++)
-                                    LOG_WARN_PID(processId, strZ(strLstGet(fileWarnList, warnIdx)));
-
-                                // Log success
-                                LOG_DETAIL_PID_FMT(processId, "pushed WAL file '%s' to the archive", strZ(walFile));
-
-                                // Write the status file
-                                archiveAsyncStatusOkWrite(
-                                    archiveModePush, walFile, strLstEmpty(fileWarnList) ? NULL : strLstJoin(fileWarnList, "\n"));
-                            }
-                            // Else the job errored
-                            else
-                            {
-                                LOG_WARN_PID_FMT(
-                                    processId,
-                                    "could not push WAL file '%s' to the archive (will be retried): [%d] %s", strZ(walFile),
-                                    protocolParallelJobErrorCode(job), strZ(protocolParallelJobErrorMessage(job)));
-
-                                archiveAsyncStatusErrorWrite(
-                                    archiveModePush, walFile, protocolParallelJobErrorCode(job),
-                                    protocolParallelJobErrorMessage(job));
-                            }
-
-                            protocolParallelJobFree(job);
-                        }
+                    // Test for stop file
+                    lockStopTest();
 
-                        // Reset the memory context occasionally so we don't use too much memory or slow down processing
-                        MEM_CONTEXT_TEMP_RESET(1000);
+                    // Keep local and remote processes from timing out while waiting
+                    if (timeMSec() - keepAliveNoOpLast >= keepAliveNoOp)
+                    {
+                        archivePushAsyncKeepAlive(&jobData);
+                        keepAliveNoOpLast = timeMSec();
                     }
-                    while (!protocolParallelDone(parallelExec));
+
+                    jobData.walFileList = archivePushProcessList(jobData.walPath);
                 }
-                MEM_CONTEXT_TEMP_END();
+                while (strLstEmpty(jobData.walFileList) && timeMSec() < keepAliveEnd);
+
+                if (strLstEmpty(jobData.walFileList))
+                    break;
             }
         }
         // On any global error write a single error file to cover all unprocessed files
@@ -0,0 +1,661 @@
+/***********************************************************************************************************************************
+WAL Trim Filters
+***********************************************************************************************************************************/
+#include "build.auto.h"
+
+#include <string.h>
+
+#include "command/archive/walTrim.h"
+#include "common/debug.h"
+#include "common/io/filter/filter.h"
+#include "common/log.h"
+#include "common/type/object.h"
+#include "common/type/pack.h"
+
+/***********************************************************************************************************************************
+WAL page layout
+
+The fields at the beginning of the page header (magic, info, timeline, page address, remaining length) are common to all supported
+versions of PostgreSQL. Padding pages are only detected for the default WAL page size. With any other page size the pages will not
+match and the segment is stored as is.
+***********************************************************************************************************************************/
+#define WAL_TRIM_PAGE_SIZE                                          ((size_t)8192)
+#define WAL_TRIM_HEADER_SIZE                                        8
+#define WAL_TRIM_ADDR_SIZE                                          8
+
+/***********************************************************************************************************************************
+Run of padding pages. Every page in the run has the same header followed by a page address that is incremented for each page. The
+remaining length and the rest of the page must be zero.
+***********************************************************************************************************************************/
+typedef struct WalTrimRun
+{
+    uint8_t header[WAL_TRIM_HEADER_SIZE];                           // Magic, info, and timeline of each page
+    uint64_t addr;                                                  // Page address of the first page
+    uint64_t step;                                                  // Page address increment (zero when the pages are all zeros)
+    uint64_t total;                                                 // Total pages in the run
+    bool addrBigEndian;                                             // Are the page addresses big-endian?
+} WalTrimRun;
+
+/***********************************************************************************************************************************
+Trailer written in place of the final run. Integers are stored big-endian so a segment trimmed on one architecture can be expanded
+on another. The header is copied from the page as is and the byte order of the page addresses is recorded since the pages are
+written in the byte order of the PostgreSQL host.
+
+The trailer size is never a multiple of the page size so a trimmed file can always be distinguished from a complete segment.
+***********************************************************************************************************************************/
+#define WAL_TRIM_MAGIC                                              "PGBRTRIM"
+#define WAL_TRIM_VERSION                                            1
+
+#define WAL_TRIM_TRAILER_ADDR                                       WAL_TRIM_HEADER_SIZE
+#define WAL_TRIM_TRAILER_STEP                                       (WAL_TRIM_TRAILER_ADDR + WAL_TRIM_ADDR_SIZE)
+#define WAL_TRIM_TRAILER_TOTAL                                      (WAL_TRIM_TRAILER_STEP + 8)
+#define WAL_TRIM_TRAILER_BIG_ENDIAN                                 (WAL_TRIM_TRAILER_TOTAL + 8)
+#define WAL_TRIM_TRAILER_VERSION                                    (WAL_TRIM_TRAILER_BIG_ENDIAN + 1)
+#define WAL_TRIM_TRAILER_MAGIC                                      (WAL_TRIM_TRAILER_VERSION + 1)
+#define WAL_TRIM_TRAILER_SIZE                                       (WAL_TRIM_TRAILER_MAGIC + sizeof(WAL_TRIM_MAGIC) - 1)
+
+// Is this host big-endian? Pages read by the trim filter were written by PostgreSQL on this host.
+static bool
+walTrimHostBigEndian(void)
+{
+    FUNCTION_TEST_VOID();
+
+    const uint16_t value = 1;
+
+    FUNCTION_TEST_RETURN(BOOL, *(const uint8_t *)&value == 0);
+}
+
+// Read/write an integer in the requested byte order
+static uint64_t
+walTrimU64Get(const unsigned char *const buffer, const bool bigEndian)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(UCHARDATA, buffer);
+        FUNCTION_TEST_PARAM(BOOL, bigEndian);
+    FUNCTION_TEST_END();
+
+    uint64_t result = 0;
+
+    for (unsigned int byteIdx = 0; byteIdx < 8; byteIdx++)
+        result |= (uint64_t)buffer[bigEndian ? byteIdx : 7 - byteIdx] << ((7 - byteIdx) * 8);
+
+    FUNCTION_TEST_RETURN(UINT64, result);
+}
+
+static void
+walTrimU64Put(unsigned char *const buffer, const uint64_t value, const bool bigEndian)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(UCHARDATA, buffer);
+        FUNCTION_TEST_PARAM(UINT64, value);
+        FUNCTION_TEST_PARAM(BOOL, bigEndian);
+    FUNCTION_TEST_END();
+
+    for (unsigned int byteIdx = 0; byteIdx < 8; byteIdx++)
+        buffer[bigEndian ? byteIdx : 7 - byteIdx] = (unsigned char)(value >> ((7 - byteIdx) * 8));
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Output shared by the filters. Output that does not fit in the output buffer is written on the next call before more input is
+processed.
+***********************************************************************************************************************************/
+typedef struct WalTrimOut
+{
+    Buffer *pending;                                                // Data waiting to be written to the output buffer
+    size_t pendingPos;                                              // Position of the data not yet written in pending
+    WalTrimRun emit;                                                // Run of padding pages to regenerate
+    uint64_t emitIdx;                                               // Next page in the run to regenerate
+    Buffer *held;                                                   // Page to write after the run is regenerated (trim only)
+} WalTrimOut;
+
+// Is there output waiting to be written?
+static bool
+walTrimOutWaiting(const WalTrimOut *const this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, this);
+    FUNCTION_TEST_END();
+
+    FUNCTION_TEST_RETURN(
+        BOOL,
+        this->pendingPos < bufUsed(this->pending) || this->emitIdx < this->emit.total ||
+            (this->held != NULL && !bufEmpty(this->held)));
+}
+
+// Write output that is waiting. Returns false when no output is waiting.
+static bool
+walTrimOutWrite(WalTrimOut *const this, Buffer *const output)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, this);
+        FUNCTION_TEST_PARAM(BUFFER, output);
+    FUNCTION_TEST_END();
+
+    bool result = true;
+
+    // Copy as much pending data as will fit in the output buffer
+    if (this->pendingPos < bufUsed(this->pending))
+    {
+        size_t copySize = bufUsed(this->pending) - this->pendingPos;
+
+        if (copySize > bufRemains(output))
+            copySize = bufRemains(output);
+
+        bufCatSub(output, this->pending, this->pendingPos, copySize);
+        this->pendingPos += copySize;
+
+        if (this->pendingPos == bufUsed(this->pending))
+        {
+            bufUsedZero(this->pending);
+            this->pendingPos = 0;
+        }
+    }
+    // Else regenerate the next page in the run
+    else if (this->emitIdx < this->emit.total)
+    {
+        unsigned char *const page = bufPtr(this->pending);
+
+        memset(page, 0, WAL_TRIM_PAGE_SIZE);
+        memcpy(page, this->emit.header, WAL_TRIM_HEADER_SIZE);
+
+        walTrimU64Put(
+            page + WAL_TRIM_HEADER_SIZE, this->emit.addr + this->emitIdx * this->emit.step, this->emit.addrBigEndian);
+
+        bufUsedSet(this->pending, WAL_TRIM_PAGE_SIZE);
+        this->emitIdx++;
+    }
+    // Else write the held page
+    else if (this->held != NULL && !bufEmpty(this->held))
+    {
+        bufCat(this->pending, this->held);
+        bufUsedZero(this->held);
+    }
+    else
+        result = false;
+
+    FUNCTION_TEST_RETURN(BOOL, result);
+}
+
+// Start regenerating a run of padding pages
+static void
+walTrimOutEmit(WalTrimOut *const this, const WalTrimRun *const run)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, this);
+        FUNCTION_TEST_PARAM_P(VOID, run);
+    FUNCTION_TEST_END();
+
+    ASSERT(!walTrimOutWaiting(this));
+
+    this->emit = *run;
+    this->emitIdx = 0;
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Trim filter
+***********************************************************************************************************************************/
+typedef struct WalTrim
+{
+    WalTrimOut out;                                                 // Output
+    Buffer *page;                                                   // Page being assembled from the input
+    uint64_t pageTotal;                                             // Pages assembled from the input
+    WalTrimRun run;                                                 // Current run of padding pages
+    size_t inputPos;                                                // Position in the input buffer
+    bool inputSame;                                                 // Is the same input required again?
+    bool flushed;                                                   // Has all input been processed?
+} WalTrim;
+
+static void
+walTrimToLog(const WalTrim *const this, StringStatic *const debugLog)
+{
+    strStcFmt(debugLog, "{pageTotal: %" PRIu64 ", runTotal: %" PRIu64 "}", this->pageTotal, this->run.total);
+}
+
+#define FUNCTION_LOG_WAL_TRIM_TYPE                                                                                                 \
+    WalTrim *
+#define FUNCTION_LOG_WAL_TRIM_FORMAT(value, buffer, bufferSize)                                                                    \
+    FUNCTION_LOG_OBJECT_FORMAT(value, walTrimToLog, buffer, bufferSize)
+
+/***********************************************************************************************************************************
+Is the page a padding page? If so the run is set to a run containing just the page.
+***********************************************************************************************************************************/
+static bool
+walTrimPagePadding(const unsigned char *const page, WalTrimRun *const run)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(UCHARDATA, page);
+        FUNCTION_TEST_PARAM_P(VOID, run);
+    FUNCTION_TEST_END();
+
+    // Everything after the page address must be zero
+    for (size_t pageIdx = WAL_TRIM_HEADER_SIZE + WAL_TRIM_ADDR_SIZE; pageIdx < WAL_TRIM_PAGE_SIZE; pageIdx++)
+    {
+        if (page[pageIdx] != 0)
+            FUNCTION_TEST_RETURN(BOOL, false);
+    }
+
+    *run = (WalTrimRun){.total = 1, .addrBigEndian = walTrimHostBigEndian()};
+    memcpy(run->header, page, WAL_TRIM_HEADER_SIZE);
+    run->addr = walTrimU64Get(page + WAL_TRIM_HEADER_SIZE, run->addrBigEndian);
+
+    // Pages that are all zeros do not have an incrementing page address
+    static const uint8_t headerZero[WAL_TRIM_HEADER_SIZE + WAL_TRIM_ADDR_SIZE] = {0};
+
+    if (memcmp(page, headerZero, sizeof(headerZero)) != 0)
+        run->step = WAL_TRIM_PAGE_SIZE;
+
+    FUNCTION_TEST_RETURN(BOOL, true);
+}
+
+/***********************************************************************************************************************************
+Add a complete page to the current run or write it to the output
+***********************************************************************************************************************************/
+static void
+walTrimPage(WalTrim *const this)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(WAL_TRIM, this);
+    FUNCTION_LOG_END();
+
+    ASSERT(bufFull(this->page));
+
+    WalTrimRun pageRun;
+
+    // The first page contains the long header so it is never trimmed
+    if (this->pageTotal > 0 && walTrimPagePadding(bufPtr(this->page), &pageRun))
+    {
+        // Add the page to the current run when it follows the last page in the run. Pages that are all zeros can only follow other
+        // pages that are all zeros since the address of the next page in any other run is never zero.
+        if (this->run.total > 0 && memcmp(this->run.header, pageRun.header, WAL_TRIM_HEADER_SIZE) == 0 &&
+            this->run.addr + this->run.total * this->run.step == pageRun.addr)
+        {
+            this->run.total++;
+        }
+        // Else output the current run and start a new run
+        else
+        {
+            walTrimOutEmit(&this->out, &this->run);
+            this->run = pageRun;
+        }
+    }
+    // Else output the current run followed by the page
+    else
+    {
+        walTrimOutEmit(&this->out, &this->run);
+        this->run = (WalTrimRun){0};
+        bufCat(this->out.held, this->page);
+    }
+
+    bufUsedZero(this->page);
+    this->pageTotal++;
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Trim the final run of padding pages
+***********************************************************************************************************************************/
+static void
+walTrimProcess(THIS_VOID, const Buffer *const input, Buffer *const output)
+{
+    THIS(WalTrim);
+
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(WAL_TRIM, this);
+        FUNCTION_LOG_PARAM(BUFFER, input);
+        FUNCTION_LOG_PARAM(BUFFER, output);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(output != NULL);
+
+    do
+    {
+        // Write output that is waiting before processing more input
+        if (!walTrimOutWrite(&this->out, output))
+        {
+            // Assemble pages from the input
+            if (input != NULL && this->inputPos < bufUsed(input))
+            {
+                size_t copySize = bufUsed(input) - this->inputPos;
+
+                if (copySize > bufRemains(this->page))
+                    copySize = bufRemains(this->page);
+
+                bufCatSub(this->page, input, this->inputPos, copySize);
+                this->inputPos += copySize;
+
+                if (bufFull(this->page))
+                    walTrimPage(this);
+            }
+            // Else all input has been processed
+            else if (input == NULL && !this->flushed)
+            {
+                // A partial page cannot be regenerated so output the current run followed by the partial page
+                if (!bufEmpty(this->page))
+                {
+                    walTrimOutEmit(&this->out, &this->run);
+                    bufCat(this->out.held, this->page);
+                }
+                // Else replace the final run with the trailer
+                else if (this->run.total > 0)
+                {
+                    unsigned char trailer[WAL_TRIM_TRAILER_SIZE];
+
+                    memcpy(trailer, this->run.header, WAL_TRIM_HEADER_SIZE);
+                    walTrimU64Put(trailer + WAL_TRIM_TRAILER_ADDR, this->run.addr, true);
+                    walTrimU64Put(trailer + WAL_TRIM_TRAILER_STEP, this->run.step, true);
+                    walTrimU64Put(trailer + WAL_TRIM_TRAILER_TOTAL, this->run.total, true);
+                    trailer[WAL_TRIM_TRAILER_BIG_ENDIAN] = this->run.addrBigEndian;
+                    trailer[WAL_TRIM_TRAILER_VERSION] = WAL_TRIM_VERSION;
+                    memcpy(trailer + WAL_TRIM_TRAILER_MAGIC, WAL_TRIM_MAGIC, sizeof(WAL_TRIM_MAGIC) - 1);
+
+                    bufCatC(this->out.pending, trailer, 0, sizeof(trailer));
+                }
+
+                this->flushed = true;
+            }
+            // Else nothing to do until there is more input
+            else
+                break;
+        }
+    }
+    while (!bufFull(output));
+
+    // The same input is required until it has been processed and all output written
+    this->inputSame = input != NULL && (this->inputPos < bufUsed(input) || walTrimOutWaiting(&this->out));
+
+    if (!this->inputSame)
+        this->inputPos = 0;
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Is the filter done?
+***********************************************************************************************************************************/
+static bool
+walTrimDone(const THIS_VOID)
+{
+    THIS(const WalTrim);
+
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(WAL_TRIM, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(BOOL, this->flushed && !walTrimOutWaiting(&this->out));
+}
+
+/***********************************************************************************************************************************
+Is the same input required again?
+***********************************************************************************************************************************/
+static bool
+walTrimInputSame(const THIS_VOID)
+{
+    THIS(const WalTrim);
+
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(WAL_TRIM, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(BOOL, this->inputSame);
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN IoFilter *
+walTrimNew(void)
+{
+    FUNCTION_LOG_VOID(logLevelTrace);
+
+    OBJ_NEW_BEGIN(WalTrim, .childQty = MEM_CONTEXT_QTY_MAX)
+    {
+        *this = (WalTrim)
+        {
+            .out =
+            {
+                .pending = bufNew(WAL_TRIM_PAGE_SIZE),
+                .held = bufNew(WAL_TRIM_PAGE_SIZE),
+            },
+            .page = bufNew(WAL_TRIM_PAGE_SIZE),
+        };
+    }
+    OBJ_NEW_END();
+
+    FUNCTION_LOG_RETURN(
+        IO_FILTER,
+        ioFilterNewP(
+            WAL_TRIM_FILTER_TYPE, this, NULL, .done = walTrimDone, .inOut = walTrimProcess, .inputSame = walTrimInputSame));
+}
+
+/***********************************************************************************************************************************
+Expand filter
+***********************************************************************************************************************************/
+typedef struct WalExpand
+{
+    uint64_t walSegmentSize;                                        // WAL segment size
+    WalTrimOut out;                                                 // Output
+    Buffer *tail;                                                   // End of the input that may be a trailer
+    uint64_t size;                                                  // Size of the input before the tail
+    size_t inputPos;                                                // Position in the input buffer
+    bool inputSame;                                                 // Is the same input required again?
+    bool flushed;                                                   // Has all input been processed?
+} WalExpand;
+
+static void
+walExpandToLog(const WalExpand *const this, StringStatic *const debugLog)
+{
+    strStcFmt(debugLog, "{size: %" PRIu64 ", emitTotal: %" PRIu64 "}", this->size, this->out.emit.total);
+}
+
+#define FUNCTION_LOG_WAL_EXPAND_TYPE                                                                                               \
+    WalExpand *
+#define FUNCTION_LOG_WAL_EXPAND_FORMAT(value, buffer, bufferSize)                                                                  \
+    FUNCTION_LOG_OBJECT_FORMAT(value, walExpandToLog, buffer, bufferSize)
+
+/***********************************************************************************************************************************
+Regenerate the final run of padding pages when the input ends with a trailer
+***********************************************************************************************************************************/
+static void
+walExpandProcess(THIS_VOID, const Buffer *const input, Buffer *const output)
+{
+    THIS(WalExpand);
+
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(WAL_EXPAND, this);
+        FUNCTION_LOG_PARAM(BUFFER, input);
+        FUNCTION_LOG_PARAM(BUFFER, output);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(output != NULL);
+
+    do
+    {
+        // Write output that is waiting before processing more input
+        if (!walTrimOutWrite(&this->out, output))
+        {
+            // Pass the input through, holding back the end of the input since it may be a trailer
+            if (input != NULL && this->inputPos < bufUsed(input))
+            {
+                size_t copySize = bufUsed(input) - this->inputPos;
+
+                if (copySize > WAL_TRIM_PAGE_SIZE)
+                    copySize = WAL_TRIM_PAGE_SIZE;
+
+                bufCat(this->out.pending, this->tail);
+                bufCatSub(this->out.pending, input, this->inputPos, copySize);
+                this->inputPos += copySize;
+
+                // Move the end of the pending data to the tail
+                const size_t tailSize = bufUsed(this->out.pending) < WAL_TRIM_TRAILER_SIZE ?
+                    bufUsed(this->out.pending) : WAL_TRIM_TRAILER_SIZE;
+
+                bufUsedZero(this->tail);
+                bufCatSub(this->tail, this->out.pending, bufUsed(this->out.pending) - tailSize, tailSize);
+                bufUsedSet(this->out.pending, bufUsed(this->out.pending) - tailSize);
+
+                this->size += bufUsed(this->out.pending);
+            }
+            // Else all input has been processed
+            else if (input == NULL && !this->flushed)
+            {
+                const unsigned char *const trailer = bufPtrConst(this->tail);
+
+                // Regenerate the run when the tail is a trailer following complete pages
+                if (bufFull(this->tail) && this->size % WAL_TRIM_PAGE_SIZE == 0 &&
+                    memcmp(trailer + WAL_TRIM_TRAILER_MAGIC, WAL_TRIM_MAGIC, sizeof(WAL_TRIM_MAGIC) - 1) == 0)
+                {
+                    if (trailer[WAL_TRIM_TRAILER_VERSION] != WAL_TRIM_VERSION)
+                    {
+                        THROW_FMT(
+                            FormatError, "WAL trim trailer version %u does not match expected version %u",
+                            (unsigned int)trailer[WAL_TRIM_TRAILER_VERSION], (unsigned int)WAL_TRIM_VERSION);
+                    }
+
+                    WalTrimRun run =
+                    {
+                        .addr = walTrimU64Get(trailer + WAL_TRIM_TRAILER_ADDR, true),
+                        .step = walTrimU64Get(trailer + WAL_TRIM_TRAILER_STEP, true),
+                        .total = walTrimU64Get(trailer + WAL_TRIM_TRAILER_TOTAL, true),
+                        .addrBigEndian = trailer[WAL_TRIM_TRAILER_BIG_ENDIAN] != 0,
+                    };
+
+                    memcpy(run.header, trailer, WAL_TRIM_HEADER_SIZE);
+
+                    // The expanded segment cannot be larger than the WAL segment size
+                    if (this->size > this->walSegmentSize ||
+                        run.total > (this->walSegmentSize - this->size) / WAL_TRIM_PAGE_SIZE)
+                    {
+                        THROW_FMT(
+                            FormatError, "WAL trim trailer expands %" PRIu64 " bytes to more than the WAL segment size %" PRIu64,
+                            this->size, this->walSegmentSize);
+                    }
+
+                    walTrimOutEmit(&this->out, &run);
+                }
+                // Else output the tail
+                else
+                    bufCat(this->out.pending, this->tail);
+
+                this->flushed = true;
+            }
+            // Else nothing to do until there is more input
+            else
+                break;
+        }
+    }
+    while (!bufFull(output));
+
+    // The same input is required until it has been processed and all output written
+    this->inputSame = input != NULL && (this->inputPos < bufUsed(input) || walTrimOutWaiting(&this->out));
+
+    if (!this->inputSame)
+        this->inputPos = 0;
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Is the filter done?
+***********************************************************************************************************************************/
+static bool
+walExpandDone(const THIS_VOID)
+{
+    THIS(const WalExpand);
+
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(WAL_EXPAND, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(BOOL, this->flushed && !walTrimOutWaiting(&this->out));
+}
+
+/***********************************************************************************************************************************
+Is the same input required again?
+***********************************************************************************************************************************/
+static bool
+walExpandInputSame(const THIS_VOID)
+{
+    THIS(const WalExpand);
+
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(WAL_EXPAND, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(BOOL, this->inputSame);
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN IoFilter *
+walExpandNew(const uint64_t walSegmentSize)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(UINT64, walSegmentSize);
+    FUNCTION_LOG_END();
+
+    ASSERT(walSegmentSize > 0);
+
+    OBJ_NEW_BEGIN(WalExpand, .childQty = MEM_CONTEXT_QTY_MAX)
+    {
+        *this = (WalExpand)
+        {
+            .walSegmentSize = walSegmentSize,
+            .out =
+            {
+                .pending = bufNew(WAL_TRIM_PAGE_SIZE + WAL_TRIM_TRAILER_SIZE),
+            },
+            .tail = bufNew(WAL_TRIM_TRAILER_SIZE),
+        };
+    }
+    OBJ_NEW_END();
+
+    // Create param list
+    Pack *paramList;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        PackWrite *const packWrite = pckWriteNewP();
+
+        pckWriteU64P(packWrite, walSegmentSize);
+        pckWriteEndP(packWrite);
+
+        paramList = pckMove(pckWriteResult(packWrite), memContextPrior());
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN(
+        IO_FILTER,
+        ioFilterNewP(
+            WAL_EXPAND_FILTER_TYPE, this, paramList, .done = walExpandDone, .inOut = walExpandProcess,
+            .inputSame = walExpandInputSame));
+}
+
+FN_EXTERN IoFilter *
+walExpandNewPack(const Pack *const paramList)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(PACK, paramList);
+    FUNCTION_TEST_END();
+
+    IoFilter *result = NULL;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        result = ioFilterMove(walExpandNew(pckReadU64P(pckReadNew(paramList))), memContextPrior());
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_TEST_RETURN(IO_FILTER, result);
+}
@@ -0,0 +1,29 @@
+/***********************************************************************************************************************************
+WAL Trim Filters
+
+WAL segments switched early by archive_timeout or pg_switch_wal() are padded to the end of the segment with pages that contain only a
+page header (or are all zeros). The trim filter replaces the final run of padding pages with a small trailer that describes the run.
+The expand filter detects the trailer and regenerates the padding pages so the segment is restored exactly. Files that do not end
+with a trailer pass through the expand filter unchanged. A trailer with an unknown version or that would expand the file past the
+WAL segment size is an error.
+***********************************************************************************************************************************/
+#ifndef COMMAND_ARCHIVE_WAL_TRIM_H
+#define COMMAND_ARCHIVE_WAL_TRIM_H
+
+#include "common/io/filter/filter.h"
+#include "common/type/pack.h"
+
+/***********************************************************************************************************************************
+Filter type constants
+***********************************************************************************************************************************/
+#define WAL_TRIM_FILTER_TYPE                                        STRID5("wal-trim", 0x6a654db0370)
+#define WAL_EXPAND_FILTER_TYPE                                      STRID5("wal-expand", 0x8e0c305db0370)
+
+/***********************************************************************************************************************************
+Constructors
+***********************************************************************************************************************************/
+FN_EXTERN IoFilter *walTrimNew(void);
+FN_EXTERN IoFilter *walExpandNew(uint64_t walSegmentSize);
+FN_EXTERN IoFilter *walExpandNewPack(const Pack *paramList);
+
+#endif
@@ -9,10 +9,12 @@ Backup Command
 #include <unistd.h>
 
 #include "command/archive/find.h"
+#include "command/archive/walTrim.h"
 #include "command/backup/backup.h"
 #include "command/backup/common.h"
 #include "command/backup/file.h"
 #include "command/backup/protocol.h"
+#include "command/backup/walSummary.h"
 #include "command/check/common.h"
 #include "command/control/common.h"
 #include "command/lock.h"
@@ -21,11 +23,13 @@ Backup Command
 #include "common/crypto/cipherBlock.h"
 #include "common/debug.h"
 #include "common/io/filter/size.h"
+#include "common/io/io.h"
 #include "common/log.h"
 #include "common/regExp.h"
 #include "common/time.h"
 #include "common/type/convert.h"
 #include "common/type/json.h"
+#include "common/wait.h"
 #include "config/common.h"
 #include "config/config.h"
 #include "config/parse.h"
@@ -167,6 +171,7 @@ typedef struct BackupData
     unsigned int version;                                           // PostgreSQL version
     unsigned int walSegmentSize;                                    // PostgreSQL wal segment size
     PgPageSize pageSize;                                            // PostgreSQL page size
+    unsigned int segmentPageTotal;                                  // PostgreSQL pages per relation segment
 } BackupData;
 
 static BackupData *
@@ -234,6 +239,7 @@ backupInit(const InfoBackup *const infoBackup)
     result->version = pgControl.version;
     result->walSegmentSize = pgControl.walSegmentSize;
     result->pageSize = pgControl.pageSize;
+    result->segmentPageTotal = pgControl.segmentPageTotal;
 
     // Validate pg_control info against the stanza
     if (result->version != infoPg.version || pgControl.systemId != infoPg.systemId)
@@ -590,7 +596,7 @@ backupBuildIncrPrior(const InfoBackup *const infoBackup)
             // If there is a prior backup then check that options for the new backup are compatible
             if (backupLabelPrior != NULL)
             {
-                result = manifestLoadFile(
+                result = manifestLoadFileP(
                     storageRepo(), strNewFmt(STORAGE_REPO_BACKUP "/%s/" BACKUP_MANIFEST_FILE, strZ(backupLabelPrior)),
                     cfgOptionStrId(cfgOptRepoCipherType), infoPgCipherPass(infoBackupPg(infoBackup)));
                 const ManifestData *const manifestPriorData = manifestData(result);
@@ -701,6 +707,158 @@ backupBuildIncr(
     FUNCTION_LOG_RETURN(BOOL, result);
 }
 
+/***********************************************************************************************************************************
+Get the prior backup start lsn used by block incremental to skip blocks where all pages are older than the prior backup. Returns 0
+when page lsns cannot be trusted to detect changes. Page checksums must be enabled so hint bit changes are WAL-logged and update the
+page lsn, and the prior backup must be on the same timeline since a timeline switch may reuse lsns older than the prior backup.
+***********************************************************************************************************************************/
+static uint64_t
+backupBlockIncrLsnPrior(const Manifest *const manifestPrior, const String *const archiveStart)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(MANIFEST, manifestPrior);
+        FUNCTION_LOG_PARAM(STRING, archiveStart);
+    FUNCTION_LOG_END();
+
+    uint64_t result = 0;
+
+    if (cfgOptionBool(cfgOptRepoBlock) && cfgOptionBool(cfgOptRepoBlockLsn) && cfgOptionBool(cfgOptChecksumPage) &&
+        manifestPrior != NULL && archiveStart != NULL && manifestData(manifestPrior)->archiveStart != NULL)
+    {
+        const ManifestData *const dataPrior = manifestData(manifestPrior);
+
+        if (pgTimelineFromWalSegment(dataPrior->archiveStart) == pgTimelineFromWalSegment(archiveStart))
+        {
+            result = pgLsnFromStr(dataPrior->lsnStart);
+
+            LOG_DETAIL_FMT(
+                "block incremental will skip blocks with all pages older than prior backup start lsn %s",
+                strZ(dataPrior->lsnStart));
+        }
+    }
+
+    FUNCTION_LOG_RETURN(UINT64, result);
+}
+
+/***********************************************************************************************************************************
+Load the WAL summaries covering the range from the prior backup start lsn to the current backup start lsn. Returns NULL when WAL
+summaries are not enabled or cannot be used, in which case changes are detected using timestamps as usual.
+***********************************************************************************************************************************/
+static WalSummary *
+backupWalSummary(
+    const BackupData *const backupData, const Manifest *const manifestPrior, const String *const lsnStart,
+    const String *const archiveStart)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(BACKUP_DATA, backupData);
+        FUNCTION_LOG_PARAM(MANIFEST, manifestPrior);
+        FUNCTION_LOG_PARAM(STRING, lsnStart);
+        FUNCTION_LOG_PARAM(STRING, archiveStart);
+    FUNCTION_LOG_END();
+
+    ASSERT(backupData != NULL);
+
+    WalSummary *result = NULL;
+
+    if (cfgOptionBool(cfgOptWalSummary) && backupData->version >= PG_VERSION_WAL_SUMMARY && manifestPrior != NULL &&
+        archiveStart != NULL && manifestData(manifestPrior)->archiveStart != NULL &&
+        pgTimelineFromWalSegment(manifestData(manifestPrior)->archiveStart) == pgTimelineFromWalSegment(archiveStart))
+    {
+        MEM_CONTEXT_TEMP_BEGIN()
+        {
+            const ManifestData *const dataPrior = manifestData(manifestPrior);
+            const unsigned int timeline = pgTimelineFromWalSegment(archiveStart);
+            const uint64_t lsnBegin = pgLsnFromStr(dataPrior->lsnStart);
+            const uint64_t lsnEnd = pgLsnFromStr(lsnStart);
+            const String *const summaryPath = strNewFmt("%s/" PG_PATH_SUMMARIES, strZ(pgWalPath(backupData->version)));
+            Wait *const wait = waitNew(cfgOptionUInt64(cfgOptArchiveTimeout));
+            StringList *summaryList;
+            uint64_t lsnCovered;
+
+            // Wait for the summarizer to reach the backup start lsn. Only wait when summaries covering the start of the range exist
+            // since otherwise the summaries will never be complete, e.g. summarize_wal is disabled or summaries have been removed.
+            do
+            {
+                summaryList = walSummaryFileList(
+                    storageListP(backupData->storagePrimary, summaryPath), timeline, lsnBegin, lsnEnd, &lsnCovered);
+            }
+            while (lsnCovered < lsnEnd && !strLstEmpty(summaryList) && waitMore(wait));
+
+            if (lsnCovered < lsnEnd)
+            {
+                LOG_WARN_FMT(
+                    "WAL summaries do not cover lsn range %s to %s on timeline %u, changes will be detected by timestamp\n"
+                    "HINT: is summarize_wal enabled and is wal_summary_keep_time long enough to cover the prior backup?",
+                    strZ(dataPrior->lsnStart), strZ(lsnStart), timeline);
+            }
+            else
+            {
+                MEM_CONTEXT_PRIOR_BEGIN()
+                {
+                    result = walSummaryNew(backupData->segmentPageTotal);
+                }
+                MEM_CONTEXT_PRIOR_END();
+
+                for (unsigned int summaryIdx = 0; summaryIdx < strLstSize(summaryList); summaryIdx++)
+                {
+                    walSummaryAdd(
+                        result,
+                        storageGetP(
+                            storageNewReadP(
+                                backupData->storagePrimary,
+                                strNewFmt("%s/%s", strZ(summaryPath), strZ(strLstGet(summaryList, summaryIdx))))));
+                }
+
+                LOG_DETAIL_FMT(
+                    "WAL summaries will be used to find unchanged files from lsn %s to %s", strZ(dataPrior->lsnStart),
+                    strZ(lsnStart));
+            }
+        }
+        MEM_CONTEXT_TEMP_END();
+    }
+
+    FUNCTION_LOG_RETURN(WAL_SUMMARY, result);
+}
+
+/***********************************************************************************************************************************
+Reference files to the prior backup when the WAL summaries show they have not changed. Only files that would otherwise be copied
+because the timestamp changed (i.e. size equals the prior file and delta is not enabled) are considered. Nothing is done when WAL
+summaries are not available.
+***********************************************************************************************************************************/
+static void
+backupWalSummaryApply(Manifest *const manifest, const WalSummary *const walSummary)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(MANIFEST, manifest);
+        FUNCTION_LOG_PARAM(WAL_SUMMARY, walSummary);
+    FUNCTION_LOG_END();
+
+    ASSERT(manifest != NULL);
+
+    if (walSummary != NULL)
+    {
+        unsigned int fileTotal = 0;
+
+        for (unsigned int fileIdx = 0; fileIdx < manifestFileTotal(manifest); fileIdx++)
+        {
+            ManifestFile file = manifestFile(manifest, fileIdx);
+
+            if (file.copy && !file.delta && file.reference != NULL && file.size == file.sizeOriginal &&
+                !walSummaryChanged(walSummary, file.name))
+            {
+                file.copy = false;
+                manifestFileUpdate(manifest, &file);
+
+                fileTotal++;
+            }
+        }
+
+        LOG_DETAIL_FMT("WAL summaries show %u file(s) with changed timestamp are unchanged since the prior backup", fileTotal);
+    }
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
 /***********************************************************************************************************************************
 Check for a backup that can be resumed and merge into the manifest if found
 ***********************************************************************************************************************************/
@@ -920,7 +1078,7 @@ backupResumeFind(const Manifest *const manifest, const String *const cipherPassB
                         {
                             TRY_BEGIN()
                             {
-                                manifestResume = manifestLoadFile(
+                                manifestResume = manifestLoadFileP(
                                     storageRepo(), manifestFile, cfgOptionStrId(cfgOptRepoCipherType), cipherPassBackup);
                             }
                             CATCH_ANY()
@@ -1709,6 +1867,8 @@ typedef struct BackupJobData
     uint64_t bundleId;                                              // Bundle id
     const bool blockIncr;                                           // Block incremental?
     size_t blockIncrSizeSuper;                                      // Super block size
+    const String *blockMapCachePath;                                // Spool path where block maps are cached (NULL if disabled)
+    const uint64_t blockIncrLsnPrior;                               // Prior backup start lsn (0 if page lsn check disabled)
 
     List *queueList;                                                // List of processing queues
 } BackupJobData;
@@ -2015,6 +2175,8 @@ backupJobCallback(void *const data, const unsigned int clientIdx)
                     pckWriteStrP(param, jobData->cipherSubPass);
                     pckWriteU32P(param, jobData->pageSize);
                     pckWriteStrP(param, cfgOptionStrNull(cfgOptPgVersionForce));
+                    pckWriteStrP(param, jobData->blockMapCachePath);
+                    pckWriteU64P(param, jobData->blockIncrLsnPrior);
                 }
 
                 pckWriteStrP(param, manifestPathPg(file.name));
@@ -2094,12 +2256,15 @@ backupJobCallback(void *const data, const unsigned int clientIdx)
 }
 
 static void
-backupProcess(const BackupData *const backupData, Manifest *const manifest, const String *const cipherPassBackup)
+backupProcess(
+    const BackupData *const backupData, Manifest *const manifest, const String *const cipherPassBackup,
+    const uint64_t blockIncrLsnPrior)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(BACKUP_DATA, backupData);
         FUNCTION_LOG_PARAM(MANIFEST, manifest);
         FUNCTION_TEST_PARAM(STRING, cipherPassBackup);
+        FUNCTION_LOG_PARAM(UINT64, blockIncrLsnPrior);
     FUNCTION_LOG_END();
 
     ASSERT(manifest != NULL);
@@ -2129,6 +2294,7 @@ backupProcess(const BackupData *const backupData, Manifest *const manifest, cons
             .bundle = cfgOptionBool(cfgOptRepoBundle),
             .bundleId = 1,
             .blockIncr = cfgOptionBool(cfgOptRepoBlock),
+            .blockIncrLsnPrior = blockIncrLsnPrior,
 
             // Build expression to identify files that can be copied from the standby when standby backup is supported
             .standbyExp = regExpNew(
@@ -2150,6 +2316,42 @@ backupProcess(const BackupData *const backupData, Manifest *const manifest, cons
             jobData.blockIncrSizeSuper =
                 backupType == backupTypeFull ?
                     (size_t)cfgOptionUInt64(cfgOptRepoBlockSizeSuperFull) : (size_t)cfgOptionUInt64(cfgOptRepoBlockSizeSuper);
+
+            // Cache block maps locally when requested. Maps are cached per repo since the same backup label may exist in more than
+            // one repo with different content.
+            if (cfgOptionBool(cfgOptBlockMapCache))
+            {
+                jobData.blockMapCachePath = strNewFmt(
+                    STORAGE_SPOOL_BLOCK_MAP "/repo%u",
+                    cfgOptionGroupIdxToKey(cfgOptGrpRepo, cfgOptionGroupIdxDefault(cfgOptGrpRepo)));
+
+                // Remove cached maps for backups not referenced by this backup. Later backups will be based on this backup (or one
+                // of its references) so these maps will never be needed again. The cache is optional so errors are logged and the
+                // backup continues.
+                TRY_BEGIN()
+                {
+                    const StringList *const labelList = storageListP(
+                        storageSpool(), jobData.blockMapCachePath,
+                        .expression = backupRegExpP(.full = true, .differential = true, .incremental = true));
+
+                    for (unsigned int labelIdx = 0; labelIdx < strLstSize(labelList); labelIdx++)
+                    {
+                        const String *const label = strLstGet(labelList, labelIdx);
+
+                        if (!strLstExists(manifestReferenceList(manifest), label))
+                        {
+                            storagePathRemoveP(
+                                storageSpoolWrite(), strNewFmt("%s/%s", strZ(jobData.blockMapCachePath), strZ(label)),
+                                .recurse = true);
+                        }
+                    }
+                }
+                CATCH_ANY()
+                {
+                    LOG_WARN_FMT("unable to remove unused cached block maps: %s", errorMessage());
+                }
+                TRY_END();
+            }
         }
 
         // If this is a full backup or hard-linked and paths are supported then create all paths explicitly so that empty paths will
@@ -2393,18 +2595,17 @@ backupArchiveCheckCopy(const BackupData *const backupData, Manifest *const manif
                             filterGroup, cfgOptionStrId(cfgOptRepoCipherType), cipherModeDecrypt,
                             infoArchiveCipherPass(backupData->archiveInfo));
 
-                        // Compress/decompress if archive and backup do not have the same compression settings
-                        if (archiveCompressType != backupCompressType)
-                        {
-                            if (archiveCompressType != compressTypeNone)
-                                ioFilterGroupAdd(filterGroup, decompressFilterP(archiveCompressType));
+                        // Expand the segment in case it was trimmed by archive-push. The backup must contain the full segment so it
+                        // can be restored by versions that do not understand trimmed segments. A trimmed segment can only be
+                        // detected at the end of the segment, so the segment is always decompressed and expanded in this pass.
+                        // Segments that were not trimmed pass through the expand filter unchanged.
+                        if (archiveCompressType != compressTypeNone)
+                            ioFilterGroupAdd(filterGroup, decompressFilterP(archiveCompressType));
 
-                            if (backupCompressType != compressTypeNone)
-                            {
-                                ioFilterGroupAdd(
-                                    filterGroup, compressFilterP(backupCompressType, cfgOptionInt(cfgOptCompressLevel)));
-                            }
-                        }
+                        ioFilterGroupAdd(filterGroup, walExpandNew(backupData->walSegmentSize));
+
+                        if (backupCompressType != compressTypeNone)
+                            ioFilterGroupAdd(filterGroup, compressFilterP(backupCompressType, cfgOptionInt(cfgOptCompressLevel)));
 
                         // Encrypt with backup key if encrypted
                         cipherBlockFilterGroupAdd(
@@ -2592,10 +2793,18 @@ cmdBackup(void)
             manifest, cfgOptionBool(cfgOptDelta), backupTime(backupData, true),
             compressTypeEnum(cfgOptionStrId(cfgOptCompressType)));
 
+        // Get the prior backup start lsn for block incremental and the WAL summaries before manifestPrior is freed
+        const uint64_t blockIncrLsnPrior = backupBlockIncrLsnPrior(manifestPrior, backupStartResult.walSegmentName);
+        WalSummary *const walSummary = backupWalSummary(
+            backupData, manifestPrior, backupStartResult.lsn, backupStartResult.walSegmentName);
+
         // Build an incremental backup if type is not full (manifestPrior will be freed in this call)
         if (!backupBuildIncr(infoBackup, manifest, manifestPrior, backupStartResult.walSegmentName))
             manifestCipherSubPassSet(manifest, cipherPassGen(cfgOptionStrId(cfgOptRepoCipherType)));
 
+        // Reference files that the WAL summaries show have not changed since the prior backup
+        backupWalSummaryApply(manifest, walSummary);
+
         // Set delta if it is not already set and the manifest requires it
         if (!cfgOptionBool(cfgOptDelta) && varBool(manifestData(manifest)->backupOptionDelta))
             cfgOptionSet(cfgOptDelta, cfgSourceParam, BOOL_TRUE_VAR);
@@ -2613,7 +2822,7 @@ cmdBackup(void)
         backupManifestSaveCopy(manifest, cipherPassBackup, false);
 
         // Process the backup manifest
-        backupProcess(backupData, manifest, cipherPassBackup);
+        backupProcess(backupData, manifest, cipherPassBackup, blockIncrLsnPrior);
 
         // Check that the clusters are alive and correctly configured after the backup
         backupDbPing(backupData, true);
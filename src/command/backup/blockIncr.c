@@ -17,6 +17,7 @@ Block Incremental Filter
 #include "common/log.h"
 #include "common/type/object.h"
 #include "common/type/pack.h"
+#include "postgres/interface/static.vendor.h"
 
 /***********************************************************************************************************************************
 Object type
@@ -36,6 +37,8 @@ typedef struct BlockIncr
     uint64_t superBlockSize;                                        // Super block
     size_t blockSize;                                               // Block size
     size_t checksumSize;                                            // Checksum size
+    size_t pageSize;                                                // Page size
+    uint64_t lsnPrior;                                              // Prior backup start lsn (0 to disable page lsn check)
     Buffer *block;                                                  // Block buffer
 
     Buffer *blockOut;                                               // Block output buffer
@@ -68,6 +71,36 @@ blockIncrToLog(const BlockIncr *const this, StringStatic *const debugLog)
 #define FUNCTION_LOG_BLOCK_INCR_FORMAT(value, buffer, bufferSize)                                                                  \
     FUNCTION_LOG_OBJECT_FORMAT(value, blockIncrToLog, buffer, bufferSize)
 
+/***********************************************************************************************************************************
+Check if all pages in the block are older than the prior backup. If so then the block cannot have changed since the prior backup
+and there is no need to generate a checksum. New pages (lsn 0) are never considered older since a truncated relation might have been
+extended again.
+***********************************************************************************************************************************/
+static bool
+blockIncrPageLsnPrior(const BlockIncr *const this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(BLOCK_INCR, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    // Only full blocks can be checked
+    if (this->lsnPrior == 0 || bufUsed(this->block) != this->blockSize)
+        FUNCTION_TEST_RETURN(BOOL, false);
+
+    for (size_t pageOffset = 0; pageOffset < this->blockSize; pageOffset += this->pageSize)
+    {
+        const PageXLogRecPtr pageLsn = ((const PageHeaderData *)(bufPtrConst(this->block) + pageOffset))->pd_lsn;
+        const uint64_t lsn = (uint64_t)pageLsn.xlogid << 32 | pageLsn.xrecoff;
+
+        if (lsn == 0 || lsn >= this->lsnPrior)
+            FUNCTION_TEST_RETURN(BOOL, false);
+    }
+
+    FUNCTION_TEST_RETURN(BOOL, true);
+}
+
 /***********************************************************************************************************************************
 Generate block incremental
 ***********************************************************************************************************************************/
@@ -121,16 +154,18 @@ blockIncrProcess(THIS_VOID, const Buffer *const input, Buffer *const output)
         {
             MEM_CONTEXT_TEMP_BEGIN()
             {
-                // Get block checksum
-                const Buffer *const checksum = xxHashOne(this->checksumSize, this->block);
-
                 // Does the block exist in the input map?
-                const BlockMapItem *const blockMapItemIn =
-                    this->blockMapPrior != NULL && this->blockNo < blockMapSize(this->blockMapPrior) ?
-                        blockMapGet(this->blockMapPrior, this->blockNo) : NULL;
+                const bool blockMapItemInExists =
+                    this->blockMapPrior != NULL && this->blockNo < blockMapSize(this->blockMapPrior);
+
+                // Get block checksum unless the page lsns show that the block has not changed
+                const Buffer *const checksum =
+                    blockMapItemInExists && blockIncrPageLsnPrior(this) ? NULL : xxHashOne(this->checksumSize, this->block);
 
                 // If the block is new or has changed then write it
-                if (blockMapItemIn == NULL || memcmp(blockMapItemIn->checksum, bufPtrConst(checksum), this->checksumSize) != 0)
+                if (!blockMapItemInExists ||
+                    (checksum != NULL &&
+                     memcmp(blockMapChecksum(this->blockMapPrior, this->blockNo), bufPtrConst(checksum), this->checksumSize) != 0))
                 {
                     // Begin the super block
                     if (this->blockOutWrite == NULL)
@@ -186,7 +221,9 @@ blockIncrProcess(THIS_VOID, const Buffer *const input, Buffer *const output)
                 // Else write a reference to the block in the prior backup
                 else
                 {
-                    blockMapAdd(this->blockMapOut, blockMapItemIn);
+                    const BlockMapItem blockMapItemIn = blockMapGet(this->blockMapPrior, this->blockNo);
+
+                    blockMapAdd(this->blockMapOut, &blockMapItemIn);
                     bufUsedZero(this->block);
                 }
 
@@ -207,11 +244,8 @@ blockIncrProcess(THIS_VOID, const Buffer *const input, Buffer *const output)
 
             for (unsigned int blockMapIdx = 0; blockMapIdx < lstSize(this->blockOutList); blockMapIdx++)
             {
-                BlockMapItem *const blockMapItem = blockMapGet(
-                    this->blockMapOut, *(unsigned int *)lstGet(this->blockOutList, blockMapIdx));
-
-                blockMapItem->size = blockOutSize;
-                blockMapItem->superBlockSize = this->blockOutSize;
+                blockMapSuperBlockSizeSet(
+                    this->blockMapOut, *(unsigned int *)lstGet(this->blockOutList, blockMapIdx), blockOutSize, this->blockOutSize);
             }
 
             pckReadFree(filter);
@@ -360,8 +394,8 @@ blockIncrInputSame(const THIS_VOID)
 FN_EXTERN IoFilter *
 blockIncrNew(
     const uint64_t superBlockSize, const size_t blockSize, const size_t checksumSize, const unsigned int reference,
-    const uint64_t bundleId, const uint64_t bundleOffset, const Buffer *const blockMapPrior, const IoFilter *const compress,
-    const IoFilter *const encrypt)
+    const uint64_t bundleId, const uint64_t bundleOffset, const Buffer *const blockMapPrior, const size_t pageSize,
+    const uint64_t lsnPrior, const IoFilter *const compress, const IoFilter *const encrypt)
 {
     FUNCTION_LOG_BEGIN(logLevelTrace);
         FUNCTION_LOG_PARAM(UINT64, superBlockSize);
@@ -371,6 +405,8 @@ blockIncrNew(
         FUNCTION_LOG_PARAM(UINT64, bundleId);
         FUNCTION_LOG_PARAM(UINT64, bundleOffset);
         FUNCTION_LOG_PARAM(BUFFER, blockMapPrior);
+        FUNCTION_LOG_PARAM(SIZE, pageSize);
+        FUNCTION_LOG_PARAM(UINT64, lsnPrior);
         FUNCTION_LOG_PARAM(IO_FILTER, compress);
         FUNCTION_LOG_PARAM(IO_FILTER, encrypt);
     FUNCTION_LOG_END();
@@ -382,6 +418,9 @@ blockIncrNew(
             .superBlockSize = (superBlockSize / blockSize + (superBlockSize % blockSize == 0 ? 0 : 1)) * blockSize,
             .blockSize = blockSize,
             .checksumSize = checksumSize,
+            .pageSize = pageSize,
+            // Page lsns can only be checked when the block size is a multiple of the page size
+            .lsnPrior = lsnPrior != 0 && blockSize % pageSize == 0 ? lsnPrior : 0,
             .reference = reference,
             .bundleId = bundleId,
             .blockOffset = bundleOffset,
@@ -433,6 +472,8 @@ blockIncrNew(
         pckWriteU64P(packWrite, bundleId);
         pckWriteU64P(packWrite, bundleOffset);
         pckWriteBinP(packWrite, blockMapPrior);
+        pckWriteU64P(packWrite, pageSize);
+        pckWriteU64P(packWrite, lsnPrior);
         pckWritePackP(packWrite, this->compressParam);
 
         if (this->compressParam != NULL)
@@ -468,6 +509,8 @@ blockIncrNewPack(const Pack *const paramList)
         const uint64_t bundleId = pckReadU64P(paramListPack);
         const uint64_t bundleOffset = pckReadU64P(paramListPack);
         const Buffer *blockMapPrior = pckReadBinP(paramListPack);
+        const size_t pageSize = (size_t)pckReadU64P(paramListPack);
+        const uint64_t lsnPrior = pckReadU64P(paramListPack);
 
         // Create compress filter
         const Pack *const compressParam = pckReadPackP(paramListPack);
@@ -485,7 +528,8 @@ blockIncrNewPack(const Pack *const paramList)
 
         result = ioFilterMove(
             blockIncrNew(
-                superBlockSize, blockSize, checksumSize, reference, bundleId, bundleOffset, blockMapPrior, compress, encrypt),
+                superBlockSize, blockSize, checksumSize, reference, bundleId, bundleOffset, blockMapPrior, pageSize, lsnPrior,
+                compress, encrypt),
             memContextPrior());
     }
     MEM_CONTEXT_TEMP_END();
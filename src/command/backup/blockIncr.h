@@ -24,6 +24,12 @@ verified by testing with SMHasher and a custom test suite. xxHash-32 is used for
 such as BtrFS and ZFS. We use at least 5 bytes even for the smallest blocks since we are looking for changes and not just
 corruption. Ultimately if there is a collision and a block change is not detected it will almost certainly be caught by the overall
 SHA1 file checksum. This will fail the backup, which is not ideal, but better than restoring corrupted data.
+
+When lsnPrior is set (to the start lsn of the prior backup) the filter checks the lsn of each page in a block before generating the
+checksum. If all the pages are older than the prior backup then the block is copied from the prior map without generating a
+checksum. Page lsns are not checked when the block size is not a multiple of pageSize. This is only valid for relation files when
+changes that do not update the page lsn (e.g. hint bits) are WAL-logged, i.e. page checksums are enabled, and the prior backup is on
+the same timeline. The caller is responsible for verifying these conditions.
 ***********************************************************************************************************************************/
 #ifndef COMMAND_BACKUP_BLOCK_INCR_H
 #define COMMAND_BACKUP_BLOCK_INCR_H
@@ -40,7 +46,8 @@ Constructors
 ***********************************************************************************************************************************/
 FN_EXTERN IoFilter *blockIncrNew(
     uint64_t superBlockSize, size_t blockSize, size_t checksumSize, unsigned int reference, uint64_t bundleId,
-    uint64_t bundleOffset, const Buffer *blockMapPrior, const IoFilter *compress, const IoFilter *encrypt);
+    uint64_t bundleOffset, const Buffer *blockMapPrior, size_t pageSize, uint64_t lsnPrior, const IoFilter *compress,
+    const IoFilter *encrypt);
 FN_EXTERN IoFilter *blockIncrNewPack(const Pack *paramList);
 
 #endif
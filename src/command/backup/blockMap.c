@@ -29,6 +29,8 @@ References, super blocks, and blocks are encoded with a bit that indicates when
 ***********************************************************************************************************************************/
 #include "build.auto.h"
 
+#include <limits.h>
+
 #include "command/backup/blockMap.h"
 #include "common/debug.h"
 #include "common/log.h"
@@ -53,6 +55,112 @@ typedef enum
     blockMapFlagVersion = 0,                                        // Version (currently always 0)
 } BlockMapFlag;
 
+/***********************************************************************************************************************************
+Object type
+***********************************************************************************************************************************/
+struct BlockMap
+{
+    BlockMapPub pub;                                                // Publicly accessible variables
+};
+
+/**********************************************************************************************************************************/
+FN_EXTERN BlockMap *
+blockMapNew(void)
+{
+    FUNCTION_TEST_VOID();
+
+    OBJ_NEW_BEGIN(BlockMap, .childQty = MEM_CONTEXT_QTY_MAX)
+    {
+        *this = (BlockMap)
+        {
+            .pub =
+            {
+                .superBlockList = lstNewP(sizeof(BlockMapSuperBlock)),
+                .blockList = lstNewP(sizeof(BlockMapBlock)),
+            },
+        };
+    }
+    OBJ_NEW_END();
+
+    FUNCTION_TEST_RETURN(BLOCK_MAP, this);
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN void
+blockMapAdd(BlockMap *const this, const BlockMapItem *const item)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(BLOCK_MAP, this);
+        FUNCTION_TEST_PARAM_P(VOID, item);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(item != NULL);
+    ASSERT(item->block <= UINT_MAX);
+
+    // Blocks are added in super block order (though a super block may be interrupted by blocks from other super blocks) so only the
+    // last super block needs to be checked to see if it can be reused. This makes memory usage proportional to the number of super
+    // blocks for everything except the block no and checksum. Reference, bundle id, and offset uniquely identify a super block.
+    unsigned int superBlockIdx = lstSize(this->pub.superBlockList);
+
+    if (superBlockIdx > 0)
+    {
+        const BlockMapSuperBlock *const superBlock = lstGetLast(this->pub.superBlockList);
+
+        if (superBlock->reference == item->reference && superBlock->offset == item->offset &&
+            superBlock->bundleId == item->bundleId)
+        {
+            superBlockIdx--;
+        }
+    }
+
+    // Add the super block if it could not be reused
+    if (superBlockIdx == lstSize(this->pub.superBlockList))
+    {
+        const BlockMapSuperBlock superBlock =
+        {
+            .reference = item->reference,
+            .superBlockSize = item->superBlockSize,
+            .bundleId = item->bundleId,
+            .offset = item->offset,
+            .size = item->size,
+        };
+
+        lstAdd(this->pub.superBlockList, &superBlock);
+    }
+
+    // Add the block
+    BlockMapBlock block = {.superBlockIdx = superBlockIdx, .block = (unsigned int)item->block};
+    memcpy(block.checksum, item->checksum, sizeof(block.checksum));
+
+    lstAdd(this->pub.blockList, &block);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN void
+blockMapSuperBlockSizeSet(BlockMap *const this, const unsigned int mapIdx, const uint64_t size, const uint64_t superBlockSize)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(BLOCK_MAP, this);
+        FUNCTION_TEST_PARAM(UINT, mapIdx);
+        FUNCTION_TEST_PARAM(UINT64, size);
+        FUNCTION_TEST_PARAM(UINT64, superBlockSize);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    BlockMapSuperBlock *const superBlock = lstGet(
+        this->pub.superBlockList, ((const BlockMapBlock *)lstGet(this->pub.blockList, mapIdx))->superBlockIdx);
+
+    superBlock->size = size;
+    superBlock->superBlockSize = superBlockSize;
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/**********************************************************************************************************************************/
 // Stores current information about a reference to avoid needed to encode it again
 typedef struct BlockMapReference
 {
@@ -238,7 +346,7 @@ blockMapNewRead(IoRead *const map, const size_t blockSize, const size_t checksum
                 memcpy(blockMapItem.checksum, bufPtr(checksum), bufUsed(checksum));
 
                 // Add to block list
-                lstAdd((List *)this, &blockMapItem);
+                blockMapAdd(this, &blockMapItem);
             }
 
             // Update block in reference with all blocks read
@@ -292,7 +400,7 @@ blockMapWrite(const BlockMap *const this, IoWrite *const output, const size_t bl
 
     while (referenceIdx < blockMapSize(this))
     {
-        const BlockMapItem *const reference = blockMapGet(this, referenceIdx);
+        const BlockMapItem reference = blockMapGet(this, referenceIdx);
         unsigned int superBlockIdx = referenceIdx;
         unsigned int blockIdx = referenceIdx;
 
@@ -301,44 +409,44 @@ blockMapWrite(const BlockMap *const this, IoWrite *const output, const size_t bl
 
         for (referenceIdx++; referenceIdx < blockMapSize(this); referenceIdx++)
         {
-            if (reference->reference != blockMapGet(this, referenceIdx)->reference)
+            if (reference.reference != blockMapGet(this, referenceIdx).reference)
             {
                 referenceEncoded = 0;
                 break;
             }
 
-            ASSERT(reference->offset <= blockMapGet(this, referenceIdx)->offset);
+            ASSERT(reference.offset <= blockMapGet(this, referenceIdx).offset);
         }
 
         // If this is the first time this reference has been written
-        BlockMapReference *referenceData = lstFind(refList, &(BlockMapReference){.reference = reference->reference});
+        BlockMapReference *referenceData = lstFind(refList, &(BlockMapReference){.reference = reference.reference});
 
         if (referenceData == NULL)
         {
             // Add bundle id and offset flags
-            if (reference->bundleId > 0)
+            if (reference.bundleId > 0)
                 referenceEncoded |= BLOCK_MAP_FLAG_BUNDLE_ID;
 
-            if (reference->offset > 0)
+            if (reference.offset > 0)
                 referenceEncoded |= BLOCK_MAP_FLAG_OFFSET;
 
             // Write the references
-            ioWriteVarIntU64(output, referenceEncoded | reference->reference << BLOCK_MAP_REFERENCE_SHIFT);
+            ioWriteVarIntU64(output, referenceEncoded | reference.reference << BLOCK_MAP_REFERENCE_SHIFT);
 
             // Write bundle id and offset
             if (referenceEncoded & BLOCK_MAP_FLAG_BUNDLE_ID)
-                ioWriteVarIntU64(output, reference->bundleId);
+                ioWriteVarIntU64(output, reference.bundleId);
 
             if (referenceEncoded & BLOCK_MAP_FLAG_OFFSET)
-                ioWriteVarIntU64(output, reference->offset);
+                ioWriteVarIntU64(output, reference.offset);
 
             // Add reference to list
             const BlockMapReference referenceAdd =
             {
-                .reference = reference->reference,
+                .reference = reference.reference,
                 .superBlockSize = blockSize,
-                .bundleId = reference->bundleId,
-                .offset = reference->offset,
+                .bundleId = reference.bundleId,
+                .offset = reference.offset,
             };
 
             referenceData = lstAdd(refList, &referenceAdd);
@@ -346,16 +454,16 @@ blockMapWrite(const BlockMap *const this, IoWrite *const output, const size_t bl
         // Else this reference has been written before
         else
         {
-            ASSERT(reference->reference == referenceData->reference);
-            ASSERT(reference->bundleId == referenceData->bundleId);
-            ASSERT(reference->offset >= referenceData->offset);
+            ASSERT(reference.reference == referenceData->reference);
+            ASSERT(reference.bundleId == referenceData->bundleId);
+            ASSERT(reference.offset >= referenceData->offset);
 
             // If the offset is identical then reference is continuing an already started super block. The super block size and
             // block no should be reused. Note that writing the reference is deferred until we know if the continued super block is
             // the last one for the reference.
-            if (reference->offset == referenceData->offset)
+            if (reference.offset == referenceData->offset)
             {
-                ASSERT(reference->superBlockSize == referenceData->superBlockSize);
+                ASSERT(reference.superBlockSize == referenceData->superBlockSize);
 
                 referenceEncoded |= BLOCK_MAP_FLAG_CONTINUE;
                 referenceContinue = true;
@@ -364,30 +472,30 @@ blockMapWrite(const BlockMap *const this, IoWrite *const output, const size_t bl
             // prior super block
             else
             {
-                if (reference->offset > referenceData->offset + referenceData->size)
+                if (reference.offset > referenceData->offset + referenceData->size)
                     referenceEncoded |= BLOCK_MAP_FLAG_OFFSET;
 
-                ioWriteVarIntU64(output, referenceEncoded | reference->reference << BLOCK_MAP_REFERENCE_SHIFT);
+                ioWriteVarIntU64(output, referenceEncoded | reference.reference << BLOCK_MAP_REFERENCE_SHIFT);
 
                 if (referenceEncoded & BLOCK_MAP_FLAG_OFFSET)
-                    ioWriteVarIntU64(output, reference->offset - (referenceData->offset + referenceData->size));
+                    ioWriteVarIntU64(output, reference.offset - (referenceData->offset + referenceData->size));
 
-                referenceData->offset = reference->offset;
-                referenceData->size = reference->size;
+                referenceData->offset = reference.offset;
+                referenceData->size = reference.size;
             }
         }
 
         // Write all super blocks in the current reference in packed format
         while (superBlockIdx < referenceIdx)
         {
-            const BlockMapItem *const superBlock = blockMapGet(this, superBlockIdx);
+            const BlockMapItem superBlock = blockMapGet(this, superBlockIdx);
 
             // Determine if this is the last super block in the reference
             uint64_t superBlockEncoded = BLOCK_MAP_FLAG_LAST;
 
             for (superBlockIdx++; superBlockIdx < referenceIdx; superBlockIdx++)
             {
-                if (superBlock->offset != blockMapGet(this, superBlockIdx)->offset)
+                if (superBlock.offset != blockMapGet(this, superBlockIdx).offset)
                 {
                     superBlockEncoded = 0;
                     break;
@@ -398,8 +506,8 @@ blockMapWrite(const BlockMap *const this, IoWrite *const output, const size_t bl
             const unsigned int blockTotal = superBlockIdx - blockIdx;
             ASSERT(blockTotal > 0);
 
-            if (referenceContinue || superBlock->block != 0 ||
-                blockTotal != superBlock->superBlockSize / blockSize + (superBlock->superBlockSize % blockSize == 0 ? 0 : 1))
+            if (referenceContinue || superBlock.block != 0 ||
+                blockTotal != superBlock.superBlockSize / blockSize + (superBlock.superBlockSize % blockSize == 0 ? 0 : 1))
             {
                 superBlockEncoded |= BLOCK_MAP_FLAG_SUPER_BLOCK_TOTAL_OFFSET;
             }
@@ -407,26 +515,26 @@ blockMapWrite(const BlockMap *const this, IoWrite *const output, const size_t bl
             // Write the continued reference now that we know if this will be the last super block in the reference
             if (referenceContinue)
             {
-                ASSERT(superBlock->superBlockSize == referenceData->superBlockSize);
+                ASSERT(superBlock.superBlockSize == referenceData->superBlockSize);
 
                 if (superBlockEncoded & BLOCK_MAP_FLAG_LAST)
                     referenceEncoded |= BLOCK_MAP_FLAG_CONTINUE_LAST;
 
-                ioWriteVarIntU64(output, referenceEncoded | reference->reference << BLOCK_MAP_REFERENCE_SHIFT);
+                ioWriteVarIntU64(output, referenceEncoded | reference.reference << BLOCK_MAP_REFERENCE_SHIFT);
                 referenceContinue = false;
             }
             // Else write the super block size for the reference
             else
             {
                 // Set offset, size, and block for the super block
-                referenceData->offset = superBlock->offset;
-                referenceData->size = superBlock->size;
+                referenceData->offset = superBlock.offset;
+                referenceData->size = superBlock.size;
                 referenceData->block = 0;
 
                 // If the super block size has changed then add the flag
-                ASSERT(reference->superBlockSize > 0);
+                ASSERT(reference.superBlockSize > 0);
 
-                if (superBlock->superBlockSize != referenceData->superBlockSize)
+                if (superBlock.superBlockSize != referenceData->superBlockSize)
                     superBlockEncoded |= BLOCK_MAP_FLAG_SUPER_BLOCK_CHANGE;
 
                 // If this is the first size written then just write the size. Otherwise write the difference from the prior size.
@@ -435,26 +543,26 @@ blockMapWrite(const BlockMap *const this, IoWrite *const output, const size_t bl
                 ioWriteVarIntU64(
                     output,
                     superBlockEncoded |
-                    (sizeLast == 0 ? superBlock->size : cvtInt64ToZigZag((int64_t)superBlock->size - sizeLast)) <<
+                    (sizeLast == 0 ? superBlock.size : cvtInt64ToZigZag((int64_t)superBlock.size - sizeLast)) <<
                     BLOCK_MAP_SUPER_BLOCK_SHIFT);
 
                 // If the super block size has changed then write it
                 if (superBlockEncoded & BLOCK_MAP_FLAG_SUPER_BLOCK_CHANGE)
                 {
                     const uint64_t superBlockSizeEncoded =
-                        (superBlock->superBlockSize / blockSize) << BLOCK_MAP_SUPER_BLOCK_SIZE_SHIFT |
-                        (superBlock->superBlockSize % blockSize == 0 ? 0 : BLOCK_MAP_FLAG_SUPER_BLOCK_SIZE_REMAINDER);
+                        (superBlock.superBlockSize / blockSize) << BLOCK_MAP_SUPER_BLOCK_SIZE_SHIFT |
+                        (superBlock.superBlockSize % blockSize == 0 ? 0 : BLOCK_MAP_FLAG_SUPER_BLOCK_SIZE_REMAINDER);
 
                     ioWriteVarIntU64(output, superBlockSizeEncoded);
 
                     if (superBlockSizeEncoded & BLOCK_MAP_FLAG_SUPER_BLOCK_SIZE_REMAINDER)
-                        ioWriteVarIntU64(output, superBlock->superBlockSize % blockSize);
+                        ioWriteVarIntU64(output, superBlock.superBlockSize % blockSize);
 
-                    referenceData->superBlockSize = superBlock->superBlockSize;
+                    referenceData->superBlockSize = superBlock.superBlockSize;
                 }
             }
 
-            sizeLast = (int64_t)superBlock->size;
+            sizeLast = (int64_t)superBlock.size;
 
             // Write block total if the super block does not include all blocks with no block offset
             if (superBlockEncoded & BLOCK_MAP_FLAG_SUPER_BLOCK_TOTAL_OFFSET)
@@ -462,7 +570,7 @@ blockMapWrite(const BlockMap *const this, IoWrite *const output, const size_t bl
                 // Write total blocks in the super block
                 const uint64_t blockTotalEncoded =
                     (blockTotal - 1) << BLOCK_MAP_BLOCK_TOTAL_SHIFT |
-                    (superBlock->block - referenceData->block > 0 ? BLOCK_MAP_FLAG_BLOCK_TOTAL_OFFSET : 0);
+                    (superBlock.block - referenceData->block > 0 ? BLOCK_MAP_FLAG_BLOCK_TOTAL_OFFSET : 0);
 
                 ioWriteVarIntU64(output, blockTotalEncoded);
 
@@ -470,12 +578,12 @@ blockMapWrite(const BlockMap *const this, IoWrite *const output, const size_t bl
                 // had blocks at the beginning overridden by a newer super block.
                 if (blockTotalEncoded & BLOCK_MAP_FLAG_BLOCK_TOTAL_OFFSET)
                 {
-                    ioWriteVarIntU64(output, superBlock->block - referenceData->block);
-                    referenceData->block = superBlock->block;
+                    ioWriteVarIntU64(output, superBlock.block - referenceData->block);
+                    referenceData->block = superBlock.block;
                 }
             }
 
-            ASSERT(superBlock->block >= referenceData->block);
+            ASSERT(superBlock.block >= referenceData->block);
 
             // Increment reference block by number of blocks written
             referenceData->block += blockTotal;
@@ -484,10 +592,10 @@ blockMapWrite(const BlockMap *const this, IoWrite *const output, const size_t bl
             for (; blockIdx < superBlockIdx; blockIdx++)
             {
                 ASSERT(
-                    superBlock == blockMapGet(this, blockIdx) ||
-                    blockMapGet(this, blockIdx)->block == blockMapGet(this, blockIdx - 1)->block + 1);
+                    blockMapGet(this, blockIdx).block == superBlock.block ||
+                    blockMapGet(this, blockIdx).block == blockMapGet(this, blockIdx - 1).block + 1);
 
-                ioWrite(output, BUF(blockMapGet(this, blockIdx)->checksum, checksumSize));
+                ioWrite(output, BUF(blockMapChecksum(this, blockIdx), checksumSize));
             }
         }
     }
@@ -13,10 +13,14 @@ Object type
 ***********************************************************************************************************************************/
 typedef struct BlockMap BlockMap;
 
+#include <string.h>
+
 #include "common/crypto/xxhash.h"
 #include "common/type/list.h"
 #include "common/type/object.h"
 
+// Block map item used to add and get blocks. Items are not stored in this format since most of the fields are the same for every
+// block in a super block (see BlockMapSuperBlock and BlockMapBlock).
 typedef struct BlockMapItem
 {
     unsigned int reference;                                         // Reference to backup where the block is stored
@@ -28,15 +32,29 @@ typedef struct BlockMapItem
     unsigned char checksum[XX_HASH_SIZE_MAX];                       // Checksum of the block
 } BlockMapItem;
 
+// Super block info shared by all blocks in the super block
+typedef struct BlockMapSuperBlock
+{
+    unsigned int reference;                                         // Reference to backup where the super block is stored
+    uint64_t superBlockSize;                                        // Super block size
+    uint64_t bundleId;                                              // Bundle where the super block is stored (0 if not bundled)
+    uint64_t offset;                                                // Offset of super block into the bundle
+    uint64_t size;                                                  // Stored super block size (with compression, etc.)
+} BlockMapSuperBlock;
+
+// Block info
+typedef struct BlockMapBlock
+{
+    unsigned int superBlockIdx;                                     // Index of the super block in the super block list
+    unsigned int block;                                             // Block no inside of super block
+    unsigned char checksum[XX_HASH_SIZE_MAX];                       // Checksum of the block
+} BlockMapBlock;
+
 /***********************************************************************************************************************************
 Constructors
 ***********************************************************************************************************************************/
 // Create empty block map
-FN_INLINE_ALWAYS BlockMap *
-blockMapNew(void)
-{
-    return (BlockMap *)OBJ_NAME(lstNewP(sizeof(BlockMapItem)), BlockMap::List);
-}
+FN_EXTERN BlockMap *blockMapNew(void);
 
 // New block map from IO
 FN_EXTERN BlockMap *blockMapNewRead(IoRead *map, size_t blockSize, size_t checksumSize);
@@ -45,12 +63,11 @@ FN_EXTERN BlockMap *blockMapNewRead(IoRead *map, size_t blockSize, size_t checks
 Functions
 ***********************************************************************************************************************************/
 // Add a block map item
-FN_INLINE_ALWAYS BlockMapItem *
-blockMapAdd(BlockMap *const this, const BlockMapItem *const item)
-{
-    ASSERT_INLINE(item != NULL);
-    return (BlockMapItem *)lstAdd((List *const)this, item);
-}
+FN_EXTERN void blockMapAdd(BlockMap *this, const BlockMapItem *item);
+
+// Set the size and super block size of the super block containing a block. This is required when a super block is being written
+// since the sizes are not known until all blocks have been added.
+FN_EXTERN void blockMapSuperBlockSizeSet(BlockMap *this, unsigned int mapIdx, uint64_t size, uint64_t superBlockSize);
 
 // Write map to IO
 FN_EXTERN void blockMapWrite(const BlockMap *this, IoWrite *output, size_t blockSize, size_t checksumSize);
@@ -58,18 +75,47 @@ FN_EXTERN void blockMapWrite(const BlockMap *this, IoWrite *output, size_t block
 /***********************************************************************************************************************************
 Getters/Setters
 ***********************************************************************************************************************************/
+typedef struct BlockMapPub
+{
+    List *superBlockList;                                           // Super block list
+    List *blockList;                                                // Block list
+} BlockMapPub;
+
 // Get a block map item
-FN_INLINE_ALWAYS BlockMapItem *
+FN_INLINE_ALWAYS BlockMapItem
 blockMapGet(const BlockMap *const this, const unsigned int mapIdx)
 {
-    return (BlockMapItem *)lstGet((List *const)this, mapIdx);
+    const BlockMapBlock *const block = (const BlockMapBlock *)lstGet(THIS_PUB(BlockMap)->blockList, mapIdx);
+    const BlockMapSuperBlock *const superBlock = (const BlockMapSuperBlock *)lstGet(
+        THIS_PUB(BlockMap)->superBlockList, block->superBlockIdx);
+
+    BlockMapItem result =
+    {
+        .reference = superBlock->reference,
+        .superBlockSize = superBlock->superBlockSize,
+        .bundleId = superBlock->bundleId,
+        .offset = superBlock->offset,
+        .size = superBlock->size,
+        .block = block->block,
+    };
+
+    memcpy(result.checksum, block->checksum, sizeof(result.checksum));
+
+    return result;
+}
+
+// Get a block checksum
+FN_INLINE_ALWAYS const unsigned char *
+blockMapChecksum(const BlockMap *const this, const unsigned int mapIdx)
+{
+    return ((const BlockMapBlock *)lstGet(THIS_PUB(BlockMap)->blockList, mapIdx))->checksum;
 }
 
 // Block map size
 FN_INLINE_ALWAYS unsigned int
 blockMapSize(const BlockMap *const this)
 {
-    return lstSize((List *const)this);
+    return lstSize(THIS_PUB(BlockMap)->blockList);
 }
 
 /***********************************************************************************************************************************
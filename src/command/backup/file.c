@@ -36,12 +36,121 @@ segmentNumber(const String *const pgFile)
     FUNCTION_TEST_RETURN(UINT, regExpMatchOne(STRDEF("\\.[0-9]+$"), pgFile) ? cvtZToUInt(strrchr(strZ(pgFile), '.') + 1) : 0);
 }
 
+/***********************************************************************************************************************************
+Read the prior block map. If a cache path is provided then the map is read from the cache when present and valid, else it is read
+from the repo and stored in the cache. The map is cached as stored in the repo (i.e. still encrypted) with a trailing checksum so
+corruption of the cached map can be detected. The cache is optional so errors reading or writing it are logged and the map is read
+from the repo instead.
+***********************************************************************************************************************************/
+static Buffer *
+backupFileBlockMapPrior(
+    const BackupFile *const file, const String *const blockMapCachePath, const CipherType cipherType,
+    const String *const cipherPass)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, file);
+        FUNCTION_TEST_PARAM(STRING, blockMapCachePath);
+        FUNCTION_TEST_PARAM(STRING_ID, cipherType);
+        FUNCTION_TEST_PARAM(STRING, cipherPass);
+    FUNCTION_TEST_END();
+
+    ASSERT(file != NULL);
+    ASSERT(file->blockIncrMapPriorFile != NULL);
+
+    Buffer *result = NULL;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        Buffer *volatile blockMap = NULL;
+        const String *cacheFile = NULL;
+
+        // Check for the map in the cache. The repo location of the map (from the prior manifest) is used as the cache key since
+        // the map can never change at that location.
+        if (blockMapCachePath != NULL)
+        {
+            ASSERT(strBeginsWithZ(file->blockIncrMapPriorFile, STORAGE_REPO_BACKUP "/"));
+
+            cacheFile = strNewFmt(
+                "%s/%s-%" PRIu64 "-%" PRIu64, strZ(blockMapCachePath),
+                strZ(file->blockIncrMapPriorFile) + sizeof(STORAGE_REPO_BACKUP), file->blockIncrMapPriorOffset,
+                file->blockIncrMapPriorSize);
+
+            TRY_BEGIN()
+            {
+                Buffer *const cache = storageGetP(storageNewReadP(storageSpool(), cacheFile, .ignoreMissing = true));
+
+                if (cache != NULL && bufUsed(cache) == file->blockIncrMapPriorSize + HASH_TYPE_SHA1_SIZE)
+                {
+                    const Buffer *const cacheChecksum = cryptoHashOne(
+                        hashTypeSha1, BUF(bufPtrConst(cache), (size_t)file->blockIncrMapPriorSize));
+
+                    if (memcmp(
+                            bufPtrConst(cacheChecksum), bufPtrConst(cache) + file->blockIncrMapPriorSize,
+                            HASH_TYPE_SHA1_SIZE) == 0)
+                    {
+                        bufUsedSet(cache, (size_t)file->blockIncrMapPriorSize);
+                        blockMap = cache;
+                    }
+                }
+            }
+            CATCH_ANY()
+            {
+                LOG_DETAIL_FMT("unable to read cached block map: %s", errorMessage());
+            }
+            TRY_END();
+        }
+
+        // Else read the map from the repo
+        if (blockMap == NULL)
+        {
+            blockMap = storageGetP(
+                storageNewReadP(
+                    storageRepo(), file->blockIncrMapPriorFile, .offset = file->blockIncrMapPriorOffset,
+                    .limit = VARUINT64(file->blockIncrMapPriorSize)));
+
+            // Store the map in the cache
+            if (cacheFile != NULL)
+            {
+                Buffer *const cache = bufDup(blockMap);
+                bufCat(cache, cryptoHashOne(hashTypeSha1, blockMap));
+
+                TRY_BEGIN()
+                {
+                    storagePutP(storageNewWriteP(storageSpoolWrite(), cacheFile), cache);
+                }
+                CATCH_ANY()
+                {
+                    LOG_DETAIL_FMT("unable to write cached block map: %s", errorMessage());
+                }
+                TRY_END();
+            }
+        }
+
+        // Decrypt the map
+        if (cipherType != cipherTypeNone)
+        {
+            IoRead *const read = ioBufferReadNew(blockMap);
+            ioFilterGroupAdd(
+                ioReadFilterGroup(read), cipherBlockNewP(cipherModeDecrypt, cipherType, BUFSTR(cipherPass), .raw = true));
+            ioReadOpen(read);
+
+            blockMap = ioReadBuf(read);
+        }
+
+        result = bufMove(blockMap, memContextPrior());
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_TEST_RETURN(BUFFER, result);
+}
+
 /**********************************************************************************************************************************/
 FN_EXTERN List *
 backupFile(
     const String *const repoFile, const uint64_t bundleId, const bool bundleRaw, const unsigned int blockIncrReference,
     const CompressType repoFileCompressType, const int repoFileCompressLevel, const CipherType cipherType,
-    const String *const cipherPass, const String *const pgVersionForce, const PgPageSize pageSize, const List *const fileList)
+    const String *const cipherPass, const String *const pgVersionForce, const PgPageSize pageSize,
+    const String *const blockMapCachePath, const uint64_t blockIncrLsnPrior, const List *const fileList)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(STRING, repoFile);                       // Repo file
@@ -54,6 +163,8 @@ backupFile(
         FUNCTION_TEST_PARAM(STRING, cipherPass);                    // Password to access the repo file if encrypted
         FUNCTION_LOG_PARAM(ENUM, pageSize);                         // Page size
         FUNCTION_LOG_PARAM(STRING, pgVersionForce);                 // Force pg version
+        FUNCTION_LOG_PARAM(STRING, blockMapCachePath);              // Block map cache path (NULL if disabled)
+        FUNCTION_LOG_PARAM(UINT64, blockIncrLsnPrior);              // Prior backup start lsn (0 if page lsn check disabled)
         FUNCTION_LOG_PARAM(LIST, fileList);                         // List of files to backup
     FUNCTION_LOG_END();
 
@@ -246,27 +357,16 @@ backupFile(
                         const Buffer *blockMap = NULL;
 
                         if (file->blockIncrMapPriorFile != NULL)
-                        {
-                            StorageRead *const blockMapRead = storageNewReadP(
-                                storageRepo(), file->blockIncrMapPriorFile, .offset = file->blockIncrMapPriorOffset,
-                                .limit = VARUINT64(file->blockIncrMapPriorSize));
-
-                            if (cipherType != cipherTypeNone)
-                            {
-                                ioFilterGroupAdd(
-                                    ioReadFilterGroup(storageReadIo(blockMapRead)),
-                                    cipherBlockNewP(cipherModeDecrypt, cipherType, BUFSTR(cipherPass), .raw = true));
-                            }
-
-                            blockMap = storageGetP(blockMapRead);
-                        }
+                            blockMap = backupFileBlockMapPrior(file, blockMapCachePath, cipherType, cipherPass);
 
-                        // Add block incremental filter
+                        // Add block incremental filter. Page lsns can only be checked for relation files, i.e. files that get page
+                        // checksums.
                         ioFilterGroupAdd(
                             ioReadFilterGroup(readIo),
                             blockIncrNew(
                                 file->blockIncrSuperSize, file->blockIncrSize, file->blockIncrChecksumSize, blockIncrReference,
-                                bundleId, bundleOffset, blockMap, compress, encrypt));
+                                bundleId, bundleOffset, blockMap, pageSize, file->pgFileChecksumPage ? blockIncrLsnPrior : 0,
+                                compress, encrypt));
 
                         repoChecksum = true;
                     }
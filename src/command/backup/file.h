@@ -66,6 +66,6 @@ typedef struct BackupFileResult
 FN_EXTERN List *backupFile(
     const String *repoFile, uint64_t bundleId, bool bundleRaw, unsigned int blockIncrReference, CompressType repoFileCompressType,
     int repoFileCompressLevel, CipherType cipherType, const String *cipherPass, const String *pgVersionForce, PgPageSize pageSize,
-    const List *fileList);
+    const String *blockMapCachePath, uint64_t blockIncrLsnPrior, const List *fileList);
 
 #endif
@@ -0,0 +1,468 @@
+/***********************************************************************************************************************************
+WAL Summary
+
+WAL summary files are stored in the PostgreSQL block reference table format:
+
+- uint32 magic.
+
+- List of relation fork entries, each consisting of:
+
+  - Tablespace oid, database oid, and relation number (uint32 each), fork number (int32), limit block (uint32), and chunk total
+    (uint32). The limit block is set when the relation fork was created, dropped, or truncated during the summarized range.
+
+  - uint16 usage for each chunk.
+
+  - uint16 entries for each chunk with usage > 0. Each chunk covers 65536 blocks and is either a list of block offsets or a bitmap
+    when the chunk is full. Only usage is required here since changes are tracked at the segment level.
+
+- A zeroed relation fork entry to terminate the list.
+
+A relation number of zero is used for database-level entries, e.g. when a database is created by copying files or dropped. These
+entries have no block usage so they are tracked as a change to all segments of relation zero, which is checked for every relation in
+the tablespace/database.
+
+- CRC-32C of all preceding data.
+***********************************************************************************************************************************/
+#include "build.auto.h"
+
+#include <limits.h>
+#include <string.h>
+
+#include "command/backup/walSummary.h"
+#include "common/debug.h"
+#include "common/log.h"
+#include "common/regExp.h"
+#include "common/type/convert.h"
+#include "common/type/list.h"
+#include "info/manifest.h"
+#include "postgres/interface/crc32.h"
+
+/**********************************************************************************************************************************/
+#define WAL_SUMMARY_MAGIC                                           0x652b137b
+#define WAL_SUMMARY_BLOCK_PER_CHUNK                                 65536
+#define WAL_SUMMARY_BLOCK_INVALID                                   UINT_MAX
+#define WAL_SUMMARY_FORK_MAIN                                       0
+#define WAL_SUMMARY_REL_NUMBER_DB                                   0
+#define WAL_SUMMARY_SEGMENT_ALL                                     UINT_MAX
+
+#define WAL_SUMMARY_FILE_EXP                                        "^[0-9A-F]{40}\\.summary$"
+
+// Default tablespace oids
+#define WAL_SUMMARY_SPC_DEFAULT                                     1663
+#define WAL_SUMMARY_SPC_GLOBAL                                      1664
+
+/***********************************************************************************************************************************
+Object type
+***********************************************************************************************************************************/
+struct WalSummary
+{
+    unsigned int segmentBlockTotal;                                 // Blocks per relation segment
+    List *segmentList;                                              // Changed relation segments
+};
+
+// Relation fork entry stored in the summary file
+typedef struct WalSummaryEntry
+{
+    uint32_t spcOid;                                                // Tablespace oid
+    uint32_t dbOid;                                                 // Database oid
+    uint32_t relNumber;                                             // Relation number
+    int32_t forkNum;                                                // Fork number
+    uint32_t limitBlock;                                            // Limit block (or invalid if no limit)
+    uint32_t chunkTotal;                                            // Total chunks
+} WalSummaryEntry;
+
+// Changed relation segment
+typedef struct WalSummarySegment
+{
+    uint32_t spcOid;                                                // Tablespace oid
+    uint32_t dbOid;                                                 // Database oid
+    uint32_t relNumber;                                             // Relation number
+    unsigned int segmentNo;                                         // Segment no (or all segments)
+} WalSummarySegment;
+
+// Summary file and the lsn range it covers
+typedef struct WalSummaryFile
+{
+    uint64_t lsnBegin;                                              // Start lsn (inclusive)
+    uint64_t lsnEnd;                                                // End lsn (exclusive)
+    const String *name;                                             // File name
+} WalSummaryFile;
+
+/***********************************************************************************************************************************
+Comparators for lists
+***********************************************************************************************************************************/
+static int
+walSummarySegmentComparator(const void *const item1, const void *const item2)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, item1);
+        FUNCTION_TEST_PARAM_P(VOID, item2);
+    FUNCTION_TEST_END();
+
+    ASSERT(item1 != NULL);
+    ASSERT(item2 != NULL);
+
+    const WalSummarySegment *const segment1 = item1;
+    const WalSummarySegment *const segment2 = item2;
+
+    if (segment1->spcOid != segment2->spcOid)
+        FUNCTION_TEST_RETURN(INT, LST_COMPARATOR_CMP(segment1->spcOid, segment2->spcOid));
+
+    if (segment1->dbOid != segment2->dbOid)
+        FUNCTION_TEST_RETURN(INT, LST_COMPARATOR_CMP(segment1->dbOid, segment2->dbOid));
+
+    if (segment1->relNumber != segment2->relNumber)
+        FUNCTION_TEST_RETURN(INT, LST_COMPARATOR_CMP(segment1->relNumber, segment2->relNumber));
+
+    FUNCTION_TEST_RETURN(INT, LST_COMPARATOR_CMP(segment1->segmentNo, segment2->segmentNo));
+}
+
+static int
+walSummaryFileComparator(const void *const item1, const void *const item2)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, item1);
+        FUNCTION_TEST_PARAM_P(VOID, item2);
+    FUNCTION_TEST_END();
+
+    ASSERT(item1 != NULL);
+    ASSERT(item2 != NULL);
+
+    FUNCTION_TEST_RETURN(
+        INT, LST_COMPARATOR_CMP(((const WalSummaryFile *)item1)->lsnBegin, ((const WalSummaryFile *)item2)->lsnBegin));
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN WalSummary *
+walSummaryNew(const unsigned int segmentPageTotal)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(UINT, segmentPageTotal);
+    FUNCTION_LOG_END();
+
+    ASSERT(segmentPageTotal > 0);
+
+    OBJ_NEW_BEGIN(WalSummary, .childQty = MEM_CONTEXT_QTY_MAX)
+    {
+        *this = (WalSummary)
+        {
+            .segmentBlockTotal = segmentPageTotal,
+            .segmentList = lstNewP(sizeof(WalSummarySegment), .comparator = walSummarySegmentComparator),
+        };
+    }
+    OBJ_NEW_END();
+
+    FUNCTION_LOG_RETURN(WAL_SUMMARY, this);
+}
+
+/***********************************************************************************************************************************
+Read data from the summary and advance the offset
+***********************************************************************************************************************************/
+static void
+walSummaryRead(const Buffer *const summary, const size_t summarySize, size_t *const offset, void *const data, const size_t size)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(BUFFER, summary);
+        FUNCTION_TEST_PARAM(SIZE, summarySize);
+        FUNCTION_TEST_PARAM_P(SIZE, offset);
+        FUNCTION_TEST_PARAM_P(VOID, data);
+        FUNCTION_TEST_PARAM(SIZE, size);
+    FUNCTION_TEST_END();
+
+    ASSERT(summary != NULL);
+    ASSERT(offset != NULL);
+
+    if (*offset + size > summarySize)
+        THROW(FormatError, "WAL summary is truncated");
+
+    if (data != NULL)
+        memcpy(data, bufPtrConst(summary) + *offset, size);
+
+    *offset += size;
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN void
+walSummaryAdd(WalSummary *const this, const Buffer *const summary)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(WAL_SUMMARY, this);
+        FUNCTION_LOG_PARAM(BUFFER, summary);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(summary != NULL);
+
+    // Check that the summary is large enough to contain a magic and a checksum and then validate the checksum
+    if (bufUsed(summary) < sizeof(uint32_t) * 2)
+        THROW(FormatError, "WAL summary is truncated");
+
+    const size_t summarySize = bufUsed(summary) - sizeof(uint32_t);
+    uint32_t checksum;
+
+    memcpy(&checksum, bufPtrConst(summary) + summarySize, sizeof(checksum));
+
+    if (crc32cOne(bufPtrConst(summary), summarySize) != checksum)
+        THROW(ChecksumError, "WAL summary checksum mismatch");
+
+    // Check magic
+    size_t offset = 0;
+    uint32_t magic;
+
+    walSummaryRead(summary, summarySize, &offset, &magic, sizeof(magic));
+
+    if (magic != WAL_SUMMARY_MAGIC)
+        THROW_FMT(FormatError, "WAL summary magic 0x%08x is invalid", magic);
+
+    // Read entries until the terminator is found
+    static const WalSummaryEntry entryTerminator = {0};
+    WalSummaryEntry entry;
+
+    do
+    {
+        walSummaryRead(summary, summarySize, &offset, &entry, sizeof(entry));
+
+        if (memcmp(&entry, &entryTerminator, sizeof(entry)) == 0)
+            break;
+
+        // Only the main fork is tracked since other forks are always copied when their timestamp changes
+        const bool forkMain = entry.forkNum == WAL_SUMMARY_FORK_MAIN;
+        WalSummarySegment segment = {.spcOid = entry.spcOid, .dbOid = entry.dbOid, .relNumber = entry.relNumber};
+
+        // If the relation was created, dropped, or truncated then mark all segments as changed. A database-level entry marks all
+        // segments of all relations in the database as changed.
+        if (forkMain && (entry.limitBlock != WAL_SUMMARY_BLOCK_INVALID || entry.relNumber == WAL_SUMMARY_REL_NUMBER_DB))
+        {
+            segment.segmentNo = WAL_SUMMARY_SEGMENT_ALL;
+            lstAdd(this->segmentList, &segment);
+        }
+
+        // Mark segments covered by chunks with changes. The chunk usage list precedes the chunk entries.
+        size_t usageOffset = offset;
+
+        walSummaryRead(summary, summarySize, &offset, NULL, entry.chunkTotal * sizeof(uint16_t));
+
+        for (unsigned int chunkIdx = 0; chunkIdx < entry.chunkTotal; chunkIdx++)
+        {
+            uint16_t usage;
+
+            walSummaryRead(summary, summarySize, &usageOffset, &usage, sizeof(usage));
+            walSummaryRead(summary, summarySize, &offset, NULL, usage * sizeof(uint16_t));
+
+            if (forkMain && usage > 0)
+            {
+                const uint64_t blockBegin = (uint64_t)chunkIdx * WAL_SUMMARY_BLOCK_PER_CHUNK;
+                const uint64_t blockEnd = blockBegin + WAL_SUMMARY_BLOCK_PER_CHUNK - 1;
+
+                for (uint64_t segmentNo = blockBegin / this->segmentBlockTotal; segmentNo <= blockEnd / this->segmentBlockTotal;
+                     segmentNo++)
+                {
+                    segment.segmentNo = (unsigned int)segmentNo;
+                    lstAdd(this->segmentList, &segment);
+                }
+            }
+        }
+    }
+    while (true);
+
+    // All data except the checksum should have been read
+    if (offset != summarySize)
+        THROW(FormatError, "WAL summary has unexpected data after terminator");
+
+    lstSort(this->segmentList, sortOrderAsc);
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Convert a string containing only digits to an oid. Returns false if the string is not a valid oid.
+***********************************************************************************************************************************/
+static bool
+walSummaryOid(const char *const value, const size_t size, uint32_t *const oid)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRINGZ, value);
+        FUNCTION_TEST_PARAM(SIZE, size);
+        FUNCTION_TEST_PARAM_P(UINT32, oid);
+    FUNCTION_TEST_END();
+
+    ASSERT(value != NULL);
+    ASSERT(oid != NULL);
+
+    if (size == 0 || size > 10 || strspn(value, "0123456789") < size)
+        FUNCTION_TEST_RETURN(BOOL, false);
+
+    const uint64_t result = cvtZSubNToUInt64Base(value, 0, size, 10);
+
+    if (result > UINT32_MAX)
+        FUNCTION_TEST_RETURN(BOOL, false);
+
+    *oid = (uint32_t)result;
+
+    FUNCTION_TEST_RETURN(BOOL, true);
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN bool
+walSummaryChanged(const WalSummary *const this, const String *const manifestName)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(WAL_SUMMARY, this);
+        FUNCTION_TEST_PARAM(STRING, manifestName);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(manifestName != NULL);
+
+    bool result = true;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        // Determine the tablespace, database, and relation file from the manifest name
+        const StringList *const nameList = strLstNewSplitZ(manifestName, "/");
+        WalSummarySegment segment = {0};
+        const String *relFile = NULL;
+
+        switch (strLstSize(nameList))
+        {
+            // pg_data/global/<rel>
+            case 3:
+            {
+                if (strEqZ(strLstGet(nameList, 0), MANIFEST_TARGET_PGDATA) && strEqZ(strLstGet(nameList, 1), PG_PATH_GLOBAL))
+                {
+                    segment.spcOid = WAL_SUMMARY_SPC_GLOBAL;
+                    relFile = strLstGet(nameList, 2);
+                }
+
+                break;
+            }
+
+            // pg_data/base/<db>/<rel>
+            case 4:
+            {
+                if (strEqZ(strLstGet(nameList, 0), MANIFEST_TARGET_PGDATA) && strEqZ(strLstGet(nameList, 1), PG_PATH_BASE) &&
+                    walSummaryOid(strZ(strLstGet(nameList, 2)), strSize(strLstGet(nameList, 2)), &segment.dbOid))
+                {
+                    segment.spcOid = WAL_SUMMARY_SPC_DEFAULT;
+                    relFile = strLstGet(nameList, 3);
+                }
+
+                break;
+            }
+
+            // pg_tblspc/<spc>/<version>/<db>/<rel>
+            case 5:
+            {
+                if (strEqZ(strLstGet(nameList, 0), MANIFEST_TARGET_PGTBLSPC) &&
+                    walSummaryOid(strZ(strLstGet(nameList, 1)), strSize(strLstGet(nameList, 1)), &segment.spcOid) &&
+                    walSummaryOid(strZ(strLstGet(nameList, 3)), strSize(strLstGet(nameList, 3)), &segment.dbOid))
+                {
+                    relFile = strLstGet(nameList, 4);
+                }
+
+                break;
+            }
+        }
+
+        // Determine the relation number and segment. Any other forks or files will not parse and are reported as changed.
+        if (relFile != NULL)
+        {
+            const char *const relFileZ = strZ(relFile);
+            const char *const segmentZ = strchr(relFileZ, '.');
+            const size_t relNumberSize = segmentZ == NULL ? strSize(relFile) : (size_t)(segmentZ - relFileZ);
+
+            if (walSummaryOid(relFileZ, relNumberSize, &segment.relNumber) &&
+                (segmentZ == NULL || walSummaryOid(segmentZ + 1, strlen(segmentZ + 1), &segment.segmentNo)))
+            {
+                result = lstExists(this->segmentList, &segment);
+
+                if (!result)
+                {
+                    segment.segmentNo = WAL_SUMMARY_SEGMENT_ALL;
+                    result = lstExists(this->segmentList, &segment);
+                }
+
+                // Check if the database was created or dropped
+                if (!result)
+                {
+                    segment.relNumber = WAL_SUMMARY_REL_NUMBER_DB;
+                    result = lstExists(this->segmentList, &segment);
+                }
+            }
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_TEST_RETURN(BOOL, result);
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN StringList *
+walSummaryFileList(
+    const StringList *const fileList, const unsigned int timeline, const uint64_t lsnBegin, const uint64_t lsnEnd,
+    uint64_t *const lsnCovered)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STRING_LIST, fileList);
+        FUNCTION_LOG_PARAM(UINT, timeline);
+        FUNCTION_LOG_PARAM(UINT64, lsnBegin);
+        FUNCTION_LOG_PARAM(UINT64, lsnEnd);
+        FUNCTION_LOG_PARAM_P(UINT64, lsnCovered);
+    FUNCTION_LOG_END();
+
+    ASSERT(fileList != NULL);
+    ASSERT(lsnCovered != NULL);
+
+    StringList *const result = strLstNew();
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        // Get summaries on the requested timeline. The file name is made up of the timeline and the start/end lsns.
+        RegExp *const fileExp = regExpNew(STRDEF(WAL_SUMMARY_FILE_EXP));
+        List *const summaryList = lstNewP(sizeof(WalSummaryFile), .comparator = walSummaryFileComparator);
+
+        for (unsigned int fileIdx = 0; fileIdx < strLstSize(fileList); fileIdx++)
+        {
+            const String *const file = strLstGet(fileList, fileIdx);
+
+            if (regExpMatch(fileExp, file) && cvtZSubNToUIntBase(strZ(file), 0, 8, 16) == timeline)
+            {
+                lstAdd(
+                    summaryList,
+                    &(WalSummaryFile)
+                    {
+                        .lsnBegin =
+                            cvtZSubNToUInt64Base(strZ(file), 8, 8, 16) << 32 | cvtZSubNToUInt64Base(strZ(file), 16, 8, 16),
+                        .lsnEnd = cvtZSubNToUInt64Base(strZ(file), 24, 8, 16) << 32 | cvtZSubNToUInt64Base(strZ(file), 32, 8, 16),
+                        .name = file,
+                    });
+            }
+        }
+
+        lstSort(summaryList, sortOrderAsc);
+
+        // Select summaries in order until a gap is found or the range is covered
+        uint64_t lsn = lsnBegin;
+
+        for (unsigned int summaryIdx = 0; summaryIdx < lstSize(summaryList); summaryIdx++)
+        {
+            const WalSummaryFile *const summary = lstGet(summaryList, summaryIdx);
+
+            if (lsn >= lsnEnd || summary->lsnBegin > lsn)
+                break;
+
+            if (summary->lsnEnd > lsn)
+            {
+                strLstAdd(result, summary->name);
+                lsn = summary->lsnEnd;
+            }
+        }
+
+        *lsnCovered = lsn;
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN(STRING_LIST, result);
+}
@@ -0,0 +1,61 @@
+/***********************************************************************************************************************************
+WAL Summary
+
+PostgreSQL >= 17 can summarize the blocks modified in each range of WAL (see summarize_wal). The summaries are stored in
+pg_wal/summaries and can be used to determine which relation segments have not changed since a prior backup, even if the timestamp
+of the segment has changed. The summaries are only tracked at the segment level since the entire segment must be stored (or
+referenced) in the backup.
+***********************************************************************************************************************************/
+#ifndef COMMAND_BACKUP_WALSUMMARY_H
+#define COMMAND_BACKUP_WALSUMMARY_H
+
+/***********************************************************************************************************************************
+Object type
+***********************************************************************************************************************************/
+typedef struct WalSummary WalSummary;
+
+#include "common/type/buffer.h"
+#include "common/type/object.h"
+#include "common/type/stringList.h"
+#include "postgres/interface.h"
+
+/***********************************************************************************************************************************
+Constructors
+***********************************************************************************************************************************/
+// Create empty WAL summary using the relation segment size (in pages) from pg_control
+FN_EXTERN WalSummary *walSummaryNew(unsigned int segmentPageTotal);
+
+/***********************************************************************************************************************************
+Functions
+***********************************************************************************************************************************/
+// Add changes from a WAL summary file
+FN_EXTERN void walSummaryAdd(WalSummary *this, const Buffer *summary);
+
+// Has the file changed? Files that are not relation main fork segments (e.g. free space map, visibility map, pg_control) are always
+// reported as changed since they are not tracked by the WAL summaries.
+FN_EXTERN bool walSummaryChanged(const WalSummary *this, const String *manifestName);
+
+// Get the list of summary files (from a list of files in pg_wal/summaries) required to cover the lsn range on the specified timeline.
+// The summaries are selected in lsn order until a gap is found or the range is covered. lsnCovered is set to the end of the range
+// covered by the returned list, so the range is fully covered when lsnCovered >= lsnEnd.
+FN_EXTERN StringList *walSummaryFileList(
+    const StringList *fileList, unsigned int timeline, uint64_t lsnBegin, uint64_t lsnEnd, uint64_t *lsnCovered);
+
+/***********************************************************************************************************************************
+Destructor
+***********************************************************************************************************************************/
+FN_INLINE_ALWAYS void
+walSummaryFree(WalSummary *const this)
+{
+    objFree(this);
+}
+
+/***********************************************************************************************************************************
+Macros for function logging
+***********************************************************************************************************************************/
+#define FUNCTION_LOG_WAL_SUMMARY_TYPE                                                                                              \
+    WalSummary *
+#define FUNCTION_LOG_WAL_SUMMARY_FORMAT(value, buffer, bufferSize)                                                                 \
+    objNameToLog(value, "WalSummary", buffer, bufferSize)
+
+#endif
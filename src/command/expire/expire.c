@@ -6,6 +6,7 @@ Expire Command
 #include "command/archive/common.h"
 #include "command/backup/common.h"
 #include "command/control/common.h"
+#include "command/expire/protocol.h"
 #include "common/debug.h"
 #include "common/regExp.h"
 #include "common/time.h"
@@ -15,6 +16,7 @@ Expire Command
 #include "info/infoBackup.h"
 #include "info/manifest.h"
 #include "protocol/helper.h"
+#include "protocol/parallel.h"
 #include "storage/helper.h"
 
 #include <stdlib.h>
@@ -35,6 +37,50 @@ typedef struct ArchiveRange
     const String *stop;
 } ArchiveRange;
 
+/***********************************************************************************************************************************
+Removals are planned for all repos before any are executed so they can be run in parallel by the local processes. Files are batched
+into a single job to reduce protocol overhead but each path gets its own job since a recursive remove may take a long time.
+***********************************************************************************************************************************/
+#define EXPIRE_REMOVE_BATCH_MAX                                     100
+
+typedef struct ExpireRemove
+{
+    unsigned int repoIdx;                                           // Repo to remove from
+    bool recurse;                                                   // Remove paths recursively?
+    StringList *pathList;                                           // Files or paths to remove
+} ExpireRemove;
+
+static void
+expireRemoveAdd(List *const removeList, const unsigned int repoIdx, const String *const path, const bool recurse)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(LIST, removeList);
+        FUNCTION_TEST_PARAM(UINT, repoIdx);
+        FUNCTION_TEST_PARAM(STRING, path);
+        FUNCTION_TEST_PARAM(BOOL, recurse);
+    FUNCTION_TEST_END();
+
+    ASSERT(removeList != NULL);
+    ASSERT(path != NULL);
+
+    ExpireRemove *remove = lstEmpty(removeList) ? NULL : lstGetLast(removeList);
+
+    // Start a new job when the file cannot be added to the last job
+    if (remove == NULL || recurse || remove->recurse || remove->repoIdx != repoIdx ||
+        strLstSize(remove->pathList) == EXPIRE_REMOVE_BATCH_MAX)
+    {
+        MEM_CONTEXT_OBJ_BEGIN(removeList)
+        {
+            remove = lstAdd(removeList, &(ExpireRemove){.repoIdx = repoIdx, .recurse = recurse, .pathList = strLstNew()});
+        }
+        MEM_CONTEXT_OBJ_END();
+    }
+
+    strLstAdd(remove->pathList, path);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
 /***********************************************************************************************************************************
 Given a backup label, expire a backup and all its dependents (if any).
 ***********************************************************************************************************************************/
@@ -380,15 +426,18 @@ logExpire(ArchiveExpired *const archiveExpire, const String *const archiveId, co
 Process archive retention
 ***********************************************************************************************************************************/
 static void
-removeExpiredArchive(const InfoBackup *const infoBackup, const bool timeBasedFullRetention, const unsigned int repoIdx)
+removeExpiredArchive(
+    const InfoBackup *const infoBackup, const bool timeBasedFullRetention, const unsigned int repoIdx, List *const removeList)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(INFO_BACKUP, infoBackup);
         FUNCTION_LOG_PARAM(BOOL, timeBasedFullRetention);
         FUNCTION_LOG_PARAM(UINT, repoIdx);
+        FUNCTION_LOG_PARAM(LIST, removeList);
     FUNCTION_LOG_END();
 
     ASSERT(infoBackup != NULL);
+    ASSERT(removeList != NULL);
 
     MEM_CONTEXT_TEMP_BEGIN()
     {
@@ -540,7 +589,7 @@ removeExpiredArchive(const InfoBackup *const infoBackup, const bool timeBasedFul
 
                                 // Execute the real expiration and deletion only if the dry-run option is disabled
                                 if (!cfgOptionValid(cfgOptDryRun) || !cfgOptionBool(cfgOptDryRun))
-                                    storagePathRemoveP(storageRepoIdxWrite(repoIdx), fullPath, .recurse = true);
+                                    expireRemoveAdd(removeList, repoIdx, fullPath, true);
                             }
 
                             // Continue to next directory
@@ -670,10 +719,9 @@ removeExpiredArchive(const InfoBackup *const infoBackup, const bool timeBasedFul
                                     // Execute the real expiration and deletion only if the dry-run mode is disabled
                                     if (!cfgOptionValid(cfgOptDryRun) || !cfgOptionBool(cfgOptDryRun))
                                     {
-                                        storagePathRemoveP(
-                                            storageRepoIdxWrite(repoIdx),
-                                            strNewFmt(STORAGE_REPO_ARCHIVE "/%s/%s", strZ(archiveId), strZ(walPath)),
-                                            .recurse = true);
+                                        expireRemoveAdd(
+                                            removeList, repoIdx,
+                                            strNewFmt(STORAGE_REPO_ARCHIVE "/%s/%s", strZ(archiveId), strZ(walPath)), true);
                                     }
 
                                     archiveExpire.total++;
@@ -719,11 +767,12 @@ removeExpiredArchive(const InfoBackup *const infoBackup, const bool timeBasedFul
                                             // Execute the real expiration and deletion only if the dry-run mode is disabled
                                             if (!cfgOptionValid(cfgOptDryRun) || !cfgOptionBool(cfgOptDryRun))
                                             {
-                                                storageRemoveP(
-                                                    storageRepoIdxWrite(repoIdx),
+                                                expireRemoveAdd(
+                                                    removeList, repoIdx,
                                                     strNewFmt(
                                                         STORAGE_REPO_ARCHIVE "/%s/%s/%s", strZ(archiveId), strZ(walPath),
-                                                        strZ(walSubPath)));
+                                                        strZ(walSubPath)),
+                                                    false);
                                             }
 
                                             // Track that this archive was removed
@@ -770,9 +819,9 @@ removeExpiredArchive(const InfoBackup *const infoBackup, const bool timeBasedFul
                                     // Execute the real expiration and deletion only if the dry-run mode is disabled
                                     if (!cfgOptionValid(cfgOptDryRun) || !cfgOptionBool(cfgOptDryRun))
                                     {
-                                        storageRemoveP(
-                                            storageRepoIdxWrite(repoIdx),
-                                            strNewFmt(STORAGE_REPO_ARCHIVE "/%s/%s", strZ(archiveId), strZ(historyFile)));
+                                        expireRemoveAdd(
+                                            removeList, repoIdx,
+                                            strNewFmt(STORAGE_REPO_ARCHIVE "/%s/%s", strZ(archiveId), strZ(historyFile)), false);
                                     }
 
                                     LOG_INFO_FMT(
@@ -795,15 +844,18 @@ removeExpiredArchive(const InfoBackup *const infoBackup, const bool timeBasedFul
 Remove expired backups from repo
 ***********************************************************************************************************************************/
 static void
-removeExpiredBackup(const InfoBackup *const infoBackup, const String *const adhocBackupLabel, const unsigned int repoIdx)
+removeExpiredBackup(
+    const InfoBackup *const infoBackup, const String *const adhocBackupLabel, const unsigned int repoIdx, List *const removeList)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(INFO_BACKUP, infoBackup);
         FUNCTION_LOG_PARAM(STRING, adhocBackupLabel);
         FUNCTION_LOG_PARAM(UINT, repoIdx);
+        FUNCTION_LOG_PARAM(LIST, removeList);
     FUNCTION_LOG_END();
 
     ASSERT(infoBackup != NULL);
+    ASSERT(removeList != NULL);
 
     MEM_CONTEXT_TEMP_BEGIN()
     {
@@ -839,7 +891,7 @@ removeExpiredBackup(const InfoBackup *const infoBackup, const String *const adho
                 // Else it may be related to the adhoc backup so check if its ancestor still exists
                 else
                 {
-                    const Manifest *const manifestResume = manifestLoadFile(
+                    const Manifest *const manifestResume = manifestLoadFileP(
                         storageRepoIdx(repoIdx), manifestFileName, cfgOptionIdxStrId(cfgOptRepoCipherType, repoIdx),
                         infoPgCipherPass(infoBackupPg(infoBackup)));
 
@@ -862,9 +914,8 @@ removeExpiredBackup(const InfoBackup *const infoBackup, const String *const adho
                 // Execute the real expiration and deletion only if the dry-run mode is disabled
                 if (!cfgOptionValid(cfgOptDryRun) || !cfgOptionBool(cfgOptDryRun))
                 {
-                    storagePathRemoveP(
-                        storageRepoIdxWrite(repoIdx), strNewFmt(STORAGE_REPO_BACKUP "/%s", strZ(strLstGet(backupList, backupIdx))),
-                        .recurse = true);
+                    expireRemoveAdd(
+                        removeList, repoIdx, strNewFmt(STORAGE_REPO_BACKUP "/%s", strZ(strLstGet(backupList, backupIdx))), true);
                 }
             }
         }
@@ -878,14 +929,16 @@ removeExpiredBackup(const InfoBackup *const infoBackup, const String *const adho
 Remove expired backup history manifests from repo
 ***********************************************************************************************************************************/
 static void
-removeExpiredHistory(const InfoBackup *const infoBackup, const unsigned int repoIdx)
+removeExpiredHistory(const InfoBackup *const infoBackup, const unsigned int repoIdx, List *const removeList)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(INFO_BACKUP, infoBackup);
         FUNCTION_LOG_PARAM(UINT, repoIdx);
+        FUNCTION_LOG_PARAM(LIST, removeList);
     FUNCTION_LOG_END();
 
     ASSERT(infoBackup != NULL);
+    ASSERT(removeList != NULL);
 
     MEM_CONTEXT_TEMP_BEGIN()
     {
@@ -919,9 +972,9 @@ removeExpiredHistory(const InfoBackup *const infoBackup, const unsigned int repo
                     // Execute the real expiration and deletion only if the dry-run mode is disabled
                     if (!cfgOptionValid(cfgOptDryRun) || !cfgOptionBool(cfgOptDryRun))
                     {
-                        storagePathRemoveP(
-                            storageRepoIdxWrite(repoIdx),
-                            strNewFmt(STORAGE_REPO_BACKUP "/" BACKUP_PATH_HISTORY "/%s", strZ(historyYear)), .recurse = true);
+                        expireRemoveAdd(
+                            removeList, repoIdx, strNewFmt(STORAGE_REPO_BACKUP "/" BACKUP_PATH_HISTORY "/%s", strZ(historyYear)),
+                            true);
                     }
                 }
                 // Else find and remove individual files
@@ -951,11 +1004,12 @@ removeExpiredHistory(const InfoBackup *const infoBackup, const unsigned int repo
                             // Execute the real expiration and deletion only if the dry-run mode is disabled
                             if (!cfgOptionValid(cfgOptDryRun) || !cfgOptionBool(cfgOptDryRun))
                             {
-                                storageRemoveP(
-                                    storageRepoIdxWrite(repoIdx),
+                                expireRemoveAdd(
+                                    removeList, repoIdx,
                                     strNewFmt(
-                                        STORAGE_REPO_BACKUP "/" BACKUP_PATH_HISTORY "/%s/%s",
-                                        strZ(historyYear), strZ(historyBackupFile)));
+                                        STORAGE_REPO_BACKUP "/" BACKUP_PATH_HISTORY "/%s/%s", strZ(historyYear),
+                                        strZ(historyBackupFile)),
+                                    false);
                             }
                         }
                     }
@@ -970,6 +1024,128 @@ removeExpiredHistory(const InfoBackup *const infoBackup, const unsigned int repo
     FUNCTION_LOG_RETURN_VOID();
 }
 
+/***********************************************************************************************************************************
+Execute planned removals in parallel using local processes. Returns the number of removals that failed.
+***********************************************************************************************************************************/
+typedef struct ExpireRemoveJobData
+{
+    const List *removeList;                                         // Planned removals
+    unsigned int removeIdx;                                         // Next removal to assign to a job
+} ExpireRemoveJobData;
+
+static ProtocolParallelJob *
+expireRemoveJobCallback(void *const data, const unsigned int clientIdx)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, data);
+        (void)clientIdx;                                            // Client index (not used for this process)
+    FUNCTION_TEST_END();
+
+    ASSERT(data != NULL);
+
+    ProtocolParallelJob *result = NULL;
+    ExpireRemoveJobData *const jobData = data;
+
+    if (jobData->removeIdx < lstSize(jobData->removeList))
+    {
+        const ExpireRemove *const remove = lstGet(jobData->removeList, jobData->removeIdx);
+        PackWrite *const param = protocolPackNew();
+
+        pckWriteU32P(param, remove->repoIdx);
+        pckWriteBoolP(param, remove->recurse);
+        pckWriteStrLstP(param, remove->pathList);
+
+        result = protocolParallelJobNew(VARUINT(jobData->removeIdx), PROTOCOL_COMMAND_EXPIRE_REMOVE, param);
+        jobData->removeIdx++;
+    }
+
+    FUNCTION_TEST_RETURN(PROTOCOL_PARALLEL_JOB, result);
+}
+
+static unsigned int
+expireRemoveExec(const List *const removeList)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(LIST, removeList);
+    FUNCTION_LOG_END();
+
+    ASSERT(removeList != NULL);
+
+    unsigned int result = 0;
+
+    if (!lstEmpty(removeList))
+    {
+        MEM_CONTEXT_TEMP_BEGIN()
+        {
+            const TimeMSec timeBegin = timeMSec();
+            unsigned int removeTotal = 0;
+
+            for (unsigned int removeIdx = 0; removeIdx < lstSize(removeList); removeIdx++)
+                removeTotal += strLstSize(((const ExpireRemove *)lstGet(removeList, removeIdx))->pathList);
+
+            // Create the parallel executor
+            ExpireRemoveJobData jobData = {.removeList = removeList};
+            ProtocolParallel *const parallelExec = protocolParallelNew(
+                cfgOptionUInt64(cfgOptProtocolTimeout) / 2, expireRemoveJobCallback, &jobData);
+
+            for (unsigned int processIdx = 1; processIdx <= cfgOptionUInt(cfgOptProcessMax); processIdx++)
+                protocolParallelClientAdd(parallelExec, protocolLocalGet(protocolStorageTypeRepo, 0, processIdx));
+
+            // Process jobs
+            unsigned int removeComplete = 0;
+
+            MEM_CONTEXT_TEMP_RESET_BEGIN()
+            {
+                do
+                {
+                    const unsigned int completed = protocolParallelProcess(parallelExec);
+
+                    for (unsigned int jobIdx = 0; jobIdx < completed; jobIdx++)
+                    {
+                        ProtocolParallelJob *const job = protocolParallelResult(parallelExec);
+                        const ExpireRemove *const remove = lstGet(removeList, varUInt(protocolParallelJobKey(job)));
+
+                        removeComplete += strLstSize(remove->pathList);
+
+                        // Log the error but continue so as much as possible is removed
+                        if (protocolParallelJobErrorCode(job) != 0)
+                        {
+                            LOG_ERROR_PID_FMT(
+                                protocolParallelJobProcessId(job), protocolParallelJobErrorCode(job), "%s: %s",
+                                cfgOptionGroupName(cfgOptGrpRepo, remove->repoIdx), strZ(protocolParallelJobErrorMessage(job)));
+
+                            result++;
+                        }
+                        else
+                        {
+                            LOG_DETAIL_PID_FMT(
+                                protocolParallelJobProcessId(job), "%s: removed %u expired file(s)/path(s) (%u%%)",
+                                cfgOptionGroupName(cfgOptGrpRepo, remove->repoIdx), strLstSize(remove->pathList),
+                                (unsigned int)((uint64_t)removeComplete * 100 / removeTotal));
+                        }
+                    }
+
+                    // Reset the memory context occasionally so we don't use too much memory or slow down processing
+                    MEM_CONTEXT_TEMP_RESET(1000);
+                }
+                while (!protocolParallelDone(parallelExec));
+            }
+            MEM_CONTEXT_TEMP_END();
+
+            // Report throughput so the time required for expire can be estimated
+            TimeMSec timeElapsed = 1;
+            MAX_ASSIGN(timeElapsed, timeMSec() - timeBegin);
+
+            LOG_DETAIL_FMT(
+                "removed %u expired file(s)/path(s) in %" PRIu64 "ms (%" PRIu64 "/sec)", removeTotal, timeElapsed,
+                (uint64_t)removeTotal * MSEC_PER_SEC / timeElapsed);
+        }
+        MEM_CONTEXT_TEMP_END();
+    }
+
+    FUNCTION_LOG_RETURN(UINT, result);
+}
+
 /**********************************************************************************************************************************/
 FN_EXTERN void
 cmdExpire(void)
@@ -1012,6 +1188,9 @@ cmdExpire(void)
         // Track any errors that may occur
         unsigned int errorTotal = 0;
 
+        // Removals planned for all repos
+        List *const removeList = lstNewP(sizeof(ExpireRemove));
+
         for (unsigned int repoIdx = repoIdxMin; repoIdx <= repoIdxMax; repoIdx++)
         {
             // Get the repo storage in case it is remote and encryption settings need to be pulled down
@@ -1074,10 +1253,10 @@ cmdExpire(void)
                         cfgOptionIdxStrId(cfgOptRepoCipherType, repoIdx), cfgOptionIdxStrNull(cfgOptRepoCipherPass, repoIdx));
                 }
 
-                // Remove all files on disk that are now expired
-                removeExpiredBackup(infoBackup, adhocBackupLabel, repoIdx);
-                removeExpiredArchive(infoBackup, timeBasedFullRetention, repoIdx);
-                removeExpiredHistory(infoBackup, repoIdx);
+                // Plan removal of all files on disk that are now expired
+                removeExpiredBackup(infoBackup, adhocBackupLabel, repoIdx, removeList);
+                removeExpiredArchive(infoBackup, timeBasedFullRetention, repoIdx, removeList);
+                removeExpiredHistory(infoBackup, repoIdx, removeList);
             }
             CATCH_ANY()
             {
@@ -1087,6 +1266,9 @@ cmdExpire(void)
             TRY_END();
         }
 
+        // Remove expired files and paths from all repos
+        errorTotal += expireRemoveExec(removeList);
+
         // Error if any errors encountered on one or more repos
         if (errorTotal > 0)
             THROW_FMT(CommandError, CFGCMD_EXPIRE " command encountered %u error(s), check the log file for details", errorTotal);
@@ -0,0 +1,34 @@
+/***********************************************************************************************************************************
+Expire File
+***********************************************************************************************************************************/
+#include "build.auto.h"
+
+#include "command/expire/file.h"
+#include "common/debug.h"
+#include "common/log.h"
+#include "storage/helper.h"
+
+/**********************************************************************************************************************************/
+FN_EXTERN void
+expireFileRemove(const unsigned int repoIdx, const StringList *const pathList, const bool recurse)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(UINT, repoIdx);                          // Repository to remove from
+        FUNCTION_LOG_PARAM(STRING_LIST, pathList);                  // Files or paths to remove
+        FUNCTION_LOG_PARAM(BOOL, recurse);                          // Remove paths recursively?
+    FUNCTION_LOG_END();
+
+    ASSERT(pathList != NULL);
+
+    for (unsigned int pathIdx = 0; pathIdx < strLstSize(pathList); pathIdx++)
+    {
+        const String *const path = strLstGet(pathList, pathIdx);
+
+        if (recurse)
+            storagePathRemoveP(storageRepoIdxWrite(repoIdx), path, .recurse = true);
+        else
+            storageRemoveP(storageRepoIdxWrite(repoIdx), path);
+    }
+
+    FUNCTION_LOG_RETURN_VOID();
+}
@@ -0,0 +1,15 @@
+/***********************************************************************************************************************************
+Expire File
+***********************************************************************************************************************************/
+#ifndef COMMAND_EXPIRE_FILE_H
+#define COMMAND_EXPIRE_FILE_H
+
+#include "common/type/stringList.h"
+
+/***********************************************************************************************************************************
+Functions
+***********************************************************************************************************************************/
+// Remove expired files or paths (recursively) from a repository
+FN_EXTERN void expireFileRemove(unsigned int repoIdx, const StringList *pathList, bool recurse);
+
+#endif
@@ -1344,10 +1344,22 @@ infoUpdateStanza(
                 // If a specific backup exists on this repo then attempt to load the manifest
                 if (backupLabel != NULL)
                 {
-                    stanzaRepo->repoList[repoIdx].manifest = manifestLoadFile(
+                    const InfoBackup *const backupInfo = stanzaRepo->repoList[repoIdx].backupInfo;
+
+                    // The file list is only needed to report files with page checksum errors, so skip loading it when backup.info
+                    // records that the backup has no errors. Loading the file list is the most expensive part of loading the
+                    // manifest.
+                    bool fileSkip = false;
+
+                    if (infoBackupLabelExists(backupInfo, backupLabel))
+                    {
+                        const Variant *const backupError = infoBackupDataByLabel(backupInfo, backupLabel)->backupError;
+                        fileSkip = backupError != NULL && !varBool(backupError);
+                    }
+
+                    stanzaRepo->repoList[repoIdx].manifest = manifestLoadFileP(
                         storage, strNewFmt(STORAGE_REPO_BACKUP "/%s/" BACKUP_MANIFEST_FILE, strZ(backupLabel)),
-                        stanzaRepo->repoList[repoIdx].cipher,
-                        infoPgCipherPass(infoBackupPg(stanzaRepo->repoList[repoIdx].backupInfo)));
+                        stanzaRepo->repoList[repoIdx].cipher, infoPgCipherPass(infoBackupPg(backupInfo)), .fileSkip = fileSkip);
                 }
 
                 // If there is a valid backup lock for this stanza then backup/expire must be running
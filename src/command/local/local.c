@@ -6,6 +6,7 @@ Local Command
 #include "command/archive/get/protocol.h"
 #include "command/archive/push/protocol.h"
 #include "command/backup/protocol.h"
+#include "command/expire/protocol.h"
 #include "command/restore/protocol.h"
 #include "command/verify/protocol.h"
 #include "common/debug.h"
@@ -23,6 +24,7 @@ static const ProtocolServerHandler commandLocalHandlerList[] =
     PROTOCOL_SERVER_HANDLER_ARCHIVE_GET_LIST
     PROTOCOL_SERVER_HANDLER_ARCHIVE_PUSH_LIST
     PROTOCOL_SERVER_HANDLER_BACKUP_LIST
+    PROTOCOL_SERVER_HANDLER_EXPIRE_LIST
     PROTOCOL_SERVER_HANDLER_RESTORE_LIST
     PROTOCOL_SERVER_HANDLER_VERIFY_LIST
 };
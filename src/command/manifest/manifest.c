@@ -78,16 +78,16 @@ cmdManifestBlockDelta(
 
         for (unsigned int blockMapIdx = 0; blockMapIdx < blockMapSize(blockMap); blockMapIdx++)
         {
-            const BlockMapItem *const blockMapItem = blockMapGet(blockMap, blockMapIdx);
+            const BlockMapItem blockMapItem = blockMapGet(blockMap, blockMapIdx);
 
             // The block must be updated if it is beyond the blocks that exist in the block checksum list or when the checksum
             // stored in the repository is different from the block checksum list
             if (blockMapIdx >= blockChecksumSize ||
                 !bufEq(
-                    BUF(blockMapItem->checksum, checksumSize),
+                    BUF(blockMapItem.checksum, checksumSize),
                     BUF(bufPtrConst(blockChecksum) + blockMapIdx * checksumSize, checksumSize)))
             {
-                const unsigned int reference = blockMapItem->reference;
+                const unsigned int reference = blockMapItem.reference;
                 ManifestBlockDeltaReference *const referenceData = lstFind(referenceList, &reference);
 
                 // If the reference has not been added
@@ -114,25 +114,25 @@ cmdManifestBlockDelta(
                 referenceList, referenceIdx);
             ManifestBlockDeltaRead *blockDeltaRead = NULL;
             ManifestBlockDeltaSuperBlock *blockDeltaSuperBlock = NULL;
-            const BlockMapItem *blockMapItemPrior = NULL;
+            BlockMapItem blockMapItemPrior = {0};
 
             for (unsigned int blockIdx = 0; blockIdx < lstSize(referenceData->blockList); blockIdx++)
             {
                 const unsigned int blockMapIdx = *(unsigned int *)lstGet(referenceData->blockList, blockIdx);
-                const BlockMapItem *const blockMapItem = blockMapGet(blockMap, blockMapIdx);
+                const BlockMapItem blockMapItem = blockMapGet(blockMap, blockMapIdx);
 
                 // Add read when it has changed
-                if (blockMapItemPrior == NULL ||
-                    (blockMapItemPrior->offset != blockMapItem->offset &&
-                     blockMapItemPrior->offset + blockMapItemPrior->size != blockMapItem->offset))
+                if (blockIdx == 0 ||
+                    (blockMapItemPrior.offset != blockMapItem.offset &&
+                     blockMapItemPrior.offset + blockMapItemPrior.size != blockMapItem.offset))
                 {
                     MEM_CONTEXT_OBJ_BEGIN(result)
                     {
                         ManifestBlockDeltaRead blockDeltaReadNew =
                         {
-                            .reference = blockMapItem->reference,
-                            .bundleId = blockMapItem->bundleId,
-                            .offset = blockMapItem->offset,
+                            .reference = blockMapItem.reference,
+                            .bundleId = blockMapItem.bundleId,
+                            .offset = blockMapItem.offset,
                             .superBlockList = lstNewP(sizeof(ManifestBlockDeltaSuperBlock)),
                         };
 
@@ -142,19 +142,19 @@ cmdManifestBlockDelta(
                 }
 
                 // Add super block when it has changed
-                if (blockMapItemPrior == NULL || blockMapItemPrior->offset != blockMapItem->offset)
+                if (blockIdx == 0 || blockMapItemPrior.offset != blockMapItem.offset)
                 {
                     MEM_CONTEXT_OBJ_BEGIN(blockDeltaRead->superBlockList)
                     {
                         ManifestBlockDeltaSuperBlock blockDeltaSuperBlockNew =
                         {
-                            .superBlockSize = blockMapItem->superBlockSize,
-                            .size = blockMapItem->size,
+                            .superBlockSize = blockMapItem.superBlockSize,
+                            .size = blockMapItem.size,
                             .blockList = lstNewP(sizeof(ManifestBlockDeltaBlock)),
                         };
 
                         blockDeltaSuperBlock = lstAdd(blockDeltaRead->superBlockList, &blockDeltaSuperBlockNew);
-                        blockDeltaRead->size += blockMapItem->size;
+                        blockDeltaRead->size += blockMapItem.size;
                     }
                     MEM_CONTEXT_OBJ_END();
                 }
@@ -162,12 +162,12 @@ cmdManifestBlockDelta(
                 // Add block
                 ManifestBlockDeltaBlock blockDeltaBlockNew =
                 {
-                    .no = blockMapItem->block,
+                    .no = blockMapItem.block,
                     .offset = blockMapIdx * blockSize,
                 };
 
                 memcpy(
-                    blockDeltaBlockNew.checksum, blockMapItem->checksum, SIZE_OF_STRUCT_MEMBER(ManifestBlockDeltaBlock, checksum));
+                    blockDeltaBlockNew.checksum, blockMapItem.checksum, SIZE_OF_STRUCT_MEMBER(ManifestBlockDeltaBlock, checksum));
                 lstAdd(blockDeltaSuperBlock->blockList, &blockDeltaBlockNew);
 
                 // Set prior item for comparison on the next loop
@@ -445,7 +445,7 @@ cmdManifestRender(void)
         const CipherType cipherType = cipherPass == NULL ? cipherTypeNone : cipherTypeAes256Cbc;
 
         // Load manifest
-        const Manifest *const manifest = manifestLoadFile(
+        const Manifest *const manifest = manifestLoadFileP(
             storageRepo(), strNewFmt(STORAGE_REPO_BACKUP "/%s/" BACKUP_MANIFEST_FILE, strZ(cfgOptionStr(cfgOptSet))),
             cipherType, cipherPass);
 
@@ -5,6 +5,7 @@ Remote Command
 
 #include <string.h>
 
+#include "command/archive/walTrim.h"
 #include "command/backup/blockIncr.h"
 #include "command/backup/pageChecksum.h"
 #include "command/control/common.h"
@@ -45,6 +46,7 @@ static const StorageRemoteFilterHandler storageRemoteFilterHandlerList[] =
     {.type = PAGE_CHECKSUM_FILTER_TYPE, .handlerParam = pageChecksumNewPack},
     {.type = SINK_FILTER_TYPE, .handlerNoParam = ioSinkNew},
     {.type = SIZE_FILTER_TYPE, .handlerNoParam = ioSizeNew},
+    {.type = WAL_EXPAND_FILTER_TYPE, .handlerParam = walExpandNewPack},
 };
 
 /**********************************************************************************************************************************/
@@ -119,7 +119,7 @@ storageGetProcess(IoWrite *const destination)
                                     !strEndsWithZ(file, BACKUP_MANIFEST_FILE) &&
                                     !strEndsWithZ(file, BACKUP_MANIFEST_FILE INFO_COPY_EXT))
                                 {
-                                    const Manifest *const manifest = manifestLoadFile(
+                                    const Manifest *const manifest = manifestLoadFileP(
                                         storageRepo(),
                                         strNewFmt(
                                             STORAGE_PATH_BACKUP "/%s/%s/%s", strZ(stanza), strZ(strLstGet(filePathSplitLst, 2)),
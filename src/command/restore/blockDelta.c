@@ -17,6 +17,7 @@ typedef struct BlockDeltaSuperBlock
 {
     uint64_t superBlockSize;                                        // Super block size
     uint64_t size;                                                  // Stored size of superblock (with compression, etc.)
+    uint64_t gap;                                                   // Bytes to skip before the super block
     List *blockList;                                                // Block list
 } BlockDeltaSuperBlock;
 
@@ -57,13 +58,14 @@ typedef struct BlockDeltaReference
 FN_EXTERN BlockDelta *
 blockDeltaNew(
     const BlockMap *const blockMap, const size_t blockSize, const size_t checksumSize, const Buffer *const blockChecksum,
-    const CipherType cipherType, const String *const cipherPass, const CompressType compressType)
+    const uint64_t readGapMax, const CipherType cipherType, const String *const cipherPass, const CompressType compressType)
 {
     FUNCTION_TEST_BEGIN();
         FUNCTION_TEST_PARAM(BLOCK_MAP, blockMap);
         FUNCTION_TEST_PARAM(SIZE, blockSize);
         FUNCTION_TEST_PARAM(SIZE, checksumSize);
         FUNCTION_TEST_PARAM(BUFFER, blockChecksum);
+        FUNCTION_TEST_PARAM(UINT64, readGapMax);
         FUNCTION_TEST_PARAM(STRING_ID, cipherType);
         FUNCTION_TEST_PARAM(STRING, cipherPass);
         FUNCTION_TEST_PARAM(ENUM, compressType);
@@ -101,16 +103,16 @@ blockDeltaNew(
 
             for (unsigned int blockMapIdx = 0; blockMapIdx < blockMapSize(blockMap); blockMapIdx++)
             {
-                const BlockMapItem *const blockMapItem = blockMapGet(blockMap, blockMapIdx);
+                const BlockMapItem blockMapItem = blockMapGet(blockMap, blockMapIdx);
 
                 // The block must be updated if it is beyond the blocks that exist in the block checksum list or when the checksum
                 // stored in the repository is different from the block checksum list
                 if (blockMapIdx >= blockChecksumSize ||
                     !bufEq(
-                        BUF(blockMapItem->checksum, this->checksumSize),
+                        BUF(blockMapItem.checksum, this->checksumSize),
                         BUF(bufPtrConst(blockChecksum) + blockMapIdx * this->checksumSize, this->checksumSize)))
                 {
-                    const unsigned int reference = blockMapItem->reference;
+                    const unsigned int reference = blockMapItem.reference;
                     BlockDeltaReference *const referenceData = lstFind(referenceList, &reference);
 
                     // If the reference has not been added
@@ -136,25 +138,28 @@ blockDeltaNew(
                 const BlockDeltaReference *const referenceData = (const BlockDeltaReference *)lstGet(referenceList, referenceIdx);
                 BlockDeltaRead *blockDeltaRead = NULL;
                 const BlockDeltaSuperBlock *blockDeltaSuperBlock = NULL;
-                const BlockMapItem *blockMapItemPrior = NULL;
+                BlockMapItem blockMapItemPrior = {0};
 
                 for (unsigned int blockIdx = 0; blockIdx < lstSize(referenceData->blockList); blockIdx++)
                 {
                     const unsigned int blockMapIdx = *(unsigned int *)lstGet(referenceData->blockList, blockIdx);
-                    const BlockMapItem *const blockMapItem = blockMapGet(blockMap, blockMapIdx);
+                    const BlockMapItem blockMapItem = blockMapGet(blockMap, blockMapIdx);
 
-                    // Add read when it has changed
-                    if (blockMapItemPrior == NULL ||
-                        (blockMapItemPrior->offset != blockMapItem->offset &&
-                         blockMapItemPrior->offset + blockMapItemPrior->size != blockMapItem->offset))
+                    // Add read when it has changed, i.e. the super block is before the prior super block or the gap between them is
+                    // too large. Smaller gaps are included in the read and skipped to reduce the number of reads.
+                    const uint64_t priorEnd = blockMapItemPrior.offset + blockMapItemPrior.size;
+
+                    if (blockIdx == 0 ||
+                        (blockMapItemPrior.offset != blockMapItem.offset &&
+                         (blockMapItem.offset < priorEnd || blockMapItem.offset - priorEnd > readGapMax)))
                     {
                         MEM_CONTEXT_OBJ_BEGIN(this->pub.readList)
                         {
                             const BlockDeltaRead blockDeltaReadNew =
                             {
-                                .reference = blockMapItem->reference,
-                                .bundleId = blockMapItem->bundleId,
-                                .offset = blockMapItem->offset,
+                                .reference = blockMapItem.reference,
+                                .bundleId = blockMapItem.bundleId,
+                                .offset = blockMapItem.offset,
                                 .superBlockList = lstNewP(sizeof(BlockDeltaSuperBlock)),
                             };
 
@@ -164,19 +169,20 @@ blockDeltaNew(
                     }
 
                     // Add super block when it has changed
-                    if (blockMapItemPrior == NULL || blockMapItemPrior->offset != blockMapItem->offset)
+                    if (blockIdx == 0 || blockMapItemPrior.offset != blockMapItem.offset)
                     {
                         MEM_CONTEXT_OBJ_BEGIN(blockDeltaRead->superBlockList)
                         {
                             const BlockDeltaSuperBlock blockDeltaSuperBlockNew =
                             {
-                                .superBlockSize = blockMapItem->superBlockSize,
-                                .size = blockMapItem->size,
+                                .superBlockSize = blockMapItem.superBlockSize,
+                                .size = blockMapItem.size,
+                                .gap = blockMapItem.offset - (blockDeltaRead->offset + blockDeltaRead->size),
                                 .blockList = lstNewP(sizeof(BlockDeltaBlock)),
                             };
 
                             blockDeltaSuperBlock = lstAdd(blockDeltaRead->superBlockList, &blockDeltaSuperBlockNew);
-                            blockDeltaRead->size += blockMapItem->size;
+                            blockDeltaRead->size += blockDeltaSuperBlockNew.gap + blockMapItem.size;
                         }
                         MEM_CONTEXT_OBJ_END();
                     }
@@ -184,11 +190,11 @@ blockDeltaNew(
                     // Add block
                     BlockDeltaBlock blockDeltaBlockNew =
                     {
-                        .no = blockMapItem->block,
+                        .no = blockMapItem.block,
                         .offset = blockMapIdx * blockSize,
                     };
 
-                    memcpy(blockDeltaBlockNew.checksum, blockMapItem->checksum, SIZE_OF_STRUCT_MEMBER(BlockDeltaBlock, checksum));
+                    memcpy(blockDeltaBlockNew.checksum, blockMapItem.checksum, SIZE_OF_STRUCT_MEMBER(BlockDeltaBlock, checksum));
                     lstAdd(blockDeltaSuperBlock->blockList, &blockDeltaBlockNew);
 
                     // Set prior item for comparison on the next loop
@@ -231,6 +237,16 @@ blockDeltaNext(BlockDelta *const this, const BlockDeltaRead *const readDelta, Io
             ioReadFree(this->limitRead);
             this->superBlockData = lstGet(readDelta->superBlockList, this->superBlockIdx);
 
+            // Skip the gap between the prior super block and the current super block
+            if (this->superBlockData->gap > 0)
+            {
+                IoRead *const gapRead = ioLimitReadNew(readIo, this->superBlockData->gap);
+
+                ioReadOpen(gapRead);
+                ioReadFlushP(gapRead);
+                ioReadFree(gapRead);
+            }
+
             MEM_CONTEXT_OBJ_BEGIN(this)
             {
                 this->limitRead = ioLimitReadNew(readIo, this->superBlockData->size);
@@ -36,9 +36,10 @@ typedef struct BlockDeltaWrite
 /***********************************************************************************************************************************
 Constructors
 ***********************************************************************************************************************************/
+// Super blocks in the same reference are read with a single read when the gaps between them are no larger than readGapMax
 FN_EXTERN BlockDelta *blockDeltaNew(
-    const BlockMap *blockMap, size_t blockSize, size_t checksumSize, const Buffer *blockChecksum, CipherType cipherType,
-    const String *cipherPass, const CompressType compressType);
+    const BlockMap *blockMap, size_t blockSize, size_t checksumSize, const Buffer *blockChecksum, uint64_t readGapMax,
+    CipherType cipherType, const String *cipherPass, const CompressType compressType);
 
 /***********************************************************************************************************************************
 Functions
@@ -15,6 +15,7 @@ Restore File
 #include "common/crypto/cipherBlock.h"
 #include "common/crypto/hash.h"
 #include "common/debug.h"
+#include "common/io/bufferRead.h"
 #include "common/io/fdWrite.h"
 #include "common/io/filter/group.h"
 #include "common/io/filter/size.h"
@@ -25,11 +26,168 @@ Restore File
 #include "info/manifest.h"
 #include "storage/helper.h"
 
+/***********************************************************************************************************************************
+Read a region of a repo file for block incremental restore using a cache. When a following super block read from the same repo file
+falls within the read gap limit the read is extended to include it and the region is cached to satisfy the following read without
+another request to the repo. Cached regions are also used by files restored later in the same job. The cache is bounded and reads
+that are not extended are not cached.
+***********************************************************************************************************************************/
+#define RESTORE_FILE_READ_CACHE_MAX                                 (4 * 1024 * 1024)
+
+typedef struct RestoreFileReadCache
+{
+    String *repoFile;                                               // Repo file the region was read from
+    uint64_t offset;                                                // Offset of the region in the repo file
+    Buffer *region;                                                 // Region read from the repo file
+} RestoreFileReadCache;
+
+// Open a read of a region of a repo file. When the region is not cached and sizeRead is larger than size then sizeRead bytes are
+// read from the repo file and cached. When the region is not cached and will not be cached the read is from the repo and the
+// StorageRead is created in the caller's mem context, which owns it.
+static IoRead *
+restoreFileReadCache(
+    List *const cache, const Storage *const storage, const String *const repoFile, const uint64_t offset, const uint64_t size,
+    const uint64_t sizeRead)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(LIST, cache);
+        FUNCTION_TEST_PARAM(STORAGE, storage);
+        FUNCTION_TEST_PARAM(STRING, repoFile);
+        FUNCTION_TEST_PARAM(UINT64, offset);
+        FUNCTION_TEST_PARAM(UINT64, size);
+        FUNCTION_TEST_PARAM(UINT64, sizeRead);
+    FUNCTION_TEST_END();
+
+    FUNCTION_AUDIT_HELPER();
+
+    ASSERT(cache != NULL);
+    ASSERT(storage != NULL);
+    ASSERT(repoFile != NULL);
+    ASSERT(sizeRead >= size);
+    ASSERT(sizeRead == size || sizeRead <= RESTORE_FILE_READ_CACHE_MAX);
+
+    IoRead *result = NULL;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        // Find a cached region containing the read
+        const RestoreFileReadCache *region = NULL;
+
+        for (unsigned int cacheIdx = 0; cacheIdx < lstSize(cache); cacheIdx++)
+        {
+            const RestoreFileReadCache *const regionFind = lstGet(cache, cacheIdx);
+
+            if (offset >= regionFind->offset && offset + size <= regionFind->offset + bufUsed(regionFind->region) &&
+                strEq(regionFind->repoFile, repoFile))
+            {
+                region = regionFind;
+                break;
+            }
+        }
+
+        // If not found and the read is extended then read the region and add it to the cache
+        if (region == NULL && sizeRead > size)
+        {
+            Buffer *const regionData = storageGetP(
+                storageNewReadP(storage, repoFile, .offset = offset, .limit = VARUINT64(sizeRead)));
+
+            // Remove the oldest regions until there is room for the new region
+            size_t cacheSize = bufUsed(regionData);
+
+            for (unsigned int cacheIdx = 0; cacheIdx < lstSize(cache); cacheIdx++)
+                cacheSize += bufUsed(((const RestoreFileReadCache *)lstGet(cache, cacheIdx))->region);
+
+            while (cacheSize > RESTORE_FILE_READ_CACHE_MAX)
+            {
+                RestoreFileReadCache *const regionRemove = lstGet(cache, 0);
+
+                cacheSize -= bufUsed(regionRemove->region);
+                strFree(regionRemove->repoFile);
+                bufFree(regionRemove->region);
+                lstRemoveIdx(cache, 0);
+            }
+
+            MEM_CONTEXT_OBJ_BEGIN(cache)
+            {
+                region = lstAdd(
+                    cache,
+                    &(RestoreFileReadCache){
+                        .repoFile = strDup(repoFile), .offset = offset, .region = bufMove(regionData, objMemContext(cache))});
+            }
+            MEM_CONTEXT_OBJ_END();
+        }
+
+        // Read directly from the repo when the region is not cached
+        if (region == NULL)
+        {
+            MEM_CONTEXT_PRIOR_BEGIN()
+            {
+                result = storageReadIo(storageNewReadP(storage, repoFile, .offset = offset, .limit = VARUINT64(size)));
+            }
+            MEM_CONTEXT_PRIOR_END();
+        }
+        // Else read from the cached region. If the repo file is shorter than expected then the read will be short and error later.
+        else
+        {
+            const size_t regionOffset = (size_t)(offset - region->offset);
+            const size_t regionSize = bufUsed(region->region) - regionOffset;
+            Buffer *const buffer = bufNewC(
+                bufPtrConst(region->region) + regionOffset, size < regionSize ? (size_t)size : regionSize);
+
+            MEM_CONTEXT_PRIOR_BEGIN()
+            {
+                result = ioBufferReadNew(buffer);
+            }
+            MEM_CONTEXT_PRIOR_END();
+
+            bufMove(buffer, objMemContext(result));
+        }
+
+        ioReadOpen(result);
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_TEST_RETURN(IO_READ, result);
+}
+
+// Get the size of a super block read extended to include following reads from the same repo file that fall within the read gap
+// limit. Reads for the same reference are always from the same repo file.
+static uint64_t
+restoreFileReadSize(const BlockDelta *const blockDelta, const unsigned int readIdx, const uint64_t readGapMax)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(BLOCK_DELTA, blockDelta);
+        FUNCTION_TEST_PARAM(UINT, readIdx);
+        FUNCTION_TEST_PARAM(UINT64, readGapMax);
+    FUNCTION_TEST_END();
+
+    ASSERT(blockDelta != NULL);
+    ASSERT(readIdx < blockDeltaReadSize(blockDelta));
+
+    const BlockDeltaRead *const read = blockDeltaReadGet(blockDelta, readIdx);
+    uint64_t result = read->size;
+
+    for (unsigned int nextIdx = readIdx + 1; nextIdx < blockDeltaReadSize(blockDelta); nextIdx++)
+    {
+        const BlockDeltaRead *const readNext = blockDeltaReadGet(blockDelta, nextIdx);
+
+        if (readNext->reference == read->reference && readNext->offset >= read->offset)
+        {
+            const uint64_t sizeNext = readNext->offset + readNext->size - read->offset;
+
+            if (sizeNext <= readGapMax && sizeNext > result)
+                result = sizeNext;
+        }
+    }
+
+    FUNCTION_TEST_RETURN(UINT64, result);
+}
+
 /**********************************************************************************************************************************/
 FN_EXTERN List *
 restoreFile(
     const String *const repoFile, const unsigned int repoIdx, const CompressType repoFileCompressType, const time_t copyTimeBegin,
-    const bool delta, const bool deltaForce, const bool bundleRaw, const String *const cipherPass,
+    const bool delta, const bool deltaForce, const bool bundleRaw, const uint64_t readGapMax, const String *const cipherPass,
     const StringList *const referenceList, List *const fileList)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
@@ -40,6 +198,7 @@ restoreFile(
         FUNCTION_LOG_PARAM(BOOL, delta);
         FUNCTION_LOG_PARAM(BOOL, deltaForce);
         FUNCTION_LOG_PARAM(BOOL, bundleRaw);
+        FUNCTION_LOG_PARAM(UINT64, readGapMax);
         FUNCTION_TEST_PARAM(STRING, cipherPass);
         FUNCTION_LOG_PARAM(STRING_LIST, referenceList);             // List of references (for block incremental)
         FUNCTION_LOG_PARAM(LIST, fileList);                         // List of files to restore
@@ -218,7 +377,9 @@ restoreFile(
 
         // Copy files from repository to database
         StorageRead *repoFileRead = NULL;
+        uint64_t repoFileOffset = 0;
         uint64_t repoFileLimit = 0;
+        List *const readCache = lstNewP(sizeof(RestoreFileReadCache));
 
         for (unsigned int fileIdx = 0; fileIdx < lstSize(fileList); fileIdx++)
         {
@@ -241,7 +402,9 @@ restoreFile(
                             ASSERT(varUInt64(file->limit) != 0);
                             repoFileLimit = varUInt64(file->limit);
 
-                            // Determine how many files can be copied with one read
+                            // Determine how many files can be copied with one read. Files that are not being copied (e.g. preserved
+                            // by delta) leave a gap but it is cheaper to read through a small gap than to start a new read,
+                            // especially on object stores.
                             for (unsigned int fileNextIdx = fileIdx + 1; fileNextIdx < lstSize(fileList); fileNextIdx++)
                             {
                                 // Only files that are being copied are considered
@@ -250,18 +413,19 @@ restoreFile(
                                     const RestoreFile *const fileNext = lstGet(fileList, fileNextIdx);
                                     ASSERT(fileNext->limit != NULL && varUInt64(fileNext->limit) != 0);
 
-                                    // Break if the offset is not the first file's offset + limit of all additional files so far
-                                    if (fileNext->offset != file->offset + repoFileLimit)
+                                    // Break if the file is before the end of the read or the gap is too large to read through
+                                    const uint64_t repoFileEnd = file->offset + repoFileLimit;
+
+                                    if (fileNext->offset < repoFileEnd || fileNext->offset - repoFileEnd > readGapMax)
                                         break;
 
-                                    repoFileLimit += varUInt64(fileNext->limit);
+                                    repoFileLimit += fileNext->offset - repoFileEnd + varUInt64(fileNext->limit);
                                 }
-                                // Else if the file was not copied then there is a gap so break
-                                else
-                                    break;
                             }
                         }
 
+                        repoFileOffset = file->offset;
+
                         // Create and open the repo file. It needs to be created in the prior context because it will live longer
                         // than a single loop when more than one file is being read.
                         MEM_CONTEXT_PRIOR_BEGIN()
@@ -275,6 +439,21 @@ restoreFile(
                         }
                         MEM_CONTEXT_PRIOR_END();
                     }
+                    // Else skip the gap (if any) between the prior file and this file
+                    else if (file->offset != repoFileOffset)
+                    {
+                        ASSERT(file->offset > repoFileOffset);
+
+                        const uint64_t gap = file->offset - repoFileOffset;
+                        IoRead *const gapRead = ioLimitReadNew(storageReadIo(repoFileRead), gap);
+
+                        ioReadOpen(gapRead);
+                        ioReadFlushP(gapRead);
+                        ioReadFree(gapRead);
+
+                        repoFileOffset = file->offset;
+                        repoFileLimit -= gap;
+                    }
 
                     // Create pg file
                     StorageWrite *const pgFileWrite = storageNewWriteP(
@@ -310,46 +489,48 @@ restoreFile(
 
                         // Apply delta to file
                         BlockDelta *const blockDelta = blockDeltaNew(
-                            blockMap, file->blockIncrSize, file->blockIncrChecksumSize, file->blockChecksum,
+                            blockMap, file->blockIncrSize, file->blockIncrChecksumSize, file->blockChecksum, readGapMax,
                             cipherPass == NULL ? cipherTypeNone : cipherTypeAes256Cbc, cipherPass, repoFileCompressType);
 
                         for (unsigned int readIdx = 0; readIdx < blockDeltaReadSize(blockDelta); readIdx++)
                         {
                             const BlockDeltaRead *const read = blockDeltaReadGet(blockDelta, readIdx);
 
-                            // Open the super block list for read. Using one read for all super blocks is cheaper than reading from
-                            // the file multiple times, which is especially noticeable on object stores.
-                            StorageRead *const superBlockRead = storageNewReadP(
-                                storageRepo(),
-                                backupFileRepoPathP(
-                                    strLstGet(referenceList, read->reference), .manifestName = file->manifestFile,
-                                    .bundleId = read->bundleId, .blockIncr = true),
-                                .offset = read->offset, .limit = VARUINT64(read->size));
-                            ioReadOpen(storageReadIo(superBlockRead));
-
-                            // Write updated blocks to the file
-                            const BlockDeltaWrite *deltaWrite = blockDeltaNext(blockDelta, read, storageReadIo(superBlockRead));
-
-                            while (deltaWrite != NULL)
+                            // Use a per-read mem context to free the read after the super blocks have been written
+                            MEM_CONTEXT_TEMP_BEGIN()
                             {
-                                // Seek to the block offset. It is possible we are already at the correct position but it is easier
-                                // and safer to let lseek() figure this out.
-                                THROW_ON_SYS_ERROR_FMT(
-                                    lseek(ioWriteFd(storageWriteIo(pgFileWrite)), (off_t)deltaWrite->offset, SEEK_SET) == -1,
-                                    FileOpenError, STORAGE_ERROR_READ_SEEK, deltaWrite->offset,
-                                    strZ(storagePathP(storagePg(), file->name)));
+                                // Open the super block list for read. Using one read for all super blocks is cheaper than reading
+                                // from the file multiple times, which is especially noticeable on object stores.
+                                IoRead *const superBlockRead = restoreFileReadCache(
+                                    readCache, storageRepoIdx(repoIdx),
+                                    backupFileRepoPathP(
+                                        strLstGet(referenceList, read->reference), .manifestName = file->manifestFile,
+                                        .bundleId = read->bundleId, .blockIncr = true),
+                                    read->offset, read->size, restoreFileReadSize(blockDelta, readIdx, readGapMax));
+
+                                // Write updated blocks to the file
+                                const BlockDeltaWrite *deltaWrite = blockDeltaNext(blockDelta, read, superBlockRead);
+
+                                while (deltaWrite != NULL)
+                                {
+                                    // Seek to the block offset. It is possible we are already at the correct position but it is
+                                    // easier and safer to let lseek() figure this out.
+                                    THROW_ON_SYS_ERROR_FMT(
+                                        lseek(ioWriteFd(storageWriteIo(pgFileWrite)), (off_t)deltaWrite->offset, SEEK_SET) == -1,
+                                        FileOpenError, STORAGE_ERROR_READ_SEEK, deltaWrite->offset,
+                                        strZ(storagePathP(storagePg(), file->name)));
 
-                                // Write block
-                                ioWrite(storageWriteIo(pgFileWrite), deltaWrite->block);
-                                fileResult->blockIncrDeltaSize += bufUsed(deltaWrite->block);
+                                    // Write block
+                                    ioWrite(storageWriteIo(pgFileWrite), deltaWrite->block);
+                                    fileResult->blockIncrDeltaSize += bufUsed(deltaWrite->block);
 
-                                // Flush writes since we may seek to a new location for the next block
-                                ioWriteFlush(storageWriteIo(pgFileWrite));
+                                    // Flush writes since we may seek to a new location for the next block
+                                    ioWriteFlush(storageWriteIo(pgFileWrite));
 
-                                deltaWrite = blockDeltaNext(blockDelta, read, storageReadIo(superBlockRead));
+                                    deltaWrite = blockDeltaNext(blockDelta, read, superBlockRead);
+                                }
                             }
-
-                            storageReadFree(superBlockRead);
+                            MEM_CONTEXT_TEMP_END();
                         }
 
                         // Close the file to complete the update
@@ -399,7 +580,10 @@ restoreFile(
 
                     // If more than one file is being copied from a single read then decrement the limit
                     if (repoFileLimit != 0)
+                    {
+                        repoFileOffset += varUInt64(file->limit);
                         repoFileLimit -= varUInt64(file->limit);
+                    }
 
                     // Free the repo file when there are no more files to copy from it
                     if (repoFileLimit == 0)
@@ -47,8 +47,12 @@ typedef struct RestoreFileResult
     uint64_t blockIncrDeltaSize;                                    // Size restored by block incremental delta
 } RestoreFileResult;
 
+// Files in a bundle are read with a single read when the gaps between them (e.g. files preserved by delta) are no larger than
+// readGapMax. The data in the gaps is read and discarded. The same limit applies to gaps between block incremental super blocks and
+// to the read ahead for super block reads.
 FN_EXTERN List *restoreFile(
     const String *repoFile, unsigned int repoIdx, CompressType repoFileCompressType, time_t copyTimeBegin, bool delta,
-    bool deltaForce, bool bundleRaw, const String *cipherPass, const StringList *referenceList, List *fileList);
+    bool deltaForce, bool bundleRaw, uint64_t readGapMax, const String *cipherPass, const StringList *referenceList,
+    List *fileList);
 
 #endif
@@ -2183,8 +2183,50 @@ typedef struct RestoreJobData
     const String *cipherSubPass;                                    // Passphrase used to decrypt files in the backup
     const String *rootReplaceUser;                                  // User to replace invalid users when root
     const String *rootReplaceGroup;                                 // Group to replace invalid group when root
+    uint64_t readGapMax;                                            // Max gap to read through rather than starting a new read
 } RestoreJobData;
 
+// Helper to estimate the largest gap that is cheaper to read through than to skip with a new read. This limit is used for gaps
+// between files in a bundle, gaps between super blocks in a block incremental read, and the read ahead for super block reads. The
+// cost of a new read is roughly the latency of a request multiplied by the throughput of the repo, i.e. the number of bytes that
+// could have been read while waiting for the new request to start. Object stores have high request latency (and often charge per
+// request) so reading through large gaps is cheaper, while a new read on local storage only costs a few system calls.
+static uint64_t
+restoreJobReadGapMax(const StringId repoType)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRING_ID, repoType);
+    FUNCTION_TEST_END();
+
+    uint64_t result;
+
+    switch (repoType)
+    {
+        // Object stores have ~10ms request latency at ~100MiB/s
+        case CFGOPTVAL_REPO_TYPE_AZURE:
+        case CFGOPTVAL_REPO_TYPE_GCS:
+        case CFGOPTVAL_REPO_TYPE_S3:
+            result = 1024 * 1024;
+            break;
+
+        // SFTP requires round trips to open and seek the file
+        case CFGOPTVAL_REPO_TYPE_SFTP:
+            result = 256 * 1024;
+            break;
+
+        // Local and network filesystems only need a seek
+        default:
+        {
+            ASSERT(repoType == CFGOPTVAL_REPO_TYPE_CIFS || repoType == CFGOPTVAL_REPO_TYPE_POSIX);
+
+            result = 64 * 1024;
+            break;
+        }
+    }
+
+    FUNCTION_TEST_RETURN(UINT64, result);
+}
+
 // Helper to calculate the next queue to scan based on the client index
 static int
 restoreJobQueueNext(const unsigned int clientIdx, int queueIdx, const unsigned int queueTotal)
@@ -2273,6 +2315,7 @@ restoreJobCallback(void *const data, const unsigned int clientIdx)
                     pckWriteBoolP(param, cfgOptionBool(cfgOptDelta));
                     pckWriteBoolP(param, cfgOptionBool(cfgOptDelta) && cfgOptionBool(cfgOptForce));
                     pckWriteBoolP(param, file.bundleId != 0 && manifestData(jobData->manifest)->bundleRaw);
+                    pckWriteU64P(param, jobData->readGapMax);
                     pckWriteStrP(param, jobData->cipherSubPass);
                     pckWriteStrLstP(param, manifestReferenceList(jobData->manifest));
 
@@ -2373,9 +2416,13 @@ cmdRestore(void)
         const RestoreBackupData backupData = restoreBackupSet();
 
         // Load manifest
-        RestoreJobData jobData = {.repoIdx = backupData.repoIdx};
+        RestoreJobData jobData =
+        {
+            .repoIdx = backupData.repoIdx,
+            .readGapMax = restoreJobReadGapMax(cfgOptionIdxStrId(cfgOptRepoType, backupData.repoIdx)),
+        };
 
-        jobData.manifest = manifestLoadFile(
+        jobData.manifest = manifestLoadFileP(
             storageRepoIdx(backupData.repoIdx),
             strNewFmt(STORAGE_REPO_BACKUP "/%s/" BACKUP_MANIFEST_FILE, strZ(backupData.backupSet)), backupData.repoCipherType,
             backupData.backupCipherPass);
@@ -3,6 +3,7 @@ Verify File
 ***********************************************************************************************************************************/
 #include "build.auto.h"
 
+#include "command/archive/walTrim.h"
 #include "command/verify/file.h"
 #include "common/crypto/cipherBlock.h"
 #include "common/crypto/hash.h"
@@ -18,7 +19,7 @@ Verify File
 FN_EXTERN VerifyResult
 verifyFile(
     const String *const filePathName, const uint64_t offset, const Variant *const limit, const CompressType compressType,
-    const Buffer *const fileChecksum, const uint64_t fileSize, const String *const cipherPass)
+    const Buffer *const fileChecksum, const uint64_t fileSize, const String *const cipherPass, const bool walSegment)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(STRING, filePathName);                   // Fully qualified file name
@@ -28,6 +29,7 @@ verifyFile(
         FUNCTION_LOG_PARAM(BUFFER, fileChecksum);                   // Checksum for the file
         FUNCTION_LOG_PARAM(UINT64, fileSize);                       // Size of file
         FUNCTION_TEST_PARAM(STRING, cipherPass);                    // Password to access the repo file if encrypted
+        FUNCTION_LOG_PARAM(BOOL, walSegment);                       // Is the file a WAL segment?
     FUNCTION_LOG_END();
 
     ASSERT(filePathName != NULL);
@@ -52,6 +54,10 @@ verifyFile(
         if (compressType != compressTypeNone)
             ioFilterGroupAdd(filterGroup, decompressFilterP(compressType));
 
+        // Add filter to expand WAL segments that were trimmed when pushed
+        if (walSegment)
+            ioFilterGroupAdd(filterGroup, walExpandNew(fileSize));
+
         // Add sha1 filter
         ioFilterGroupAdd(filterGroup, cryptoHashNew(hashTypeSha1));
 
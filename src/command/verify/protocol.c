@@ -42,11 +42,12 @@ verifyFileProtocol(PackRead *const param)
         const Buffer *const fileChecksum = pckReadBinP(param);
         const uint64_t fileSize = pckReadU64P(param);
         const String *const cipherPass = pckReadStrP(param);
+        const bool walSegment = pckReadBoolP(param);
 
         // Return result
         pckWriteU32P(
             protocolServerResultData(result),
-            verifyFile(filePathName, offset, limit, compressType, fileChecksum, fileSize, cipherPass));
+            verifyFile(filePathName, offset, limit, compressType, fileChecksum, fileSize, cipherPass, walSegment));
     }
     MEM_CONTEXT_TEMP_END();
 
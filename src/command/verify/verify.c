@@ -222,7 +222,7 @@ verifyInfoFile(const String *const pathFileName, const bool keepFile, const Stri
                 else if (strBeginsWith(pathFileName, INFO_ARCHIVE_PATH_FILE_STR))
                     result.archive = infoArchiveMove(infoArchiveNewLoad(infoRead), memContextPrior());
                 else
-                    result.manifest = manifestMove(manifestNewLoad(infoRead), memContextPrior());
+                    result.manifest = manifestMove(manifestNewLoadP(infoRead), memContextPrior());
             }
             else
                 ioReadDrain(infoRead);
@@ -762,6 +762,7 @@ verifyArchive(VerifyJobData *const jobData)
                         pckWriteBinP(param, checksum);
                         pckWriteU64P(param, archiveResult->pgWalInfo.size);
                         pckWriteStrP(param, jobData->walCipherPass);
+                        pckWriteBoolP(param, true);
 
                         // Assign job to result, prepending the archiveId to the key for consistency with backup processing
                         const String *const jobKey = strNewFmt("%s/%s", strZ(archiveResult->archiveId), strZ(filePathName));
@@ -1014,6 +1015,8 @@ verifyBackup(VerifyJobData *const jobData)
                                 pckWriteStrP(param, jobData->backupCipherPass);
                             }
 
+                            pckWriteBoolP(param, false);
+
                             // Assign job to result (prepend backup label being processed to the key since some files are in a prior
                             // backup)
                             const String *const jobKey = strNewFmt("%s/%s", strZ(backupResult->backupLabel), strZ(filePathName));
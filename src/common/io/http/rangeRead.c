@@ -0,0 +1,274 @@
+/***********************************************************************************************************************************
+HTTP Range Read
+***********************************************************************************************************************************/
+#include "build.auto.h"
+
+#include "common/debug.h"
+#include "common/io/http/rangeRead.h"
+#include "common/io/http/response.h"
+#include "common/io/read.h"
+#include "common/log.h"
+#include "common/type/convert.h"
+#include "common/type/list.h"
+
+/***********************************************************************************************************************************
+Object type
+***********************************************************************************************************************************/
+struct HttpRangeRead
+{
+    HttpRangeReadRequestCallback *requestCallback;                  // Callback to start a ranged request
+    void *requestCallbackData;                                      // Data to pass to callback
+    uint64_t rangeSize;                                             // Size of each range
+    unsigned int rangeMax;                                          // Maximum requests in progress (including the current response)
+
+    uint64_t rangeNext;                                             // Offset of the next range to request
+    uint64_t rangeEnd;                                              // Offset where reading ends
+    List *requestList;                                              // Requests in progress, oldest first
+    HttpResponse *response;                                         // Response currently being read (NULL when object is empty)
+    const HttpHeader *header;                                       // Header of the first response (used to validate later ranges)
+};
+
+/***********************************************************************************************************************************
+Start requests until the maximum are in progress or all ranges have been requested
+***********************************************************************************************************************************/
+static void
+httpRangeReadRequestFill(HttpRangeRead *const this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(HTTP_RANGE_READ, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    MEM_CONTEXT_OBJ_BEGIN(this)
+    {
+        // The response being read counts as a request in progress
+        while (lstSize(this->requestList) < this->rangeMax - 1 && this->rangeNext < this->rangeEnd)
+        {
+            uint64_t size = this->rangeEnd - this->rangeNext;
+            MIN_ASSIGN(size, this->rangeSize);
+
+            HttpRequest *const request = this->requestCallback(this->requestCallbackData, this->rangeNext, size, this->header);
+            lstAdd(this->requestList, &request);
+
+            this->rangeNext += size;
+        }
+    }
+    MEM_CONTEXT_OBJ_END();
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Replace the current response with the response to the oldest request in progress
+***********************************************************************************************************************************/
+static void
+httpRangeReadResponseNext(HttpRangeRead *const this)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(HTTP_RANGE_READ, this);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(!lstEmpty(this->requestList));
+
+    HttpRequest *const request = *(HttpRequest **)lstGet(this->requestList, 0);
+
+    httpResponseFree(this->response);
+
+    MEM_CONTEXT_OBJ_BEGIN(this)
+    {
+        this->response = httpRequestResponse(request, false);
+    }
+    MEM_CONTEXT_OBJ_END();
+
+    // Every range after the first must be returned as partial content
+    if (httpResponseCode(this->response) != HTTP_RESPONSE_CODE_PARTIAL_CONTENT)
+        httpRequestError(request, this->response);
+
+    httpRequestFree(request);
+    lstRemoveIdx(this->requestList, 0);
+
+    // Start the next request to keep the maximum in progress
+    httpRangeReadRequestFill(this);
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN HttpRangeRead *
+httpRangeReadNew(
+    HttpRangeReadRequestCallback *const requestCallback, void *const requestCallbackData, const uint64_t offset,
+    const Variant *const limit, const uint64_t rangeSize, const unsigned int rangeMax)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(FUNCTIONP, requestCallback);
+        FUNCTION_LOG_PARAM_P(VOID, requestCallbackData);
+        FUNCTION_LOG_PARAM(UINT64, offset);
+        FUNCTION_LOG_PARAM(VARIANT, limit);
+        FUNCTION_LOG_PARAM(UINT64, rangeSize);
+        FUNCTION_LOG_PARAM(UINT, rangeMax);
+    FUNCTION_LOG_END();
+
+    ASSERT(requestCallback != NULL);
+    ASSERT(limit == NULL || varUInt64(limit) > 0);
+    ASSERT(rangeSize > 0);
+    ASSERT(rangeMax > 1);
+
+    OBJ_NEW_BEGIN(HttpRangeRead, .childQty = MEM_CONTEXT_QTY_MAX)
+    {
+        *this = (HttpRangeRead)
+        {
+            .requestCallback = requestCallback,
+            .requestCallbackData = requestCallbackData,
+            .rangeSize = rangeSize,
+            .rangeMax = rangeMax,
+            .rangeNext = offset,
+            .rangeEnd = limit == NULL ? UINT64_MAX : offset + varUInt64(limit),
+            .requestList = lstNewP(sizeof(HttpRequest *)),
+        };
+    }
+    OBJ_NEW_END();
+
+    FUNCTION_LOG_RETURN(HTTP_RANGE_READ, this);
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN bool
+httpRangeReadOpen(HttpRangeRead *const this)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(HTTP_RANGE_READ, this);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(this->response == NULL && lstEmpty(this->requestList));
+
+    bool result = true;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        // Request the first range. The size of the object is not known yet so other ranges cannot be requested until the response
+        // arrives.
+        uint64_t size = this->rangeEnd - this->rangeNext;
+        MIN_ASSIGN(size, this->rangeSize);
+
+        HttpRequest *const request = this->requestCallback(this->requestCallbackData, this->rangeNext, size, NULL);
+
+        MEM_CONTEXT_OBJ_BEGIN(this)
+        {
+            this->response = httpRequestResponse(request, false);
+        }
+        MEM_CONTEXT_OBJ_END();
+
+        switch (httpResponseCode(this->response))
+        {
+            // Partial content so the content-range header contains the size of the object, e.g. bytes 0-1023/4096
+            case HTTP_RESPONSE_CODE_PARTIAL_CONTENT:
+            {
+                const String *const contentRange = httpHeaderGet(
+                    httpResponseHeader(this->response), HTTP_HEADER_CONTENT_RANGE_STR);
+                const int totalIdx = contentRange == NULL ? -1 : strChr(contentRange, '/');
+
+                if (totalIdx == -1)
+                {
+                    THROW_FMT(
+                        FormatError, "invalid " HTTP_HEADER_CONTENT_RANGE " header '%s' in partial content response",
+                        strZNull(contentRange));
+                }
+
+                MIN_ASSIGN(this->rangeEnd, cvtZToUInt64(strZ(contentRange) + totalIdx + 1));
+                this->rangeNext += size;
+
+                // Keep the header so the ranges that follow can be made conditional on the object not changing
+                MEM_CONTEXT_OBJ_BEGIN(this)
+                {
+                    this->header = httpHeaderDup(httpResponseHeader(this->response), NULL);
+                }
+                MEM_CONTEXT_OBJ_END();
+
+                break;
+            }
+
+            // The object is missing
+            case HTTP_RESPONSE_CODE_NOT_FOUND:
+            {
+                httpResponseFree(this->response);
+                this->response = NULL;
+                this->rangeEnd = this->rangeNext;
+                result = false;
+
+                break;
+            }
+
+            // A range starting at zero is not satisfiable when the object is empty
+            case HTTP_RESPONSE_CODE_RANGE_NOT_SATISFIABLE:
+            {
+                if (this->rangeNext != 0)
+                    httpRequestError(request, this->response);
+
+                httpResponseFree(this->response);
+                this->response = NULL;
+                this->rangeEnd = 0;
+
+                break;
+            }
+
+            // Else the range was ignored and the response contains all the content. Error if the request was not successful.
+            default:
+            {
+                if (!httpResponseCodeOk(this->response))
+                    httpRequestError(request, this->response);
+
+                this->rangeEnd = this->rangeNext;
+                break;
+            }
+        }
+
+        // Start requests for the ranges that follow
+        httpRangeReadRequestFill(this);
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN(BOOL, result);
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN size_t
+httpRangeReadContent(HttpRangeRead *const this, Buffer *const buffer)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(HTTP_RANGE_READ, this);
+        FUNCTION_LOG_PARAM(BUFFER, buffer);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(buffer != NULL && !bufFull(buffer));
+
+    const size_t sizeBegin = bufUsed(buffer);
+
+    // Read ranges in the order they were requested until the buffer is full or there are no more ranges
+    while (!bufFull(buffer) && !httpRangeReadEof(this))
+    {
+        if (ioReadEof(httpResponseIoRead(this->response)))
+            httpRangeReadResponseNext(this);
+        else
+            ioRead(httpResponseIoRead(this->response), buffer);
+    }
+
+    FUNCTION_LOG_RETURN(SIZE, bufUsed(buffer) - sizeBegin);
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN bool
+httpRangeReadEof(const HttpRangeRead *const this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(HTTP_RANGE_READ, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(
+        BOOL, this->response == NULL || (lstEmpty(this->requestList) && ioReadEof(httpResponseIoRead(this->response))));
+}
@@ -0,0 +1,75 @@
+/***********************************************************************************************************************************
+HTTP Range Read
+
+Read an object with a series of ranged GET requests that are started before they are needed so several are in progress at once.
+Responses are always read in the order the requests were started, so content is delivered to the caller strictly in order while
+later ranges are already being transferred. The number of requests in progress bounds the memory used since content that has not
+been read yet is held in the socket buffers of each session.
+
+The first request determines the size of the object from the content-range header so no additional request is required to get the
+size. If the server ignores the range and returns the entire object then the object is read from that response alone. The header of
+the first response is passed to the callback for the ranges that follow so they can be made conditional on the object not changing,
+e.g. with an if-match header. Otherwise content from different versions of the object could be mixed if it is overwritten while
+being read.
+***********************************************************************************************************************************/
+#ifndef COMMON_IO_HTTP_RANGE_READ_H
+#define COMMON_IO_HTTP_RANGE_READ_H
+
+/***********************************************************************************************************************************
+Object type
+***********************************************************************************************************************************/
+typedef struct HttpRangeRead HttpRangeRead;
+
+#include "common/io/http/request.h"
+#include "common/type/buffer.h"
+#include "common/type/object.h"
+#include "common/type/variant.h"
+
+/***********************************************************************************************************************************
+Default size of each range
+***********************************************************************************************************************************/
+#define HTTP_RANGE_READ_SIZE                                        (8 * 1024 * 1024)
+
+/***********************************************************************************************************************************
+Callback to start an async ranged GET request. The request must be allocated in the current memory context. The header is from the
+response to the first range and is NULL when the first range is being requested.
+***********************************************************************************************************************************/
+typedef HttpRequest *HttpRangeReadRequestCallback(void *data, uint64_t offset, uint64_t size, const HttpHeader *header);
+
+/***********************************************************************************************************************************
+Constructors
+***********************************************************************************************************************************/
+FN_EXTERN HttpRangeRead *httpRangeReadNew(
+    HttpRangeReadRequestCallback *requestCallback, void *requestCallbackData, uint64_t offset, const Variant *limit,
+    uint64_t rangeSize, unsigned int rangeMax);
+
+/***********************************************************************************************************************************
+Functions
+***********************************************************************************************************************************/
+// Send the first request and start the requests that follow it. Returns false if the object is missing.
+FN_EXTERN bool httpRangeReadOpen(HttpRangeRead *this);
+
+// Read content into the buffer
+FN_EXTERN size_t httpRangeReadContent(HttpRangeRead *this, Buffer *buffer);
+
+// Has all content been read?
+FN_EXTERN bool httpRangeReadEof(const HttpRangeRead *this);
+
+/***********************************************************************************************************************************
+Destructor
+***********************************************************************************************************************************/
+FN_INLINE_ALWAYS void
+httpRangeReadFree(HttpRangeRead *const this)
+{
+    objFree(this);
+}
+
+/***********************************************************************************************************************************
+Macros for function logging
+***********************************************************************************************************************************/
+#define FUNCTION_LOG_HTTP_RANGE_READ_TYPE                                                                                          \
+    HttpRangeRead *
+#define FUNCTION_LOG_HTTP_RANGE_READ_FORMAT(value, buffer, bufferSize)                                                             \
+    objNameToLog(value, "HttpRangeRead", buffer, bufferSize)
+
+#endif
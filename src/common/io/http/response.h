@@ -21,9 +21,11 @@ typedef struct HttpResponseMulti HttpResponseMulti;
 /***********************************************************************************************************************************
 HTTP Response Constants
 ***********************************************************************************************************************************/
+#define HTTP_RESPONSE_CODE_PARTIAL_CONTENT                          206
 #define HTTP_RESPONSE_CODE_PERMANENT_REDIRECT                       308
 #define HTTP_RESPONSE_CODE_FORBIDDEN                                403
 #define HTTP_RESPONSE_CODE_NOT_FOUND                                404
+#define HTTP_RESPONSE_CODE_RANGE_NOT_SATISFIABLE                    416
 
 // 2xx indicates success
 #define HTTP_RESPONSE_CODE_CLASS_OK                                 2
@@ -37,6 +37,19 @@ Useful for ensuring coverage in cases where compared values may be always ascend
     }                                                                                                                              \
     while (0)
 
+/***********************************************************************************************************************************
+If param2 < param1 then assign it to param1
+
+Useful for ensuring coverage in cases where compared values may be always ascending or descending.
+***********************************************************************************************************************************/
+#define MIN_ASSIGN(param1, param2)                                                                                                 \
+    do                                                                                                                             \
+    {                                                                                                                              \
+        if (param2 < param1)                                                                                                       \
+            param1 = param2;                                                                                                       \
+    }                                                                                                                              \
+    while (0)
+
 /***********************************************************************************************************************************
 If the "condition" (a compile-time-constant expression) evaluates to false then throw a compile error using the "message" (a string
 literal).
@@ -65,6 +65,7 @@ lstClear(List *const this)
         }
         MEM_CONTEXT_END();
 
+        this->list = NULL;
         this->pub.listSize = 0;
         this->listSizeMax = 0;
     }
@@ -7,8 +7,10 @@ Xml Handler
 
 #include <libxml/parser.h>
 #include <libxml/tree.h>
+#include <libxml/xmlreader.h>
 
 #include "common/debug.h"
+#include "common/io/io.h"
 #include "common/log.h"
 #include "common/memContext.h"
 #include "common/type/xml.h"
@@ -35,6 +37,20 @@ struct XmlDocument
     xmlDocPtr xml;
 };
 
+/***********************************************************************************************************************************
+Reader type
+***********************************************************************************************************************************/
+struct XmlReader
+{
+    IoRead *read;                                                   // Document to read
+    Buffer *buffer;                                                 // Buffer for reads requested by libxml2
+    xmlTextReaderPtr reader;                                        // libxml2 reader
+    const String *container;                                        // Child of the root node that contains the nodes to return
+    XmlNode *node;                                                  // Current node
+    const ErrorType *errorType;                                     // Type of error thrown while reading
+    String *errorMessage;                                           // Message of error thrown while reading
+};
+
 /***********************************************************************************************************************************
 Error handler
 
@@ -376,3 +392,168 @@ xmlDocumentBuf(const XmlDocument *const this)
 
     FUNCTION_TEST_RETURN(BUFFER, result);
 }
+
+/***********************************************************************************************************************************
+Free reader
+***********************************************************************************************************************************/
+static void
+xmlReaderFreeResource(THIS_VOID)
+{
+    THIS(XmlReader);
+
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(XML_READER, this);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+
+    xmlFreeTextReader(this->reader);
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Read callback for libxml2. Errors cannot be thrown through libxml2 so the error is stored and thrown again when libxml2 returns.
+***********************************************************************************************************************************/
+static int
+xmlReaderRead(void *const context, char *const buffer, const int len)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, context);
+        FUNCTION_TEST_PARAM_P(CHARDATA, buffer);
+        FUNCTION_TEST_PARAM(INT, len);
+    FUNCTION_TEST_END();
+
+    FUNCTION_AUDIT_CALLBACK();
+
+    ASSERT(context != NULL);
+    ASSERT(buffer != NULL);
+    ASSERT(len > 0);
+
+    XmlReader *const this = context;
+    int result = 0;
+
+    TRY_BEGIN()
+    {
+        size_t size = (size_t)len;
+        MIN_ASSIGN(size, bufSize(this->buffer));
+
+        bufUsedZero(this->buffer);
+        bufLimitSet(this->buffer, size);
+        ioRead(this->read, this->buffer);
+
+        memcpy(buffer, bufPtrConst(this->buffer), bufUsed(this->buffer));
+        result = (int)bufUsed(this->buffer);
+    }
+    CATCH_ANY()
+    {
+        MEM_CONTEXT_OBJ_BEGIN(this)
+        {
+            this->errorType = errorType();
+            this->errorMessage = strNewZ(errorMessage());
+        }
+        MEM_CONTEXT_OBJ_END();
+
+        result = -1;
+    }
+    TRY_END();
+
+    FUNCTION_TEST_RETURN(INT, result);
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN XmlReader *
+xmlReaderNew(IoRead *const read, const XmlReaderNewParam param)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(IO_READ, read);
+        FUNCTION_TEST_PARAM(STRING, param.container);
+    FUNCTION_TEST_END();
+
+    ASSERT(read != NULL);
+
+    xmlInit();
+
+    OBJ_NEW_BEGIN(XmlReader, .childQty = MEM_CONTEXT_QTY_MAX, .callbackQty = 1)
+    {
+        *this = (XmlReader)
+        {
+            .read = read,
+            .buffer = bufNew(ioBufferSize()),
+            .container = strDup(param.container),
+        };
+
+        this->reader = xmlReaderForIO(xmlReaderRead, NULL, this, NULL, NULL, 0);
+
+        // Set callback to ensure xml reader is freed
+        memContextCallbackSet(objMemContext(this), xmlReaderFreeResource, this);
+    }
+    OBJ_NEW_END();
+
+    FUNCTION_TEST_RETURN(XML_READER, this);
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN const XmlNode *
+xmlReaderNext(XmlReader *const this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(XML_READER, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    const XmlNode *result = NULL;
+
+    // Skip the content of the current node so it can be freed, or read the first node
+    int read = this->node == NULL ? xmlTextReaderRead(this->reader) : xmlTextReaderNext(this->reader);
+
+    while (read == 1)
+    {
+        // Expand the next element that is a child of the root node or the container. Elements at depth two are only reached inside
+        // the container since the content of other children of the root node is skipped.
+        const int depth = xmlTextReaderDepth(this->reader);
+
+        if (xmlTextReaderNodeType(this->reader) == XML_READER_TYPE_ELEMENT &&
+            ((depth == 1 &&
+              (this->container == NULL || !strEqZ(this->container, (const char *)xmlTextReaderConstLocalName(this->reader)))) ||
+             depth == 2))
+        {
+            xmlNodePtr const node = xmlTextReaderExpand(this->reader);
+
+            // Expand fails when the content of the node is not valid
+            if (node == NULL)
+            {
+                read = -1;
+                break;
+            }
+
+            if (this->node == NULL)
+            {
+                MEM_CONTEXT_OBJ_BEGIN(this)
+                {
+                    this->node = xmlNodeNew(node);
+                }
+                MEM_CONTEXT_OBJ_END();
+            }
+            else
+                this->node->node = node;
+
+            result = this->node;
+            break;
+        }
+
+        read = xmlTextReaderRead(this->reader);
+    }
+
+    // Throw the error from the read callback if there was one, else the document is invalid
+    if (read == -1)
+    {
+        if (this->errorType != NULL)
+            THROWP(this->errorType, strZ(this->errorMessage));
+
+        THROW(FormatError, "invalid xml");
+    }
+
+    FUNCTION_TEST_RETURN_CONST(XML_NODE, result);
+}
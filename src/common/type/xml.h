@@ -14,7 +14,9 @@ Objects
 typedef struct XmlDocument XmlDocument;
 typedef struct XmlNode XmlNode;
 typedef struct XmlNodeList XmlNodeList;
+typedef struct XmlReader XmlReader;
 
+#include "common/io/read.h"
 #include "common/memContext.h"
 #include "common/type/list.h"
 #include "common/type/object.h"
@@ -113,6 +115,38 @@ xmlNodeLstFree(XmlNodeList *const this)
     lstFree((List *const)this);
 }
 
+/***********************************************************************************************************************************
+Reader Constructors
+***********************************************************************************************************************************/
+// Read a document from an IoRead one child of the root node at a time. Only the current child is held in memory so large documents
+// can be processed while they are still being read. If a container is specified then the children of the container are returned in
+// place of the container, e.g. the entries of a list that is wrapped in a single child of the root node.
+typedef struct XmlReaderNewParam
+{
+    VAR_PARAM_HEADER;
+    const String *container;                                        // Child of the root node whose children should be returned
+} XmlReaderNewParam;
+
+#define xmlReaderNewP(read, ...)                                                                                                   \
+    xmlReaderNew(read, (XmlReaderNewParam){VAR_PARAM_INIT, __VA_ARGS__})
+
+FN_EXTERN XmlReader *xmlReaderNew(IoRead *read, XmlReaderNewParam param);
+
+/***********************************************************************************************************************************
+Reader Functions
+***********************************************************************************************************************************/
+// Get the next node or NULL when there are no more. The node is only valid until the next call.
+FN_EXTERN const XmlNode *xmlReaderNext(XmlReader *this);
+
+/***********************************************************************************************************************************
+Reader Destructor
+***********************************************************************************************************************************/
+FN_INLINE_ALWAYS void
+xmlReaderFree(XmlReader *const this)
+{
+    objFree(this);
+}
+
 /***********************************************************************************************************************************
 Macros for function logging
 ***********************************************************************************************************************************/
@@ -131,4 +165,9 @@ Macros for function logging
 #define FUNCTION_LOG_XML_NODE_LIST_FORMAT(value, buffer, bufferSize)                                                               \
     objNameToLog(value, "XmlNodeList", buffer, bufferSize)
 
+#define FUNCTION_LOG_XML_READER_TYPE                                                                                               \
+    XmlReader *
+#define FUNCTION_LOG_XML_READER_FORMAT(value, buffer, bufferSize)                                                                  \
+    objNameToLog(value, "XmlReader", buffer, bufferSize)
+
 #endif
@@ -47,20 +47,27 @@ Option constants
 #define CFGOPT_ARCHIVE_ASYNC                                        "archive-async"
 #define CFGOPT_ARCHIVE_CHECK                                        "archive-check"
 #define CFGOPT_ARCHIVE_COPY                                         "archive-copy"
+#define CFGOPT_ARCHIVE_GET_CACHE_MAX                                "archive-get-cache-max"
+#define CFGOPT_ARCHIVE_GET_CACHE_PATH                               "archive-get-cache-path"
 #define CFGOPT_ARCHIVE_GET_QUEUE_MAX                                "archive-get-queue-max"
+#define CFGOPT_ARCHIVE_GET_RACE                                     "archive-get-race"
 #define CFGOPT_ARCHIVE_HEADER_CHECK                                 "archive-header-check"
 #define CFGOPT_ARCHIVE_MISSING_RETRY                                "archive-missing-retry"
 #define CFGOPT_ARCHIVE_MODE                                         "archive-mode"
 #define CFGOPT_ARCHIVE_MODE_CHECK                                   "archive-mode-check"
+#define CFGOPT_ARCHIVE_PUSH_KEEP_ALIVE                              "archive-push-keep-alive"
 #define CFGOPT_ARCHIVE_PUSH_QUEUE_MAX                               "archive-push-queue-max"
+#define CFGOPT_ARCHIVE_PUSH_TRIM                                    "archive-push-trim"
 #define CFGOPT_ARCHIVE_TIMEOUT                                      "archive-timeout"
 #define CFGOPT_BACKUP_STANDBY                                       "backup-standby"
 #define CFGOPT_BETA                                                 "beta"
+#define CFGOPT_BLOCK_MAP_CACHE                                      "block-map-cache"
 #define CFGOPT_BUFFER_SIZE                                          "buffer-size"
 #define CFGOPT_CHECKSUM_PAGE                                        "checksum-page"
 #define CFGOPT_CIPHER_PASS                                          "cipher-pass"
 #define CFGOPT_CMD                                                  "cmd"
 #define CFGOPT_CMD_SSH                                              "cmd-ssh"
+#define CFGOPT_CMD_SSH_CONTROL_PATH                                 "cmd-ssh-control-path"
 #define CFGOPT_COMPRESS                                             "compress"
 #define CFGOPT_COMPRESS_LEVEL                                       "compress-level"
 #define CFGOPT_COMPRESS_LEVEL_NETWORK                               "compress-level-network"
@@ -138,8 +145,9 @@ Option constants
 #define CFGOPT_TYPE                                                 "type"
 #define CFGOPT_VERBOSE                                              "verbose"
 #define CFGOPT_VERSION                                              "version"
+#define CFGOPT_WAL_SUMMARY                                          "wal-summary"
 
-#define CFG_OPTION_TOTAL                                            184
+#define CFG_OPTION_TOTAL                                            195
 
 /***********************************************************************************************************************************
 Option value constants
@@ -396,20 +404,27 @@ typedef enum
     cfgOptArchiveAsync,
     cfgOptArchiveCheck,
     cfgOptArchiveCopy,
+    cfgOptArchiveGetCacheMax,
+    cfgOptArchiveGetCachePath,
     cfgOptArchiveGetQueueMax,
+    cfgOptArchiveGetRace,
     cfgOptArchiveHeaderCheck,
     cfgOptArchiveMissingRetry,
     cfgOptArchiveMode,
     cfgOptArchiveModeCheck,
+    cfgOptArchivePushKeepAlive,
     cfgOptArchivePushQueueMax,
+    cfgOptArchivePushTrim,
     cfgOptArchiveTimeout,
     cfgOptBackupStandby,
     cfgOptBeta,
+    cfgOptBlockMapCache,
     cfgOptBufferSize,
     cfgOptChecksumPage,
     cfgOptCipherPass,
     cfgOptCmd,
     cfgOptCmdSsh,
+    cfgOptCmdSshControlPath,
     cfgOptCompress,
     cfgOptCompressLevel,
     cfgOptCompressLevelNetwork,
@@ -485,6 +500,7 @@ typedef enum
     cfgOptRepoBlock,
     cfgOptRepoBlockAgeMap,
     cfgOptRepoBlockChecksumSizeMap,
+    cfgOptRepoBlockLsn,
     cfgOptRepoBlockSizeMap,
     cfgOptRepoBlockSizeSuper,
     cfgOptRepoBlockSizeSuperFull,
@@ -524,6 +540,7 @@ typedef enum
     cfgOptRepoS3KeySecret,
     cfgOptRepoS3KeyType,
     cfgOptRepoS3KmsKeyId,
+    cfgOptRepoS3ListMax,
     cfgOptRepoS3Region,
     cfgOptRepoS3Role,
     cfgOptRepoS3SseCustomerKey,
@@ -541,6 +558,7 @@ typedef enum
     cfgOptRepoSftpPublicKeyFile,
     cfgOptRepoStorageCaFile,
     cfgOptRepoStorageCaPath,
+    cfgOptRepoStorageDownloadMax,
     cfgOptRepoStorageHost,
     cfgOptRepoStoragePort,
     cfgOptRepoStorageTag,
@@ -576,6 +594,7 @@ typedef enum
     cfgOptType,
     cfgOptVerbose,
     cfgOptVersion,
+    cfgOptWalSummary,
 } ConfigOption;
 
 #endif
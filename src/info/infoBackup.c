@@ -833,7 +833,7 @@ infoBackupLoadFileReconstruct(
                 if (storageExistsP(storage, manifestFileName))
                 {
                     bool found = false;
-                    const Manifest *const manifest = manifestLoadFile(
+                    const Manifest *const manifest = manifestLoadFileP(
                         storage, manifestFileName, cipherType, infoPgCipherPass(infoBackupPg(infoBackup)));
                     const ManifestData *const manData = manifestData(manifest);
 
@@ -9,6 +9,7 @@ Backup Manifest Handler
 
 #include "common/crypto/cipherBlock.h"
 #include "common/debug.h"
+#include "common/encode.h"
 #include "common/log.h"
 #include "common/regExp.h"
 #include "common/type/json.h"
@@ -970,9 +971,10 @@ manifestBuildInfo(
                     FUNCTION_TEST_RETURN_VOID();
             }
 
-            // Skip the contents of archive_status when online
+            // Skip the contents of archive_status and summaries when online. WAL summaries are only useful to the cluster that
+            // generated them and PostgreSQL will recreate them as needed.
             if (buildData->online && strEq(manifestParentName, buildData->manifestWalName) &&
-                strEqZ(info->name, PG_PATH_ARCHIVE_STATUS))
+                (strEqZ(info->name, PG_PATH_ARCHIVE_STATUS) || strEqZ(info->name, PG_PATH_SUMMARIES)))
             {
                 FUNCTION_TEST_RETURN_VOID();
             }
@@ -1433,9 +1435,16 @@ manifestNewBuild(
             // Remove unlogged relations from the manifest. This can't be done during the initial build because of the requirement
             // to check for _init files which will sort after the vast majority of the relation files. We could check storage for
             // each _init file but that would be expensive.
+            //
+            // Files to keep are collected in a single pass and then copied back over the list, which is truncated at the end.
+            // Removing files one at a time moves the rest of the list on every removal, which is quadratic when there are many
+            // unlogged relations and delays the start of the backup jobs. The list is not modified until the pass is complete so
+            // _init lookups are always done against the complete, sorted list.
             // -------------------------------------------------------------------------------------------------------------------------
             RegExp *relationExp = regExpNew(strNewFmt("^" DB_PATH_EXP "/" RELATION_EXP "$", strZ(buildData.tablespaceId)));
-            unsigned int fileIdx = 0;
+            const unsigned int fileTotal = manifestFileTotal(this);
+            ManifestFilePack **const fileKeepList = memNewPtrArray(fileTotal);
+            unsigned int fileKeepTotal = 0;
             char lastRelationFileId[21] = "";                   // Large enough for a 64-bit unsigned integer
             bool lastRelationFileIdUnlogged = false;
 
@@ -1444,7 +1453,7 @@ manifestNewBuild(
             const size_t sizeBegin = memContextSize(memContextCurrent());
 #endif
 
-            while (fileIdx < manifestFileTotal(this))
+            for (unsigned int fileIdx = 0; fileIdx < fileTotal; fileIdx++)
             {
                 // If this file looks like a relation. Note that this never matches on _init forks.
                 const String *const filePathName = manifestFileNameGet(this, fileIdx);
@@ -1485,21 +1494,29 @@ manifestNewBuild(
                         strcpy(lastRelationFileId, relationFileId);
                     }
 
-                    // If relation is unlogged then remove it
+                    // If relation is unlogged then skip it so it will be removed
                     if (lastRelationFileIdUnlogged)
-                    {
-                        manifestFileRemove(this, filePathName);
                         continue;
-                    }
                 }
 
-                fileIdx++;
+                // Keep the file
+                fileKeepList[fileKeepTotal] = *(ManifestFilePack **)lstGet(this->pub.fileList, fileIdx);
+                fileKeepTotal++;
             }
 
+            // Copy kept files over the list and remove files left over at the end
+            for (unsigned int fileIdx = 0; fileIdx < fileKeepTotal; fileIdx++)
+                *(ManifestFilePack **)lstGet(this->pub.fileList, fileIdx) = fileKeepList[fileIdx];
+
+            while (manifestFileTotal(this) > fileKeepTotal)
+                lstRemoveLast(this->pub.fileList);
+
 #ifdef DEBUG_MEM
             // Make sure that the temp context did not grow too much during the loop
             ASSERT(memContextSize(memContextCurrent()) - sizeBegin < 256);
 #endif
+
+            memFree(fileKeepList);
         }
         MEM_CONTEXT_TEMP_END();
     }
@@ -1938,6 +1955,7 @@ typedef struct ManifestLoadData
 {
     MemContext *memContext;                                         // Mem context for data needed only during load
     Manifest *manifest;                                             // Manifest info
+    bool fileSkip;                                                  // Skip the file list?
     bool referenceListFound;                                        // Was a reference list found?
 
     List *linkFoundList;                                            // Values found in links
@@ -1993,6 +2011,24 @@ manifestOwnerDefaultGet(const Variant *const ownerDefault)
     FUNCTION_TEST_RETURN_CONST(VARIANT, varDup(ownerDefault));
 }
 
+// Helper to decode a hex checksum into a buffer provided by the caller. This avoids allocating a buffer for every checksum loaded.
+static const uint8_t *
+manifestChecksumDecode(const String *const checksum, uint8_t *const buffer)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRING, checksum);
+        FUNCTION_TEST_PARAM_P(UCHARDATA, buffer);
+    FUNCTION_TEST_END();
+
+    ASSERT(checksum != NULL);
+    ASSERT(buffer != NULL);
+
+    CHECK_FMT(FormatError, strSize(checksum) == HASH_TYPE_SHA1_SIZE_HEX, "invalid checksum '%s'", strZ(checksum));
+    decodeToBin(encodingHex, strZ(checksum), buffer);
+
+    FUNCTION_TEST_RETURN_TYPE_P(uint8_t, buffer);
+}
+
 static void
 manifestLoadCallback(void *const callbackData, const String *const section, const String *const key, const String *const value)
 {
@@ -2012,10 +2048,16 @@ manifestLoadCallback(void *const callbackData, const String *const section, cons
     ManifestLoadData *const loadData = (ManifestLoadData *)callbackData;
     Manifest *const manifest = loadData->manifest;
 
+    // Skip the file list when not required. Parsing the file list is by far the most expensive part of the load.
+    if (loadData->fileSkip && strEqZ(section, MANIFEST_SECTION_TARGET_FILE))
+        FUNCTION_TEST_RETURN_VOID();
+
     // -----------------------------------------------------------------------------------------------------------------------------
     if (strEqZ(section, MANIFEST_SECTION_TARGET_FILE))
     {
         ManifestFile file = {.name = key};
+        uint8_t checksumSha1[HASH_TYPE_SHA1_SIZE];
+        uint8_t checksumRepoSha1[HASH_TYPE_SHA1_SIZE];
 
         JsonRead *const json = jsonReadNew(value);
         jsonReadObjectBegin(json);
@@ -2046,7 +2088,7 @@ manifestLoadCallback(void *const callbackData, const String *const section, cons
         // The checksum might not exist if this is a partial save that was done during the backup to preserve checksums for already
         // backed up files
         if (jsonReadKeyExpectStrId(json, MANIFEST_KEY_CHECKSUM))
-            file.checksumSha1 = bufPtr(bufNewDecode(encodingHex, jsonReadStr(json)));
+            file.checksumSha1 = manifestChecksumDecode(jsonReadStr(json), checksumSha1);
 
         // Page checksum errors
         if (jsonReadKeyExpectZ(json, MANIFEST_KEY_CHECKSUM_PAGE))
@@ -2073,7 +2115,7 @@ manifestLoadCallback(void *const callbackData, const String *const section, cons
         // The repo checksum might not exist if this is a partial save that was done during the backup to preserve checksums for
         // already backed up files or if this is an older manifest
         if (jsonReadKeyExpectStrId(json, MANIFEST_KEY_CHECKSUM_REPO))
-            file.checksumRepoSha1 = bufPtr(bufNewDecode(encodingHex, jsonReadStr(json)));
+            file.checksumRepoSha1 = manifestChecksumDecode(jsonReadStr(json), checksumRepoSha1);
 
         // Reference
         if (jsonReadKeyExpectStrId(json, MANIFEST_KEY_REFERENCE))
@@ -2384,10 +2426,11 @@ manifestLoadCallback(void *const callbackData, const String *const section, cons
 }
 
 FN_EXTERN Manifest *
-manifestNewLoad(IoRead *const read)
+manifestNewLoad(IoRead *const read, const ManifestNewLoadParam param)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(IO_READ, read);
+        FUNCTION_LOG_PARAM(BOOL, param.fileSkip);
     FUNCTION_LOG_END();
 
     ASSERT(read != NULL);
@@ -2403,6 +2446,7 @@ manifestNewLoad(IoRead *const read)
         {
             .memContext = memContextNewP("load", .childQty = MEM_CONTEXT_QTY_MAX),
             .manifest = this,
+            .fileSkip = param.fileSkip,
         };
 
         // Set file defaults that will be updated when we know what the real defaults are. These need to be set to values that are
@@ -2500,6 +2544,24 @@ manifestOwnerVar(const String *const ownerDefault)
     FUNCTION_TEST_RETURN_CONST(VARIANT, ownerDefault == NULL ? BOOL_FALSE_VAR : varNewStr(ownerDefault));
 }
 
+// Helper to check if an owner is equal to the default without creating a variant for the owner
+static bool
+manifestOwnerDefaultEq(const String *const owner, const Variant *const ownerDefault)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRING, owner);
+        FUNCTION_TEST_PARAM(VARIANT, ownerDefault);
+    FUNCTION_TEST_END();
+
+    ASSERT(ownerDefault != NULL);
+
+    // A NULL owner is represented by boolean false
+    if (owner == NULL)
+        FUNCTION_TEST_RETURN(BOOL, varType(ownerDefault) == varTypeBool);
+
+    FUNCTION_TEST_RETURN(BOOL, varType(ownerDefault) == varTypeString && strEq(owner, varStr(ownerDefault)));
+}
+
 static void
 manifestSaveCallback(void *const callbackData, const String *const sectionNext, InfoSave *const infoSaveData)
 {
@@ -2792,9 +2854,10 @@ manifestSaveCallback(void *const callbackData, const String *const sectionNext,
                 // performed during a backup.
                 if (file.size != 0 && file.checksumSha1 != NULL)
                 {
-                    jsonWriteStr(
-                        jsonWriteKeyStrId(json, MANIFEST_KEY_CHECKSUM),
-                        strNewEncode(encodingHex, BUF(file.checksumSha1, HASH_TYPE_SHA1_SIZE)));
+                    char checksum[HASH_TYPE_SHA1_SIZE_HEX + 1];
+
+                    encodeToStr(encodingHex, file.checksumSha1, HASH_TYPE_SHA1_SIZE, checksum);
+                    jsonWriteZ(jsonWriteKeyStrId(json, MANIFEST_KEY_CHECKSUM), checksum);
                 }
 
                 if (file.checksumPage)
@@ -2805,7 +2868,7 @@ manifestSaveCallback(void *const callbackData, const String *const sectionNext,
                         jsonWriteJson(jsonWriteKeyZ(json, MANIFEST_KEY_CHECKSUM_PAGE_ERROR), file.checksumPageErrorList);
                 }
 
-                if (!varEq(manifestOwnerVar(file.group), saveData->groupDefault))
+                if (!manifestOwnerDefaultEq(file.group, saveData->groupDefault))
                     jsonWriteVar(jsonWriteKeyZ(json, MANIFEST_KEY_GROUP), manifestOwnerVar(file.group));
 
                 if (file.mode != saveData->fileModeDefault)
@@ -2815,9 +2878,10 @@ manifestSaveCallback(void *const callbackData, const String *const sectionNext,
                 // and encryption applied.
                 if (file.checksumRepoSha1 != NULL)
                 {
-                    jsonWriteStr(
-                        jsonWriteKeyStrId(json, MANIFEST_KEY_CHECKSUM_REPO),
-                        strNewEncode(encodingHex, BUF(file.checksumRepoSha1, HASH_TYPE_SHA1_SIZE)));
+                    char checksumRepo[HASH_TYPE_SHA1_SIZE_HEX + 1];
+
+                    encodeToStr(encodingHex, file.checksumRepoSha1, HASH_TYPE_SHA1_SIZE, checksumRepo);
+                    jsonWriteZ(jsonWriteKeyStrId(json, MANIFEST_KEY_CHECKSUM_REPO), checksumRepo);
                 }
 
                 if (file.reference != NULL)
@@ -2833,7 +2897,7 @@ manifestSaveCallback(void *const callbackData, const String *const sectionNext,
 
                 jsonWriteUInt64(jsonWriteKeyStrId(json, MANIFEST_KEY_TIMESTAMP), (uint64_t)file.timestamp);
 
-                if (!varEq(manifestOwnerVar(file.user), saveData->userDefault))
+                if (!manifestOwnerDefaultEq(file.user, saveData->userDefault))
                     jsonWriteVar(jsonWriteKeyZ(json, MANIFEST_KEY_USER), manifestOwnerVar(file.user));
 
                 infoSaveValue(
@@ -2867,10 +2931,10 @@ manifestSaveCallback(void *const callbackData, const String *const sectionNext,
 
                 jsonWriteStr(jsonWriteKeyStrId(json, MANIFEST_KEY_DESTINATION), link->destination);
 
-                if (!varEq(manifestOwnerVar(link->group), saveData->groupDefault))
+                if (!manifestOwnerDefaultEq(link->group, saveData->groupDefault))
                     jsonWriteVar(jsonWriteKeyZ(json, MANIFEST_KEY_GROUP), manifestOwnerVar(link->group));
 
-                if (!varEq(manifestOwnerVar(link->user), saveData->userDefault))
+                if (!manifestOwnerDefaultEq(link->user, saveData->userDefault))
                     jsonWriteVar(jsonWriteKeyZ(json, MANIFEST_KEY_USER), manifestOwnerVar(link->user));
 
                 infoSaveValue(
@@ -2904,13 +2968,13 @@ manifestSaveCallback(void *const callbackData, const String *const sectionNext,
                 const ManifestPath *const path = manifestPath(manifest, pathIdx);
                 JsonWrite *const json = jsonWriteObjectBegin(jsonWriteNewP());
 
-                if (!varEq(manifestOwnerVar(path->group), saveData->groupDefault))
+                if (!manifestOwnerDefaultEq(path->group, saveData->groupDefault))
                     jsonWriteVar(jsonWriteKeyZ(json, MANIFEST_KEY_GROUP), manifestOwnerVar(path->group));
 
                 if (path->mode != saveData->pathModeDefault)
                     jsonWriteStrFmt(jsonWriteKeyZ(json, MANIFEST_KEY_MODE), "%04o", path->mode);
 
-                if (!varEq(manifestOwnerVar(path->user), saveData->userDefault))
+                if (!manifestOwnerDefaultEq(path->user, saveData->userDefault))
                     jsonWriteVar(jsonWriteKeyZ(json, MANIFEST_KEY_USER), manifestOwnerVar(path->user));
 
                 infoSaveValue(
@@ -3349,6 +3413,7 @@ typedef struct ManifestLoadFileData
     const String *fileName;                                         // Base filename
     CipherType cipherType;                                          // Cipher type
     const String *cipherPass;                                       // Cipher passphrase
+    bool fileSkip;                                                  // Skip the file list?
     Manifest *manifest;                                             // Loaded manifest object
 } ManifestLoadFileData;
 
@@ -3378,7 +3443,7 @@ manifestLoadFileCallback(void *const data, const unsigned int try)
 
             MEM_CONTEXT_BEGIN(loadData->memContext)
             {
-                loadData->manifest = manifestNewLoad(read);
+                loadData->manifest = manifestNewLoadP(read, .fileSkip = loadData->fileSkip);
                 result = true;
             }
             MEM_CONTEXT_END();
@@ -3391,13 +3456,15 @@ manifestLoadFileCallback(void *const data, const unsigned int try)
 
 FN_EXTERN Manifest *
 manifestLoadFile(
-    const Storage *const storage, const String *const fileName, const CipherType cipherType, const String *const cipherPass)
+    const Storage *const storage, const String *const fileName, const CipherType cipherType, const String *const cipherPass,
+    const ManifestLoadFileParam param)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(STORAGE, storage);
         FUNCTION_LOG_PARAM(STRING, fileName);
         FUNCTION_LOG_PARAM(STRING_ID, cipherType);
         FUNCTION_TEST_PARAM(STRING, cipherPass);
+        FUNCTION_LOG_PARAM(BOOL, param.fileSkip);
     FUNCTION_LOG_END();
 
     ASSERT(storage != NULL);
@@ -3411,6 +3478,7 @@ manifestLoadFile(
         .fileName = fileName,
         .cipherType = cipherType,
         .cipherPass = cipherPass,
+        .fileSkip = param.fileSkip,
     };
 
     MEM_CONTEXT_TEMP_BEGIN()
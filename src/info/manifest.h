@@ -221,7 +221,16 @@ FN_EXTERN Manifest *manifestNewBuild(
     const Pack *tablespaceList);
 
 // Load a manifest from IO
-FN_EXTERN Manifest *manifestNewLoad(IoRead *read);
+typedef struct ManifestNewLoadParam
+{
+    VAR_PARAM_HEADER;
+    bool fileSkip;                                                  // Skip the file list when only other sections are needed
+} ManifestNewLoadParam;
+
+#define manifestNewLoadP(read, ...)                                                                                                \
+    manifestNewLoad(read, (ManifestNewLoadParam){VAR_PARAM_INIT, __VA_ARGS__})
+
+FN_EXTERN Manifest *manifestNewLoad(IoRead *read, ManifestNewLoadParam param);
 
 /***********************************************************************************************************************************
 Getters/Setters
@@ -500,8 +509,17 @@ manifestFree(Manifest *const this)
 Helper functions
 ***********************************************************************************************************************************/
 // Load backup manifest
+typedef struct ManifestLoadFileParam
+{
+    VAR_PARAM_HEADER;
+    bool fileSkip;                                                  // Skip the file list when only other sections are needed
+} ManifestLoadFileParam;
+
+#define manifestLoadFileP(storage, fileName, cipherType, cipherPass, ...)                                                          \
+    manifestLoadFile(storage, fileName, cipherType, cipherPass, (ManifestLoadFileParam){VAR_PARAM_INIT, __VA_ARGS__})
+
 FN_EXTERN Manifest *manifestLoadFile(
-    const Storage *storage, const String *fileName, CipherType cipherType, const String *cipherPass);
+    const Storage *storage, const String *fileName, CipherType cipherType, const String *cipherPass, ManifestLoadFileParam param);
 
 /***********************************************************************************************************************************
 Macros for function logging
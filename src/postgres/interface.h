@@ -52,6 +52,7 @@ STRING_DECLARE(PG_PATH_GLOBAL_STR);
 #define PG_PATH_PGSTATTMP                                           "pg_stat_tmp"
 #define PG_PATH_PGSUBTRANS                                          "pg_subtrans"
 #define PG_PATH_PGTBLSPC                                            "pg_tblspc"
+#define PG_PATH_SUMMARIES                                           "summaries"
 
 #define PG_PREFIX_PGSQLTMP                                          "pgsql_tmp"
 
@@ -104,6 +105,7 @@ typedef struct PgControl
     uint32_t timeline;                                              // Current timeline
 
     PgPageSize pageSize;
+    unsigned int segmentPageTotal;                                  // Pages per relation segment
     unsigned int walSegmentSize;
 
     unsigned int pageChecksumVersion;                               // Page checksum version (0 if no checksum, 1 if checksum)
@@ -29,4 +29,7 @@ Version where various PostgreSQL capabilities were introduced
 // recovery settings are implemented as GUCs (recovery.conf is no longer valid)
 #define PG_VERSION_RECOVERY_GUC                                     PG_VERSION_12
 
+// WAL summaries are generated in pg_wal/summaries (when summarize_wal is enabled)
+#define PG_VERSION_WAL_SUMMARY                                      PG_VERSION_17
+
 #endif
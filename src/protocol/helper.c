@@ -22,6 +22,7 @@ Protocol Helper
 #include "config/protocol.h"
 #include "postgres/version.h"
 #include "protocol/helper.h"
+#include "storage/posix/storage.h"
 #include "version.h"
 
 /***********************************************************************************************************************************
@@ -30,6 +31,9 @@ Constants
 STRING_EXTERN(PROTOCOL_SERVICE_LOCAL_STR,                           PROTOCOL_SERVICE_LOCAL);
 STRING_EXTERN(PROTOCOL_SERVICE_REMOTE_STR,                          PROTOCOL_SERVICE_REMOTE);
 
+// Seconds an SSH master connection stays open in the background after the last session using it has closed
+#define PROTOCOL_SSH_CONTROL_PERSIST                                "60"
+
 /***********************************************************************************************************************************
 Local variables
 ***********************************************************************************************************************************/
@@ -649,6 +653,26 @@ protocolRemoteParamSsh(const ProtocolStorageType protocolStorageType, const unsi
         strLstAddZ(result, "-o");
         strLstAddZ(result, "PasswordAuthentication=no");
 
+        // Multiplex sessions to the same host over a single connection when a control path is set. The first session starts a
+        // master connection in the background and later sessions (e.g. from local processes) open channels on the master
+        // connection rather than performing a new handshake. The master is not tied to the first session so it is not closed while
+        // other sessions are still using it, and it stays open for a time after the last session closes so the next command to
+        // the host can reuse it. %C is expanded by ssh to a hash of the connection parameters so each host gets a short, unique
+        // socket.
+        if (cfgOptionTest(cfgOptCmdSshControlPath))
+        {
+            const String *const controlPath = cfgOptionStr(cfgOptCmdSshControlPath);
+
+            storagePathCreateP(storagePosixNewP(FSLASH_STR, .write = true), controlPath);
+
+            strLstAddZ(result, "-o");
+            strLstAddZ(result, "ControlMaster=auto");
+            strLstAddZ(result, "-o");
+            strLstAddFmt(result, "ControlPath=%s/%%C", strZ(controlPath));
+            strLstAddZ(result, "-o");
+            strLstAddZ(result, "ControlPersist=" PROTOCOL_SSH_CONTROL_PERSIST);
+        }
+
         // Append port if specified
         const ConfigOption optHostPort = isRepo ? cfgOptRepoHostPort : cfgOptPgHostPort;
 
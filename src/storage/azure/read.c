@@ -5,6 +5,7 @@ Azure Storage Read
 
 #include "common/debug.h"
 #include "common/io/http/client.h"
+#include "common/io/http/rangeRead.h"
 #include "common/log.h"
 #include "common/type/object.h"
 #include "storage/azure/read.h"
@@ -22,8 +23,11 @@ typedef struct StorageReadAzure
 {
     StorageReadInterface interface;                                 // Interface
     StorageAzure *storage;                                          // Storage that created this object
+    uint64_t rangeSize;                                             // Size of each range when reading concurrently
+    unsigned int rangeMax;                                          // Maximum ranges in progress (1 reads with a single request)
 
     HttpResponse *httpResponse;                                     // HTTP response
+    HttpRangeRead *rangeRead;                                       // Ranged reads in progress
 } StorageReadAzure;
 
 /***********************************************************************************************************************************
@@ -34,6 +38,49 @@ Macros for function logging
 #define FUNCTION_LOG_STORAGE_READ_AZURE_FORMAT(value, buffer, bufferSize)                                                          \
     objNameToLog(value, "StorageReadAzure", buffer, bufferSize)
 
+/***********************************************************************************************************************************
+Start a ranged request
+***********************************************************************************************************************************/
+static HttpRequest *
+storageReadAzureRangeRequest(void *const data, const uint64_t offset, const uint64_t size, const HttpHeader *const responseHeader)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, data);
+        FUNCTION_TEST_PARAM(UINT64, offset);
+        FUNCTION_TEST_PARAM(UINT64, size);
+        FUNCTION_TEST_PARAM(HTTP_HEADER, responseHeader);
+    FUNCTION_TEST_END();
+
+    ASSERT(data != NULL);
+
+    StorageReadAzure *const this = data;
+    HttpRequest *result = NULL;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        HttpHeader *const header = httpHeaderPutRange(httpHeaderNew(NULL), offset, VARUINT64(size));
+
+        // Error if the object has changed since the first range was requested
+        const String *const etag = responseHeader == NULL ? NULL : httpHeaderGet(responseHeader, HTTP_HEADER_ETAG_STR);
+
+        if (etag != NULL)
+            httpHeaderAdd(header, HTTP_HEADER_IF_MATCH_STR, etag);
+
+        const HttpQuery *const query =
+            this->interface.version ? httpQueryPut(httpQueryNewP(), AZURE_QUERY_VERSION_ID_STR, this->interface.versionId) : NULL;
+
+        MEM_CONTEXT_PRIOR_BEGIN()
+        {
+            result = storageAzureRequestAsyncP(
+                this->storage, HTTP_VERB_GET_STR, .path = this->interface.name, .query = query, .header = header);
+        }
+        MEM_CONTEXT_PRIOR_END();
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_TEST_RETURN(HTTP_REQUEST, result);
+}
+
 /***********************************************************************************************************************************
 Open the file
 ***********************************************************************************************************************************/
@@ -47,32 +94,46 @@ storageReadAzureOpen(THIS_VOID)
     FUNCTION_LOG_END();
 
     ASSERT(this != NULL);
-    ASSERT(this->httpResponse == NULL);
+    ASSERT(this->httpResponse == NULL && this->rangeRead == NULL);
 
     bool result = false;
 
     // Read if not versioned or if versionId is not null
     if (!this->interface.version || this->interface.versionId != NULL)
     {
-        // Request the file
-        MEM_CONTEXT_OBJ_BEGIN(this)
+        // Request the file in ranges that are read concurrently
+        if (this->rangeMax > 1)
         {
-            this->httpResponse = storageAzureRequestP(
-                this->storage, HTTP_VERB_GET_STR, .path = this->interface.name,
-                .query =
-                    this->interface.version ?
-                        httpQueryPut(httpQueryNewP(), AZURE_QUERY_VERSION_ID_STR, this->interface.versionId) : NULL,
-                .header = httpHeaderPutRange(httpHeaderNew(NULL), this->interface.offset, this->interface.limit),
-                .allowMissing = true, .contentIo = true);
-        }
-        MEM_CONTEXT_OBJ_END();
+            MEM_CONTEXT_OBJ_BEGIN(this)
+            {
+                this->rangeRead = httpRangeReadNew(
+                    storageReadAzureRangeRequest, this, this->interface.offset, this->interface.limit, this->rangeSize,
+                    this->rangeMax);
+            }
+            MEM_CONTEXT_OBJ_END();
 
-        if (httpResponseCodeOk(this->httpResponse))
+            result = httpRangeReadOpen(this->rangeRead);
+        }
+        // Else request the file with a single request
+        else
         {
-            result = true;
+            MEM_CONTEXT_OBJ_BEGIN(this)
+            {
+                this->httpResponse = storageAzureRequestP(
+                    this->storage, HTTP_VERB_GET_STR, .path = this->interface.name,
+                    .query =
+                        this->interface.version ?
+                            httpQueryPut(httpQueryNewP(), AZURE_QUERY_VERSION_ID_STR, this->interface.versionId) : NULL,
+                    .header = httpHeaderPutRange(httpHeaderNew(NULL), this->interface.offset, this->interface.limit),
+                    .allowMissing = true, .contentIo = true);
+            }
+            MEM_CONTEXT_OBJ_END();
+
+            result = httpResponseCodeOk(this->httpResponse);
         }
-        // Else error unless ignore missing
-        else if (!this->interface.ignoreMissing)
+
+        // Error unless ignore missing
+        if (!result && !this->interface.ignoreMissing)
             THROW_FMT(FileMissingError, STORAGE_ERROR_READ_MISSING, strZ(this->interface.name));
     }
 
@@ -93,11 +154,13 @@ storageReadAzure(THIS_VOID, Buffer *const buffer, const bool block)
         FUNCTION_LOG_PARAM(BOOL, block);
     FUNCTION_LOG_END();
 
-    ASSERT(this != NULL && this->httpResponse != NULL);
-    ASSERT(httpResponseIoRead(this->httpResponse) != NULL);
+    ASSERT(this != NULL && (this->httpResponse != NULL || this->rangeRead != NULL));
     ASSERT(buffer != NULL && !bufFull(buffer));
 
-    FUNCTION_LOG_RETURN(SIZE, ioRead(httpResponseIoRead(this->httpResponse), buffer));
+    FUNCTION_LOG_RETURN(
+        SIZE,
+        this->rangeRead != NULL ?
+            httpRangeReadContent(this->rangeRead, buffer) : ioRead(httpResponseIoRead(this->httpResponse), buffer));
 }
 
 /***********************************************************************************************************************************
@@ -112,17 +175,18 @@ storageReadAzureEof(THIS_VOID)
         FUNCTION_TEST_PARAM(STORAGE_READ_AZURE, this);
     FUNCTION_TEST_END();
 
-    ASSERT(this != NULL && this->httpResponse != NULL);
-    ASSERT(httpResponseIoRead(this->httpResponse) != NULL);
+    ASSERT(this != NULL && (this->httpResponse != NULL || this->rangeRead != NULL));
 
-    FUNCTION_TEST_RETURN(BOOL, ioReadEof(httpResponseIoRead(this->httpResponse)));
+    FUNCTION_TEST_RETURN(
+        BOOL, this->rangeRead != NULL ? httpRangeReadEof(this->rangeRead) : ioReadEof(httpResponseIoRead(this->httpResponse)));
 }
 
 /**********************************************************************************************************************************/
 FN_EXTERN StorageRead *
 storageReadAzureNew(
     StorageAzure *const storage, const String *const name, const bool ignoreMissing, const uint64_t offset,
-    const Variant *const limit, const bool version, const String *const versionId)
+    const Variant *const limit, const bool version, const String *const versionId, const uint64_t rangeSize,
+    const unsigned int rangeMax)
 {
     FUNCTION_LOG_BEGIN(logLevelTrace);
         FUNCTION_LOG_PARAM(STORAGE_AZURE, storage);
@@ -132,16 +196,22 @@ storageReadAzureNew(
         FUNCTION_LOG_PARAM(VARIANT, limit);
         FUNCTION_LOG_PARAM(BOOL, version);
         FUNCTION_LOG_PARAM(STRING, versionId);
+        FUNCTION_LOG_PARAM(UINT64, rangeSize);
+        FUNCTION_LOG_PARAM(UINT, rangeMax);
     FUNCTION_LOG_END();
 
     ASSERT(storage != NULL);
     ASSERT(name != NULL);
+    ASSERT(rangeSize > 0);
+    ASSERT(rangeMax > 0);
 
     OBJ_NEW_BEGIN(StorageReadAzure, .childQty = MEM_CONTEXT_QTY_MAX)
     {
         *this = (StorageReadAzure)
         {
             .storage = storage,
+            .rangeSize = rangeSize,
+            .rangeMax = rangeMax,
 
             .interface = (StorageReadInterface)
             {
@@ -12,6 +12,6 @@ Constructors
 ***********************************************************************************************************************************/
 FN_EXTERN StorageRead *storageReadAzureNew(
     StorageAzure *storage, const String *name, bool ignoreMissing, uint64_t offset, const Variant *limit, bool version,
-    const String *versionId);
+    const String *versionId, uint64_t rangeSize, unsigned int rangeMax);
 
 #endif
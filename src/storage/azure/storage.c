@@ -10,6 +10,7 @@ Azure Storage
 #include "common/debug.h"
 #include "common/io/http/client.h"
 #include "common/io/http/common.h"
+#include "common/io/http/rangeRead.h"
 #include "common/io/socket/client.h"
 #include "common/io/tls/client.h"
 #include "common/log.h"
@@ -70,6 +71,8 @@ struct StorageAzure
     const HttpQuery *sasKey;                                        // SAS key
     const String *host;                                             // Host name
     size_t blockSize;                                               // Block size for multi-block upload
+    unsigned int downloadMax;                                       // Maximum ranges downloading concurrently
+    uint64_t downloadSize;                                          // Size of each range when downloading concurrently
     const String *tag;                                              // Tags to be applied to objects
     const String *pathPrefix;                                       // Account/container prefix
 
@@ -147,6 +150,7 @@ storageAzureAuth(
             // Generate string to sign
             const String *const contentLength = httpHeaderGet(httpHeader, HTTP_HEADER_CONTENT_LENGTH_STR);
             const String *const contentMd5 = httpHeaderGet(httpHeader, HTTP_HEADER_CONTENT_MD5_STR);
+            const String *const ifMatch = httpHeaderGet(httpHeader, HTTP_HEADER_IF_MATCH_STR);
             const String *const range = httpHeaderGet(httpHeader, HTTP_HEADER_RANGE_STR);
 
             const String *const stringToSign = strNewFmt(
@@ -158,7 +162,7 @@ storageAzureAuth(
                 "\n"                                                    // content-type
                 "%s\n"                                                  // date
                 "\n"                                                    // If-Modified-Since
-                "\n"                                                    // If-Match
+                "%s\n"                                                  // If-Match
                 "\n"                                                    // If-None-Match
                 "\n"                                                    // If-Unmodified-Since
                 "%s\n"                                                  // range
@@ -166,8 +170,8 @@ storageAzureAuth(
                 "/%s%s"                                                 // Canonicalized account/path
                 "%s",                                                   // Canonicalized query
                 strZ(verb), strEq(contentLength, ZERO_STR) ? "" : strZ(contentLength), contentMd5 == NULL ? "" : strZ(contentMd5),
-                strZ(dateTime), range == NULL ? "" : strZ(range), strZ(headerCanonical), strZ(this->account), strZ(path),
-                strZ(queryCanonical));
+                strZ(dateTime), ifMatch == NULL ? "" : strZ(ifMatch), range == NULL ? "" : strZ(range), strZ(headerCanonical),
+                strZ(this->account), strZ(path), strZ(queryCanonical));
 
             // Generate authorization header
             httpHeaderPut(
@@ -401,120 +405,120 @@ storageAzureListInternal(
                 // If there is an outstanding async request then wait for the response
                 if (request != NULL)
                 {
-                    response = storageAzureResponseP(request);
+                    response = storageAzureResponseP(request, .contentIo = true);
 
                     httpRequestFree(request);
                     request = NULL;
                 }
                 // Else get the response immediately from a sync request
                 else
-                    response = storageAzureRequestP(this, HTTP_VERB_GET_STR, .query = query);
+                    response = storageAzureRequestP(this, HTTP_VERB_GET_STR, .query = query, .contentIo = true);
 
-                const XmlNode *const xmlRoot = xmlDocumentRoot(xmlDocumentNewBuf(httpResponseContent(response)));
+                // Process blobs as the response is read so the entire page does not need to be held in memory. The continuation
+                // marker follows the blobs in the response so the next request cannot be sent until the page has been processed.
+                XmlReader *const reader = xmlReaderNewP(httpResponseIoRead(response), .container = AZURE_XML_TAG_BLOBS_STR);
+                const String *continuationMarker = EMPTY_STR;
+                const XmlNode *node;
 
-                // If a continuation marker exists then send an async request to get more data
-                const String *const continuationMarker = xmlNodeContent(
-                    xmlNodeChild(xmlRoot, AZURE_XML_TAG_NEXT_MARKER_STR, false));
-
-                if (!strEq(continuationMarker, EMPTY_STR))
+                while ((node = xmlReaderNext(reader)) != NULL)
                 {
-                    httpQueryPut(query, AZURE_QUERY_MARKER_STR, continuationMarker);
+                    const String *const nodeName = xmlNodeName(node);
 
-                    // Store request in the outer temp context
-                    MEM_CONTEXT_PRIOR_BEGIN()
+                    // Get continuation marker
+                    if (strEq(nodeName, AZURE_XML_TAG_NEXT_MARKER_STR))
+                        continuationMarker = xmlNodeContent(node);
+                    // Else get path
+                    else if (strEq(nodeName, AZURE_XML_TAG_BLOB_PREFIX_STR))
                     {
-                        request = storageAzureRequestAsyncP(this, HTTP_VERB_GET_STR, .query = query);
-                    }
-                    MEM_CONTEXT_PRIOR_END();
-                }
-
-                // Get prefix list
-                const XmlNode *const blobs = xmlNodeChild(xmlRoot, AZURE_XML_TAG_BLOBS_STR, true);
-                const XmlNodeList *const blobPrefixList = xmlNodeChildList(blobs, AZURE_XML_TAG_BLOB_PREFIX_STR);
-
-                for (unsigned int blobPrefixIdx = 0; blobPrefixIdx < xmlNodeLstSize(blobPrefixList); blobPrefixIdx++)
-                {
-                    const XmlNode *const subPathNode = xmlNodeLstGet(blobPrefixList, blobPrefixIdx);
-
-                    // Get path name
-                    StorageInfo info =
-                    {
-                        .level = level,
-                        .name = xmlNodeContent(xmlNodeChild(subPathNode, AZURE_XML_TAG_NAME_STR, true)),
-                        .exists = true,
-                    };
-
-                    // Strip off base prefix and final /
-                    info.name = strSubN(info.name, strSize(basePrefix), strSize(info.name) - strSize(basePrefix) - 1);
-
-                    // Add type info if requested
-                    if (level >= storageInfoLevelType)
-                        info.type = storageTypePath;
-
-                    // Callback with info
-                    callback(callbackData, &info);
-                }
-
-                // Get file list
-                const XmlNodeList *const fileList = xmlNodeChildList(blobs, AZURE_XML_TAG_BLOB_STR);
-
-                for (unsigned int fileIdx = 0; fileIdx < xmlNodeLstSize(fileList); fileIdx++)
-                {
-                    const XmlNode *const fileNode = xmlNodeLstGet(fileList, fileIdx);
-                    const XmlNode *const property = xmlNodeChild(fileNode, AZURE_XML_TAG_PROPERTIES_STR, true);
+                        // Get path name
+                        StorageInfo info =
+                        {
+                            .level = level,
+                            .name = xmlNodeContent(xmlNodeChild(node, AZURE_XML_TAG_NAME_STR, true)),
+                            .exists = true,
+                        };
 
-                    // Get file name and strip off the base prefix when present
-                    const String *name = xmlNodeContent(xmlNodeChild(fileNode, AZURE_XML_TAG_NAME_STR, true));
+                        // Strip off base prefix and final /
+                        info.name = strSubN(info.name, strSize(basePrefix), strSize(info.name) - strSize(basePrefix) - 1);
 
-                    if (!strEmpty(basePrefix))
-                        name = strSub(name, strSize(basePrefix));
+                        // Add type info if requested
+                        if (level >= storageInfoLevelType)
+                            info.type = storageTypePath;
 
-                    // Return info for last file if new file
-                    if (infoLast.exists && !strEq(name, nameLast))
-                    {
-                        callback(callbackData, &infoLast);
-                        infoLast.exists = false;
+                        // Callback with info
+                        callback(callbackData, &info);
                     }
-
-                    // If targeting by time exclude versions that are newer than targetTime. Note that the API does not provide
-                    // reliable delete markers so the filtering will also show files that have been deleted rather than replaced
-                    // with a new version. The problem with the delete markers is that Creation-Time/Last-Modified are set equal to
-                    // the times in the last version so we don't know when the file was deleted. It might be possible to use
-                    // VersionId for this purpose, since it appears to be a timestamp, but the field is described as "opaque" in the
-                    // documentation so it does not seem to be a good idea to use it.
-                    if (targetTime != 0)
+                    // Else get file
+                    else if (strEq(nodeName, AZURE_XML_TAG_BLOB_STR))
                     {
-                        infoLast.timeModified = httpDateToTime(
-                            xmlNodeContent(xmlNodeChild(property, AZURE_XML_TAG_LAST_MODIFIED_STR, true)));
+                        const XmlNode *const property = xmlNodeChild(node, AZURE_XML_TAG_PROPERTIES_STR, true);
 
-                        // Skip this version if it is newer than the time limit
-                        if (infoLast.timeModified > targetTime)
-                            continue;
-                    }
+                        // Get file name and strip off the base prefix when present
+                        const String *name = xmlNodeContent(xmlNodeChild(node, AZURE_XML_TAG_NAME_STR, true));
 
-                    // Update last name and set exists
-                    strCat(strTrunc(nameLast), name);
-                    infoLast.exists = true;
+                        if (!strEmpty(basePrefix))
+                            name = strSub(name, strSize(basePrefix));
 
-                    // Add basic info if requested (no need to add type info since file is default type)
-                    if (level >= storageInfoLevelBasic)
-                    {
-                        infoLast.size = cvtZToUInt64(
-                            strZ(xmlNodeContent(xmlNodeChild(property, AZURE_XML_TAG_CONTENT_LENGTH_STR, true))));
+                        // Return info for last file if new file
+                        if (infoLast.exists && !strEq(name, nameLast))
+                        {
+                            callback(callbackData, &infoLast);
+                            infoLast.exists = false;
+                        }
 
-                        if (targetTime == 0)
+                        // If targeting by time exclude versions that are newer than targetTime. Note that the API does not provide
+                        // reliable delete markers so the filtering will also show files that have been deleted rather than
+                        // replaced with a new version. The problem with the delete markers is that Creation-Time/Last-Modified
+                        // are set equal to the times in the last version so we don't know when the file was deleted. It might be
+                        // possible to use VersionId for this purpose, since it appears to be a timestamp, but the field is
+                        // described as "opaque" in the documentation so it does not seem to be a good idea to use it.
+                        if (targetTime != 0)
                         {
                             infoLast.timeModified = httpDateToTime(
                                 xmlNodeContent(xmlNodeChild(property, AZURE_XML_TAG_LAST_MODIFIED_STR, true)));
+
+                            // Skip this version if it is newer than the time limit
+                            if (infoLast.timeModified > targetTime)
+                                continue;
                         }
-                        else
+
+                        // Update last name and set exists
+                        strCat(strTrunc(nameLast), name);
+                        infoLast.exists = true;
+
+                        // Add basic info if requested (no need to add type info since file is default type)
+                        if (level >= storageInfoLevelBasic)
                         {
-                            strCat(
-                                strTrunc(versionIdLast),
-                                xmlNodeContent(xmlNodeChild(fileNode, AZURE_XML_TAG_VERSION_ID_STR, true)));
+                            infoLast.size = cvtZToUInt64(
+                                strZ(xmlNodeContent(xmlNodeChild(property, AZURE_XML_TAG_CONTENT_LENGTH_STR, true))));
+
+                            if (targetTime == 0)
+                            {
+                                infoLast.timeModified = httpDateToTime(
+                                    xmlNodeContent(xmlNodeChild(property, AZURE_XML_TAG_LAST_MODIFIED_STR, true)));
+                            }
+                            else
+                            {
+                                strCat(
+                                    strTrunc(versionIdLast),
+                                    xmlNodeContent(xmlNodeChild(node, AZURE_XML_TAG_VERSION_ID_STR, true)));
+                            }
                         }
                     }
                 }
+
+                // If a continuation marker exists then send an async request to get more data
+                if (!strEq(continuationMarker, EMPTY_STR))
+                {
+                    httpQueryPut(query, AZURE_QUERY_MARKER_STR, continuationMarker);
+
+                    // Store request in the outer temp context
+                    MEM_CONTEXT_PRIOR_BEGIN()
+                    {
+                        request = storageAzureRequestAsyncP(this, HTTP_VERB_GET_STR, .query = query);
+                    }
+                    MEM_CONTEXT_PRIOR_END();
+                }
             }
             MEM_CONTEXT_TEMP_END();
         }
@@ -623,7 +627,10 @@ storageAzureNewRead(THIS_VOID, const String *const file, const bool ignoreMissin
     ASSERT(file != NULL);
 
     FUNCTION_LOG_RETURN(
-        STORAGE_READ, storageReadAzureNew(this, file, ignoreMissing, param.offset, param.limit, param.version, param.versionId));
+        STORAGE_READ,
+        storageReadAzureNew(
+            this, file, ignoreMissing, param.offset, param.limit, param.version, param.versionId, this->downloadSize,
+            this->downloadMax));
 }
 
 /**********************************************************************************************************************************/
@@ -766,8 +773,9 @@ FN_EXTERN Storage *
 storageAzureNew(
     const String *const path, const bool write, const time_t targetTime, StoragePathExpressionCallback pathExpressionFunction,
     const String *const container, const String *const account, const StorageAzureKeyType keyType, const String *const key,
-    const size_t blockSize, const KeyValue *const tag, const String *const endpoint, const StorageAzureUriStyle uriStyle,
-    const unsigned int port, const TimeMSec timeout, const bool verifyPeer, const String *const caFile, const String *const caPath)
+    const size_t blockSize, const unsigned int downloadMax, const KeyValue *const tag, const String *const endpoint,
+    const StorageAzureUriStyle uriStyle, const unsigned int port, const TimeMSec timeout, const bool verifyPeer,
+    const String *const caFile, const String *const caPath)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(STRING, path);
@@ -779,6 +787,7 @@ storageAzureNew(
         FUNCTION_LOG_PARAM(STRING_ID, keyType);
         FUNCTION_TEST_PARAM(STRING, key);
         FUNCTION_LOG_PARAM(SIZE, blockSize);
+        FUNCTION_LOG_PARAM(UINT, downloadMax);
         FUNCTION_LOG_PARAM(KEY_VALUE, tag);
         FUNCTION_LOG_PARAM(STRING, endpoint);
         FUNCTION_LOG_PARAM(ENUM, uriStyle);
@@ -795,6 +804,7 @@ storageAzureNew(
     ASSERT(endpoint != NULL);
     ASSERT(key != NULL);
     ASSERT(blockSize != 0);
+    ASSERT(downloadMax != 0);
 
     OBJ_NEW_BEGIN(StorageAzure, .childQty = MEM_CONTEXT_QTY_MAX)
     {
@@ -804,6 +814,8 @@ storageAzureNew(
             .container = strDup(container),
             .account = strDup(account),
             .blockSize = blockSize,
+            .downloadMax = downloadMax,
+            .downloadSize = HTTP_RANGE_READ_SIZE,
             .host = uriStyle == storageAzureUriStyleHost ? strNewFmt("%s.%s", strZ(account), strZ(endpoint)) : strDup(endpoint),
             .pathPrefix =
                 uriStyle == storageAzureUriStyleHost ?
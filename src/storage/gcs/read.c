@@ -5,16 +5,23 @@ GCS Storage Read
 
 #include "common/debug.h"
 #include "common/io/http/client.h"
+#include "common/io/http/rangeRead.h"
 #include "common/io/read.h"
 #include "common/log.h"
 #include "common/type/object.h"
 #include "storage/gcs/read.h"
 #include "storage/read.h"
 
+/***********************************************************************************************************************************
+GCS http headers
+***********************************************************************************************************************************/
+STRING_STATIC(GCS_HEADER_GENERATION_STR,                            "x-goog-generation");
+
 /***********************************************************************************************************************************
 GCS query tokens
 ***********************************************************************************************************************************/
 STRING_STATIC(GCS_QUERY_ALT_STR,                                    "alt");
+STRING_STATIC(GCS_QUERY_IF_GENERATION_MATCH_STR,                    "ifGenerationMatch");
 
 /***********************************************************************************************************************************
 Object type
@@ -23,8 +30,11 @@ typedef struct StorageReadGcs
 {
     StorageReadInterface interface;                                 // Interface
     StorageGcs *storage;                                            // Storage that created this object
+    uint64_t rangeSize;                                             // Size of each range when reading concurrently
+    unsigned int rangeMax;                                          // Maximum ranges in progress (1 reads with a single request)
 
     HttpResponse *httpResponse;                                     // HTTP response
+    HttpRangeRead *rangeRead;                                       // Ranged reads in progress
 } StorageReadGcs;
 
 /***********************************************************************************************************************************
@@ -35,6 +45,51 @@ Macros for function logging
 #define FUNCTION_LOG_STORAGE_READ_GCS_FORMAT(value, buffer, bufferSize)                                                            \
     objNameToLog(value, "StorageReadGcs", buffer, bufferSize)
 
+/***********************************************************************************************************************************
+Start a ranged request
+***********************************************************************************************************************************/
+static HttpRequest *
+storageReadGcsRangeRequest(void *const data, const uint64_t offset, const uint64_t size, const HttpHeader *const responseHeader)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, data);
+        FUNCTION_TEST_PARAM(UINT64, offset);
+        FUNCTION_TEST_PARAM(UINT64, size);
+        FUNCTION_TEST_PARAM(HTTP_HEADER, responseHeader);
+    FUNCTION_TEST_END();
+
+    ASSERT(data != NULL);
+
+    StorageReadGcs *const this = data;
+    HttpRequest *result = NULL;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        const HttpHeader *const header = httpHeaderPutRange(httpHeaderNew(NULL), offset, VARUINT64(size));
+        HttpQuery *const query = httpQueryAdd(httpQueryNewP(), GCS_QUERY_ALT_STR, GCS_QUERY_MEDIA_STR);
+
+        if (this->interface.versionId)
+            httpQueryAdd(query, varStr(GCS_JSON_GENERATION_VAR), this->interface.versionId);
+
+        // Error if the object has changed since the first range was requested
+        const String *const generation =
+            responseHeader == NULL ? NULL : httpHeaderGet(responseHeader, GCS_HEADER_GENERATION_STR);
+
+        if (generation != NULL)
+            httpQueryAdd(query, GCS_QUERY_IF_GENERATION_MATCH_STR, generation);
+
+        MEM_CONTEXT_PRIOR_BEGIN()
+        {
+            result = storageGcsRequestAsyncP(
+                this->storage, HTTP_VERB_GET_STR, .object = this->interface.name, .header = header, .query = query);
+        }
+        MEM_CONTEXT_PRIOR_END();
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_TEST_RETURN(HTTP_REQUEST, result);
+}
+
 /***********************************************************************************************************************************
 Open the file
 ***********************************************************************************************************************************/
@@ -48,34 +103,48 @@ storageReadGcsOpen(THIS_VOID)
     FUNCTION_LOG_END();
 
     ASSERT(this != NULL);
-    ASSERT(this->httpResponse == NULL);
+    ASSERT(this->httpResponse == NULL && this->rangeRead == NULL);
 
     bool result = false;
 
     // Read if not versioned or if versionId is not null
     if (!this->interface.version || this->interface.versionId != NULL)
     {
-        // Request the file
-        MEM_CONTEXT_OBJ_BEGIN(this)
+        // Request the file in ranges that are read concurrently
+        if (this->rangeMax > 1)
         {
-            HttpQuery *const query = httpQueryAdd(httpQueryNewP(), GCS_QUERY_ALT_STR, GCS_QUERY_MEDIA_STR);
-
-            if (this->interface.versionId)
-                httpQueryAdd(query, varStr(GCS_JSON_GENERATION_VAR), this->interface.versionId);
+            MEM_CONTEXT_OBJ_BEGIN(this)
+            {
+                this->rangeRead = httpRangeReadNew(
+                    storageReadGcsRangeRequest, this, this->interface.offset, this->interface.limit, this->rangeSize,
+                    this->rangeMax);
+            }
+            MEM_CONTEXT_OBJ_END();
 
-            this->httpResponse = storageGcsRequestP(
-                this->storage, HTTP_VERB_GET_STR, .object = this->interface.name,
-                .header = httpHeaderPutRange(httpHeaderNew(NULL), this->interface.offset, this->interface.limit),
-                .allowMissing = true, .contentIo = true, .query = query);
+            result = httpRangeReadOpen(this->rangeRead);
         }
-        MEM_CONTEXT_OBJ_END();
-
-        if (httpResponseCodeOk(this->httpResponse))
+        // Else request the file with a single request
+        else
         {
-            result = true;
+            MEM_CONTEXT_OBJ_BEGIN(this)
+            {
+                HttpQuery *const query = httpQueryAdd(httpQueryNewP(), GCS_QUERY_ALT_STR, GCS_QUERY_MEDIA_STR);
+
+                if (this->interface.versionId)
+                    httpQueryAdd(query, varStr(GCS_JSON_GENERATION_VAR), this->interface.versionId);
+
+                this->httpResponse = storageGcsRequestP(
+                    this->storage, HTTP_VERB_GET_STR, .object = this->interface.name,
+                    .header = httpHeaderPutRange(httpHeaderNew(NULL), this->interface.offset, this->interface.limit),
+                    .allowMissing = true, .contentIo = true, .query = query);
+            }
+            MEM_CONTEXT_OBJ_END();
+
+            result = httpResponseCodeOk(this->httpResponse);
         }
-        // Else error unless ignore missing
-        else if (!this->interface.ignoreMissing)
+
+        // Error unless ignore missing
+        if (!result && !this->interface.ignoreMissing)
             THROW_FMT(FileMissingError, STORAGE_ERROR_READ_MISSING, strZ(this->interface.name));
     }
 
@@ -96,11 +165,13 @@ storageReadGcs(THIS_VOID, Buffer *const buffer, const bool block)
         FUNCTION_LOG_PARAM(BOOL, block);
     FUNCTION_LOG_END();
 
-    ASSERT(this != NULL && this->httpResponse != NULL);
-    ASSERT(httpResponseIoRead(this->httpResponse) != NULL);
+    ASSERT(this != NULL && (this->httpResponse != NULL || this->rangeRead != NULL));
     ASSERT(buffer != NULL && !bufFull(buffer));
 
-    FUNCTION_LOG_RETURN(SIZE, ioRead(httpResponseIoRead(this->httpResponse), buffer));
+    FUNCTION_LOG_RETURN(
+        SIZE,
+        this->rangeRead != NULL ?
+            httpRangeReadContent(this->rangeRead, buffer) : ioRead(httpResponseIoRead(this->httpResponse), buffer));
 }
 
 /***********************************************************************************************************************************
@@ -115,17 +186,18 @@ storageReadGcsEof(THIS_VOID)
         FUNCTION_TEST_PARAM(STORAGE_READ_GCS, this);
     FUNCTION_TEST_END();
 
-    ASSERT(this != NULL && this->httpResponse != NULL);
-    ASSERT(httpResponseIoRead(this->httpResponse) != NULL);
+    ASSERT(this != NULL && (this->httpResponse != NULL || this->rangeRead != NULL));
 
-    FUNCTION_TEST_RETURN(BOOL, ioReadEof(httpResponseIoRead(this->httpResponse)));
+    FUNCTION_TEST_RETURN(
+        BOOL, this->rangeRead != NULL ? httpRangeReadEof(this->rangeRead) : ioReadEof(httpResponseIoRead(this->httpResponse)));
 }
 
 /**********************************************************************************************************************************/
 FN_EXTERN StorageRead *
 storageReadGcsNew(
     StorageGcs *const storage, const String *const name, const bool ignoreMissing, const uint64_t offset,
-    const Variant *const limit, const bool version, const String *const versionId)
+    const Variant *const limit, const bool version, const String *const versionId, const uint64_t rangeSize,
+    const unsigned int rangeMax)
 {
     FUNCTION_LOG_BEGIN(logLevelTrace);
         FUNCTION_LOG_PARAM(STORAGE_GCS, storage);
@@ -135,16 +207,22 @@ storageReadGcsNew(
         FUNCTION_LOG_PARAM(VARIANT, limit);
         FUNCTION_LOG_PARAM(BOOL, version);
         FUNCTION_LOG_PARAM(STRING, versionId);
+        FUNCTION_LOG_PARAM(UINT64, rangeSize);
+        FUNCTION_LOG_PARAM(UINT, rangeMax);
     FUNCTION_LOG_END();
 
     ASSERT(storage != NULL);
     ASSERT(name != NULL);
+    ASSERT(rangeSize > 0);
+    ASSERT(rangeMax > 0);
 
     OBJ_NEW_BEGIN(StorageReadGcs, .childQty = MEM_CONTEXT_QTY_MAX)
     {
         *this = (StorageReadGcs)
         {
             .storage = storage,
+            .rangeSize = rangeSize,
+            .rangeMax = rangeMax,
 
             .interface = (StorageReadInterface)
             {
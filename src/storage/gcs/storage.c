@@ -14,6 +14,7 @@ GCS Storage
 #include "common/debug.h"
 #include "common/io/http/client.h"
 #include "common/io/http/common.h"
+#include "common/io/http/rangeRead.h"
 #include "common/io/http/url.h"
 #include "common/io/socket/client.h"
 #include "common/io/tls/client.h"
@@ -96,6 +97,8 @@ struct StorageGcs
     const String *bucket;                                           // Bucket to store data in
     const String *endpoint;                                         // Endpoint
     size_t chunkSize;                                               // Block size for resumable upload
+    unsigned int downloadMax;                                       // Maximum ranges downloading concurrently
+    uint64_t downloadSize;                                          // Size of each range when downloading concurrently
     unsigned int deleteMax;                                         // Maximum objects that can be deleted in one request
     const Buffer *tag;                                              // Tags to be applied to objects
 
@@ -934,7 +937,10 @@ storageGcsNewRead(THIS_VOID, const String *const file, const bool ignoreMissing,
     ASSERT(file != NULL);
 
     FUNCTION_LOG_RETURN(
-        STORAGE_READ, storageReadGcsNew(this, file, ignoreMissing, param.offset, param.limit, param.version, param.versionId));
+        STORAGE_READ,
+        storageReadGcsNew(
+            this, file, ignoreMissing, param.offset, param.limit, param.version, param.versionId, this->downloadSize,
+            this->downloadMax));
 }
 
 /**********************************************************************************************************************************/
@@ -1180,8 +1186,8 @@ FN_EXTERN Storage *
 storageGcsNew(
     const String *const path, const bool write, const time_t targetTime, StoragePathExpressionCallback pathExpressionFunction,
     const String *const bucket, const StorageGcsKeyType keyType, const String *const key, const size_t chunkSize,
-    const KeyValue *const tag, const String *const endpoint, const TimeMSec timeout, const bool verifyPeer,
-    const String *const caFile, const String *const caPath)
+    const unsigned int downloadMax, const KeyValue *const tag, const String *const endpoint, const TimeMSec timeout,
+    const bool verifyPeer, const String *const caFile, const String *const caPath)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(STRING, path);
@@ -1192,6 +1198,7 @@ storageGcsNew(
         FUNCTION_LOG_PARAM(STRING_ID, keyType);
         FUNCTION_TEST_PARAM(STRING, key);
         FUNCTION_LOG_PARAM(SIZE, chunkSize);
+        FUNCTION_LOG_PARAM(UINT, downloadMax);
         FUNCTION_LOG_PARAM(KEY_VALUE, tag);
         FUNCTION_LOG_PARAM(STRING, endpoint);
         FUNCTION_LOG_PARAM(TIME_MSEC, timeout);
@@ -1204,6 +1211,7 @@ storageGcsNew(
     ASSERT(bucket != NULL);
     ASSERT(keyType == storageGcsKeyTypeAuto || key != NULL);
     ASSERT(chunkSize != 0);
+    ASSERT(downloadMax != 0);
 
     OBJ_NEW_BEGIN(StorageGcs, .childQty = MEM_CONTEXT_QTY_MAX)
     {
@@ -1214,6 +1222,8 @@ storageGcsNew(
             .bucket = strDup(bucket),
             .keyType = keyType,
             .chunkSize = chunkSize,
+            .downloadMax = downloadMax,
+            .downloadSize = HTTP_RANGE_READ_SIZE,
             .deleteMax = STORAGE_GCS_DELETE_MAX,
         };
 
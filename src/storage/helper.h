@@ -15,6 +15,8 @@ STRING_DECLARE(STORAGE_SPOOL_ARCHIVE_STR);
 STRING_DECLARE(STORAGE_SPOOL_ARCHIVE_IN_STR);
 #define STORAGE_SPOOL_ARCHIVE_OUT                                   "<SPOOL:ARCHIVE:OUT>"
 STRING_DECLARE(STORAGE_SPOOL_ARCHIVE_OUT_STR);
+#define STORAGE_SPOOL_BLOCK_MAP                                     "<SPOOL:BLOCK-MAP>"
+STRING_DECLARE(STORAGE_SPOOL_BLOCK_MAP_STR);
 
 #define STORAGE_REPO_ARCHIVE                                        "<REPO:ARCHIVE>"
 STRING_DECLARE(STORAGE_REPO_ARCHIVE_STR);
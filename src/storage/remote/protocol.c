@@ -369,20 +369,22 @@ storageRemoteListProtocol(PackRead *const param)
 
 /**********************************************************************************************************************************/
 static bool
-storageRemoteReadInternal(StorageRead *const fileRead, PackWrite *const packWrite)
+storageRemoteReadInternal(StorageRead *const fileRead, const size_t blockSize, PackWrite *const packWrite)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(STORAGE_READ, fileRead);
+        FUNCTION_LOG_PARAM(SIZE, blockSize);
         FUNCTION_LOG_PARAM(PACK_WRITE, packWrite);
     FUNCTION_LOG_END();
 
     ASSERT(fileRead != NULL);
+    ASSERT(blockSize > 0);
     ASSERT(packWrite != NULL);
 
     FUNCTION_AUDIT_HELPER();
 
     // Read block and send to client
-    Buffer *const buffer = bufNew(ioBufferSize());
+    Buffer *const buffer = bufNew(blockSize);
 
     ioRead(storageReadIo(fileRead), buffer);
     pckWriteBoolP(packWrite, bufEmpty(buffer));
@@ -448,7 +450,7 @@ storageRemoteReadOpenProtocol(PackRead *const param)
         if (exists)
         {
             // If there is more to read then set session data
-            if (storageRemoteReadInternal(fileRead, data))
+            if (storageRemoteReadInternal(fileRead, ioBufferSize(), data))
                 protocolServerResultSessionDataSet(result, fileRead);
         }
     }
@@ -467,13 +469,20 @@ storageRemoteReadProtocol(PackRead *const param, void *const fileRead)
 
     FUNCTION_AUDIT_STRUCT();
 
-    ASSERT(param == NULL);
+    ASSERT(param != NULL);
     ASSERT(fileRead != NULL);
     ASSERT(storageRemoteProtocolLocal.driver != NULL);
 
-    ProtocolServerResult *const result = protocolServerResultNewP(.extra = ioBufferSize());
+    // The client requests larger blocks as the read progresses so fewer round trips are needed. The size is bounded to limit the
+    // memory a client can make the server allocate.
+    const size_t blockSize = (size_t)pckReadU64P(param);
+    CHECK(
+        ProtocolError, blockSize > 0 && blockSize <= ioBufferSize() * STORAGE_READ_REMOTE_BLOCK_MULTIPLIER_MAX,
+        "invalid block size");
+
+    ProtocolServerResult *const result = protocolServerResultNewP(.extra = blockSize);
 
-    if (!storageRemoteReadInternal(fileRead, protocolServerResultData(result)))
+    if (!storageRemoteReadInternal(fileRead, blockSize, protocolServerResultData(result)))
         protocolServerResultCloseSet(result);
 
     FUNCTION_LOG_RETURN(PROTOCOL_SERVER_RESULT, result);
@@ -7,6 +7,14 @@ Remote Storage Protocol Handler
 #include "common/type/pack.h"
 #include "protocol/server.h"
 
+/***********************************************************************************************************************************
+Maximum size of a block requested from the remote as a multiple of the buffer size. Each request is a round trip so small blocks cap
+throughput on high latency links at roughly block size / RTT. The first block is returned with the open and is the buffer size (so
+small files do not allocate more than needed). The requested block size starts at double the buffer size and doubles with each
+request until this limit is reached.
+***********************************************************************************************************************************/
+#define STORAGE_READ_REMOTE_BLOCK_MULTIPLIER_MAX                    8
+
 /***********************************************************************************************************************************
 Functions
 ***********************************************************************************************************************************/
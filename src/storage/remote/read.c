@@ -29,6 +29,7 @@ typedef struct StorageReadRemote
     ProtocolClient *client;                                         // Protocol client for requests
     ProtocolClientSession *session;                                 // Protocol session for requests
     size_t remaining;                                               // Bytes remaining to be read in block
+    size_t blockSize;                                               // Size of the next block to request
     Buffer *block;                                                  // Block currently being read
     bool eof;                                                       // Has the file reached eof?
     bool eofFound;                                                  // Eof found but a block is remaining to be read
@@ -46,6 +47,34 @@ Macros for function logging
 #define FUNCTION_LOG_STORAGE_READ_REMOTE_FORMAT(value, buffer, bufferSize)                                                         \
     objNameToLog(value, "StorageReadRemote", buffer, bufferSize)
 
+/***********************************************************************************************************************************
+Request the next block from the remote
+***********************************************************************************************************************************/
+static void
+storageReadRemoteRequest(StorageReadRemote *const this)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(STORAGE_READ_REMOTE, this);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        PackWrite *const param = protocolPackNew();
+
+        pckWriteU64P(param, this->blockSize);
+        protocolClientSessionRequestAsyncP(this->session, .param = param);
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    // Double the block size for the next request until the limit is reached
+    if (this->blockSize < ioBufferSize() * STORAGE_READ_REMOTE_BLOCK_MULTIPLIER_MAX)
+        this->blockSize *= 2;
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
 /***********************************************************************************************************************************
 Read from a file
 ***********************************************************************************************************************************/
@@ -118,12 +147,12 @@ storageReadRemote(THIS_VOID, Buffer *const buffer, const bool block)
                 MEM_CONTEXT_TEMP_BEGIN()
                 {
                     if (!protocolClientSessionQueued(this->session))
-                        protocolClientSessionRequestAsyncP(this->session);
+                        storageReadRemoteRequest(this);
 
                     storageReadRemoteInternal(this, protocolClientSessionResponse(this->session));
 
                     if (!this->eofFound)
-                        protocolClientSessionRequestAsyncP(this->session);
+                        storageReadRemoteRequest(this);
                 }
                 MEM_CONTEXT_TEMP_END();
             }
@@ -287,6 +316,7 @@ storageReadRemoteNew(
             .storage = storage,
             .client = client,
             .session = protocolClientSessionNewP(client, PROTOCOL_COMMAND_STORAGE_READ, .async = true),
+            .blockSize = ioBufferSize() * 2,
 
             .interface = (StorageReadInterface)
             {
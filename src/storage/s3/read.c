@@ -7,6 +7,7 @@ Based on the documentation at https://cloud.google.com/storage/docs/json_api/v1/
 
 #include "common/debug.h"
 #include "common/io/http/client.h"
+#include "common/io/http/rangeRead.h"
 #include "common/log.h"
 #include "common/type/object.h"
 #include "storage/read.h"
@@ -22,8 +23,11 @@ typedef struct StorageReadS3
 {
     StorageReadInterface interface;                                 // Interface
     StorageS3 *storage;                                             // Storage that created this object
+    uint64_t rangeSize;                                             // Size of each range when reading concurrently
+    unsigned int rangeMax;                                          // Maximum ranges in progress (1 reads with a single request)
 
     HttpResponse *httpResponse;                                     // HTTP response
+    HttpRangeRead *rangeRead;                                       // Ranged reads in progress
 } StorageReadS3;
 
 /***********************************************************************************************************************************
@@ -34,6 +38,50 @@ Macros for function logging
 #define FUNCTION_LOG_STORAGE_READ_S3_FORMAT(value, buffer, bufferSize)                                                             \
     objNameToLog(value, "StorageReadS3", buffer, bufferSize)
 
+/***********************************************************************************************************************************
+Start a ranged request
+***********************************************************************************************************************************/
+static HttpRequest *
+storageReadS3RangeRequest(void *const data, const uint64_t offset, const uint64_t size, const HttpHeader *const responseHeader)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, data);
+        FUNCTION_TEST_PARAM(UINT64, offset);
+        FUNCTION_TEST_PARAM(UINT64, size);
+        FUNCTION_TEST_PARAM(HTTP_HEADER, responseHeader);
+    FUNCTION_TEST_END();
+
+    ASSERT(data != NULL);
+
+    StorageReadS3 *const this = data;
+    HttpRequest *result = NULL;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        HttpHeader *const header = httpHeaderPutRange(httpHeaderNew(NULL), offset, VARUINT64(size));
+
+        // Error if the object has changed since the first range was requested
+        const String *const etag = responseHeader == NULL ? NULL : httpHeaderGet(responseHeader, HTTP_HEADER_ETAG_STR);
+
+        if (etag != NULL)
+            httpHeaderAdd(header, HTTP_HEADER_IF_MATCH_STR, etag);
+
+        const HttpQuery *const query =
+            this->interface.versionId == NULL
+                ? NULL : httpQueryPut(httpQueryNewP(), STRDEF("versionId"), this->interface.versionId);
+
+        MEM_CONTEXT_PRIOR_BEGIN()
+        {
+            result = storageS3RequestAsyncP(
+                this->storage, HTTP_VERB_GET_STR, this->interface.name, .header = header, .query = query, .sseC = true);
+        }
+        MEM_CONTEXT_PRIOR_END();
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_TEST_RETURN(HTTP_REQUEST, result);
+}
+
 /***********************************************************************************************************************************
 Open the file
 ***********************************************************************************************************************************/
@@ -47,32 +95,46 @@ storageReadS3Open(THIS_VOID)
     FUNCTION_LOG_END();
 
     ASSERT(this != NULL);
-    ASSERT(this->httpResponse == NULL);
+    ASSERT(this->httpResponse == NULL && this->rangeRead == NULL);
 
     bool result = false;
 
     // Read if not versioned or if versionId is not null
     if (!this->interface.version || this->interface.versionId != NULL)
     {
-        // Request the file
-        MEM_CONTEXT_OBJ_BEGIN(this)
+        // Request the file in ranges that are read concurrently
+        if (this->rangeMax > 1)
         {
-            this->httpResponse = storageS3RequestP(
-                this->storage, HTTP_VERB_GET_STR, this->interface.name,
-                .header = httpHeaderPutRange(httpHeaderNew(NULL), this->interface.offset, this->interface.limit),
-                .query =
-                    this->interface.versionId == NULL
-                        ? NULL : httpQueryPut(httpQueryNewP(), STRDEF("versionId"), this->interface.versionId),
-                .allowMissing = true, .contentIo = true, .sseC = true);
-        }
-        MEM_CONTEXT_OBJ_END();
+            MEM_CONTEXT_OBJ_BEGIN(this)
+            {
+                this->rangeRead = httpRangeReadNew(
+                    storageReadS3RangeRequest, this, this->interface.offset, this->interface.limit, this->rangeSize,
+                    this->rangeMax);
+            }
+            MEM_CONTEXT_OBJ_END();
 
-        if (httpResponseCodeOk(this->httpResponse))
+            result = httpRangeReadOpen(this->rangeRead);
+        }
+        // Else request the file with a single request
+        else
         {
-            result = true;
+            MEM_CONTEXT_OBJ_BEGIN(this)
+            {
+                this->httpResponse = storageS3RequestP(
+                    this->storage, HTTP_VERB_GET_STR, this->interface.name,
+                    .header = httpHeaderPutRange(httpHeaderNew(NULL), this->interface.offset, this->interface.limit),
+                    .query =
+                        this->interface.versionId == NULL
+                            ? NULL : httpQueryPut(httpQueryNewP(), STRDEF("versionId"), this->interface.versionId),
+                    .allowMissing = true, .contentIo = true, .sseC = true);
+            }
+            MEM_CONTEXT_OBJ_END();
+
+            result = httpResponseCodeOk(this->httpResponse);
         }
-        // Else error unless ignore missing
-        else if (!this->interface.ignoreMissing)
+
+        // Error unless ignore missing
+        if (!result && !this->interface.ignoreMissing)
             THROW_FMT(FileMissingError, STORAGE_ERROR_READ_MISSING, strZ(this->interface.name));
     }
 
@@ -93,11 +155,13 @@ storageReadS3(THIS_VOID, Buffer *const buffer, const bool block)
         FUNCTION_LOG_PARAM(BOOL, block);
     FUNCTION_LOG_END();
 
-    ASSERT(this != NULL && this->httpResponse != NULL);
-    ASSERT(httpResponseIoRead(this->httpResponse) != NULL);
+    ASSERT(this != NULL && (this->httpResponse != NULL || this->rangeRead != NULL));
     ASSERT(buffer != NULL && !bufFull(buffer));
 
-    FUNCTION_LOG_RETURN(SIZE, ioRead(httpResponseIoRead(this->httpResponse), buffer));
+    FUNCTION_LOG_RETURN(
+        SIZE,
+        this->rangeRead != NULL ?
+            httpRangeReadContent(this->rangeRead, buffer) : ioRead(httpResponseIoRead(this->httpResponse), buffer));
 }
 
 /***********************************************************************************************************************************
@@ -112,17 +176,17 @@ storageReadS3Eof(THIS_VOID)
         FUNCTION_TEST_PARAM(STORAGE_READ_S3, this);
     FUNCTION_TEST_END();
 
-    ASSERT(this != NULL && this->httpResponse != NULL);
-    ASSERT(httpResponseIoRead(this->httpResponse) != NULL);
+    ASSERT(this != NULL && (this->httpResponse != NULL || this->rangeRead != NULL));
 
-    FUNCTION_TEST_RETURN(BOOL, ioReadEof(httpResponseIoRead(this->httpResponse)));
+    FUNCTION_TEST_RETURN(
+        BOOL, this->rangeRead != NULL ? httpRangeReadEof(this->rangeRead) : ioReadEof(httpResponseIoRead(this->httpResponse)));
 }
 
 /**********************************************************************************************************************************/
 FN_EXTERN StorageRead *
 storageReadS3New(
     StorageS3 *const storage, const String *const name, const bool ignoreMissing, const uint64_t offset, const Variant *const limit,
-    const bool version, const String *const versionId)
+    const bool version, const String *const versionId, const uint64_t rangeSize, const unsigned int rangeMax)
 {
     FUNCTION_LOG_BEGIN(logLevelTrace);
         FUNCTION_LOG_PARAM(STORAGE_S3, storage);
@@ -132,17 +196,23 @@ storageReadS3New(
         FUNCTION_LOG_PARAM(VARIANT, limit);
         FUNCTION_LOG_PARAM(BOOL, version);
         FUNCTION_LOG_PARAM(STRING, versionId);
+        FUNCTION_LOG_PARAM(UINT64, rangeSize);
+        FUNCTION_LOG_PARAM(UINT, rangeMax);
     FUNCTION_LOG_END();
 
     ASSERT(storage != NULL);
     ASSERT(name != NULL);
     ASSERT(limit == NULL || varUInt64(limit) > 0);
+    ASSERT(rangeSize > 0);
+    ASSERT(rangeMax > 0);
 
     OBJ_NEW_BEGIN(StorageReadS3, .childQty = MEM_CONTEXT_QTY_MAX)
     {
         *this = (StorageReadS3)
         {
             .storage = storage,
+            .rangeSize = rangeSize,
+            .rangeMax = rangeMax,
 
             .interface = (StorageReadInterface)
             {
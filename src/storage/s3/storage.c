@@ -9,6 +9,7 @@ S3 Storage
 #include "common/debug.h"
 #include "common/io/http/client.h"
 #include "common/io/http/common.h"
+#include "common/io/http/rangeRead.h"
 #include "common/io/socket/client.h"
 #include "common/io/tls/client.h"
 #include "common/log.h"
@@ -106,6 +107,9 @@ struct StorageS3
     const String *sseCustomerKey;                                   // Base64 of SSE-C encryption key
     const String *sseCustomerKeyMd5;                                // Base64 of MD5 of SSE-C key
     size_t partSize;                                                // Part size for multi-part upload
+    unsigned int downloadMax;                                       // Maximum ranges downloading concurrently
+    uint64_t downloadSize;                                          // Size of each range when downloading concurrently
+    unsigned int listMax;                                           // Maximum list requests in progress for recursive lists
     const String *tag;                                              // Tags to be applied to objects
     unsigned int deleteMax;                                         // Maximum objects that can be deleted in one request
     StorageS3UriStyle uriStyle;                                     // Path or host style URIs
@@ -619,20 +623,55 @@ storageS3Request(StorageS3 *const this, const String *const verb, const String *
 }
 
 /***********************************************************************************************************************************
-General function for listing files to be used by other list routines
+Create the query for a list request
+***********************************************************************************************************************************/
+static HttpQuery *
+storageS3ListQuery(const String *const queryPrefix, const bool recurse, const time_t targetTime)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRING, queryPrefix);
+        FUNCTION_TEST_PARAM(BOOL, recurse);
+        FUNCTION_TEST_PARAM(TIME, targetTime);
+    FUNCTION_TEST_END();
+
+    ASSERT(queryPrefix != NULL);
+
+    HttpQuery *const result = httpQueryNewP();
+
+    // Add the delimiter to not recurse
+    if (!recurse)
+        httpQueryAdd(result, S3_QUERY_DELIMITER_STR, FSLASH_STR);
+
+    // Use list type 2 or versions as specified
+    if (targetTime != 0)
+        httpQueryAdd(result, S3_QUERY_VERSIONS_STR, EMPTY_STR);
+    else
+        httpQueryAdd(result, S3_QUERY_LIST_TYPE_STR, S3_QUERY_VALUE_LIST_TYPE_2_STR);
+
+    // Don't specify empty prefix because it is the default
+    if (!strEmpty(queryPrefix))
+        httpQueryAdd(result, S3_QUERY_PREFIX_STR, queryPrefix);
+
+    FUNCTION_TEST_RETURN(HTTP_QUERY, result);
+}
+
+/***********************************************************************************************************************************
+List all keys that begin with the query prefix, requesting as many pages as required. If a request for the first page has already
+been sent then it is passed in request and freed when the response has been read.
 ***********************************************************************************************************************************/
 static void
-storageS3ListInternal(
-    StorageS3 *const this, const String *const path, const StorageInfoLevel level, const String *const expression,
-    const bool recurse, const time_t targetTime, StorageListCallback callback, void *const callbackData)
+storageS3ListPrefix(
+    StorageS3 *const this, const String *const basePrefix, const String *const queryPrefix, const StorageInfoLevel level,
+    const bool recurse, const time_t targetTime, HttpRequest *request, StorageListCallback callback, void *const callbackData)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(STORAGE_S3, this);
-        FUNCTION_LOG_PARAM(STRING, path);
+        FUNCTION_LOG_PARAM(STRING, basePrefix);
+        FUNCTION_LOG_PARAM(STRING, queryPrefix);
         FUNCTION_LOG_PARAM(ENUM, level);
-        FUNCTION_LOG_PARAM(STRING, expression);
         FUNCTION_LOG_PARAM(BOOL, recurse);
         FUNCTION_LOG_PARAM(TIME, targetTime);
+        FUNCTION_LOG_PARAM(HTTP_REQUEST, request);
         FUNCTION_LOG_PARAM(FUNCTIONP, callback);
         FUNCTION_LOG_PARAM_P(VOID, callbackData);
     FUNCTION_LOG_END();
@@ -640,45 +679,13 @@ storageS3ListInternal(
     FUNCTION_AUDIT_CALLBACK();
 
     ASSERT(this != NULL);
-    ASSERT(path != NULL);
+    ASSERT(basePrefix != NULL);
+    ASSERT(queryPrefix != NULL);
 
     MEM_CONTEXT_TEMP_BEGIN()
     {
-        // Build the base prefix by stripping off the initial /
-        const String *const basePrefix = strSize(path) == 1 ? EMPTY_STR : strNewFmt("%s/", strZ(strSub(path, 1)));
-
-        // Get the expression prefix when possible to limit initial results
-        const String *const expressionPrefix = regExpPrefix(expression);
-
-        // If there is an expression prefix then use it to build the query prefix, otherwise query prefix is base prefix
-        const String *queryPrefix;
-
-        if (expressionPrefix == NULL)
-            queryPrefix = basePrefix;
-        else
-        {
-            if (strEmpty(basePrefix))
-                queryPrefix = expressionPrefix;
-            else
-                queryPrefix = strNewFmt("%s%s", strZ(basePrefix), strZ(expressionPrefix));
-        }
-
         // Create query
-        HttpQuery *const query = httpQueryNewP();
-
-        // Add the delimiter to not recurse
-        if (!recurse)
-            httpQueryAdd(query, S3_QUERY_DELIMITER_STR, FSLASH_STR);
-
-        // Use list type 2 or versions as specified
-        if (targetTime != 0)
-            httpQueryAdd(query, S3_QUERY_VERSIONS_STR, EMPTY_STR);
-        else
-            httpQueryAdd(query, S3_QUERY_LIST_TYPE_STR, S3_QUERY_VALUE_LIST_TYPE_2_STR);
-
-        // Don't specify empty prefix because it is the default
-        if (!strEmpty(queryPrefix))
-            httpQueryAdd(query, S3_QUERY_PREFIX_STR, queryPrefix);
+        HttpQuery *const query = storageS3ListQuery(queryPrefix, recurse, targetTime);
 
         // Store last info so it can be updated across requests for versioning
         String *const nameLast = strNew();
@@ -689,8 +696,6 @@ storageS3ListInternal(
             infoLast.versionId = versionIdLast;
 
         // Loop as long as a continuation token returned
-        HttpRequest *request = NULL;
-
         do
         {
             // Use an inner mem context here because we could potentially be retrieving millions of files so it is a good idea to
@@ -702,137 +707,135 @@ storageS3ListInternal(
                 // If there is an outstanding async request then wait for the response
                 if (request != NULL)
                 {
-                    response = storageS3ResponseP(request);
+                    response = storageS3ResponseP(request, .contentIo = true);
 
                     httpRequestFree(request);
                     request = NULL;
                 }
                 // Else get the response immediately from a sync request
                 else
-                    response = storageS3RequestP(this, HTTP_VERB_GET_STR, FSLASH_STR, .query = query);
+                    response = storageS3RequestP(this, HTTP_VERB_GET_STR, FSLASH_STR, .query = query, .contentIo = true);
 
-                const XmlNode *const xmlRoot = xmlDocumentRoot(xmlDocumentNewBuf(httpResponseContent(response)));
+                // Process nodes as the response is read. Entries are returned in the order they appear in the response, so there is
+                // no need to wait for the entire page before processing begins.
+                XmlReader *const reader = xmlReaderNewP(httpResponseIoRead(response));
+                bool truncated = false;
+                const String *nextContinuationToken = EMPTY_STR;
+                const XmlNode *node;
 
-                // If list is truncated then send an async request to get more data
-                if (strEq(xmlNodeContent(xmlNodeChild(xmlRoot, S3_XML_TAG_IS_TRUNCATED_STR, true)), TRUE_STR))
+                while ((node = xmlReaderNext(reader)) != NULL)
                 {
-                    const String *const nextContinuationToken = xmlNodeContent(
-                        xmlNodeChild(xmlRoot, S3_XML_TAG_NEXT_CONTINUATION_TOKEN_STR, true));
-                    CHECK(FormatError, !strEmpty(nextContinuationToken), S3_XML_TAG_NEXT_CONTINUATION_TOKEN " may not be empty");
-
-                    httpQueryPut(query, S3_QUERY_CONTINUATION_TOKEN_STR, nextContinuationToken);
+                    const String *const nodeName = xmlNodeName(node);
 
-                    // Store request in the outer temp context
-                    MEM_CONTEXT_PRIOR_BEGIN()
+                    // If list is truncated then send an async request to get more data as soon as the continuation token is known,
+                    // which is usually before the entries
+                    if (strEq(nodeName, S3_XML_TAG_IS_TRUNCATED_STR) || strEq(nodeName, S3_XML_TAG_NEXT_CONTINUATION_TOKEN_STR))
                     {
-                        request = storageS3RequestAsyncP(this, HTTP_VERB_GET_STR, FSLASH_STR, .query = query);
-                    }
-                    MEM_CONTEXT_PRIOR_END();
-                }
-
-                // Get prefix list
-                const XmlNodeList *const subPathList = xmlNodeChildList(xmlRoot, S3_XML_TAG_COMMON_PREFIXES_STR);
-
-                for (unsigned int subPathIdx = 0; subPathIdx < xmlNodeLstSize(subPathList); subPathIdx++)
-                {
-                    const XmlNode *const subPathNode = xmlNodeLstGet(subPathList, subPathIdx);
+                        if (strEq(nodeName, S3_XML_TAG_IS_TRUNCATED_STR))
+                            truncated = strEq(xmlNodeContent(node), TRUE_STR);
+                        else
+                            nextContinuationToken = xmlNodeContent(node);
 
-                    // Get path name
-                    StorageInfo info =
+                        if (truncated && !strEmpty(nextContinuationToken))
+                        {
+                            httpQueryPut(query, S3_QUERY_CONTINUATION_TOKEN_STR, nextContinuationToken);
+
+                            // Store request in the outer temp context
+                            MEM_CONTEXT_PRIOR_BEGIN()
+                            {
+                                request = storageS3RequestAsyncP(this, HTTP_VERB_GET_STR, FSLASH_STR, .query = query);
+                            }
+                            MEM_CONTEXT_PRIOR_END();
+                        }
+                    }
+                    // Else get path
+                    else if (strEq(nodeName, S3_XML_TAG_COMMON_PREFIXES_STR))
                     {
-                        .level = level,
-                        .name = xmlNodeContent(xmlNodeChild(subPathNode, S3_XML_TAG_PREFIX_STR, true)),
-                        .exists = true,
-                    };
-
-                    // Strip off base prefix and final /
-                    info.name = strSubN(info.name, strSize(basePrefix), strSize(info.name) - strSize(basePrefix) - 1);
-
-                    // Add type info if requested
-                    if (level >= storageInfoLevelType)
-                        info.type = storageTypePath;
-
-                    // Callback with info
-                    callback(callbackData, &info);
-                }
-
-                // Get file list
-                const XmlNodeList *fileList;
-
-                if (targetTime != 0)
-                {
-                    StringList *const nameList = strLstNew();
-                    strLstAdd(nameList, S3_XML_TAG_VERSION_STR);
-                    strLstAdd(nameList, S3_XML_TAG_DELETE_MARKER_STR);
-
-                    fileList = xmlNodeChildListMulti(xmlRoot, nameList);
-                }
-                else
-                    fileList = xmlNodeChildList(xmlRoot, S3_XML_TAG_CONTENTS_STR);
-
-                for (unsigned int fileIdx = 0; fileIdx < xmlNodeLstSize(fileList); fileIdx++)
-                {
-                    const XmlNode *const fileNode = xmlNodeLstGet(fileList, fileIdx);
+                        // Get path name
+                        StorageInfo info =
+                        {
+                            .level = level,
+                            .name = xmlNodeContent(xmlNodeChild(node, S3_XML_TAG_PREFIX_STR, true)),
+                            .exists = true,
+                        };
 
-                    // Get file name and strip off the base prefix when present
-                    const String *name = xmlNodeContent(xmlNodeChild(fileNode, S3_XML_TAG_KEY_STR, true));
+                        // Strip off base prefix and final /
+                        info.name = strSubN(info.name, strSize(basePrefix), strSize(info.name) - strSize(basePrefix) - 1);
 
-                    if (!strEmpty(basePrefix))
-                        name = strSub(name, strSize(basePrefix));
+                        // Add type info if requested
+                        if (level >= storageInfoLevelType)
+                            info.type = storageTypePath;
 
-                    // Return info for last file if new file
-                    if (infoLast.exists && !strEq(name, nameLast))
-                    {
-                        callback(callbackData, &infoLast);
-                        infoLast.exists = false;
+                        // Callback with info
+                        callback(callbackData, &info);
                     }
-
-                    // If targeting by time
-                    if (targetTime != 0)
+                    // Else get file
+                    else if (
+                        targetTime != 0 ?
+                            strEq(nodeName, S3_XML_TAG_VERSION_STR) || strEq(nodeName, S3_XML_TAG_DELETE_MARKER_STR) :
+                            strEq(nodeName, S3_XML_TAG_CONTENTS_STR))
                     {
-                        // Skip later versions
-                        infoLast.timeModified = storageS3CvtTime(
-                            xmlNodeContent(xmlNodeChild(fileNode, S3_XML_TAG_LAST_MODIFIED_STR, true)));
-
-                        if (infoLast.timeModified > targetTime)
-                            continue;
+                        // Get file name and strip off the base prefix when present
+                        const String *name = xmlNodeContent(xmlNodeChild(node, S3_XML_TAG_KEY_STR, true));
 
-                        // If a version has already been returned (or delete marker found) then skip this version
-                        if (strEq(infoLast.name, name))
-                            continue;
+                        if (!strEmpty(basePrefix))
+                            name = strSub(name, strSize(basePrefix));
 
-                        // If most recent version is a delete marker then the file will not be returned
-                        const bool deleteMarker = strEq(xmlNodeName(fileNode), S3_XML_TAG_DELETE_MARKER_STR);
-
-                        if (deleteMarker)
+                        // Return info for last file if new file
+                        if (infoLast.exists && !strEq(name, nameLast))
                         {
-                            strCat(strTrunc(nameLast), name);
+                            callback(callbackData, &infoLast);
                             infoLast.exists = false;
-                            continue;
                         }
-                    }
-
-                    // Update last name and set exists
-                    strCat(strTrunc(nameLast), name);
-                    infoLast.exists = true;
 
-                    // Add basic info if requested (no need to add type info since file is default type)
-                    if (level >= storageInfoLevelBasic)
-                    {
+                        // If targeting by time
                         if (targetTime != 0)
                         {
-                            strCat(
-                                strTrunc(versionIdLast), xmlNodeContent(xmlNodeChild(fileNode, S3_XML_TAG_VERSION_ID_STR, true)));
-                        }
-                        else
-                        {
+                            // Skip later versions
                             infoLast.timeModified = storageS3CvtTime(
-                                xmlNodeContent(xmlNodeChild(fileNode, S3_XML_TAG_LAST_MODIFIED_STR, true)));
+                                xmlNodeContent(xmlNodeChild(node, S3_XML_TAG_LAST_MODIFIED_STR, true)));
+
+                            if (infoLast.timeModified > targetTime)
+                                continue;
+
+                            // If a version has already been returned (or delete marker found) then skip this version
+                            if (strEq(infoLast.name, name))
+                                continue;
+
+                            // If most recent version is a delete marker then the file will not be returned
+                            if (strEq(nodeName, S3_XML_TAG_DELETE_MARKER_STR))
+                            {
+                                strCat(strTrunc(nameLast), name);
+                                infoLast.exists = false;
+                                continue;
+                            }
                         }
 
-                        infoLast.size = cvtZToUInt64(strZ(xmlNodeContent(xmlNodeChild(fileNode, S3_XML_TAG_SIZE_STR, true))));
+                        // Update last name and set exists
+                        strCat(strTrunc(nameLast), name);
+                        infoLast.exists = true;
+
+                        // Add basic info if requested (no need to add type info since file is default type)
+                        if (level >= storageInfoLevelBasic)
+                        {
+                            if (targetTime != 0)
+                            {
+                                strCat(
+                                    strTrunc(versionIdLast), xmlNodeContent(xmlNodeChild(node, S3_XML_TAG_VERSION_ID_STR, true)));
+                            }
+                            else
+                            {
+                                infoLast.timeModified = storageS3CvtTime(
+                                    xmlNodeContent(xmlNodeChild(node, S3_XML_TAG_LAST_MODIFIED_STR, true)));
+                            }
+
+                            infoLast.size = cvtZToUInt64(strZ(xmlNodeContent(xmlNodeChild(node, S3_XML_TAG_SIZE_STR, true))));
+                        }
                     }
                 }
+
+                // Error if the list is truncated but there is no token to continue with
+                CHECK(FormatError, !truncated || request != NULL, S3_XML_TAG_NEXT_CONTINUATION_TOKEN " may not be empty");
             }
             MEM_CONTEXT_TEMP_END();
         }
@@ -847,6 +850,227 @@ storageS3ListInternal(
     FUNCTION_LOG_RETURN_VOID();
 }
 
+/***********************************************************************************************************************************
+List recursively in shards with up to listMax list requests in progress. Each path is either split, i.e. listed one level at a time
+so the paths below it become new paths to be listed, or listed recursively as a single shard. A path is split while there are too
+few paths known to keep listMax requests in progress. This finds the level with enough paths, e.g. the WAL directories below the
+archive id paths of a stanza archive or the database paths below pg_data in a backup, without knowing the layout in advance.
+
+Files are passed to the callback as they are read so the files in a level are never stored. Paths are queued until the listing of
+their level is complete so the decision to split can be made with all the paths in the level known. Keys are not returned in order
+since the shards are read in the order they were requested, which is fine for path removal, the only user of recursive lists.
+***********************************************************************************************************************************/
+typedef struct StorageS3ListShard
+{
+    HttpRequest *request;                                           // Request in progress
+    const String *queryPrefix;                                      // Prefix being listed
+    bool split;                                                     // Is the prefix being split (listed one level)?
+} StorageS3ListShard;
+
+typedef struct StorageS3ListShardData
+{
+    StorageS3 *driver;                                              // Driver
+    const String *basePrefix;                                       // Base prefix of the list
+    StorageInfoLevel level;                                         // Info level requested by the caller
+    StorageListCallback callback;                                   // Caller callback
+    void *callbackData;                                             // Caller callback data
+    StringList *pathList;                                           // Prefixes waiting to be listed
+    unsigned int pathIdx;                                           // Next prefix to be listed
+    List *requestList;                                              // Shards with a request in progress
+} StorageS3ListShardData;
+
+static void
+storageS3ListShardCallback(void *const callbackData, const StorageInfo *const info)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, callbackData);
+        FUNCTION_TEST_PARAM(STORAGE_INFO, info);
+    FUNCTION_TEST_END();
+
+    ASSERT(callbackData != NULL);
+    ASSERT(info != NULL);
+
+    StorageS3ListShardData *const data = callbackData;
+
+    // Paths are only returned when a prefix is split so queue them to be listed
+    if (info->type == storageTypePath)
+        strLstAddFmt(data->pathList, "%s%s/", strZ(data->basePrefix), strZ(info->name));
+    // Else return the file at the level requested by the caller
+    else
+    {
+        StorageInfo infoFile = *info;
+        infoFile.level = data->level;
+
+        data->callback(data->callbackData, &infoFile);
+    }
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+// Start requests for queued prefixes until the maximum are in progress
+static void
+storageS3ListShardStart(StorageS3ListShardData *const data)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, data);
+    FUNCTION_TEST_END();
+
+    ASSERT(data != NULL);
+
+    while (lstSize(data->requestList) < data->driver->listMax && data->pathIdx < strLstSize(data->pathList))
+    {
+        const String *const queryPrefix = strLstGet(data->pathList, data->pathIdx);
+        data->pathIdx++;
+
+        // Split the prefix when the prefixes in progress and queued (including this one) are fewer than the maximum requests
+        const bool split = lstSize(data->requestList) + strLstSize(data->pathList) - data->pathIdx + 1 < data->driver->listMax;
+
+        MEM_CONTEXT_TEMP_BEGIN()
+        {
+            const HttpQuery *const query = storageS3ListQuery(queryPrefix, !split, 0);
+
+            MEM_CONTEXT_BEGIN(lstMemContext(data->requestList))
+            {
+                const StorageS3ListShard shard =
+                {
+                    .request = storageS3RequestAsyncP(data->driver, HTTP_VERB_GET_STR, FSLASH_STR, .query = query),
+                    .queryPrefix = queryPrefix,
+                    .split = split,
+                };
+
+                lstAdd(data->requestList, &shard);
+            }
+            MEM_CONTEXT_END();
+        }
+        MEM_CONTEXT_TEMP_END();
+    }
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+static void
+storageS3ListShard(
+    StorageS3 *const this, const String *const basePrefix, const String *const queryPrefix, const StorageInfoLevel level,
+    StorageListCallback callback, void *const callbackData)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STORAGE_S3, this);
+        FUNCTION_LOG_PARAM(STRING, basePrefix);
+        FUNCTION_LOG_PARAM(STRING, queryPrefix);
+        FUNCTION_LOG_PARAM(ENUM, level);
+        FUNCTION_LOG_PARAM(FUNCTIONP, callback);
+        FUNCTION_LOG_PARAM_P(VOID, callbackData);
+    FUNCTION_LOG_END();
+
+    FUNCTION_AUDIT_CALLBACK();
+
+    ASSERT(this != NULL);
+    ASSERT(basePrefix != NULL);
+    ASSERT(queryPrefix != NULL);
+    ASSERT(this->listMax > 1);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        StorageS3ListShardData data =
+        {
+            .driver = this,
+            .basePrefix = basePrefix,
+            .level = level,
+            .callback = callback,
+            .callbackData = callbackData,
+            .pathList = strLstNew(),
+            .requestList = lstNewP(sizeof(StorageS3ListShard)),
+        };
+
+        // Start with the query prefix, which will always be split since it is the only prefix known
+        strLstAdd(data.pathList, queryPrefix);
+        storageS3ListShardStart(&data);
+
+        // Read shards in the order they were requested. Type is required when splitting to tell paths from files.
+        StorageInfoLevel levelSplit = level;
+        MAX_ASSIGN(levelSplit, storageInfoLevelType);
+
+        while (!lstEmpty(data.requestList))
+        {
+            const StorageS3ListShard shard = *(StorageS3ListShard *)lstGet(data.requestList, 0);
+            lstRemoveIdx(data.requestList, 0);
+
+            storageS3ListPrefix(
+                this, basePrefix, shard.queryPrefix, shard.split ? levelSplit : level, !shard.split, 0, shard.request,
+                storageS3ListShardCallback, &data);
+
+            // Start requests to replace the shard that was read, including any paths found when the shard was split
+            storageS3ListShardStart(&data);
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+General function for listing files to be used by other list routines
+***********************************************************************************************************************************/
+static void
+storageS3ListInternal(
+    StorageS3 *const this, const String *const path, const StorageInfoLevel level, const String *const expression,
+    const bool recurse, const time_t targetTime, StorageListCallback callback, void *const callbackData)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STORAGE_S3, this);
+        FUNCTION_LOG_PARAM(STRING, path);
+        FUNCTION_LOG_PARAM(ENUM, level);
+        FUNCTION_LOG_PARAM(STRING, expression);
+        FUNCTION_LOG_PARAM(BOOL, recurse);
+        FUNCTION_LOG_PARAM(TIME, targetTime);
+        FUNCTION_LOG_PARAM(FUNCTIONP, callback);
+        FUNCTION_LOG_PARAM_P(VOID, callbackData);
+    FUNCTION_LOG_END();
+
+    FUNCTION_AUDIT_CALLBACK();
+
+    ASSERT(this != NULL);
+    ASSERT(path != NULL);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        // Build the base prefix by stripping off the initial /
+        const String *const basePrefix = strSize(path) == 1 ? EMPTY_STR : strNewFmt("%s/", strZ(strSub(path, 1)));
+
+        // Shard recursive lists when concurrent list requests are allowed. Recursive lists are only used to remove paths so no
+        // expression or target time is required.
+        if (recurse && this->listMax > 1)
+        {
+            ASSERT(expression == NULL && targetTime == 0);
+
+            storageS3ListShard(this, basePrefix, basePrefix, level, callback, callbackData);
+        }
+        else
+        {
+            // Get the expression prefix when possible to limit initial results
+            const String *const expressionPrefix = regExpPrefix(expression);
+
+            // If there is an expression prefix then use it to build the query prefix, otherwise query prefix is base prefix
+            const String *queryPrefix;
+
+            if (expressionPrefix == NULL)
+                queryPrefix = basePrefix;
+            else
+            {
+                if (strEmpty(basePrefix))
+                    queryPrefix = expressionPrefix;
+                else
+                    queryPrefix = strNewFmt("%s%s", strZ(basePrefix), strZ(expressionPrefix));
+            }
+
+            storageS3ListPrefix(this, basePrefix, queryPrefix, level, recurse, targetTime, NULL, callback, callbackData);
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
 /**********************************************************************************************************************************/
 static StorageInfo
 storageS3Info(THIS_VOID, const String *const file, const StorageInfoLevel level, const StorageInterfaceInfoParam param)
@@ -949,7 +1173,10 @@ storageS3NewRead(THIS_VOID, const String *const file, const bool ignoreMissing,
     ASSERT(file != NULL);
 
     FUNCTION_LOG_RETURN(
-        STORAGE_READ, storageReadS3New(this, file, ignoreMissing, param.offset, param.limit, param.version, param.versionId));
+        STORAGE_READ,
+        storageReadS3New(
+            this, file, ignoreMissing, param.offset, param.limit, param.version, param.versionId, this->downloadSize,
+            this->downloadMax));
 }
 
 /**********************************************************************************************************************************/
@@ -1177,8 +1404,9 @@ storageS3New(
     const String *const bucket, const String *const endPoint, const StorageS3UriStyle uriStyle, const String *const region,
     const StorageS3KeyType keyType, const String *const accessKey, const String *const secretAccessKey,
     const String *const securityToken, const String *const kmsKeyId, const String *sseCustomerKey, const String *const credRole,
-    const String *const webIdTokenFile, const size_t partSize, const KeyValue *const tag, const String *host,
-    const unsigned int port, const TimeMSec timeout, const bool verifyPeer, const String *const caFile, const String *const caPath)
+    const String *const webIdTokenFile, const size_t partSize, const unsigned int downloadMax, const unsigned int listMax,
+    const KeyValue *const tag, const String *host, const unsigned int port, const TimeMSec timeout, const bool verifyPeer,
+    const String *const caFile, const String *const caPath)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(STRING, path);
@@ -1198,6 +1426,8 @@ storageS3New(
         FUNCTION_TEST_PARAM(STRING, credRole);
         FUNCTION_TEST_PARAM(STRING, webIdTokenFile);
         FUNCTION_LOG_PARAM(SIZE, partSize);
+        FUNCTION_LOG_PARAM(UINT, downloadMax);
+        FUNCTION_LOG_PARAM(UINT, listMax);
         FUNCTION_LOG_PARAM(KEY_VALUE, tag);
         FUNCTION_LOG_PARAM(STRING, host);
         FUNCTION_LOG_PARAM(UINT, port);
@@ -1212,6 +1442,8 @@ storageS3New(
     ASSERT(endPoint != NULL);
     ASSERT(region != NULL);
     ASSERT(partSize != 0);
+    ASSERT(downloadMax != 0);
+    ASSERT(listMax != 0);
 
     OBJ_NEW_BEGIN(StorageS3, .childQty = MEM_CONTEXT_QTY_MAX)
     {
@@ -1224,6 +1456,9 @@ storageS3New(
             .kmsKeyId = strDup(kmsKeyId),
             .sseCustomerKey = strDup(sseCustomerKey),
             .partSize = partSize,
+            .downloadMax = downloadMax,
+            .downloadSize = HTTP_RANGE_READ_SIZE,
+            .listMax = listMax,
             .deleteMax = STORAGE_S3_DELETE_MAX,
             .uriStyle = uriStyle,
             .bucketEndpoint =
@@ -5,6 +5,7 @@ Harness for Creating Test Backups
 
 #include <string.h>
 
+#include "command/archive/walTrim.h"
 #include "command/backup/backup.h"
 #include "common/compress/helper.h"
 #include "common/crypto/common.h"
@@ -94,12 +95,15 @@ hrnBackupScriptSet(const HrnBackupScript *const script, const unsigned int scrip
 
 /**********************************************************************************************************************************/
 static void
-backupProcess(const BackupData *const backupData, Manifest *const manifest, const String *const cipherPassBackup)
+backupProcess(
+    const BackupData *const backupData, Manifest *const manifest, const String *const cipherPassBackup,
+    const uint64_t blockIncrLsnPrior)
 {
     FUNCTION_HARNESS_BEGIN();
         FUNCTION_HARNESS_PARAM(BACKUP_DATA, backupData);
         FUNCTION_HARNESS_PARAM(MANIFEST, manifest);
         FUNCTION_HARNESS_PARAM(STRING, cipherPassBackup);
+        FUNCTION_HARNESS_PARAM(UINT64, blockIncrLsnPrior);
     FUNCTION_HARNESS_END();
 
     // If any file changes are scripted then make them
@@ -141,7 +145,7 @@ backupProcess(const BackupData *const backupData, Manifest *const manifest, cons
         hrnBackupLocal.scriptSize = 0;
     }
 
-    backupProcess_SHIMMED(backupData, manifest, cipherPassBackup);
+    backupProcess_SHIMMED(backupData, manifest, cipherPassBackup, blockIncrLsnPrior);
 
     FUNCTION_HARNESS_RETURN_VOID();
 }
@@ -238,6 +242,9 @@ hrnBackupPqScript(const unsigned int pgVersion, const time_t backupTimeStart, Hr
                             STORAGE_REPO_ARCHIVE "/%s/%s-%s%s", strZ(archiveId), strZ(strLstGet(walSegmentList, walSegmentIdx)),
                             strZ(walChecksum), strZ(compressExtStr(param.walCompressType))));
 
+                    if (param.walTrim)
+                        ioFilterGroupAdd(ioWriteFilterGroup(storageWriteIo(write)), walTrimNew());
+
                     if (param.walCompressType != compressTypeNone)
                         ioFilterGroupAdd(ioWriteFilterGroup(storageWriteIo(write)), compressFilterP(param.walCompressType, 1));
 
@@ -47,6 +47,7 @@ typedef struct HrnBackupPqScriptParam
     bool noArchiveCheck;                                            // Do not check archive
     bool walSwitch;                                                 // WAL switch is required
     CompressType walCompressType;                                   // Compress type for the archive files
+    bool walTrim;                                                   // Trim padding pages from the archive files
     CipherType cipherType;                                          // Cipher type
     const char *cipherPass;                                         // Cipher pass
     unsigned int walTotal;                                          // Total WAL to write
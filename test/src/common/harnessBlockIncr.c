@@ -27,7 +27,8 @@ hrnBlockDeltaRender(const BlockMap *const blockMap, const size_t blockSize, cons
     ASSERT(blockSize > 0);
 
     String *const result = strNew();
-    BlockDelta *const blockDelta = blockDeltaNew(blockMap, blockSize, checksumSize, NULL, cipherTypeNone, NULL, compressTypeNone);
+    BlockDelta *const blockDelta = blockDeltaNew(
+        blockMap, blockSize, checksumSize, NULL, 256 * 1024, cipherTypeNone, NULL, compressTypeNone);
 
     for (unsigned int readIdx = 0; readIdx < blockDeltaReadSize(blockDelta); readIdx++)
     {
@@ -41,8 +42,12 @@ hrnBlockDeltaRender(const BlockMap *const blockMap, const size_t blockSize, cons
         {
             const BlockDeltaSuperBlock *const superBlock = lstGet(read->superBlockList, superBlockIdx);
 
-            strCatFmt(
-                result, "  super block {max: %" PRIu64 ", size: %" PRIu64 "}\n", superBlock->superBlockSize, superBlock->size);
+            strCatFmt(result, "  super block {max: %" PRIu64 ", size: %" PRIu64, superBlock->superBlockSize, superBlock->size);
+
+            if (superBlock->gap > 0)
+                strCatFmt(result, ", gap: %" PRIu64, superBlock->gap);
+
+            strCatZ(result, "}\n");
 
             for (unsigned int blockIdx = 0; blockIdx < lstSize(superBlock->blockList); blockIdx++)
             {
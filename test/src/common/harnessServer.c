@@ -37,6 +37,7 @@ typedef enum
     hrnServerCmdExpect,
     hrnServerCmdReply,
     hrnServerCmdSleep,
+    hrnServerCmdSwap,
 } HrnServerCmd;
 
 /***********************************************************************************************************************************
@@ -236,6 +237,18 @@ hrnServerScriptSleep(IoWrite *write, TimeMSec sleepMs)
     FUNCTION_HARNESS_RETURN_VOID();
 }
 
+void
+hrnServerScriptSwap(IoWrite *write)
+{
+    FUNCTION_HARNESS_BEGIN();
+        FUNCTION_HARNESS_PARAM(IO_WRITE, write);
+    FUNCTION_HARNESS_END();
+
+    hrnServerScriptCommand(write, hrnServerCmdSwap, NULL);
+
+    FUNCTION_HARNESS_RETURN_VOID();
+}
+
 /**********************************************************************************************************************************/
 void
 hrnServerRun(IoRead *const read, const HrnServerProtocol protocol, const unsigned int port, HrnServerRunParam param)
@@ -274,6 +287,7 @@ hrnServerRun(IoRead *const read, const HrnServerProtocol protocol, const unsigne
 
     // Loop until no more commands
     IoSession *serverSession = NULL;
+    IoSession *serverSessionHeld = NULL;
     bool done = false;
 
     do
@@ -372,6 +386,16 @@ hrnServerRun(IoRead *const read, const HrnServerProtocol protocol, const unsigne
             case hrnServerCmdSleep:
                 sleepMSec(varUInt64Force(data));
                 break;
+
+            case hrnServerCmdSwap:
+            {
+                IoSession *const serverSessionSwap = serverSession;
+
+                serverSession = serverSessionHeld;
+                serverSessionHeld = serverSessionSwap;
+
+                break;
+            }
         }
     }
     while (!done);
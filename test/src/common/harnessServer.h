@@ -89,6 +89,10 @@ void hrnServerScriptReplyZ(IoWrite *write, const char *data);
 // Sleep specified milliseconds
 void hrnServerScriptSleep(IoWrite *write, TimeMSec sleepMs);
 
+// Swap the current session with the held session (initially none). This allows a new session to be accepted while the current
+// session is held open, e.g. to check that a request was sent on the new session before a response was sent on the held session.
+void hrnServerScriptSwap(IoWrite *write);
+
 /***********************************************************************************************************************************
 Getters/Setters
 ***********************************************************************************************************************************/
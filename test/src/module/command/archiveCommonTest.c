@@ -3,6 +3,10 @@ Test Archive Common
 ***********************************************************************************************************************************/
 #include <unistd.h>
 
+#include "command/archive/walTrim.h"
+#include "common/io/bufferRead.h"
+#include "common/io/filter/filter.intern.h"
+#include "common/io/io.h"
 #include "storage/helper.h"
 #include "storage/posix/storage.h"
 
@@ -10,6 +14,54 @@ Test Archive Common
 #include "common/harnessFork.h"
 #include "common/harnessStorage.h"
 
+/***********************************************************************************************************************************
+Add a WAL page. Pages with no data are padding pages.
+***********************************************************************************************************************************/
+#define TEST_WAL_PAGE_SIZE                                          8192
+#define TEST_WAL_SEGMENT_SIZE                                       (16 * 1024 * 1024)
+#define TEST_WAL_TRIM_TRAILER_SIZE                                  42
+
+static void
+testWalPage(Buffer *const wal, const uint32_t magic, const uint32_t timeline, const uint64_t addr, const unsigned char data)
+{
+    FUNCTION_HARNESS_BEGIN();
+        FUNCTION_HARNESS_PARAM(BUFFER, wal);
+        FUNCTION_HARNESS_PARAM(UINT32, magic);
+        FUNCTION_HARNESS_PARAM(UINT32, timeline);
+        FUNCTION_HARNESS_PARAM(UINT64, addr);
+        FUNCTION_HARNESS_PARAM(UINT, data);
+    FUNCTION_HARNESS_END();
+
+    unsigned char page[TEST_WAL_PAGE_SIZE] = {0};
+
+    memcpy(page, &magic, sizeof(magic));
+    memcpy(page + 4, &timeline, sizeof(timeline));
+    memcpy(page + 8, &addr, sizeof(addr));
+    page[TEST_WAL_PAGE_SIZE - 1] = data;
+
+    bufCatC(wal, page, 0, sizeof(page));
+
+    FUNCTION_HARNESS_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Run a buffer through a filter
+***********************************************************************************************************************************/
+static Buffer *
+testWalFilter(const Buffer *const input, IoFilter *const filter)
+{
+    FUNCTION_HARNESS_BEGIN();
+        FUNCTION_HARNESS_PARAM(BUFFER, input);
+        FUNCTION_HARNESS_PARAM(IO_FILTER, filter);
+    FUNCTION_HARNESS_END();
+
+    IoRead *const read = ioBufferReadNew(input);
+    ioFilterGroupAdd(ioReadFilterGroup(read), filter);
+    ioReadOpen(read);
+
+    FUNCTION_HARNESS_RETURN(BUFFER, ioReadBuf(read));
+}
+
 /***********************************************************************************************************************************
 Test Run
 ***********************************************************************************************************************************/
@@ -298,6 +350,26 @@ testRun(void)
             walSegmentFindOne(storageRepo(), STRDEF("9.6-2"), STRDEF("123456781234567812345678.partial"), 0), NULL,
             "did not find partial segment");
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("find in list");
+
+        StringList *const list = strLstNew();
+        strLstAddZ(list, "123456781234567812345677-eeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeee.gz");
+        strLstAddZ(list, "123456781234567812345678-aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa");
+        strLstAddZ(list, "123456781234567812345678-bbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbb.gz");
+        strLstAddZ(list, "123456781234567812345679-cccccccccccccccccccccccccccccccccccccccc.gz");
+
+        TEST_RESULT_STR_Z(
+            walSegmentFindList(list, STRDEF("123456781234567812345679")),
+            "123456781234567812345679-cccccccccccccccccccccccccccccccccccccccc.gz", "found segment");
+        TEST_RESULT_STR(walSegmentFindList(list, STRDEF("12345678123456781234567A")), NULL, "segment not found");
+        TEST_ERROR(
+            walSegmentFindList(list, STRDEF("123456781234567812345678")), ArchiveDuplicateError,
+            "duplicates found in archive for WAL segment 123456781234567812345678:"
+            " 123456781234567812345678-aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"
+            ", 123456781234567812345678-bbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbb.gz\n"
+            "HINT: are multiple primaries archiving to this stanza?");
+
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("find more than one segment with caching");
 
@@ -431,6 +503,200 @@ testRun(void)
             "get range >= 11/1MB");
     }
 
+    // *****************************************************************************************************************************
+    if (testBegin("walTrimNew() and walExpandNew(TEST_WAL_SEGMENT_SIZE)"))
+    {
+        const uint32_t magic = 0xD116;
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("trim final run of padding pages");
+
+        Buffer *wal = bufNew(0);
+
+        testWalPage(wal, magic | 0x00020000, 1, 0x1000000, 1);
+        testWalPage(wal, magic, 1, 0x1002000, 2);
+
+        for (unsigned int pageIdx = 2; pageIdx < 8; pageIdx++)
+            testWalPage(wal, magic, 1, 0x1000000 + pageIdx * TEST_WAL_PAGE_SIZE, 0);
+
+        Buffer *trim = NULL;
+
+        TEST_ASSIGN(trim, testWalFilter(wal, walTrimNew()), "trim");
+        TEST_RESULT_UINT(bufUsed(trim), 2 * TEST_WAL_PAGE_SIZE + TEST_WAL_TRIM_TRAILER_SIZE, "trimmed size");
+        TEST_RESULT_BOOL(
+            bufEq(bufNewC(bufPtr(trim), 2 * TEST_WAL_PAGE_SIZE), bufNewC(bufPtr(wal), 2 * TEST_WAL_PAGE_SIZE)), true, "data pages");
+        TEST_RESULT_BOOL(bufEq(testWalFilter(trim, walExpandNew(TEST_WAL_SEGMENT_SIZE)), wal), true, "expand");
+
+        const Buffer *const trailer = bufNewC(bufPtr(trim) + 2 * TEST_WAL_PAGE_SIZE, TEST_WAL_TRIM_TRAILER_SIZE);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("trailer has a fixed byte order");
+
+        TEST_RESULT_BOOL(bufEq(bufNewC(bufPtrConst(trailer), 8), bufNewC(bufPtr(wal) + 2 * TEST_WAL_PAGE_SIZE, 8)), true, "header");
+        TEST_RESULT_STR_Z(
+            strNewEncode(encodingHex, bufNewC(bufPtrConst(trailer) + 8, 24)),
+            "0000000001004000" "0000000000002000" "0000000000000006", "addr, step, and total are big-endian");
+        TEST_RESULT_STR_Z(
+            strNewEncode(encodingHex, bufNewC(bufPtrConst(trailer) + 33, 9)), "01" "504742525452494d", "version and magic");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("expand page addresses in the recorded byte order");
+
+        Buffer *const trimSwap = bufDup(trim);
+        bufPtr(trimSwap)[2 * TEST_WAL_PAGE_SIZE + 32] = !bufPtr(trimSwap)[2 * TEST_WAL_PAGE_SIZE + 32];
+
+        const Buffer *const expandSwap = testWalFilter(trimSwap, walExpandNew(TEST_WAL_SEGMENT_SIZE));
+
+        TEST_RESULT_UINT(bufUsed(expandSwap), bufUsed(wal), "expanded size");
+
+        unsigned char addrSwap[8];
+
+        for (unsigned int byteIdx = 0; byteIdx < 8; byteIdx++)
+            addrSwap[byteIdx] = bufPtrConst(wal)[2 * TEST_WAL_PAGE_SIZE + 8 + 7 - byteIdx];
+
+        TEST_RESULT_BOOL(memcmp(bufPtrConst(expandSwap) + 2 * TEST_WAL_PAGE_SIZE + 8, addrSwap, 8) == 0, true, "swapped address");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("invalid trailer");
+
+        TEST_ERROR(
+            testWalFilter(trim, walExpandNew(7 * TEST_WAL_PAGE_SIZE)), FormatError,
+            "WAL trim trailer expands 16384 bytes to more than the WAL segment size 57344");
+        TEST_ERROR(
+            testWalFilter(trim, walExpandNew(TEST_WAL_PAGE_SIZE)), FormatError,
+            "WAL trim trailer expands 16384 bytes to more than the WAL segment size 8192");
+
+        Buffer *const trimVersion = bufDup(trim);
+        bufPtr(trimVersion)[2 * TEST_WAL_PAGE_SIZE + 33] = 2;
+
+        TEST_ERROR(
+            testWalFilter(trimVersion, walExpandNew(TEST_WAL_SEGMENT_SIZE)), FormatError,
+            "WAL trim trailer version 2 does not match expected version 1");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("expand filter created from a param list");
+
+        IoFilter *const expandPack = walExpandNew(8 * TEST_WAL_PAGE_SIZE);
+
+        TEST_RESULT_BOOL(
+            bufEq(testWalFilter(trim, walExpandNewPack(ioFilterParamList(expandPack))), wal), true, "expand");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("trim and expand with a small buffer");
+
+        const size_t bufferSizeOld = ioBufferSize();
+        ioBufferSizeSet(1000);
+
+        TEST_RESULT_BOOL(bufEq(testWalFilter(wal, walTrimNew()), trim), true, "trim");
+        TEST_RESULT_BOOL(bufEq(testWalFilter(trim, walExpandNew(TEST_WAL_SEGMENT_SIZE)), wal), true, "expand");
+
+        ioBufferSizeSet(bufferSizeOld);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("runs broken by data, address gap, and header change");
+
+        wal = bufNew(0);
+
+        testWalPage(wal, magic | 0x00020000, 1, 0x1000000, 0);
+        testWalPage(wal, magic, 1, 0x1002000, 0);
+        testWalPage(wal, magic, 1, 0x1004000, 3);
+        testWalPage(wal, magic, 1, 0x1006000, 0);
+        testWalPage(wal, magic, 1, 0x100A000, 0);
+        testWalPage(wal, magic, 2, 0x100C000, 0);
+        testWalPage(wal, 0, 0, 0, 0);
+        testWalPage(wal, 0, 0, 0, 0);
+        testWalPage(wal, 0, 0, 0, 0);
+
+        TEST_ASSIGN(trim, testWalFilter(wal, walTrimNew()), "trim");
+        TEST_RESULT_UINT(bufUsed(trim), 6 * TEST_WAL_PAGE_SIZE + TEST_WAL_TRIM_TRAILER_SIZE, "trimmed size");
+        TEST_RESULT_BOOL(bufEq(testWalFilter(trim, walExpandNew(TEST_WAL_SEGMENT_SIZE)), wal), true, "expand");
+
+        ioBufferSizeSet(1024);
+
+        TEST_RESULT_BOOL(bufEq(testWalFilter(wal, walTrimNew()), trim), true, "trim with small buffer");
+        TEST_RESULT_BOOL(bufEq(testWalFilter(trim, walExpandNew(TEST_WAL_SEGMENT_SIZE)), wal), true, "expand with small buffer");
+
+        IoRead *read = ioBufferReadNew(wal);
+        ioFilterGroupAdd(ioReadFilterGroup(read), walTrimNew());
+        ioFilterGroupAdd(ioReadFilterGroup(read), walExpandNew(TEST_WAL_SEGMENT_SIZE));
+        ioReadOpen(read);
+
+        TEST_RESULT_BOOL(bufEq(ioReadBuf(read), wal), true, "trim and expand in the same filter group");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("expand output is full after all input has been processed");
+
+        Buffer *const input = bufNew(100);
+        memset(bufPtr(input), 'X', bufSize(input));
+        bufUsedSet(input, bufSize(input));
+
+        IoFilter *const expand = walExpandNew(TEST_WAL_SEGMENT_SIZE);
+        Buffer *const output = bufNew(10);
+
+        TEST_RESULT_VOID(ioFilterProcessInOut(expand, input, output), "process");
+        TEST_RESULT_BOOL(ioFilterInputSame(expand), true, "same input required");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("expand output is full before all input has been processed");
+
+        Buffer *const inputLarge = bufNew(TEST_WAL_PAGE_SIZE + 100);
+        memset(bufPtr(inputLarge), 'X', bufSize(inputLarge));
+        bufUsedSet(inputLarge, bufSize(inputLarge));
+
+        IoFilter *const expandLarge = walExpandNew(TEST_WAL_SEGMENT_SIZE);
+        bufUsedZero(output);
+
+        TEST_RESULT_VOID(ioFilterProcessInOut(expandLarge, inputLarge, output), "process");
+        TEST_RESULT_BOOL(ioFilterInputSame(expandLarge), true, "same input required");
+
+        ioBufferSizeSet(bufferSizeOld);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("partial page is not trimmed");
+
+        wal = bufNew(0);
+
+        testWalPage(wal, magic | 0x00020000, 1, 0x1000000, 1);
+        testWalPage(wal, magic, 1, 0x1002000, 0);
+        bufCatC(wal, (const unsigned char *)"PARTIAL", 0, 7);
+
+        TEST_RESULT_BOOL(bufEq(testWalFilter(wal, walTrimNew()), wal), true, "trim");
+        TEST_RESULT_BOOL(bufEq(testWalFilter(wal, walExpandNew(TEST_WAL_SEGMENT_SIZE)), wal), true, "expand");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("segment without padding is not trimmed");
+
+        wal = bufNew(0);
+
+        testWalPage(wal, magic | 0x00020000, 1, 0x1000000, 1);
+        testWalPage(wal, magic, 1, 0x1002000, 0);
+        testWalPage(wal, magic, 1, 0x1004000, 2);
+
+        TEST_RESULT_BOOL(bufEq(testWalFilter(wal, walTrimNew()), wal), true, "trim");
+        TEST_RESULT_BOOL(bufEq(testWalFilter(wal, walExpandNew(TEST_WAL_SEGMENT_SIZE)), wal), true, "expand");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("expand passes through files that do not end with a trailer");
+
+        TEST_RESULT_BOOL(
+            bufEq(testWalFilter(BUFSTRDEF("SHORT"), walExpandNew(TEST_WAL_SEGMENT_SIZE)), BUFSTRDEF("SHORT")), true, "short file");
+        TEST_RESULT_BOOL(bufEq(testWalFilter(bufNew(0), walExpandNew(TEST_WAL_SEGMENT_SIZE)), bufNew(0)), true, "empty file");
+        TEST_RESULT_BOOL(bufEq(testWalFilter(bufNew(0), walTrimNew()), bufNew(0)), true, "trim empty file");
+
+        trim = bufDup(testWalFilter(BUFSTRDEF("X"), walTrimNew()));
+        bufCat(trim, trailer);
+
+        TEST_RESULT_BOOL(
+            bufEq(testWalFilter(trim, walExpandNew(TEST_WAL_SEGMENT_SIZE)), trim), true, "trailer not following complete pages");
+
+        wal = bufNew(0);
+
+        testWalPage(wal, magic | 0x00020000, 1, 0x1000000, 1);
+        bufCatC(wal, bufPtr(wal) + 100, 0, TEST_WAL_TRIM_TRAILER_SIZE);
+
+        TEST_RESULT_BOOL(bufEq(testWalFilter(wal, walExpandNew(TEST_WAL_SEGMENT_SIZE)), wal), true, "trailer without magic");
+    }
+
     // *****************************************************************************************************************************
     if (testBegin("archiveIdComparator()"))
     {
@@ -1,6 +1,7 @@
 /***********************************************************************************************************************************
 Test Archive Get Command
 ***********************************************************************************************************************************/
+#include "command/archive/walTrim.h"
 #include "common/io/fdRead.h"
 #include "common/io/fdWrite.h"
 
@@ -32,20 +33,15 @@ testRun(void)
         size_t queueSize = 16 * 1024 * 1024;
         size_t walSegmentSize = 16 * 1024 * 1024;
 
-        // -------------------------------------------------------------------------------------------------------------------------
-        TEST_TITLE("path missing");
-
-        TEST_ERROR(
-            queueNeed(STRDEF("000000010000000100000001"), false, queueSize, walSegmentSize, PG_VERSION_95),
-            PathMissingError, "unable to list file info for missing path '" TEST_PATH "/spool/archive/test1/in'");
-
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("queue size too small");
 
         HRN_STORAGE_PATH_CREATE(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN);
 
         TEST_RESULT_STRLST_Z(
-            queueNeed(STRDEF("000000010000000100000001"), false, queueSize, walSegmentSize, PG_VERSION_95),
+            queueNeed(
+                STRDEF("000000010000000100000001"), false, queueSize, queueSize, walSegmentSize, PG_VERSION_95,
+                storageListP(storageSpool(), STORAGE_SPOOL_ARCHIVE_IN_STR)),
             "000000010000000100000001\n000000010000000100000002\n", "queue size smaller than min");
 
         // -------------------------------------------------------------------------------------------------------------------------
@@ -54,7 +50,9 @@ testRun(void)
         queueSize = (16 * 1024 * 1024) * 3;
 
         TEST_RESULT_STRLST_Z(
-            queueNeed(STRDEF("000000010000000100000001"), false, queueSize, walSegmentSize, PG_VERSION_95),
+            queueNeed(
+                STRDEF("000000010000000100000001"), false, queueSize, queueSize, walSegmentSize, PG_VERSION_95,
+                storageListP(storageSpool(), STORAGE_SPOOL_ARCHIVE_IN_STR)),
             "000000010000000100000001\n000000010000000100000002\n000000010000000100000003\n", "empty queue");
 
         // -------------------------------------------------------------------------------------------------------------------------
@@ -83,12 +81,77 @@ testRun(void)
         HRN_STORAGE_PUT_EMPTY(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN "/000000010000000B00000000.ok");
 
         TEST_RESULT_STRLST_Z(
-            queueNeed(STRDEF("000000010000000A00000FFD"), true, queueSize, walSegmentSize, PG_VERSION_11),
+            queueNeed(
+                STRDEF("000000010000000A00000FFD"), true, queueSize, queueSize, walSegmentSize, PG_VERSION_11,
+                storageListP(storageSpool(), STORAGE_SPOOL_ARCHIVE_IN_STR)),
             "000000010000000B00000000\n000000010000000B00000001\n000000010000000B00000002\n", "queue has wal");
 
         TEST_STORAGE_LIST(
             storageSpool(), STORAGE_SPOOL_ARCHIVE_IN,
             "000000010000000A00000FFE\n000000010000000A00000FFF\n000000010000000A00000FFF.ok\n");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("reduced queue size keeps fetched WAL");
+
+        TEST_RESULT_STRLST_Z(
+            queueNeed(
+                STRDEF("000000010000000A00000FFC"), true, walSegmentSize * 2, queueSize, walSegmentSize, PG_VERSION_11,
+                storageListP(storageSpool(), STORAGE_SPOOL_ARCHIVE_IN_STR)),
+            "000000010000000A00000FFD\n", "only missing wal in reduced queue needed");
+
+        TEST_STORAGE_LIST(
+            storageSpool(), STORAGE_SPOOL_ARCHIVE_IN,
+            "000000010000000A00000FFE\n000000010000000A00000FFF\n000000010000000A00000FFF.ok\n",
+            .comment = "wal beyond reduced queue is kept");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("adaptive queue size");
+
+        queueSize = walSegmentSize * 16;
+
+        TEST_RESULT_UINT(
+            queueSizeAdaptive(false, queueSize, walSegmentSize, &(ArchiveGetStat){.replay = 1000, .fetch = 1000}), queueSize,
+            "segment not found uses max");
+        TEST_RESULT_UINT(
+            queueSizeAdaptive(true, queueSize, walSegmentSize, &(ArchiveGetStat){.replay = 1000}), queueSize,
+            "fetch not measured uses max");
+        TEST_RESULT_UINT(
+            queueSizeAdaptive(true, queueSize, walSegmentSize, &(ArchiveGetStat){.fetch = 1000}), queueSize,
+            "replay not measured uses max");
+        TEST_RESULT_UINT(
+            queueSizeAdaptive(true, queueSize, walSegmentSize, &(ArchiveGetStat){.replay = 60000, .fetch = 1000}),
+            walSegmentSize * 2, "slow replay uses min");
+        TEST_RESULT_UINT(
+            queueSizeAdaptive(true, queueSize, walSegmentSize, &(ArchiveGetStat){.replay = 400, .fetch = 1000}),
+            walSegmentSize * 5, "replay faster than fetch");
+        TEST_RESULT_UINT(
+            queueSizeAdaptive(true, queueSize, walSegmentSize, &(ArchiveGetStat){.replay = 10, .fetch = 1000}), queueSize,
+            "fast replay limited to max");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("stats");
+
+        TEST_RESULT_UINT(archiveGetStatLoad().replay, 0, "missing stats");
+
+        HRN_STORAGE_PUT_Z(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE "/get.stat", "BOGUS");
+        TEST_RESULT_UINT(archiveGetStatLoad().replay, 0, "invalid stats");
+
+        HRN_STORAGE_PUT_Z(
+            storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE "/get.stat", "{\"fetch\":3,\"replay\":2,\"timeLast\":1,\"version\":999}");
+        TEST_RESULT_UINT(archiveGetStatLoad().replay, 0, "invalid stats version");
+
+        TEST_RESULT_VOID(archiveGetStatSave(&(ArchiveGetStat){.timeLast = 1, .replay = 2, .fetch = 3}), "save stats");
+        TEST_STORAGE_GET(
+            storageSpool(), STORAGE_SPOOL_ARCHIVE "/get.stat", "{\"fetch\":3,\"replay\":2,\"timeLast\":1,\"version\":1}",
+            .comment = "check stats file");
+
+        ArchiveGetStat stat = archiveGetStatLoad();
+        TEST_RESULT_UINT(stat.timeLast, 1, "check time last");
+        TEST_RESULT_UINT(stat.replay, 2, "check replay");
+        TEST_RESULT_UINT(stat.fetch, 3, "check fetch");
+
+        TEST_RESULT_UINT(archiveGetStatAvg(0, 1000), 1000, "first sample");
+        TEST_RESULT_UINT(archiveGetStatAvg(1000, 2000), 1250, "moving average");
     }
 
     // *****************************************************************************************************************************
@@ -554,6 +617,181 @@ testRun(void)
         TEST_STORAGE_LIST(
             storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN, "000000010000000200000000.pgbackrest.tmp\n", .remove = true);
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("race repos where first repo fails checksum validation");
+
+        HRN_STORAGE_REMOVE(
+            storageRepoIdxWrite(0),
+            STORAGE_REPO_ARCHIVE "/10-1/000000010000000200000000-aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa.gz",
+            .errorOnMissing = true);
+        HRN_STORAGE_REMOVE(
+            storageRepoIdxWrite(1),
+            STORAGE_REPO_ARCHIVE "/10-1/000000010000000200000000-aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa.gz",
+            .errorOnMissing = true);
+
+        argList = strLstDup(argBaseList);
+        hrnCfgArgRawBool(argList, cfgOptArchiveGetRace, true);
+        strLstAddZ(argList, "000000010000000200000000");
+        strLstAddZ(argList, "000000010000000200000001");
+        HRN_CFG_LOAD(cfgCmdArchiveGet, argList, .role = cfgCmdRoleAsync);
+
+        HRN_STORAGE_PUT_Z(
+            storageRepoIdxWrite(0), STORAGE_REPO_ARCHIVE "/10-1/000000010000000200000000-cc1799bcc4ba935246708543c67d4e68b2c3e8b0",
+            "BOGUS");
+        HRN_STORAGE_PUT_Z(
+            storageRepoIdxWrite(1), STORAGE_REPO_ARCHIVE "/10-1/000000010000000200000000-cc1799bcc4ba935246708543c67d4e68b2c3e8b0",
+            "WALDATA");
+        HRN_STORAGE_PUT_Z(
+            storageRepoIdxWrite(0), STORAGE_REPO_ARCHIVE "/10-1/000000010000000200000001-cc1799bcc4ba935246708543c67d4e68b2c3e8b0",
+            "WALDATA");
+
+        TEST_RESULT_VOID(cmdArchiveGetAsync(), "archive async");
+
+        TEST_RESULT_LOG(
+            "P00   INFO: get 2 WAL file(s) from archive: 000000010000000200000000...000000010000000200000001\n"
+            "P00   WARN: repo3: [ArchiveMismatchError] unable to retrieve the archive id for database version '10' and system-id"
+            " '" HRN_PG_SYSTEMID_10_Z "'\n"
+            "P01   WARN: [FileReadError] raised from local-1 shim protocol: unable to get 000000010000000200000000:\n"
+            "            repo1: 10-1/0000000100000002/000000010000000200000000-cc1799bcc4ba935246708543c67d4e68b2c3e8b0"
+            " [ChecksumError] actual checksum '06e270f495c735ba25c5627945f4c80a5bc7118b' does not match expected checksum"
+            " 'cc1799bcc4ba935246708543c67d4e68b2c3e8b0'\n"
+            "P01 DETAIL: found 000000010000000200000000 in the repo2: 10-1 archive\n"
+            "P01 DETAIL: found 000000010000000200000001 in the repo1: 10-1 archive");
+
+        TEST_STORAGE_GET(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN "/000000010000000200000000", "WALDATA", .remove = true);
+        TEST_STORAGE_GET(
+            storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN "/000000010000000200000000.ok",
+            "0\n"
+            "repo3: [ArchiveMismatchError] unable to retrieve the archive id for database version '10' and system-id"
+            " '" HRN_PG_SYSTEMID_10_Z "'",
+            .remove = true);
+        TEST_STORAGE_GET(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN "/000000010000000200000001", "WALDATA", .remove = true);
+        TEST_STORAGE_GET(
+            storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN "/000000010000000200000001.ok",
+            "0\n"
+            "repo3: [ArchiveMismatchError] unable to retrieve the archive id for database version '10' and system-id"
+            " '" HRN_PG_SYSTEMID_10_Z "'",
+            .remove = true);
+        TEST_STORAGE_LIST_EMPTY(storageSpool(), STORAGE_SPOOL_ARCHIVE_IN);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("race repos in parallel");
+
+        argList = strLstDup(argBaseList);
+        hrnCfgArgRawBool(argList, cfgOptArchiveGetRace, true);
+        hrnCfgArgRawZ(argList, cfgOptProcessMax, "2");
+        strLstAddZ(argList, "000000010000000200000000");
+        HRN_CFG_LOAD(cfgCmdArchiveGet, argList, .role = cfgCmdRoleAsync);
+
+        HRN_STORAGE_PUT_Z(
+            storageRepoIdxWrite(0), STORAGE_REPO_ARCHIVE "/10-1/000000010000000200000000-cc1799bcc4ba935246708543c67d4e68b2c3e8b0",
+            "WALDATA");
+
+        // The winner is not deterministic so only log warnings
+        harnessLogLevelSet(logLevelWarn);
+
+        TEST_RESULT_VOID(cmdArchiveGetAsync(), "archive async");
+
+        TEST_RESULT_LOG(
+            "P00   WARN: repo3: [ArchiveMismatchError] unable to retrieve the archive id for database version '10' and system-id"
+            " '" HRN_PG_SYSTEMID_10_Z "'");
+
+        harnessLogLevelSet(logLevelDetail);
+
+        TEST_STORAGE_GET(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN "/000000010000000200000000", "WALDATA", .remove = true);
+        TEST_STORAGE_GET(
+            storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN "/000000010000000200000000.ok",
+            "0\n"
+            "repo3: [ArchiveMismatchError] unable to retrieve the archive id for database version '10' and system-id"
+            " '" HRN_PG_SYSTEMID_10_Z "'",
+            .remove = true);
+        TEST_STORAGE_LIST_EMPTY(storageSpool(), STORAGE_SPOOL_ARCHIVE_IN);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("race repos where all repos fail checksum validation");
+
+        argList = strLstDup(argBaseList);
+        hrnCfgArgRawBool(argList, cfgOptArchiveGetRace, true);
+        strLstAddZ(argList, "000000010000000200000000");
+        HRN_CFG_LOAD(cfgCmdArchiveGet, argList, .role = cfgCmdRoleAsync);
+
+        HRN_STORAGE_PUT_Z(
+            storageRepoIdxWrite(0), STORAGE_REPO_ARCHIVE "/10-1/000000010000000200000000-cc1799bcc4ba935246708543c67d4e68b2c3e8b0",
+            "BOGUS");
+        HRN_STORAGE_PUT_Z(
+            storageRepoIdxWrite(1), STORAGE_REPO_ARCHIVE "/10-1/000000010000000200000000-cc1799bcc4ba935246708543c67d4e68b2c3e8b0",
+            "BOGUS");
+
+        TEST_RESULT_VOID(cmdArchiveGetAsync(), "archive async");
+
+        TEST_RESULT_LOG(
+            "P00   INFO: get 1 WAL file(s) from archive: 000000010000000200000000\n"
+            "P00   WARN: repo3: [ArchiveMismatchError] unable to retrieve the archive id for database version '10' and system-id"
+            " '" HRN_PG_SYSTEMID_10_Z "'\n"
+            "P01   WARN: [FileReadError] raised from local-1 shim protocol: unable to get 000000010000000200000000:\n"
+            "            repo1: 10-1/0000000100000002/000000010000000200000000-cc1799bcc4ba935246708543c67d4e68b2c3e8b0"
+            " [ChecksumError] actual checksum '06e270f495c735ba25c5627945f4c80a5bc7118b' does not match expected checksum"
+            " 'cc1799bcc4ba935246708543c67d4e68b2c3e8b0'\n"
+            "P01   WARN: [FileReadError] raised from local-1 shim protocol: unable to get 000000010000000200000000:\n"
+            "            repo2: 10-1/0000000100000002/000000010000000200000000-cc1799bcc4ba935246708543c67d4e68b2c3e8b0"
+            " [ChecksumError] actual checksum '06e270f495c735ba25c5627945f4c80a5bc7118b' does not match expected checksum"
+            " 'cc1799bcc4ba935246708543c67d4e68b2c3e8b0'");
+
+        TEST_STORAGE_GET(
+            storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN "/000000010000000200000000.error",
+            "42\n"
+            "raised from local-1 shim protocol: unable to get 000000010000000200000000:\n"
+            "repo2: 10-1/0000000100000002/000000010000000200000000-cc1799bcc4ba935246708543c67d4e68b2c3e8b0 [ChecksumError] actual"
+            " checksum '06e270f495c735ba25c5627945f4c80a5bc7118b' does not match expected checksum"
+            " 'cc1799bcc4ba935246708543c67d4e68b2c3e8b0'\n"
+            "repo3: [ArchiveMismatchError] unable to retrieve the archive id for database version '10' and system-id"
+            " '" HRN_PG_SYSTEMID_10_Z "'",
+            .remove = true);
+        TEST_STORAGE_LIST_EMPTY(storageSpool(), STORAGE_SPOOL_ARCHIVE_IN);
+
+        HRN_STORAGE_REMOVE(
+            storageRepoIdxWrite(0), STORAGE_REPO_ARCHIVE "/10-1/000000010000000200000000-cc1799bcc4ba935246708543c67d4e68b2c3e8b0",
+            .errorOnMissing = true);
+        HRN_STORAGE_REMOVE(
+            storageRepoIdxWrite(1), STORAGE_REPO_ARCHIVE "/10-1/000000010000000200000000-cc1799bcc4ba935246708543c67d4e68b2c3e8b0",
+            .errorOnMissing = true);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("race repos where first repo wins and remaining repos are skipped");
+
+        argList = strLstDup(argBaseList);
+        hrnCfgArgRawBool(argList, cfgOptArchiveGetRace, true);
+        strLstAddZ(argList, "000000010000000200000000");
+        HRN_CFG_LOAD(cfgCmdArchiveGet, argList, .role = cfgCmdRoleAsync);
+
+        // Fix repo3 archive info so the file is found in all three repos
+        HRN_INFO_PUT(
+            storageRepoIdxWrite(2), INFO_ARCHIVE_PATH_FILE,
+            "[db]\n"
+            "db-id=1\n"
+            "\n"
+            "[db:history]\n"
+            "1={\"db-id\":" HRN_PG_SYSTEMID_10_Z ",\"db-version\":\"10\"}\n");
+
+        HRN_STORAGE_PUT_Z(
+            storageRepoIdxWrite(0), STORAGE_REPO_ARCHIVE "/10-1/000000010000000200000000-cc1799bcc4ba935246708543c67d4e68b2c3e8b0",
+            "WALDATA");
+        HRN_STORAGE_PUT_Z(
+            storageRepoIdxWrite(1), STORAGE_REPO_ARCHIVE "/10-1/000000010000000200000000-cc1799bcc4ba935246708543c67d4e68b2c3e8b0",
+            "WALDATA");
+        HRN_STORAGE_PUT_Z(
+            storageRepoIdxWrite(2), STORAGE_REPO_ARCHIVE "/10-1/000000010000000200000000-cc1799bcc4ba935246708543c67d4e68b2c3e8b0",
+            "WALDATA");
+
+        TEST_RESULT_VOID(cmdArchiveGetAsync(), "archive async");
+
+        TEST_RESULT_LOG(
+            "P00   INFO: get 1 WAL file(s) from archive: 000000010000000200000000\n"
+            "P01 DETAIL: found 000000010000000200000000 in the repo1: 10-1 archive");
+
+        TEST_STORAGE_GET(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN "/000000010000000200000000", "WALDATA", .remove = true);
+        TEST_STORAGE_LIST_EMPTY(storageSpool(), STORAGE_SPOOL_ARCHIVE_IN);
+
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("global error on invalid executable");
 
@@ -720,6 +958,9 @@ testRun(void)
         hrnCfgArgRawZ(argList, cfgOptArchiveGetQueueMax, "48");
         HRN_CFG_LOAD(cfgCmdArchiveGet, argList, .exeBogus = true);
 
+        // Last time in the future (e.g. clock moved backward) is not used to measure replay
+        archiveGetStatSave(&(ArchiveGetStat){.timeLast = UINT64_MAX});
+
         // Write more WAL segments (in this case queue should be full)
         HRN_STORAGE_PUT_Z(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN "/000000010000000100000001", "SHOULD-BE-A-REAL-WAL-FILE");
         HRN_STORAGE_PUT_Z(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN "/000000010000000100000001.ok", "0\nwarning about x");
@@ -846,6 +1087,27 @@ testRun(void)
 
         TEST_RESULT_LOG("P00   INFO: found 01ABCDEF01ABCDEF01ABCDEF in the repo1: 10-1 archive");
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("get trimmed WAL segment");
+
+        memset(bufPtr(buffer), 0xFF, 16);
+
+        const String *const walTrimFile = STRDEF(
+            STORAGE_REPO_ARCHIVE "/10-1/01ABCDEF01ABCDEF01ABCDEF-aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa");
+        StorageWrite *const write = storageNewWriteP(storageRepoWrite(), walTrimFile);
+        ioFilterGroupAdd(ioWriteFilterGroup(storageWriteIo(write)), walTrimNew());
+
+        TEST_RESULT_VOID(storagePutP(write, buffer), "put trimmed segment");
+        TEST_RESULT_UINT(storageInfoP(storageRepo(), walTrimFile).size, 8192 + 42, "check trimmed size");
+
+        TEST_RESULT_INT(cmdArchiveGet(), 0, "get");
+
+        TEST_RESULT_LOG("P00   INFO: found 01ABCDEF01ABCDEF01ABCDEF in the repo1: 10-1 archive");
+
+        TEST_RESULT_BOOL(
+            bufEq(storageGetP(storageNewReadP(storagePg(), STRDEF("pg_wal/RECOVERYXLOG"))), buffer), true,
+            "check expanded segment");
+
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("get WAL segment with a modified control/catalog version");
 
@@ -1183,6 +1445,239 @@ testRun(void)
 
         // Check that the ok file was removed
         TEST_STORAGE_LIST_EMPTY(storageSpool(), STORAGE_SPOOL_ARCHIVE_IN);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("get WAL segment and add to cache");
+
+        const Storage *const storageCache = storagePosixNewP(STRDEF(TEST_PATH "/cache"), .write = true);
+
+        argList = strLstDup(argBaseList);
+        hrnCfgArgRawZ(argList, cfgOptArchiveGetCachePath, TEST_PATH "/cache");
+        hrnCfgArgRawZ(argList, cfgOptArchiveGetCacheMax, "16");
+        strLstAddZ(argList, "000000010000000100000002");
+        strLstAddZ(argList, TEST_PATH "/pg/pg_wal/RECOVERYXLOG");
+        HRN_CFG_LOAD(cfgCmdArchiveGet, argList);
+
+        HRN_STORAGE_PUT_Z(
+            storageRepoWrite(), STORAGE_REPO_ARCHIVE "/10-2/000000010000000100000002-aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa",
+            "SEGMENT2", .compressType = compressTypeGz);
+
+        TEST_RESULT_INT(cmdArchiveGet(), 0, "get");
+        TEST_RESULT_LOG("P00   INFO: found 000000010000000100000002 in the repo1: 10-2 archive");
+
+        TEST_STORAGE_GET(storagePgWrite(), "pg_wal/RECOVERYXLOG", "SEGMENT2", .remove = true);
+        TEST_STORAGE_LIST(
+            storageCache, "test1/10-2", "000000010000000100000002\n000000010000000100000002.lock\n",
+            .comment = "segment is decompressed in cache");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("get WAL segment from cache");
+
+        HRN_STORAGE_PUT_Z(
+            storageRepoWrite(), STORAGE_REPO_ARCHIVE "/10-2/000000010000000100000002-aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa",
+            "SEGMENT2-REPO", .compressType = compressTypeGz);
+
+        TEST_RESULT_INT(cmdArchiveGet(), 0, "get");
+        TEST_RESULT_LOG("P00   INFO: found 000000010000000100000002 in the repo1: 10-2 archive");
+
+        TEST_STORAGE_GET(storagePgWrite(), "pg_wal/RECOVERYXLOG", "SEGMENT2", .remove = true, .comment = "segment from cache");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("add WAL segments to cache, evict oldest, and remove stale files");
+
+        HRN_STORAGE_PUT_Z(
+            storageRepoWrite(), STORAGE_REPO_ARCHIVE "/10-2/000000010000000100000003-aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa",
+            "SEGMENT3");
+        HRN_STORAGE_PUT_Z(
+            storageRepoWrite(), STORAGE_REPO_ARCHIVE "/10-2/000000010000000100000004-aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa",
+            "SEGMENT4");
+        HRN_STORAGE_PUT_Z(storageCache, "test1/10-2/000000010000000100000003.pgbackrest.tmp", "TMP");
+        HRN_STORAGE_PUT_Z(storageCache, "test1/10-1/000000010000000100000001", "SEGMENT1", .timeModified = 1000000000);
+        HRN_STORAGE_PUT_Z(storageCache, "test1/10-1/000000010000000100000009.pgbackrest.tmp", "TMP");
+        HRN_STORAGE_PUT_Z(storageCache, "test1/10-1/other", "OTHER");
+        HRN_STORAGE_PUT_Z(storageCache, "test1/10-3/000000010000000100000001", "SEGMENT1", .timeModified = 1000000001);
+        HRN_STORAGE_PUT_EMPTY(storageCache, "test1/10-3/000000010000000100000008.lock");
+
+        argList = strLstDup(argBaseList);
+        hrnCfgArgRawZ(argList, cfgOptArchiveGetCachePath, TEST_PATH "/cache");
+        hrnCfgArgRawZ(argList, cfgOptArchiveGetCacheMax, "16");
+        strLstAddZ(argList, "000000010000000100000003");
+        strLstAddZ(argList, TEST_PATH "/pg/pg_wal/RECOVERYXLOG");
+        HRN_CFG_LOAD(cfgCmdArchiveGet, argList);
+
+        TEST_RESULT_INT(cmdArchiveGet(), 0, "get");
+        TEST_RESULT_LOG("P00   INFO: found 000000010000000100000003 in the repo1: 10-2 archive");
+
+        argList = strLstDup(argBaseList);
+        hrnCfgArgRawZ(argList, cfgOptArchiveGetCachePath, TEST_PATH "/cache");
+        hrnCfgArgRawZ(argList, cfgOptArchiveGetCacheMax, "16");
+        strLstAddZ(argList, "000000010000000100000004");
+        strLstAddZ(argList, TEST_PATH "/pg/pg_wal/RECOVERYXLOG");
+        HRN_CFG_LOAD(cfgCmdArchiveGet, argList);
+
+        TEST_RESULT_INT(cmdArchiveGet(), 0, "get");
+        TEST_RESULT_LOG("P00   INFO: found 000000010000000100000004 in the repo1: 10-2 archive");
+
+        TEST_STORAGE_GET(storagePgWrite(), "pg_wal/RECOVERYXLOG", "SEGMENT4", .remove = true);
+        TEST_STORAGE_LIST(
+            storageCache, "test1/10-2",
+            "000000010000000100000003\n000000010000000100000003.lock\n000000010000000100000004\n"
+            "000000010000000100000004.lock\n",
+            .comment = "oldest segment evicted");
+        TEST_STORAGE_LIST(
+            storageCache, "test1/10-1", "other\n", .comment = "oldest segment and stale temp file removed, other file remains");
+        TEST_STORAGE_LIST_EMPTY(storageCache, "test1/10-3", .comment = "oldest segment and stale lock file removed");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("segment added and locked segments are not evicted");
+
+        const int fdLocked = archiveGetCacheLock(storageCache, STRDEF("test1/10-2/000000010000000100000004"), false);
+
+        argList = strLstDup(argBaseList);
+        hrnCfgArgRawZ(argList, cfgOptArchiveGetCachePath, TEST_PATH "/cache");
+        hrnCfgArgRawZ(argList, cfgOptArchiveGetCacheMax, "0");
+        strLstAddZ(argList, "000000010000000100000002");
+        strLstAddZ(argList, TEST_PATH "/pg/pg_wal/RECOVERYXLOG");
+        HRN_CFG_LOAD(cfgCmdArchiveGet, argList);
+
+        TEST_RESULT_INT(cmdArchiveGet(), 0, "get");
+        TEST_RESULT_LOG("P00   INFO: found 000000010000000100000002 in the repo1: 10-2 archive");
+
+        close(fdLocked);
+
+        TEST_STORAGE_GET(storagePgWrite(), "pg_wal/RECOVERYXLOG", "SEGMENT2-REPO", .remove = true);
+        TEST_STORAGE_LIST(
+            storageCache, "test1/10-2",
+            "000000010000000100000002\n000000010000000100000002.lock\n000000010000000100000004\n"
+            "000000010000000100000004.lock\n",
+            .comment = "segment added and locked segment remain");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("segment added to cache by another process while waiting for lock");
+
+        HRN_FORK_BEGIN()
+        {
+            HRN_FORK_CHILD_BEGIN()
+            {
+                // Lock segment and notify parent
+                const int fd = archiveGetCacheLock(storageCache, STRDEF("test1/10-2/000000010000000100000003"), true);
+                HRN_FORK_CHILD_NOTIFY_PUT();
+
+                // Add segment to the cache and release the lock once the parent is waiting
+                sleepMSec(500);
+                HRN_STORAGE_PUT_Z(storageCache, "test1/10-2/000000010000000100000003", "SEGMENT3-CHILD");
+                close(fd);
+            }
+            HRN_FORK_CHILD_END();
+
+            HRN_FORK_PARENT_BEGIN()
+            {
+                HRN_FORK_PARENT_NOTIFY_GET(0);
+
+                argList = strLstDup(argBaseList);
+                hrnCfgArgRawZ(argList, cfgOptArchiveGetCachePath, TEST_PATH "/cache");
+                strLstAddZ(argList, "000000010000000100000003");
+                strLstAddZ(argList, TEST_PATH "/pg/pg_wal/RECOVERYXLOG");
+                HRN_CFG_LOAD(cfgCmdArchiveGet, argList);
+
+                TEST_RESULT_INT(cmdArchiveGet(), 0, "get");
+                TEST_RESULT_LOG("P00   INFO: found 000000010000000100000003 in the repo1: 10-2 archive");
+
+                TEST_STORAGE_GET(storagePgWrite(), "pg_wal/RECOVERYXLOG", "SEGMENT3-CHILD", .remove = true);
+            }
+            HRN_FORK_PARENT_END();
+        }
+        HRN_FORK_END();
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("partial segment is not cached");
+
+        HRN_STORAGE_PUT_Z(
+            storageRepoWrite(),
+            STORAGE_REPO_ARCHIVE "/10-2/000000010000000100000003.partial-aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa", "PARTIAL");
+
+        argList = strLstDup(argBaseList);
+        hrnCfgArgRawZ(argList, cfgOptArchiveGetCachePath, TEST_PATH "/cache");
+        strLstAddZ(argList, "000000010000000100000003.partial");
+        strLstAddZ(argList, TEST_PATH "/pg/pg_wal/RECOVERYXLOG");
+        HRN_CFG_LOAD(cfgCmdArchiveGet, argList);
+
+        TEST_RESULT_INT(cmdArchiveGet(), 0, "get");
+        TEST_RESULT_LOG("P00   INFO: found 000000010000000100000003.partial in the repo1: 10-2 archive");
+
+        TEST_STORAGE_GET(storagePgWrite(), "pg_wal/RECOVERYXLOG", "PARTIAL", .remove = true);
+        TEST_STORAGE_LIST(
+            storageCache, "test1/10-2",
+            "000000010000000100000002\n000000010000000100000002.lock\n000000010000000100000003\n"
+            "000000010000000100000003.lock\n000000010000000100000004\n000000010000000100000004.lock\n",
+            .comment = "partial not in cache");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("error on cache lock");
+
+        argList = strLstDup(argBaseList);
+        hrnCfgArgRawZ(argList, cfgOptArchiveGetCachePath, TEST_PATH "/cache");
+        strLstAddZ(argList, "000000010000000100000002");
+        strLstAddZ(argList, TEST_PATH "/pg/pg_wal/RECOVERYXLOG");
+        HRN_CFG_LOAD(cfgCmdArchiveGet, argList);
+
+        HRN_STORAGE_REMOVE(storageCache, "test1/10-2/000000010000000100000002", .errorOnMissing = true);
+        HRN_STORAGE_REMOVE(storageCache, "test1/10-2/000000010000000100000002.lock", .errorOnMissing = true);
+        HRN_STORAGE_MODE(storageCache, "test1/10-2", .mode = 0500);
+
+        TEST_ERROR_FMT(
+            cmdArchiveGet(), FileReadError,
+            "unable to get 000000010000000100000002:\n"
+            "repo1: 10-2/0000000100000001/000000010000000100000002-aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa.gz [FileOpenError]"
+            " unable to open cache lock file '%s': [13] Permission denied",
+            TEST_PATH "/cache/test1/10-2/000000010000000100000002.lock");
+
+        HRN_STORAGE_MODE(storageCache, "test1/10-2");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("cache lock is retried when lock file is removed or replaced");
+
+        const String *const cacheFile = STRDEF("test1/10-2/000000010000000100000005");
+
+        HRN_FORK_BEGIN()
+        {
+            HRN_FORK_CHILD_BEGIN()
+            {
+                // Lock and notify parent
+                const int fd = archiveGetCacheLock(storageCache, cacheFile, true);
+                HRN_FORK_CHILD_NOTIFY_PUT();
+
+                // Replace the lock file and release the original lock once the parent is waiting
+                sleepMSec(500);
+                HRN_STORAGE_REMOVE(storageCache, "test1/10-2/000000010000000100000005.lock", .errorOnMissing = true);
+                const int fdReplace = archiveGetCacheLock(storageCache, cacheFile, true);
+                close(fd);
+
+                // Remove the replacement lock file and release the lock once the parent is waiting again
+                sleepMSec(500);
+                HRN_STORAGE_REMOVE(storageCache, "test1/10-2/000000010000000100000005.lock", .errorOnMissing = true);
+                close(fdReplace);
+            }
+            HRN_FORK_CHILD_END();
+
+            HRN_FORK_PARENT_BEGIN()
+            {
+                HRN_FORK_PARENT_NOTIFY_GET(0);
+
+                int fd;
+                TEST_ASSIGN(fd, archiveGetCacheLock(storageCache, cacheFile, true), "lock after retries");
+                TEST_RESULT_INT(archiveGetCacheLock(storageCache, cacheFile, false), -1, "lock is held");
+                close(fd);
+            }
+            HRN_FORK_PARENT_END();
+        }
+        HRN_FORK_END();
+
+        TEST_STORAGE_LIST(
+            storageCache, "test1/10-2",
+            "000000010000000100000003\n000000010000000100000003.lock\n000000010000000100000004\n"
+            "000000010000000100000004.lock\n000000010000000100000005.lock\n",
+            .remove = true);
     }
 
     FUNCTION_HARNESS_RETURN_VOID();
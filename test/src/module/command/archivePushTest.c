@@ -1,6 +1,7 @@
 /***********************************************************************************************************************************
 Test Archive Push Command
 ***********************************************************************************************************************************/
+#include "command/archive/walTrim.h"
 #include "common/io/fdRead.h"
 #include "common/io/fdWrite.h"
 #include "common/time.h"
@@ -416,6 +417,32 @@ testRun(void)
                 strNewFmt("repo/archive/test/11-1/0000000100000001/000000010000000100000002-%s.gz.pgbackrest.tmp", walBuffer2Sha1)),
             false, "check WAL tmp file is gone");
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("push a trimmed WAL segment");
+
+        argListTemp = strLstDup(argList);
+        hrnCfgArgRawBool(argListTemp, cfgOptArchivePushTrim, true);
+        hrnCfgArgRawZ(argListTemp, cfgOptCompressType, "none");
+        strLstAddZ(argListTemp, "pg_wal/0000000100000001000000A0");
+        HRN_CFG_LOAD(cfgCmdArchivePush, argListTemp);
+
+        HRN_STORAGE_PUT(storagePgWrite(), "pg_wal/0000000100000001000000A0", walBuffer1);
+
+        TEST_RESULT_VOID(cmdArchivePush(), "push the WAL segment");
+        TEST_RESULT_LOG("P00   INFO: pushed WAL file '0000000100000001000000A0' to the archive");
+
+        const String *const walTrimFile = strNewFmt(
+            STORAGE_REPO_ARCHIVE "/11-1/0000000100000001/0000000100000001000000A0-%s",
+            strZ(strNewEncode(encodingHex, cryptoHashOne(hashTypeSha1, walBuffer1))));
+
+        TEST_RESULT_UINT(
+            storageInfoP(storageRepoIdx(0), walTrimFile).size, pgPageSize8 + 42, "padding pages trimmed, checksum of full segment");
+
+        StorageRead *const walTrimRead = storageNewReadP(storageRepoIdx(0), walTrimFile);
+        ioFilterGroupAdd(ioReadFilterGroup(storageReadIo(walTrimRead)), walExpandNew(bufUsed(walBuffer1)));
+
+        TEST_RESULT_BOOL(bufEq(storageGetP(walTrimRead), walBuffer1), true, "expand to full segment");
+
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("push a history file");
 
@@ -972,6 +999,101 @@ testRun(void)
         // Remove the ready file to prevent WAL 3 from being considered for the next test
         HRN_STORAGE_REMOVE(storagePgWrite(), "pg_xlog/archive_status/000000010000000100000003.ready", .errorOnMissing = true);
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("keep alive and push WAL 4 and 5");
+
+        argListTemp = strLstDup(argList);
+        hrnCfgArgRawZ(argListTemp, cfgOptArchivePushKeepAlive, "1");
+        hrnCfgArgRawZ(argListTemp, cfgOptProtocolTimeout, "250ms");
+        HRN_CFG_LOAD(cfgCmdArchivePush, argListTemp, .role = cfgCmdRoleAsync);
+
+        HRN_STORAGE_PUT(storagePgWrite(), "pg_xlog/000000010000000100000004", walBuffer3);
+        HRN_STORAGE_PUT_EMPTY(storagePgWrite(), "pg_xlog/archive_status/000000010000000100000004.ready");
+        HRN_STORAGE_PUT(storagePgWrite(), "pg_xlog/000000010000000100000005", walBuffer3);
+
+        HRN_FORK_BEGIN()
+        {
+            HRN_FORK_CHILD_BEGIN()
+            {
+                // Wait for WAL 4 to be pushed
+                while (!storageExistsP(storageSpool(), STRDEF(STORAGE_SPOOL_ARCHIVE_OUT "/000000010000000100000004.ok")))
+                    sleepMSec(10);
+
+                // Create ready file for WAL 5 while the async process is being kept alive. Wait long enough for a keep alive to be
+                // sent to the local process.
+                sleepMSec(250);
+                HRN_STORAGE_PUT_EMPTY(storagePgWrite(), "pg_xlog/archive_status/000000010000000100000005.ready");
+            }
+            HRN_FORK_CHILD_END();
+
+            HRN_FORK_PARENT_BEGIN()
+            {
+                TEST_RESULT_VOID(cmdArchivePushAsync(), "push WAL segments");
+                TEST_RESULT_LOG(
+                    "P00   INFO: push 1 WAL file(s) to archive: 000000010000000100000004\n"
+                    "P01 DETAIL: pushed WAL file '000000010000000100000004' to the archive\n"
+                    "P00   INFO: push 1 WAL file(s) to archive: 000000010000000100000005\n"
+                    "P01 DETAIL: pushed WAL file '000000010000000100000005' to the archive");
+            }
+            HRN_FORK_PARENT_END();
+        }
+        HRN_FORK_END();
+
+        TEST_STORAGE_EXISTS(
+            storageTest, zNewFmt("repo3/archive/test/9.4-1/0000000100000001/000000010000000100000004-%s", walBuffer3Sha1),
+            .comment = "check repo3 for WAL 4 file");
+        TEST_STORAGE_EXISTS(
+            storageTest, zNewFmt("repo3/archive/test/9.4-1/0000000100000001/000000010000000100000005-%s", walBuffer3Sha1),
+            .comment = "check repo3 for WAL 5 file");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("keep alive stops on error");
+
+        HRN_STORAGE_PUT_EMPTY(storagePgWrite(), "pg_xlog/archive_status/000000010000000100000006.ready");
+
+        TEST_RESULT_VOID(cmdArchivePushAsync(), "push WAL segments");
+        TEST_RESULT_LOG_FMT(
+            "P00   INFO: push 1 WAL file(s) to archive: 000000010000000100000006\n"
+            "P01   WARN: could not push WAL file '000000010000000100000006' to the archive (will be retried): [55] raised from"
+            " local-1 shim protocol: " STORAGE_ERROR_READ_MISSING,
+            TEST_PATH "/pg/pg_xlog/000000010000000100000006");
+
+        // Remove ready files to prevent WAL 4-6 from being considered for the next test
+        HRN_STORAGE_REMOVE(storagePgWrite(), "pg_xlog/archive_status/000000010000000100000004.ready", .errorOnMissing = true);
+        HRN_STORAGE_REMOVE(storagePgWrite(), "pg_xlog/archive_status/000000010000000100000005.ready", .errorOnMissing = true);
+        HRN_STORAGE_REMOVE(storagePgWrite(), "pg_xlog/archive_status/000000010000000100000006.ready", .errorOnMissing = true);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("push history file and WAL when one repo cannot be listed");
+
+        HRN_CFG_LOAD(cfgCmdArchivePush, argList, .role = cfgCmdRoleAsync);
+
+        HRN_STORAGE_PUT_Z(storagePgWrite(), "pg_xlog/00000002.history", "HISTORY");
+        HRN_STORAGE_PUT_EMPTY(storagePgWrite(), "pg_xlog/archive_status/00000002.history.ready");
+        HRN_STORAGE_PUT(storagePgWrite(), "pg_xlog/000000010000000100000007", walBuffer3);
+        HRN_STORAGE_PUT_EMPTY(storagePgWrite(), "pg_xlog/archive_status/000000010000000100000007.ready");
+
+        HRN_STORAGE_MODE(storageTest, "repo3/archive/test/9.4-1/0000000100000001", .mode = 0200);
+
+        TEST_RESULT_VOID(cmdArchivePushAsync(), "push WAL segments");
+        TEST_RESULT_LOG_FMT(
+            "P00   INFO: push 2 WAL file(s) to archive: 000000010000000100000007...00000002.history\n"
+            "P01   WARN: could not push WAL file '000000010000000100000007' to the archive (will be retried): [104] raised from"
+            " local-1 shim protocol: archive-push command encountered error(s):\n"
+            "            repo3: [PathOpenError] unable to list file info for path '%s': [13] Permission denied\n"
+            "P01 DETAIL: pushed WAL file '00000002.history' to the archive",
+            TEST_PATH "/repo3/archive/test/9.4-1/0000000100000001");
+
+        HRN_STORAGE_MODE(storageTest, "repo3/archive/test/9.4-1/0000000100000001");
+
+        TEST_STORAGE_EXISTS(
+            storageTest, zNewFmt("repo/archive/test/9.4-1/0000000100000001/000000010000000100000007-%s", walBuffer3Sha1),
+            .comment = "check repo1 for WAL 7 file");
+        TEST_STORAGE_EXISTS(storageTest, "repo3/archive/test/9.4-1/00000002.history", .comment = "check repo3 for history file");
+
+        HRN_STORAGE_REMOVE(storagePgWrite(), "pg_xlog/archive_status/00000002.history.ready", .errorOnMissing = true);
+        HRN_STORAGE_REMOVE(storagePgWrite(), "pg_xlog/archive_status/000000010000000100000007.ready", .errorOnMissing = true);
+
         // Check that drop functionality works
         // -------------------------------------------------------------------------------------------------------------------------
         // Remove status files
@@ -980,9 +1102,11 @@ testRun(void)
 
         argListTemp = strLstDup(argList);
         hrnCfgArgRawZ(argListTemp, cfgOptArchivePushQueueMax, "16m");
+        hrnCfgArgRawZ(argListTemp, cfgOptArchivePushKeepAlive, "200ms");
+        hrnCfgArgRawZ(argListTemp, cfgOptProtocolTimeout, "200ms");
         HRN_CFG_LOAD(cfgCmdArchivePush, argListTemp, .role = cfgCmdRoleAsync);
 
-        TEST_RESULT_VOID(cmdArchivePushAsync(), "push WAL segments");
+        TEST_RESULT_VOID(cmdArchivePushAsync(), "push WAL segments (keep alive without local processes)");
         TEST_RESULT_LOG(
             "P00   INFO: push 2 WAL file(s) to archive: 000000010000000100000001...000000010000000100000002\n"
             "P00   WARN: dropped WAL file '000000010000000100000001' because archive queue exceeded 16MB\n"
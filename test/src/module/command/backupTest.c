@@ -6,6 +6,7 @@ Test Backup Command
 #include "common/crypto/hash.h"
 #include "common/io/bufferRead.h"
 #include "common/io/bufferWrite.h"
+#include "postgres/interface/crc32.h"
 #include "postgres/interface/static.vendor.h"
 #include "storage/helper.h"
 #include "storage/posix/storage.h"
@@ -98,14 +99,14 @@ testBackupValidateFile(
 
         // Build map log
         String *const mapLog = strNew();
-        const BlockMapItem *blockMapItemLast = NULL;
+        BlockMapItem blockMapItemLast = {0};
 
         for (unsigned int blockMapIdx = 0; blockMapIdx < blockMapSize(blockMap); blockMapIdx++)
         {
-            const BlockMapItem *const blockMapItem = blockMapGet(blockMap, blockMapIdx);
+            const BlockMapItem blockMapItem = blockMapGet(blockMap, blockMapIdx);
             const bool superBlockChange =
-                blockMapItemLast == NULL || blockMapItemLast->reference != blockMapItem->reference ||
-                blockMapItemLast->offset != blockMapItem->offset;
+                blockMapIdx == 0 || blockMapItemLast.reference != blockMapItem.reference ||
+                blockMapItemLast.offset != blockMapItem.offset;
 
             if (superBlockChange && blockMapIdx != 0)
                 strCatChr(mapLog, '}');
@@ -114,9 +115,9 @@ testBackupValidateFile(
                 strCatChr(mapLog, ',');
 
             if (superBlockChange)
-                strCatFmt(mapLog, "%u:{", blockMapItem->reference);
+                strCatFmt(mapLog, "%u:{", blockMapItem.reference);
 
-            strCatFmt(mapLog, "%" PRIu64, blockMapItem->block);
+            strCatFmt(mapLog, "%" PRIu64, blockMapItem.block);
 
             blockMapItemLast = blockMapItem;
         }
@@ -126,7 +127,7 @@ testBackupValidateFile(
         bufUsedSet(fileBuffer, bufSize(fileBuffer));
 
         BlockDelta *const blockDelta = blockDeltaNew(
-            blockMap, file.blockIncrSize, file.blockIncrChecksumSize, NULL, cipherType, cipherPass,
+            blockMap, file.blockIncrSize, file.blockIncrChecksumSize, NULL, 256 * 1024, cipherType, cipherPass,
             manifestData->backupOptionCompressType);
 
         for (unsigned int readIdx = 0; readIdx < blockDeltaReadSize(blockDelta); readIdx++)
@@ -424,7 +425,7 @@ testBackupValidate(const Storage *const storage, const String *const path, const
         const InfoBackup *const infoBackup = infoBackupLoadFile(
             storageRepo(), INFO_BACKUP_PATH_FILE_STR, param.cipherType == 0 ? cipherTypeNone : param.cipherType,
             param.cipherPass == NULL ? NULL : STR(param.cipherPass));
-        Manifest *manifest = manifestLoadFile(
+        Manifest *manifest = manifestLoadFileP(
             storage, strNewFmt("%s/" BACKUP_MANIFEST_FILE, strZ(path)), param.cipherType == 0 ? cipherTypeNone : param.cipherType,
             param.cipherPass == NULL ? NULL : infoBackupCipherPass(infoBackup));
 
@@ -549,6 +550,68 @@ testBackupValidate(const Storage *const storage, const String *const path, const
     FUNCTION_HARNESS_RETURN(STRING, result);
 }
 
+/***********************************************************************************************************************************
+Build a WAL summary in the PostgreSQL block reference table format
+***********************************************************************************************************************************/
+static Buffer *
+testWalSummaryNew(const uint32_t magic)
+{
+    FUNCTION_HARNESS_BEGIN();
+        FUNCTION_HARNESS_PARAM(UINT32, magic);
+    FUNCTION_HARNESS_END();
+
+    Buffer *const result = bufNew(0);
+    bufCatC(result, (const unsigned char *)&magic, 0, sizeof(magic));
+
+    FUNCTION_HARNESS_RETURN(BUFFER, result);
+}
+
+static void
+testWalSummaryEntry(
+    Buffer *const summary, const uint32_t spcOid, const uint32_t dbOid, const uint32_t relNumber, const int32_t forkNum,
+    const uint32_t limitBlock, const uint32_t chunkTotal, const uint16_t *const usageList)
+{
+    FUNCTION_HARNESS_BEGIN();
+        FUNCTION_HARNESS_PARAM(BUFFER, summary);
+        FUNCTION_HARNESS_PARAM(UINT32, spcOid);
+        FUNCTION_HARNESS_PARAM(UINT32, dbOid);
+        FUNCTION_HARNESS_PARAM(UINT32, relNumber);
+        FUNCTION_HARNESS_PARAM(INT, forkNum);
+        FUNCTION_HARNESS_PARAM(UINT32, limitBlock);
+        FUNCTION_HARNESS_PARAM(UINT32, chunkTotal);
+        FUNCTION_HARNESS_PARAM_P(VOID, usageList);
+    FUNCTION_HARNESS_END();
+
+    const uint32_t entry[] = {spcOid, dbOid, relNumber, (uint32_t)forkNum, limitBlock, chunkTotal};
+    bufCatC(summary, (const unsigned char *)entry, 0, sizeof(entry));
+    bufCatC(summary, (const unsigned char *)usageList, 0, chunkTotal * sizeof(uint16_t));
+
+    // Chunk contents are not used so zeroes are fine
+    for (unsigned int chunkIdx = 0; chunkIdx < chunkTotal; chunkIdx++)
+    {
+        for (unsigned int usageIdx = 0; usageIdx < usageList[chunkIdx]; usageIdx++)
+            bufCatC(summary, (const unsigned char *)&(uint16_t){0}, 0, sizeof(uint16_t));
+    }
+
+    FUNCTION_HARNESS_RETURN_VOID();
+}
+
+static Buffer *
+testWalSummaryEnd(Buffer *const summary)
+{
+    FUNCTION_HARNESS_BEGIN();
+        FUNCTION_HARNESS_PARAM(BUFFER, summary);
+    FUNCTION_HARNESS_END();
+
+    const uint32_t terminator[6] = {0};
+    bufCatC(summary, (const unsigned char *)terminator, 0, sizeof(terminator));
+
+    const uint32_t checksum = crc32cOne(bufPtrConst(summary), bufUsed(summary));
+    bufCatC(summary, (const unsigned char *)&checksum, 0, sizeof(checksum));
+
+    FUNCTION_HARNESS_RETURN(BUFFER, summary);
+}
+
 /***********************************************************************************************************************************
 Test Run
 ***********************************************************************************************************************************/
@@ -753,8 +816,8 @@ testRun(void)
             .checksum = {0xee, 0xee, 0x01, 0xff, 0xff},
         };
 
-        TEST_RESULT_UINT(blockMapAdd(blockMap, &blockMapItem)->reference, 128, "add");
-        TEST_RESULT_UINT(blockMapGet(blockMap, 0)->reference, 128, "get");
+        TEST_RESULT_VOID(blockMapAdd(blockMap, &blockMapItem), "add");
+        TEST_RESULT_UINT(blockMapGet(blockMap, 0).reference, 128, "get");
 
         blockMapItem = (BlockMapItem)
         {
@@ -817,6 +880,25 @@ testRun(void)
 
         TEST_RESULT_VOID(blockMapAdd(blockMap, &blockMapItem), "add");
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("super block reuse");
+
+        BlockMap *blockMapReuse = blockMapNew();
+
+        blockMapItem = (BlockMapItem){.reference = 1, .superBlockSize = 8, .size = 4, .block = 0};
+        TEST_RESULT_VOID(blockMapAdd(blockMapReuse, &blockMapItem), "add");
+        blockMapItem = (BlockMapItem){.reference = 1, .superBlockSize = 8, .size = 4, .block = 1};
+        TEST_RESULT_VOID(blockMapAdd(blockMapReuse, &blockMapItem), "add to same super block");
+        blockMapItem = (BlockMapItem){.reference = 1, .bundleId = 1, .superBlockSize = 8, .size = 4};
+        TEST_RESULT_VOID(blockMapAdd(blockMapReuse, &blockMapItem), "add with new bundle");
+        TEST_RESULT_UINT(lstSize(blockMapReuse->pub.superBlockList), 2, "super block count");
+        TEST_RESULT_UINT(blockMapSize(blockMapReuse), 3, "block count");
+
+        TEST_RESULT_VOID(blockMapSuperBlockSizeSet(blockMapReuse, 1, 5, 9), "set super block size");
+        TEST_RESULT_UINT(blockMapGet(blockMapReuse, 0).size, 5, "check size");
+        TEST_RESULT_UINT(blockMapGet(blockMapReuse, 0).superBlockSize, 9, "check super block size");
+        TEST_RESULT_UINT(blockMapGet(blockMapReuse, 2).size, 4, "check size unchanged");
+
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("write equal block map");
 
@@ -880,14 +962,42 @@ testRun(void)
             "read {reference: 4, bundleId: 0, offset: 0, size: 8}\n"
             "  super block {max: 1, size: 8}\n"
             "    block {no: 0, offset: 5}\n"
-            "read {reference: 0, bundleId: 1, offset: 1, size: 5}\n"
+            "read {reference: 0, bundleId: 1, offset: 1, size: 105}\n"
             "  super block {max: 1, size: 5}\n"
             "    block {no: 0, offset: 2}\n"
-            "read {reference: 0, bundleId: 1, offset: 7, size: 99}\n"
-            "  super block {max: 1, size: 99}\n"
+            "  super block {max: 1, size: 99, gap: 1}\n"
             "    block {no: 0, offset: 4}\n",
             "check delta");
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("block delta with gaps too large to read and super blocks out of order");
+
+        BlockMap *blockMapGap = blockMapNew();
+
+        blockMapItem = (BlockMapItem){.reference = 1, .superBlockSize = 1, .offset = 0, .size = 10};
+        TEST_RESULT_VOID(blockMapAdd(blockMapGap, &blockMapItem), "add");
+        blockMapItem = (BlockMapItem){.reference = 1, .superBlockSize = 1, .offset = 10 + 256 * 1024, .size = 10};
+        TEST_RESULT_VOID(blockMapAdd(blockMapGap, &blockMapItem), "add at max gap");
+        blockMapItem = (BlockMapItem){.reference = 1, .superBlockSize = 1, .offset = 30 + 512 * 1024, .size = 10};
+        TEST_RESULT_VOID(blockMapAdd(blockMapGap, &blockMapItem), "add past max gap");
+        blockMapItem = (BlockMapItem){.reference = 1, .superBlockSize = 1, .offset = 10, .size = 10};
+        TEST_RESULT_VOID(blockMapAdd(blockMapGap, &blockMapItem), "add out of order");
+
+        TEST_RESULT_STR_Z(
+            hrnBlockDeltaRender(blockMapGap, 1, 5),
+            "read {reference: 1, bundleId: 0, offset: 0, size: 262164}\n"
+            "  super block {max: 1, size: 10}\n"
+            "    block {no: 0, offset: 0}\n"
+            "  super block {max: 1, size: 10, gap: 262144}\n"
+            "    block {no: 0, offset: 1}\n"
+            "read {reference: 1, bundleId: 0, offset: 524318, size: 10}\n"
+            "  super block {max: 1, size: 10}\n"
+            "    block {no: 0, offset: 2}\n"
+            "read {reference: 1, bundleId: 0, offset: 10, size: 10}\n"
+            "  super block {max: 1, size: 10}\n"
+            "    block {no: 0, offset: 3}\n",
+            "check delta");
+
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("build unequal block map");
 
@@ -1117,7 +1227,7 @@ testRun(void)
         IoWrite *write = ioBufferWriteNew(destination);
 
         TEST_RESULT_VOID(
-            ioFilterGroupAdd(ioWriteFilterGroup(write), blockIncrNew(3, 3, 6, 0, 0, 0, NULL, NULL, NULL)), "block incr");
+            ioFilterGroupAdd(ioWriteFilterGroup(write), blockIncrNew(3, 3, 6, 0, 0, 0, NULL, 0, 0, NULL, NULL)), "block incr");
         TEST_RESULT_VOID(ioWriteOpen(write), "open");
         TEST_RESULT_VOID(ioWrite(write, source), "write");
         TEST_RESULT_VOID(ioWriteClose(write), "close");
@@ -1133,7 +1243,7 @@ testRun(void)
         write = ioBufferWriteNew(destination);
 
         TEST_RESULT_VOID(
-            ioFilterGroupAdd(ioWriteFilterGroup(write), blockIncrNew(3, 3, 8, 0, 0, 0, NULL, NULL, NULL)), "block incr");
+            ioFilterGroupAdd(ioWriteFilterGroup(write), blockIncrNew(3, 3, 8, 0, 0, 0, NULL, 0, 0, NULL, NULL)), "block incr");
         TEST_RESULT_VOID(ioWriteOpen(write), "open");
         TEST_RESULT_VOID(ioWrite(write, source), "write");
         TEST_RESULT_VOID(ioWriteClose(write), "close");
@@ -1168,7 +1278,7 @@ testRun(void)
         TEST_RESULT_VOID(
             ioFilterGroupAdd(
                 ioWriteFilterGroup(write),
-                blockIncrNewPack(ioFilterParamList(blockIncrNew(2, 3, 8, 2, 4, 5, NULL, NULL, NULL)))),
+                blockIncrNewPack(ioFilterParamList(blockIncrNew(2, 3, 8, 2, 4, 5, NULL, 0, 0, NULL, NULL)))),
             "block incr");
         TEST_RESULT_VOID(ioWriteOpen(write), "open");
         TEST_RESULT_VOID(ioWrite(write, source), "write");
@@ -1210,7 +1320,8 @@ testRun(void)
             ioFilterGroupAdd(ioWriteFilterGroup(write), ioBufferNew()), "buffer to force internal buffer size");
         TEST_RESULT_VOID(
             ioFilterGroupAdd(
-                ioWriteFilterGroup(write), blockIncrNewPack(ioFilterParamList(blockIncrNew(3, 3, 8, 3, 0, 0, map, NULL, NULL)))),
+                ioWriteFilterGroup(write),
+                blockIncrNewPack(ioFilterParamList(blockIncrNew(3, 3, 8, 3, 0, 0, map, 0, 0, NULL, NULL)))),
             "block incr");
         TEST_RESULT_VOID(ioWriteOpen(write), "open");
         TEST_RESULT_VOID(ioWrite(write, source), "write");
@@ -1254,7 +1365,8 @@ testRun(void)
             ioFilterGroupAdd(ioWriteFilterGroup(write), ioBufferNew()), "buffer to force internal buffer size");
         TEST_RESULT_VOID(
             ioFilterGroupAdd(
-                ioWriteFilterGroup(write), blockIncrNewPack(ioFilterParamList(blockIncrNew(3, 3, 8, 3, 0, 0, map, NULL, NULL)))),
+                ioWriteFilterGroup(write),
+                blockIncrNewPack(ioFilterParamList(blockIncrNew(3, 3, 8, 3, 0, 0, map, 0, 0, NULL, NULL)))),
             "block incr");
         TEST_RESULT_VOID(ioWriteOpen(write), "open");
         TEST_RESULT_VOID(ioWrite(write, source), "write");
@@ -1277,7 +1389,8 @@ testRun(void)
             ioFilterGroupAdd(ioWriteFilterGroup(write), ioBufferNew()), "buffer to force internal buffer size");
         TEST_RESULT_VOID(
             ioFilterGroupAdd(
-                ioWriteFilterGroup(write), blockIncrNewPack(ioFilterParamList(blockIncrNew(6, 3, 8, 2, 4, 5, NULL, NULL, NULL)))),
+                ioWriteFilterGroup(write),
+                blockIncrNewPack(ioFilterParamList(blockIncrNew(6, 3, 8, 2, 4, 5, NULL, 0, 0, NULL, NULL)))),
             "block incr");
         TEST_RESULT_VOID(ioWriteOpen(write), "open");
         TEST_RESULT_VOID(ioWrite(write, source), "write");
@@ -1305,18 +1418,259 @@ testRun(void)
             "    block {no: 0, offset: 6}\n",
             "check delta");
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("full and incr backup with page lsn check");
+
+        // Build pages with an lsn followed by data. Each block is two pages and the last block is partial.
+        const struct
+        {
+            uint32_t lsnFull;
+            char dataFull;
+            uint32_t lsnIncr;
+            char dataIncr;
+        } pageList[] =
+        {
+            {.lsnFull = 0x10, .dataFull = 'A', .lsnIncr = 0x10, .dataIncr = 'a'},   // Changed without lsn update so skipped
+            {.lsnFull = 0x20, .dataFull = 'B', .lsnIncr = 0x20, .dataIncr = 'B'},
+            {.lsnFull = 0x30, .dataFull = 'C', .lsnIncr = 0x30, .dataIncr = 'C'},   // Newer page so checked and changed
+            {.lsnFull = 0x40, .dataFull = 'D', .lsnIncr = 0x200, .dataIncr = 'd'},
+            {.lsnFull = 0x00, .dataFull = 'E', .lsnIncr = 0x00, .dataIncr = 'E'},   // New page so checked and unchanged
+            {.lsnFull = 0x50, .dataFull = 'F', .lsnIncr = 0x50, .dataIncr = 'F'},
+        };
+
+        Buffer *const sourceFull = bufNew(LENGTH_OF(pageList) * 16 + 1);
+        Buffer *const sourceIncr = bufNew(LENGTH_OF(pageList) * 16 + 1);
+
+        for (unsigned int pageIdx = 0; pageIdx < LENGTH_OF(pageList); pageIdx++)
+        {
+            const PageXLogRecPtr lsnFull = {.xrecoff = pageList[pageIdx].lsnFull};
+            const PageXLogRecPtr lsnIncr = {.xrecoff = pageList[pageIdx].lsnIncr};
+
+            bufCatC(sourceFull, (const unsigned char *)&lsnFull, 0, sizeof(lsnFull));
+            memset(bufRemainsPtr(sourceFull), pageList[pageIdx].dataFull, 8);
+            bufUsedInc(sourceFull, 8);
+
+            bufCatC(sourceIncr, (const unsigned char *)&lsnIncr, 0, sizeof(lsnIncr));
+            memset(bufRemainsPtr(sourceIncr), pageList[pageIdx].dataIncr, 8);
+            bufUsedInc(sourceIncr, 8);
+        }
+
+        // Partial block is always checked
+        bufCat(sourceFull, BUFSTRDEF("Z"));
+        bufCat(sourceIncr, BUFSTRDEF("Z"));
+
+        destination = bufNew(256);
+        write = ioBufferWriteNew(destination);
+
+        TEST_RESULT_VOID(
+            ioFilterGroupAdd(
+                ioWriteFilterGroup(write),
+                blockIncrNewPack(ioFilterParamList(blockIncrNew(32, 32, 8, 0, 0, 0, NULL, 16, 0x100, NULL, NULL)))),
+            "block incr");
+        TEST_RESULT_VOID(ioWriteOpen(write), "open");
+        TEST_RESULT_VOID(ioWrite(write, sourceFull), "write");
+        TEST_RESULT_VOID(ioWriteClose(write), "close");
+
+        TEST_ASSIGN(mapSize, pckReadU64P(ioFilterGroupResultP(ioWriteFilterGroup(write), BLOCK_INCR_FILTER_TYPE)), "map size");
+        map = BUF(bufPtr(destination) + (bufUsed(destination) - (size_t)mapSize), (size_t)mapSize);
+
+        destination = bufNew(256);
+        write = ioBufferWriteNew(destination);
+
+        TEST_RESULT_VOID(
+            ioFilterGroupAdd(
+                ioWriteFilterGroup(write),
+                blockIncrNewPack(ioFilterParamList(blockIncrNew(32, 32, 8, 1, 0, 0, map, 16, 0x100, NULL, NULL)))),
+            "block incr");
+        TEST_RESULT_VOID(ioWriteOpen(write), "open");
+        TEST_RESULT_VOID(ioWrite(write, sourceIncr), "write");
+        TEST_RESULT_VOID(ioWriteClose(write), "close");
+
+        TEST_ASSIGN(mapSize, pckReadU64P(ioFilterGroupResultP(ioWriteFilterGroup(write), BLOCK_INCR_FILTER_TYPE)), "map size");
+        map = BUF(bufPtr(destination) + (bufUsed(destination) - (size_t)mapSize), (size_t)mapSize);
+
+        TEST_RESULT_STR_Z(
+            hrnBlockDeltaRender(blockMapNewRead(ioBufferReadNewOpen(map), 32, 8), 32, 8),
+            "read {reference: 1, bundleId: 0, offset: 0, size: 32}\n"
+            "  super block {max: 32, size: 32}\n"
+            "    block {no: 0, offset: 32}\n"
+            "read {reference: 0, bundleId: 0, offset: 0, size: 97}\n"
+            "  super block {max: 32, size: 32}\n"
+            "    block {no: 0, offset: 0}\n"
+            "  super block {max: 32, size: 32, gap: 32}\n"
+            "    block {no: 0, offset: 64}\n"
+            "  super block {max: 1, size: 1}\n"
+            "    block {no: 0, offset: 96}\n",
+            "check delta");
+
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("new filter from pack");
 
+        // Page lsn check is disabled since the block size is not a multiple of the page size
         TEST_RESULT_VOID(
             blockIncrNewPack(
                 ioFilterParamList(
                     blockIncrNew(
-                        3, 3, 8, 2, 4, 5, NULL, compressFilterP(compressTypeGz, 1, .raw = true),
+                        3, 3, 8, 2, 4, 5, NULL, 2, 0x100, compressFilterP(compressTypeGz, 1, .raw = true),
                         cipherBlockNewP(cipherModeEncrypt, cipherTypeAes256Cbc, BUFSTRDEF(TEST_CIPHER_PASS), .raw = true)))),
             "block incr pack");
     }
 
+    // *****************************************************************************************************************************
+    if (testBegin("WalSummary"))
+    {
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("summary file list");
+
+        StringList *fileList = strLstNew();
+        strLstAddZ(fileList, "00000001000000000100000000000000" "02000000.summary");
+        strLstAddZ(fileList, "00000001000000000180000000000000" "02000000.summary");
+        strLstAddZ(fileList, "00000001000000000200000000000000" "03000000.summary");
+        strLstAddZ(fileList, "00000001000000000400000000000000" "05000000.summary");
+        strLstAddZ(fileList, "00000002000000000200000000000000" "03000000.summary");
+        strLstAddZ(fileList, "00000001000000000200000000000000" "03000000.summary.tmp");
+        strLstAddZ(fileList, "BOGUS.summary");
+
+        uint64_t lsnCovered = 0;
+
+        TEST_RESULT_STRLST_Z(
+            walSummaryFileList(fileList, 1, 0x1000028, 0x2800000, &lsnCovered),
+            "00000001000000000100000000000000" "02000000.summary\n00000001000000000200000000000000" "03000000.summary\n",
+            "range covered");
+        TEST_RESULT_UINT(lsnCovered, 0x3000000, "lsn covered");
+
+        TEST_RESULT_STRLST_Z(
+            walSummaryFileList(fileList, 1, 0x1000028, 0x4800000, &lsnCovered),
+            "00000001000000000100000000000000" "02000000.summary\n00000001000000000200000000000000" "03000000.summary\n",
+            "range not covered due to gap");
+        TEST_RESULT_UINT(lsnCovered, 0x3000000, "lsn covered");
+
+        TEST_RESULT_STRLST_Z(walSummaryFileList(fileList, 1, 0x1000028, 0x1000028, &lsnCovered), NULL, "empty range");
+        TEST_RESULT_UINT(lsnCovered, 0x1000028, "lsn covered");
+
+        TEST_RESULT_STRLST_Z(walSummaryFileList(fileList, 1, 0x800000, 0x2000000, &lsnCovered), NULL, "range start missing");
+        TEST_RESULT_UINT(lsnCovered, 0x800000, "lsn covered");
+
+        TEST_RESULT_STRLST_Z(
+            walSummaryFileList(fileList, 2, 0x2000000, 0x2800000, &lsnCovered),
+            "00000002000000000200000000000000" "03000000.summary\n", "timeline 2");
+        TEST_RESULT_UINT(lsnCovered, 0x3000000, "lsn covered");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("summary errors");
+
+        WalSummary *walSummary = walSummaryNew(PG_SEGMENT_SIZE_DEFAULT / pgPageSize8);
+
+        TEST_ERROR(walSummaryAdd(walSummary, BUFSTRDEF("BAD")), FormatError, "WAL summary is truncated");
+        TEST_ERROR(walSummaryAdd(walSummary, BUFSTRDEF("BADBADXX")), ChecksumError, "WAL summary checksum mismatch");
+        TEST_ERROR(
+            walSummaryAdd(walSummary, testWalSummaryEnd(testWalSummaryNew(0x12345678))), FormatError,
+            "WAL summary magic 0x12345678 is invalid");
+
+        Buffer *summary = testWalSummaryNew(0x652b137b);
+        bufCatC(summary, (const unsigned char *)"TRUNC", 0, 5);
+        bufCatC(summary, (const unsigned char *)&(uint32_t){crc32cOne(bufPtrConst(summary), bufUsed(summary))}, 0, 4);
+
+        TEST_ERROR(walSummaryAdd(walSummary, summary), FormatError, "WAL summary is truncated");
+
+        summary = testWalSummaryNew(0x652b137b);
+        testWalSummaryEntry(summary, 1663, 1, 100, 0, UINT32_MAX, 1, (const uint16_t []){4096});
+        bufUsedSet(summary, bufUsed(summary) - 2);
+        bufCatC(summary, (const unsigned char *)&(uint32_t){crc32cOne(bufPtrConst(summary), bufUsed(summary))}, 0, 4);
+
+        TEST_ERROR(walSummaryAdd(walSummary, summary), FormatError, "WAL summary is truncated");
+
+        summary = testWalSummaryEnd(testWalSummaryNew(0x652b137b));
+        bufUsedSet(summary, bufUsed(summary) - 4);
+        bufCatC(summary, (const unsigned char *)"XX", 0, 2);
+        bufCatC(summary, (const unsigned char *)&(uint32_t){crc32cOne(bufPtrConst(summary), bufUsed(summary))}, 0, 4);
+
+        TEST_ERROR(walSummaryAdd(walSummary, summary), FormatError, "WAL summary has unexpected data after terminator");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("changed segments");
+
+        summary = testWalSummaryNew(0x652b137b);
+        testWalSummaryEntry(summary, 1663, 1, 100, 0, UINT32_MAX, 3, (const uint16_t []){1, 0, 4096});
+        testWalSummaryEntry(summary, 1663, 1, 101, 1, UINT32_MAX, 1, (const uint16_t []){1});
+        testWalSummaryEntry(summary, 1663, 1, 102, 2, 0, 0, NULL);
+        testWalSummaryEntry(summary, 1664, 0, 200, 0, 0, 0, NULL);
+        testWalSummaryEntry(summary, 16385, 5, 300, 0, UINT32_MAX, 1, (const uint16_t []){2});
+        testWalSummaryEntry(summary, 1663, 2, 100, 0, UINT32_MAX, 1, (const uint16_t []){1});
+
+        TEST_RESULT_VOID(walSummaryAdd(walSummary, testWalSummaryEnd(summary)), "add summary");
+
+        summary = testWalSummaryNew(0x652b137b);
+        testWalSummaryEntry(summary, 1663, 1, 103, 0, UINT32_MAX, 1, (const uint16_t []){1});
+
+        TEST_RESULT_VOID(walSummaryAdd(walSummary, testWalSummaryEnd(summary)), "add another summary");
+
+        TEST_RESULT_BOOL(walSummaryChanged(walSummary, STRDEF("pg_data/base/1/100")), true, "segment 0 changed");
+        TEST_RESULT_BOOL(walSummaryChanged(walSummary, STRDEF("pg_data/base/1/100.1")), true, "segment 1 changed");
+        TEST_RESULT_BOOL(walSummaryChanged(walSummary, STRDEF("pg_data/base/1/100.2")), false, "segment 2 not changed");
+        TEST_RESULT_BOOL(walSummaryChanged(walSummary, STRDEF("pg_data/base/1/101")), false, "only fsm changed");
+        TEST_RESULT_BOOL(walSummaryChanged(walSummary, STRDEF("pg_data/base/1/101_fsm")), true, "fsm always changed");
+        TEST_RESULT_BOOL(walSummaryChanged(walSummary, STRDEF("pg_data/base/1/102")), false, "only vm truncated");
+        TEST_RESULT_BOOL(walSummaryChanged(walSummary, STRDEF("pg_data/base/1/103")), true, "changed in another summary");
+        TEST_RESULT_BOOL(walSummaryChanged(walSummary, STRDEF("pg_data/base/2/100")), true, "changed in another db");
+        TEST_RESULT_BOOL(walSummaryChanged(walSummary, STRDEF("pg_data/base/2/101")), false, "not changed in another db");
+        TEST_RESULT_BOOL(walSummaryChanged(walSummary, STRDEF("pg_data/global/200")), true, "created");
+        TEST_RESULT_BOOL(walSummaryChanged(walSummary, STRDEF("pg_data/global/200.3")), true, "created (all segments)");
+        TEST_RESULT_BOOL(walSummaryChanged(walSummary, STRDEF("pg_data/global/201")), false, "global not changed");
+        TEST_RESULT_BOOL(walSummaryChanged(walSummary, STRDEF("pg_data/global/pg_control")), true, "pg_control");
+        TEST_RESULT_BOOL(
+            walSummaryChanged(walSummary, STRDEF("pg_tblspc/16385/PG_17_202406281/5/300")), true, "tablespace changed");
+        TEST_RESULT_BOOL(
+            walSummaryChanged(walSummary, STRDEF("pg_tblspc/16385/PG_17_202406281/5/301")), false, "tablespace not changed");
+        TEST_RESULT_BOOL(walSummaryChanged(walSummary, STRDEF("pg_tblspc/X/PG_17_202406281/5/301")), true, "invalid spc");
+        TEST_RESULT_BOOL(walSummaryChanged(walSummary, STRDEF("pg_tblspc/16385/PG_17_202406281/X/301")), true, "invalid db");
+        TEST_RESULT_BOOL(walSummaryChanged(walSummary, STRDEF("pg_data/pg_xact/0000/0000/0000")), true, "not a tablespace");
+        TEST_RESULT_BOOL(walSummaryChanged(walSummary, STRDEF("pg_data/base/X/100")), true, "invalid db");
+        TEST_RESULT_BOOL(walSummaryChanged(walSummary, STRDEF("pg_data/pg_xact/1/100")), true, "not base");
+        TEST_RESULT_BOOL(walSummaryChanged(walSummary, STRDEF("pg_data/pg_xact/0000")), true, "not global");
+        TEST_RESULT_BOOL(walSummaryChanged(walSummary, STRDEF("pg_tblspc/16385/PG_17_202406281")), true, "not pg_data");
+        TEST_RESULT_BOOL(walSummaryChanged(walSummary, STRDEF("pg_data/base/1/100.X")), true, "invalid segment");
+        TEST_RESULT_BOOL(walSummaryChanged(walSummary, STRDEF("pg_data/base/1/.1")), true, "missing relation");
+        TEST_RESULT_BOOL(walSummaryChanged(walSummary, STRDEF("pg_data/base/1/12345678901")), true, "relation too long");
+        TEST_RESULT_BOOL(walSummaryChanged(walSummary, STRDEF("pg_data/base/1/4294967296")), true, "relation too large");
+        TEST_RESULT_BOOL(walSummaryChanged(walSummary, STRDEF("pg_data/" PG_FILE_PGVERSION)), true, "not a relation");
+        TEST_RESULT_BOOL(walSummaryChanged(walSummary, STRDEF("pg_tblspc/16385/PG_17_202406281/5")), true, "not a relation");
+
+        TEST_RESULT_VOID(walSummaryFree(walSummary), "free");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("changed segments with chunks spanning segments");
+
+        walSummary = walSummaryNew(PG_SEGMENT_SIZE_DEFAULT / pgPageSize32);
+
+        summary = testWalSummaryNew(0x652b137b);
+        testWalSummaryEntry(summary, 1663, 1, 100, 0, UINT32_MAX, 2, (const uint16_t []){0, 1});
+
+        TEST_RESULT_VOID(walSummaryAdd(walSummary, testWalSummaryEnd(summary)), "add summary");
+
+        TEST_RESULT_BOOL(walSummaryChanged(walSummary, STRDEF("pg_data/base/1/100.1")), false, "segment 1 not changed");
+        TEST_RESULT_BOOL(walSummaryChanged(walSummary, STRDEF("pg_data/base/1/100.2")), true, "segment 2 changed");
+        TEST_RESULT_BOOL(walSummaryChanged(walSummary, STRDEF("pg_data/base/1/100.3")), true, "segment 3 changed");
+        TEST_RESULT_BOOL(walSummaryChanged(walSummary, STRDEF("pg_data/base/1/100.4")), false, "segment 4 not changed");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("database created or dropped");
+
+        summary = testWalSummaryNew(0x652b137b);
+        testWalSummaryEntry(summary, 1663, 3, 0, 0, 0, 0, NULL);
+        testWalSummaryEntry(summary, 16385, 6, 0, 0, UINT32_MAX, 0, NULL);
+
+        TEST_RESULT_VOID(walSummaryAdd(walSummary, testWalSummaryEnd(summary)), "add summary");
+
+        TEST_RESULT_BOOL(walSummaryChanged(walSummary, STRDEF("pg_data/base/3/100")), true, "db created");
+        TEST_RESULT_BOOL(walSummaryChanged(walSummary, STRDEF("pg_data/base/3/4294967295.7")), true, "db created (all relations)");
+        TEST_RESULT_BOOL(
+            walSummaryChanged(walSummary, STRDEF("pg_tblspc/16385/PG_17_202406281/6/300")), true, "tablespace db created");
+        TEST_RESULT_BOOL(
+            walSummaryChanged(walSummary, STRDEF("pg_tblspc/16385/PG_17_202406281/3/100")), false, "db in another tablespace");
+        TEST_RESULT_BOOL(walSummaryChanged(walSummary, STRDEF("pg_data/base/4/100")), false, "another db not changed");
+    }
+
     // *****************************************************************************************************************************
     if (testBegin("backupLabelCreate()"))
     {
@@ -1654,6 +2008,206 @@ testRun(void)
         dbFree(backupData->dbPrimary);
     }
 
+    // *****************************************************************************************************************************
+    if (testBegin("backupBlockIncrLsnPrior()"))
+    {
+        // Set log level to detail
+        harnessLogLevelSet(logLevelDetail);
+
+        Manifest *manifestPrior = NULL;
+
+        OBJ_NEW_BASE_BEGIN(Manifest, .childQty = MEM_CONTEXT_QTY_MAX)
+        {
+            manifestPrior = manifestNewInternal();
+        }
+        OBJ_NEW_END();
+
+        StringList *argList = strLstNew();
+        hrnCfgArgRawZ(argList, cfgOptStanza, "test1");
+        hrnCfgArgRawZ(argList, cfgOptRepoPath, TEST_PATH "/repo");
+        hrnCfgArgRawZ(argList, cfgOptPgPath, "/pg");
+        hrnCfgArgRawZ(argList, cfgOptRepoRetentionFull, "1");
+        HRN_CFG_LOAD(cfgCmdBackup, argList);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("disabled when block incremental or page lsn is disabled");
+
+        TEST_RESULT_UINT(backupBlockIncrLsnPrior(manifestPrior, NULL), 0, "block incremental disabled");
+
+        hrnCfgArgRawBool(argList, cfgOptRepoBundle, true);
+        hrnCfgArgRawBool(argList, cfgOptRepoBlock, true);
+        HRN_CFG_LOAD(cfgCmdBackup, argList);
+
+        TEST_RESULT_UINT(backupBlockIncrLsnPrior(manifestPrior, NULL), 0, "page lsn disabled");
+
+        hrnCfgArgRawBool(argList, cfgOptRepoBlockLsn, true);
+        hrnCfgArgRawBool(argList, cfgOptChecksumPage, false);
+        HRN_CFG_LOAD(cfgCmdBackup, argList);
+
+        TEST_RESULT_UINT(backupBlockIncrLsnPrior(manifestPrior, NULL), 0, "page checksums disabled");
+
+        cfgOptionSet(cfgOptChecksumPage, cfgSourceParam, BOOL_TRUE_VAR);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("disabled when prior backup is missing, either backup is offline, or the timeline has changed");
+
+        TEST_RESULT_UINT(backupBlockIncrLsnPrior(NULL, STRDEF("000000010000000000000001")), 0, "no prior backup");
+        TEST_RESULT_UINT(backupBlockIncrLsnPrior(manifestPrior, NULL), 0, "offline backup");
+        TEST_RESULT_UINT(backupBlockIncrLsnPrior(manifestPrior, STRDEF("000000010000000000000001")), 0, "offline prior backup");
+
+        manifestPrior->pub.data.archiveStart = STRDEF("000000010000000000000001");
+        manifestPrior->pub.data.lsnStart = STRDEF("0/1000028");
+
+        TEST_RESULT_UINT(backupBlockIncrLsnPrior(manifestPrior, STRDEF("000000020000000000000002")), 0, "timeline changed");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("prior backup start lsn");
+
+        TEST_RESULT_UINT(backupBlockIncrLsnPrior(manifestPrior, STRDEF("000000010000000000000002")), 0x1000028, "lsn");
+
+        TEST_RESULT_LOG(
+            "P00 DETAIL: block incremental will skip blocks with all pages older than prior backup start lsn 0/1000028");
+    }
+
+    // *****************************************************************************************************************************
+    if (testBegin("backupWalSummary() and backupWalSummaryApply()"))
+    {
+        // Set log level to detail
+        harnessLogLevelSet(logLevelDetail);
+
+        Manifest *manifestPrior = NULL;
+
+        OBJ_NEW_BASE_BEGIN(Manifest, .childQty = MEM_CONTEXT_QTY_MAX)
+        {
+            manifestPrior = manifestNewInternal();
+        }
+        OBJ_NEW_END();
+
+        StringList *argList = strLstNew();
+        hrnCfgArgRawZ(argList, cfgOptStanza, "test1");
+        hrnCfgArgRawZ(argList, cfgOptRepoPath, TEST_PATH "/repo");
+        hrnCfgArgRawZ(argList, cfgOptPgPath, TEST_PATH "/pg");
+        hrnCfgArgRawZ(argList, cfgOptRepoRetentionFull, "1");
+        HRN_CFG_LOAD(cfgCmdBackup, argList);
+
+        BackupData backupData =
+            {.version = PG_VERSION_16, .pageSize = pgPageSize8, .segmentPageTotal = PG_SEGMENT_SIZE_DEFAULT / pgPageSize8};
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("disabled when option is disabled, version < 17, prior backup is missing, offline, or the timeline has changed");
+
+        TEST_RESULT_PTR(backupWalSummary(&backupData, manifestPrior, NULL, NULL), NULL, "option disabled");
+
+        hrnCfgArgRawBool(argList, cfgOptWalSummary, true);
+        hrnCfgArgRawZ(argList, cfgOptArchiveTimeout, "250ms");
+        HRN_CFG_LOAD(cfgCmdBackup, argList);
+
+        backupData.storagePrimary = storagePg();
+
+        TEST_RESULT_PTR(
+            backupWalSummary(&backupData, manifestPrior, STRDEF("0/3000028"), STRDEF("000000010000000000000003")), NULL,
+            "version < 17");
+
+        backupData.version = PG_VERSION_17;
+
+        TEST_RESULT_PTR(
+            backupWalSummary(&backupData, NULL, STRDEF("0/3000028"), STRDEF("000000010000000000000003")), NULL, "no prior backup");
+        TEST_RESULT_PTR(backupWalSummary(&backupData, manifestPrior, NULL, NULL), NULL, "offline backup");
+        TEST_RESULT_PTR(
+            backupWalSummary(&backupData, manifestPrior, STRDEF("0/3000028"), STRDEF("000000010000000000000003")), NULL,
+            "offline prior backup");
+
+        manifestPrior->pub.data.archiveStart = STRDEF("000000010000000000000001");
+        manifestPrior->pub.data.lsnStart = STRDEF("0/1000028");
+
+        TEST_RESULT_PTR(
+            backupWalSummary(&backupData, manifestPrior, STRDEF("0/3000028"), STRDEF("000000020000000000000003")), NULL,
+            "timeline changed");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("summaries missing");
+
+        TEST_RESULT_PTR(
+            backupWalSummary(&backupData, manifestPrior, STRDEF("0/3000028"), STRDEF("000000010000000000000003")), NULL,
+            "no summaries");
+
+        TEST_RESULT_LOG(
+            "P00   WARN: WAL summaries do not cover lsn range 0/1000028 to 0/3000028 on timeline 1, changes will be detected by"
+            " timestamp\n"
+            "            HINT: is summarize_wal enabled and is wal_summary_keep_time long enough to cover the prior backup?");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("summaries incomplete after waiting");
+
+        Buffer *summary = testWalSummaryNew(0x652b137b);
+        testWalSummaryEntry(summary, 1663, 1, 100, 0, UINT32_MAX, 1, (const uint16_t []){1});
+        HRN_STORAGE_PUT(
+            storagePgWrite(), "pg_wal/summaries/00000001000000000100000000000000" "02000000.summary", testWalSummaryEnd(summary));
+
+        TEST_RESULT_PTR(
+            backupWalSummary(&backupData, manifestPrior, STRDEF("0/3000028"), STRDEF("000000010000000000000003")), NULL,
+            "incomplete summaries");
+
+        TEST_RESULT_LOG(
+            "P00   WARN: WAL summaries do not cover lsn range 0/1000028 to 0/3000028 on timeline 1, changes will be detected by"
+            " timestamp\n"
+            "            HINT: is summarize_wal enabled and is wal_summary_keep_time long enough to cover the prior backup?");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("summaries complete");
+
+        summary = testWalSummaryNew(0x652b137b);
+        testWalSummaryEntry(summary, 1663, 1, 101, 0, UINT32_MAX, 1, (const uint16_t []){1});
+        HRN_STORAGE_PUT(
+            storagePgWrite(), "pg_wal/summaries/00000001000000000200000000000000" "04000000.summary", testWalSummaryEnd(summary));
+
+        WalSummary *walSummary = NULL;
+
+        TEST_ASSIGN(
+            walSummary, backupWalSummary(&backupData, manifestPrior, STRDEF("0/3000028"), STRDEF("000000010000000000000003")),
+            "summaries");
+
+        TEST_RESULT_LOG("P00 DETAIL: WAL summaries will be used to find unchanged files from lsn 0/1000028 to 0/3000028");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("reference unchanged files");
+
+        Manifest *manifest = NULL;
+
+        OBJ_NEW_BASE_BEGIN(Manifest, .childQty = MEM_CONTEXT_QTY_MAX)
+        {
+            manifest = manifestNewInternal();
+            manifest->pub.referenceList = strLstNew();
+            strLstAddZ(manifest->pub.referenceList, "20191002-070640F");
+
+            HRN_MANIFEST_FILE_ADD(manifest, .name = "pg_data/base/1/100", .copy = true, .reference = "20191002-070640F", .size = 8);
+            HRN_MANIFEST_FILE_ADD(manifest, .name = "pg_data/base/1/101", .copy = true, .reference = "20191002-070640F", .size = 8);
+            HRN_MANIFEST_FILE_ADD(manifest, .name = "pg_data/base/1/102", .copy = true, .reference = "20191002-070640F", .size = 8);
+            HRN_MANIFEST_FILE_ADD(manifest, .name = "pg_data/base/1/103", .reference = "20191002-070640F", .size = 8);
+            HRN_MANIFEST_FILE_ADD(
+                manifest, .name = "pg_data/base/1/104", .copy = true, .delta = true, .reference = "20191002-070640F", .size = 8);
+            HRN_MANIFEST_FILE_ADD(manifest, .name = "pg_data/base/1/105", .copy = true, .size = 8);
+            HRN_MANIFEST_FILE_ADD(
+                manifest, .name = "pg_data/base/1/106", .copy = true, .reference = "20191002-070640F", .size = 8,
+                .sizeOriginal = 16);
+        }
+        OBJ_NEW_END();
+
+        TEST_RESULT_VOID(backupWalSummaryApply(manifest, NULL), "no summaries");
+        TEST_RESULT_BOOL(manifestFile(manifest, 2).copy, true, "not applied");
+
+        TEST_RESULT_VOID(backupWalSummaryApply(manifest, walSummary), "apply");
+        TEST_RESULT_BOOL(manifestFile(manifest, 0).copy, true, "changed");
+        TEST_RESULT_BOOL(manifestFile(manifest, 1).copy, true, "changed");
+        TEST_RESULT_BOOL(manifestFile(manifest, 2).copy, false, "not changed");
+        TEST_RESULT_BOOL(manifestFile(manifest, 3).copy, false, "not copied");
+        TEST_RESULT_BOOL(manifestFile(manifest, 4).copy, true, "delta");
+        TEST_RESULT_BOOL(manifestFile(manifest, 5).copy, true, "no reference");
+        TEST_RESULT_BOOL(manifestFile(manifest, 6).copy, true, "size changed");
+
+        TEST_RESULT_LOG("P00 DETAIL: WAL summaries show 1 file(s) with changed timestamp are unchanged since the prior backup");
+    }
+
     // *****************************************************************************************************************************
     if (testBegin("backupResumeFind()"))
     {
@@ -3244,8 +3798,8 @@ testRun(void)
 
             // Run backup
             hrnBackupPqScriptP(
-                PG_VERSION_11, backupTimeStart, .walCompressType = compressTypeGz, .walTotal = 2, .pgVersionForce = STRDEF("11"),
-                .walSwitch = true);
+                PG_VERSION_11, backupTimeStart, .walCompressType = compressTypeGz, .walTrim = true, .walTotal = 2,
+                .pgVersionForce = STRDEF("11"), .walSwitch = true);
             TEST_RESULT_VOID(hrnCmdBackup(), "backup");
 
             TEST_RESULT_LOG(
@@ -3606,7 +4160,7 @@ testRun(void)
         {
             // Load the previous manifest and null out the checksum-page option to be sure it gets set to false in this backup
             const String *manifestPriorFile = STRDEF(STORAGE_REPO_BACKUP "/20191103-165320F/" BACKUP_MANIFEST_FILE);
-            Manifest *manifestPrior = manifestNewLoad(storageReadIo(storageNewReadP(storageRepo(), manifestPriorFile)));
+            Manifest *manifestPrior = manifestNewLoadP(storageReadIo(storageNewReadP(storageRepo(), manifestPriorFile)));
             ((ManifestData *)manifestData(manifestPrior))->backupOptionChecksumPage = NULL;
             manifestSave(manifestPrior, storageWriteIo(storageNewWriteP(storageRepoWrite(), manifestPriorFile)));
 
@@ -3625,8 +4179,46 @@ testRun(void)
             hrnCfgArgRawZ(argList, cfgOptRepoBlockSizeMap, STRINGIFY(BLOCK_MIN_FILE_SIZE) "=" STRINGIFY(BLOCK_MIN_SIZE));
             hrnCfgArgRawZ(argList, cfgOptRepoBlockSizeMap, STRINGIFY(BLOCK_MID_FILE_SIZE) "=" STRINGIFY(BLOCK_MID_SIZE));
             hrnCfgArgRawZ(argList, cfgOptRepoBlockSizeSuper, "1MiB");
+            hrnCfgArgRawBool(argList, cfgOptBlockMapCache, true);
+            hrnCfgArgRawZ(argList, cfgOptSpoolPath, TEST_PATH "/spool");
             HRN_CFG_LOAD(cfgCmdBackup, argList);
 
+            // Cache prior block maps. The map for block-incr-same is valid, block-incr-shrink has an invalid size, and
+            // block-incr-shrink-block has an invalid checksum. Invalid and missing maps will be read from the repo.
+            const char *const blockMapCacheList[] = {"block-incr-same", "block-incr-shrink", "block-incr-shrink-block"};
+
+            for (unsigned int cacheIdx = 0; cacheIdx < LENGTH_OF(blockMapCacheList); cacheIdx++)
+            {
+                const ManifestFile file = manifestFileFind(
+                    manifestPrior, strNewFmt(MANIFEST_TARGET_PGDATA "/%s", blockMapCacheList[cacheIdx]));
+                const uint64_t offset = file.bundleOffset + file.sizeRepo - file.blockIncrMapSize;
+
+                Buffer *const cache = storageGetP(
+                    storageNewReadP(
+                        storageRepo(), strNewFmt(STORAGE_REPO_BACKUP "/20191103-165320F/bundle/%" PRIu64, file.bundleId),
+                        .offset = offset, .limit = VARUINT64(file.blockIncrMapSize)));
+                bufCat(cache, cryptoHashOne(hashTypeSha1, cache));
+
+                if (cacheIdx == 1)
+                    bufUsedSet(cache, bufUsed(cache) - 1);
+                else if (cacheIdx == 2)
+                    bufPtr(cache)[0] ^= 0xFF;
+
+                HRN_STORAGE_PUT(
+                    storageSpoolWrite(),
+                    strZ(
+                        strNewFmt(
+                            STORAGE_SPOOL_BLOCK_MAP "/repo1/20191103-165320F/bundle/%" PRIu64 "-%" PRIu64 "-%" PRIu64,
+                            file.bundleId, offset, file.blockIncrMapSize)),
+                    cache);
+            }
+
+            // The cached map for block-incr-grow is a path so it can be neither read nor written. An unreferenced backup in the
+            // cache is a file so it cannot be removed as a path. These errors are logged and the backup continues.
+            HRN_STORAGE_PATH_CREATE(
+                storageSpoolWrite(), STORAGE_SPOOL_BLOCK_MAP "/repo1/20191103-165320F/pg_data/block-incr-grow.pgbi-24576-24");
+            HRN_STORAGE_PUT_EMPTY(storageSpoolWrite(), STORAGE_SPOOL_BLOCK_MAP "/repo1/20191101-000000F");
+
             // Grow file size to check block incr delta. This is large enough that it would get a new block size if it were a new
             // file rather than a delta. Also split the first super block.
             Buffer *file = bufNew(BLOCK_MID_FILE_SIZE);
@@ -3690,7 +4282,14 @@ testRun(void)
                 "P00   INFO: execute non-exclusive backup start: backup begins after the next regular checkpoint completes\n"
                 "P00   INFO: backup start archive = 0000000105DC213000000000, lsn = 5dc2130/0\n"
                 "P00   INFO: check archive for segment 0000000105DC213000000000\n"
+                "P00   WARN: unable to remove unused cached block maps: unable to list file info for path '" TEST_PATH "/spool/"
+                "block-map/test1/repo1/20191101-000000F': [20] Not a directory\n"
                 "P01 DETAIL: backup file " TEST_PATH "/pg1/block-incr-larger (1.4MB, [PCT]) checksum [SHA1]\n"
+                "P01 DETAIL: unable to read cached block map: unable to read '" TEST_PATH "/spool/block-map/test1/repo1/"
+                "20191103-165320F/pg_data/block-incr-grow.pgbi-24576-24': [21] Is a directory\n"
+                "P01 DETAIL: unable to write cached block map: unable to move '" TEST_PATH "/spool/block-map/test1/repo1/"
+                "20191103-165320F/pg_data/block-incr-grow.pgbi-24576-24.pgbackrest.tmp' to '" TEST_PATH "/spool/block-map/test1/"
+                "repo1/20191103-165320F/pg_data/block-incr-grow.pgbi-24576-24': [21] Is a directory\n"
                 "P01 DETAIL: backup file " TEST_PATH "/pg1/block-incr-grow (128KB, [PCT]) checksum [SHA1]\n"
                 "P01 DETAIL: store truncated file " TEST_PATH "/pg1/truncate-to-zero (4B->0B, [PCT])\n"
                 "P01 DETAIL: match file from prior backup " TEST_PATH "/pg1/normal-same (4B, [PCT]) checksum [SHA1]\n"
@@ -3729,6 +4328,22 @@ testRun(void)
                 "pg_data={\"path\":\"" TEST_PATH "/pg1\",\"type\":\"path\"}\n",
                 "compare file list");
 
+            TEST_STORAGE_LIST(
+                storageSpool(), STORAGE_SPOOL_BLOCK_MAP,
+                "repo1/\n"
+                "repo1/20191101-000000F\n"
+                "repo1/20191103-165320F/\n"
+                "repo1/20191103-165320F/bundle/\n"
+                "repo1/20191103-165320F/bundle/1-40965-22\n"
+                "repo1/20191103-165320F/bundle/1-73778-29\n"
+                "repo1/20191103-165320F/bundle/1-90191-22\n"
+                "repo1/20191103-165320F/pg_data/\n"
+                "repo1/20191103-165320F/pg_data/block-incr-grow.pgbi-24576-24/\n"
+                "repo1/20191103-165320F/pg_data/block-incr-grow.pgbi-24576-24.pgbackrest.tmp\n",
+                .comment = "check block map cache");
+
+            HRN_STORAGE_REMOVE(storageSpoolWrite(), STORAGE_SPOOL_BLOCK_MAP "/repo1/20191101-000000F");
+
             HRN_STORAGE_REMOVE(storagePgWrite(), "block-incr-grow");
             HRN_STORAGE_REMOVE(storagePgWrite(), "block-incr-larger");
             HRN_STORAGE_REMOVE(storagePgWrite(), "block-incr-same");
@@ -3942,6 +4557,8 @@ testRun(void)
             hrnCfgArgRawZ(argList, cfgOptRepoBlockAgeMap, "2=0");
             hrnCfgArgRawZ(argList, cfgOptRepoBlockChecksumSizeMap, "16KiB=16");
             hrnCfgArgRawZ(argList, cfgOptRepoBlockChecksumSizeMap, "8KiB=12");
+            hrnCfgArgRawBool(argList, cfgOptBlockMapCache, true);
+            hrnCfgArgRawZ(argList, cfgOptSpoolPath, TEST_PATH "/spool");
             hrnCfgEnvRawZ(cfgOptRepoCipherPass, TEST_CIPHER_PASS);
             HRN_CFG_LOAD(cfgCmdBackup, argList);
 
@@ -4015,6 +4632,14 @@ testRun(void)
                 "[backup:target]\n"
                 "pg_data={\"path\":\"" TEST_PATH "/pg1\",\"type\":\"path\"}\n",
                 "compare file list");
+
+            TEST_STORAGE_LIST(
+                storageSpool(), STORAGE_SPOOL_BLOCK_MAP,
+                "repo1/\n"
+                "repo1/20191108-080000F/\n"
+                "repo1/20191108-080000F/pg_data/\n"
+                "repo1/20191108-080000F/pg_data/block-incr-grow.pgbi-56-40\n",
+                .comment = "check block map cache, unreferenced backups removed");
         }
 
         // -------------------------------------------------------------------------------------------------------------------------
@@ -4104,6 +4729,84 @@ testRun(void)
                 "pg_data={\"path\":\"" TEST_PATH "/pg1\",\"type\":\"path\"}\n",
                 "compare file list");
         }
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("online 11 incr backup with block incr and page lsn");
+
+        backupTimeStart = BACKUP_EPOCH + 3600000;
+
+        {
+            // Load options
+            StringList *argList = strLstNew();
+            hrnCfgArgRawZ(argList, cfgOptStanza, "test1");
+            hrnCfgArgRaw(argList, cfgOptRepoPath, repoPath);
+            hrnCfgArgRaw(argList, cfgOptPgPath, pg1Path);
+            hrnCfgArgRawZ(argList, cfgOptRepoRetentionFull, "1");
+            hrnCfgArgRawStrId(argList, cfgOptType, backupTypeIncr);
+            hrnCfgArgRawBool(argList, cfgOptRepoBundle, true);
+            hrnCfgArgRawZ(argList, cfgOptRepoBundleLimit, "8KiB");
+            hrnCfgArgRawZ(argList, cfgOptCompressType, "none");
+            hrnCfgArgRawZ(argList, cfgOptRepoCipherType, "aes-256-cbc");
+            hrnCfgArgRawBool(argList, cfgOptRepoBlock, true);
+            hrnCfgArgRawBool(argList, cfgOptRepoBlockLsn, true);
+            hrnCfgArgRawZ(argList, cfgOptRepoBlockSizeMap, "16KiB=8KiB");
+            hrnCfgEnvRawZ(cfgOptRepoCipherPass, TEST_CIPHER_PASS);
+            HRN_CFG_LOAD(cfgCmdBackup, argList);
+
+            // Relation and non-relation files that use block incr
+            Buffer *const file = bufNew(pgPageSize4 * 4);
+            memset(bufPtr(file), 0, bufSize(file));
+            bufUsedSet(file, bufSize(file));
+
+            HRN_STORAGE_PUT(storagePgWrite(), "global/3", file, .timeModified = backupTimeStart);
+            HRN_STORAGE_PUT(storagePgWrite(), "block-incr-not-relation", file, .timeModified = backupTimeStart);
+
+            // Run backup
+            hrnBackupPqScriptP(
+                PG_VERSION_11, backupTimeStart, .walCompressType = compressTypeNone, .cipherType = cipherTypeAes256Cbc,
+                .cipherPass = TEST_CIPHER_PASS, .walTotal = 2, .walSwitch = true);
+            TEST_RESULT_VOID(hrnCmdBackup(), "backup");
+
+            TEST_RESULT_LOG(
+                "P00   INFO: last backup label = 20191111-192000F, version = " PROJECT_VERSION "\n"
+                "P00   INFO: execute non-exclusive backup start: backup begins after the next regular checkpoint completes\n"
+                "P00   INFO: backup start archive = 0000000105DCB3B000000000, lsn = 5dcb3b0/0\n"
+                "P00   INFO: check archive for segment 0000000105DCB3B000000000\n"
+                "P00 DETAIL: block incremental will skip blocks with all pages older than prior backup start lsn 5dc9b40/0\n"
+                "P01 DETAIL: backup file " TEST_PATH "/pg1/global/1 (16KB, [PCT]) checksum [SHA1]\n"
+                "P00   WARN: invalid page checksum found in file " TEST_PATH "/pg1/global/1 at page 3\n"
+                "P01 DETAIL: backup file " TEST_PATH "/pg1/global/3 (16KB, [PCT]) checksum [SHA1]\n"
+                "P01 DETAIL: backup file " TEST_PATH "/pg1/block-incr-not-relation (16KB, [PCT]) checksum [SHA1]\n"
+                "P01 DETAIL: backup file " TEST_PATH "/pg1/global/pg_control (bundle 1/0, 8KB, [PCT]) checksum [SHA1]\n"
+                "P00 DETAIL: reference pg_data/PG_VERSION to 20191111-192000F\n"
+                "P00 DETAIL: reference pg_data/global/2 to 20191111-192000F\n"
+                "P00   INFO: execute non-exclusive backup stop and wait for all WAL segments to archive\n"
+                "P00   INFO: backup stop archive = 0000000105DCB3B000000001, lsn = 5dcb3b0/300000\n"
+                "P00 DETAIL: wrote 'backup_label' file returned from backup stop function\n"
+                "P00   INFO: check archive for segment(s) 0000000105DCB3B000000000:0000000105DCB3B000000001\n"
+                "P00   INFO: new backup label = 20191111-192000F_20191112-230640I\n"
+                "P00   INFO: incr backup size = [SIZE], file total = 7");
+
+            TEST_RESULT_STR_Z(
+                testBackupValidateP(
+                    storageRepo(), STRDEF(STORAGE_REPO_BACKUP "/latest"), .cipherType = cipherTypeAes256Cbc,
+                    .cipherPass = TEST_CIPHER_PASS),
+                ".> {d=20191111-192000F_20191112-230640I}\n"
+                "bundle/1/pg_data/global/pg_control {s=8192}\n"
+                "pg_data/backup_label {s=17, ts=+2}\n"
+                "pg_data/block-incr-not-relation.pgbi {s=16384, m=1:{0,1}}\n"
+                "pg_data/global/1.pgbi {s=16384, m=1:{0,1}, ts=-99999, ckp=[3]}\n"
+                "pg_data/global/3.pgbi {s=16384, m=1:{0,1}, ckp=t}\n"
+                "20191111-192000F/bundle/1/pg_data/PG_VERSION {s=2, ts=-100000}\n"
+                "20191111-192000F/pg_data/global/2 {s=16384, ts=-100000, ckp=[3]}\n"
+                "--------\n"
+                "[backup:target]\n"
+                "pg_data={\"path\":\"" TEST_PATH "/pg1\",\"type\":\"path\"}\n",
+                "compare file list");
+
+            HRN_STORAGE_REMOVE(storagePgWrite(), "global/3");
+            HRN_STORAGE_REMOVE(storagePgWrite(), "block-incr-not-relation");
+        }
     }
 
     FUNCTION_HARNESS_RETURN_VOID();
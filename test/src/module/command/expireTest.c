@@ -9,6 +9,7 @@ Test Expire Command
 
 #include "common/harnessConfig.h"
 #include "common/harnessInfo.h"
+#include "common/harnessProtocol.h"
 #include "common/harnessStorage.h"
 #include "common/harnessTime.h"
 
@@ -63,6 +64,41 @@ archiveExpectList(const unsigned int start, unsigned int end, const char *majorW
     return strZ(result);
 }
 
+/***********************************************************************************************************************************
+Plan removals for the first repo and execute them
+***********************************************************************************************************************************/
+static void
+testRemoveExpiredArchive(const InfoBackup *const infoBackup, const bool timeBasedFullRetention)
+{
+    FUNCTION_HARNESS_BEGIN();
+        FUNCTION_HARNESS_PARAM(INFO_BACKUP, infoBackup);
+        FUNCTION_HARNESS_PARAM(BOOL, timeBasedFullRetention);
+    FUNCTION_HARNESS_END();
+
+    List *const removeList = lstNewP(sizeof(ExpireRemove));
+
+    removeExpiredArchive(infoBackup, timeBasedFullRetention, 0, removeList);
+    expireRemoveExec(removeList);
+
+    FUNCTION_HARNESS_RETURN_VOID();
+}
+
+static void
+testRemoveExpiredBackup(const InfoBackup *const infoBackup, const String *const adhocBackupLabel)
+{
+    FUNCTION_HARNESS_BEGIN();
+        FUNCTION_HARNESS_PARAM(INFO_BACKUP, infoBackup);
+        FUNCTION_HARNESS_PARAM(STRING, adhocBackupLabel);
+    FUNCTION_HARNESS_END();
+
+    List *const removeList = lstNewP(sizeof(ExpireRemove));
+
+    removeExpiredBackup(infoBackup, adhocBackupLabel, 0, removeList);
+    expireRemoveExec(removeList);
+
+    FUNCTION_HARNESS_RETURN_VOID();
+}
+
 /***********************************************************************************************************************************
 Test Run
 ***********************************************************************************************************************************/
@@ -71,6 +107,10 @@ testRun(void)
 {
     FUNCTION_HARNESS_VOID();
 
+    // Install local command handler shim
+    static const ProtocolServerHandler testLocalHandlerList[] = {PROTOCOL_SERVER_HANDLER_EXPIRE_LIST};
+    hrnProtocolLocalShimInstall(testLocalHandlerList, LENGTH_OF(testLocalHandlerList));
+
     StringList *argListBase = strLstNew();
     hrnCfgArgRawZ(argListBase, cfgOptStanza, "db");
     hrnCfgArgRawZ(argListBase, cfgOptRepoPath, TEST_PATH "/repo");
@@ -406,7 +446,7 @@ testRun(void)
             storageRepoWrite(), STORAGE_REPO_BACKUP "/20181118-152100F_20181119-152152D.save", BOGUS_STR,
             .comment = "directory look-alike file must not be removed");
 
-        TEST_RESULT_VOID(removeExpiredBackup(infoBackup, NULL, 0), "remove backups not in backup.info current");
+        TEST_RESULT_VOID(testRemoveExpiredBackup(infoBackup, NULL), "remove backups not in backup.info current");
 
         TEST_RESULT_LOG(
             "P00   INFO: repo1: remove expired backup 20181119-152100F_20181119-152152D\n"
@@ -437,7 +477,7 @@ testRun(void)
 
         TEST_ASSIGN(infoBackup, infoBackupNewLoad(ioBufferReadNew(backupInfoContent)), "get backup.info");
 
-        TEST_RESULT_VOID(removeExpiredBackup(infoBackup, NULL, 0), "remove backups - backup.info current empty");
+        TEST_RESULT_VOID(testRemoveExpiredBackup(infoBackup, NULL), "remove backups - backup.info current empty");
 
         TEST_RESULT_LOG("P00   INFO: repo1: remove expired backup 20181119-152138F");
         TEST_STORAGE_LIST(
@@ -445,6 +485,37 @@ testRun(void)
             "20181118-152100F_20181119-152152D.save\n"
             BOGUS_STR "/\n"
             "backup.info\n");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("file removals are batched per repo");
+
+        List *removeList = lstNewP(sizeof(ExpireRemove));
+
+        for (unsigned int fileIdx = 0; fileIdx <= EXPIRE_REMOVE_BATCH_MAX; fileIdx++)
+            expireRemoveAdd(removeList, 0, strNewFmt(STORAGE_REPO_BACKUP "/file%u", fileIdx), false);
+
+        expireRemoveAdd(removeList, 1, STRDEF(STORAGE_REPO_BACKUP "/file"), false);
+
+        TEST_RESULT_UINT(lstSize(removeList), 3, "job total");
+        TEST_RESULT_UINT(strLstSize(((ExpireRemove *)lstGet(removeList, 0))->pathList), EXPIRE_REMOVE_BATCH_MAX, "full batch");
+        TEST_RESULT_UINT(strLstSize(((ExpireRemove *)lstGet(removeList, 1))->pathList), 1, "remaining file");
+        TEST_RESULT_UINT(((ExpireRemove *)lstGet(removeList, 2))->repoIdx, 1, "new job for repo");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("removal error is logged and counted");
+
+        HRN_STORAGE_PUT_EMPTY(storageRepoWrite(), STORAGE_REPO_BACKUP "/error/file");
+        HRN_STORAGE_MODE(storageRepoWrite(), STORAGE_REPO_BACKUP "/error", .mode = 0500);
+
+        removeList = lstNewP(sizeof(ExpireRemove));
+        expireRemoveAdd(removeList, 0, STRDEF(STORAGE_REPO_BACKUP "/error/file"), false);
+
+        TEST_RESULT_UINT(expireRemoveExec(removeList), 1, "remove");
+        TEST_RESULT_LOG(
+            "P01  ERROR: [060]: repo1: raised from local-1 shim protocol: unable to remove '" TEST_PATH
+            "/repo/backup/db/error/file': [13] Permission denied");
+
+        HRN_STORAGE_MODE(storageRepoWrite(), STORAGE_REPO_BACKUP "/error");
     }
 
     // *****************************************************************************************************************************
@@ -496,7 +567,7 @@ testRun(void)
         InfoBackup *infoBackup = NULL;
         TEST_ASSIGN(infoBackup, infoBackupNewLoad(ioBufferReadNew(backupInfoContent)), "get backup.info");
 
-        TEST_RESULT_VOID(removeExpiredArchive(infoBackup, false, 0), "archive retention not set");
+        TEST_RESULT_VOID(testRemoveExpiredArchive(infoBackup, false), "archive retention not set");
         TEST_RESULT_LOG(
             "P00   WARN: option 'repo1-retention-full' is not set for 'repo1-retention-full-type=count', the repository may run out"
             " of space\n"
@@ -504,7 +575,7 @@ testRun(void)
             " maximum.\n"
             "P00   INFO: option 'repo1-retention-archive' is not set - archive logs will not be expired");
 
-        TEST_RESULT_VOID(removeExpiredArchive(infoBackup, true, 0), "archive retention not set - retention-full-type=time");
+        TEST_RESULT_VOID(testRemoveExpiredArchive(infoBackup, true), "archive retention not set - retention-full-type=time");
         TEST_RESULT_LOG("P00   INFO: repo1: time-based archive retention not met - archive logs will not be expired");
 
         // -------------------------------------------------------------------------------------------------------------------------
@@ -515,7 +586,7 @@ testRun(void)
         HRN_CFG_LOAD(cfgCmdExpire, argList);
 
         TEST_RESULT_VOID(
-            removeExpiredArchive(infoBackup, false, 0), "archive retention set, retention type default, no current backups");
+            testRemoveExpiredArchive(infoBackup, false), "archive retention set, retention type default, no current backups");
         TEST_RESULT_LOG(
             "P00   WARN: option 'repo1-retention-full' is not set for 'repo1-retention-full-type=count', the repository may run out"
             " of space\n"
@@ -614,7 +685,7 @@ testRun(void)
             "1={\"db-id\":6625592122879095702,\"db-version\":\"9.4\"}\n"
             "2={\"db-id\":6626363367545678089,\"db-version\":\"10\"}");
 
-        TEST_RESULT_VOID(removeExpiredArchive(infoBackup, true, 0), "no archive on disk");
+        TEST_RESULT_VOID(testRemoveExpiredArchive(infoBackup, true), "no archive on disk");
 
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("retention-archive set - remove archives across timelines");
@@ -628,7 +699,7 @@ testRun(void)
         HRN_CFG_LOAD(cfgCmdExpire, argList);
 
         TEST_RESULT_VOID(
-            removeExpiredArchive(infoBackup, false, 0), "archive retention type = full (default), repo1-retention-archive=3");
+            testRemoveExpiredArchive(infoBackup, false), "archive retention type = full (default), repo1-retention-archive=3");
 
         TEST_STORAGE_LIST(
             storageRepo(), STORAGE_REPO_ARCHIVE "/9.4-1/0000000100000000", archiveExpectList(2, 10, "0000000100000000"),
@@ -651,7 +722,7 @@ testRun(void)
         HRN_CFG_LOAD(cfgCmdExpire, argList);
 
         TEST_RESULT_VOID(
-            removeExpiredArchive(infoBackup, false, 0), "archive retention type = full (default), repo1-retention-archive=2");
+            testRemoveExpiredArchive(infoBackup, false), "archive retention type = full (default), repo1-retention-archive=2");
 
         TEST_STORAGE_LIST(
             storageRepo(), STORAGE_REPO_ARCHIVE "/9.4-1/0000000100000000", archiveExpectList(2, 2, "0000000100000000"),
@@ -675,7 +746,7 @@ testRun(void)
         HRN_CFG_LOAD(cfgCmdExpire, argList);
 
         TEST_RESULT_VOID(
-            removeExpiredArchive(infoBackup, false, 0), "archive retention type = full (default), repo1-retention-archive=1");
+            testRemoveExpiredArchive(infoBackup, false), "archive retention type = full (default), repo1-retention-archive=1");
 
         TEST_STORAGE_LIST(
             storageRepo(), STORAGE_REPO_ARCHIVE "/9.4-1/0000000100000000", archiveExpectList(2, 2, "0000000100000000"),
@@ -702,7 +773,7 @@ testRun(void)
         HRN_CFG_LOAD(cfgCmdExpire, argList);
 
         TEST_RESULT_VOID(
-            removeExpiredArchive(infoBackup, false, 0),
+            testRemoveExpiredArchive(infoBackup, false),
             "full counts as differential and incremental associated with differential expires");
 
         String *result = strNewFmt(
@@ -735,7 +806,7 @@ testRun(void)
         // Regenerate archive
         archiveGenerate(storageRepoWrite(), STORAGE_REPO_ARCHIVE, 1, 10, "9.4-1", "0000000200000000");
 
-        TEST_RESULT_VOID(removeExpiredArchive(infoBackup, false, 0), "differential and full count as an incremental");
+        TEST_RESULT_VOID(testRemoveExpiredArchive(infoBackup, false), "differential and full count as an incremental");
 
         result = strNewFmt(
             "%s%s%s", archiveExpectList(2, 2, "0000000200000000"), archiveExpectList(4, 5, "0000000200000000"),
@@ -877,6 +948,8 @@ testRun(void)
         Storage *storageTest = storagePosixNewP(TEST_PATH_STR, .write = true);
 
         harnessLogLevelSet(logLevelDetail);
+        hrnLogReplaceAdd(" in [0-9]+ms \\(", "[0-9]+ms", "TIME", false);
+        hrnLogReplaceAdd("\\([0-9]+/sec\\)", "[0-9]+", "RATE", false);
 
         // Rename backup.info files on repo1 to cause error
         HRN_STORAGE_MOVE(
@@ -1062,7 +1135,16 @@ testRun(void)
             ", start = 000000020000000000000009\n"
             "P00   INFO: repo2: 9.4-1 remove archive, start = 000000020000000000000004, stop = 000000020000000000000007\n"
             "P00 DETAIL: repo2: 10-2 archive retention on backup 20181119-152900F, start = 000000010000000000000003\n"
-            "P00   INFO: repo2: 10-2 no archive to remove");
+            "P00   INFO: repo2: 10-2 no archive to remove\n"
+            "P01 DETAIL: repo1: removed 1 expired file(s)/path(s) (10%)\n"
+            "P01 DETAIL: repo1: removed 1 expired file(s)/path(s) (20%)\n"
+            "P01 DETAIL: repo1: removed 1 expired file(s)/path(s) (30%)\n"
+            "P01 DETAIL: repo1: removed 1 expired file(s)/path(s) (40%)\n"
+            "P01 DETAIL: repo1: removed 1 expired file(s)/path(s) (50%)\n"
+            "P01 DETAIL: repo2: removed 1 expired file(s)/path(s) (60%)\n"
+            "P01 DETAIL: repo2: removed 1 expired file(s)/path(s) (70%)\n"
+            "P01 DETAIL: repo2: removed 3 expired file(s)/path(s) (100%)\n"
+            "P00 DETAIL: removed 10 expired file(s)/path(s) in [TIME] ([RATE]/sec)");
 
         TEST_ASSIGN(
             infoBackup, infoBackupLoadFile(storageRepo(), INFO_BACKUP_PATH_FILE_STR, cipherTypeNone, NULL),
@@ -1209,7 +1291,7 @@ testRun(void)
         HRN_CFG_LOAD(cfgCmdExpire, argList);
 
         TEST_RESULT_VOID(
-            removeExpiredArchive(infoBackup, false, 0), "backup selected for retention does not have archive-start so do nothing");
+            testRemoveExpiredArchive(infoBackup, false), "backup selected for retention does not have archive-start so do nothing");
         TEST_STORAGE_LIST(
             storageRepo(), STORAGE_REPO_ARCHIVE "/9.4-1/0000000100000000", archiveExpectList(1, 5, "0000000100000000"),
             .comment = "nothing removed from 9.4-1/0000000100000000");
@@ -1222,15 +1304,19 @@ testRun(void)
         hrnCfgArgRawZ(argList, cfgOptRepoRetentionArchiveType, "full");
         HRN_CFG_LOAD(cfgCmdExpire, argList);
         harnessLogLevelSet(logLevelDetail);
+        hrnLogReplaceAdd(" in [0-9]+ms \\(", "[0-9]+ms", "TIME", false);
+        hrnLogReplaceAdd("\\([0-9]+/sec\\)", "[0-9]+", "RATE", false);
 
         TEST_RESULT_VOID(
-            removeExpiredArchive(infoBackup, false, 0), "backup earlier than selected for retention does not have archive-start");
+            testRemoveExpiredArchive(infoBackup, false), "backup earlier than selected for retention does not have archive-start");
         TEST_RESULT_LOG(
             "P00 DETAIL: repo1: 9.4-1 archive retention on backup 20181119-152138F, start = 000000010000000000000002"
             ", stop = 000000010000000000000002\n"
             "P00 DETAIL: repo1: 9.4-1 archive retention on backup 20181119-152900F, start = 000000010000000000000004\n"
             "P00   INFO: repo1: 9.4-1 remove archive, start = 000000010000000000000001, stop = 000000010000000000000001\n"
-            "P00   INFO: repo1: 9.4-1 remove archive, start = 000000010000000000000003, stop = 000000010000000000000003");
+            "P00   INFO: repo1: 9.4-1 remove archive, start = 000000010000000000000003, stop = 000000010000000000000003\n"
+            "P01 DETAIL: repo1: removed 2 expired file(s)/path(s) (100%)\n"
+            "P00 DETAIL: removed 2 expired file(s)/path(s) in [TIME] ([RATE]/sec)");
 
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("expire history files - dry run");
@@ -1334,7 +1420,9 @@ testRun(void)
             "P00   INFO: repo1: 9.4-1 no archive to remove\n"
             "P00 DETAIL: repo1: 10-2 archive retention on backup 20181119-152900F, start = 000000030000000000000006\n"
             "P00   INFO: repo1: 10-2 no archive to remove\n"
-            "P00   INFO: repo1: 10-2 remove history file 00000002.history");
+            "P00   INFO: repo1: 10-2 remove history file 00000002.history\n"
+            "P01 DETAIL: repo1: removed 1 expired file(s)/path(s) (100%)\n"
+            "P00 DETAIL: removed 1 expired file(s)/path(s) in [TIME] ([RATE]/sec)");
 
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("expire history files via backup command");
@@ -1358,7 +1446,9 @@ testRun(void)
             "P00   INFO: repo1: 9.4-1 no archive to remove\n"
             "P00 DETAIL: repo1: 10-2 archive retention on backup 20181119-152900F, start = 000000030000000000000006\n"
             "P00   INFO: repo1: 10-2 no archive to remove\n"
-            "P00   INFO: repo1: 10-2 remove history file 00000002.history");
+            "P00   INFO: repo1: 10-2 remove history file 00000002.history\n"
+            "P01 DETAIL: repo1: removed 1 expired file(s)/path(s) (100%)\n"
+            "P00 DETAIL: removed 1 expired file(s)/path(s) in [TIME] ([RATE]/sec)");
 
         harnessLogLevelReset();
 
@@ -1871,6 +1961,8 @@ testRun(void)
 
         // Set the log level to detail so archive expiration messages are seen
         harnessLogLevelSet(logLevelDetail);
+        hrnLogReplaceAdd(" in [0-9]+ms \\(", "[0-9]+ms", "TIME", false);
+        hrnLogReplaceAdd("\\([0-9]+/sec\\)", "[0-9]+", "RATE", false);
 
         TEST_RESULT_VOID(cmdExpire(), "adhoc expire only backup and dependent");
 
@@ -1907,7 +1999,11 @@ testRun(void)
             ", stop = 000000010000000000000004\n"
             "P00 DETAIL: repo1: 12-2 archive retention on backup 20181119-152900F, start = 000000010000000000000006\n"
             "P00   INFO: repo1: 12-2 remove archive, start = 000000010000000000000001, stop = 000000010000000000000001\n"
-            "P00   INFO: repo1: 12-2 remove archive, start = 000000010000000000000005, stop = 000000010000000000000005");
+            "P00   INFO: repo1: 12-2 remove archive, start = 000000010000000000000005, stop = 000000010000000000000005\n"
+            "P01 DETAIL: repo1: removed 1 expired file(s)/path(s) (25%)\n"
+            "P01 DETAIL: repo1: removed 1 expired file(s)/path(s) (50%)\n"
+            "P01 DETAIL: repo1: removed 2 expired file(s)/path(s) (100%)\n"
+            "P00 DETAIL: removed 4 expired file(s)/path(s) in [TIME] ([RATE]/sec)");
 
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("expire full and archive (no dependents)");
@@ -1942,7 +2038,10 @@ testRun(void)
             "P00 DETAIL: repo1: 12-2 archive retention on backup 20181119-152850F, start = 000000010000000000000002"
             ", stop = 000000010000000000000004\n"
             "P00 DETAIL: repo1: 12-2 archive retention on backup 20181119-152900F, start = 000000010000000000000006\n"
-            "P00   INFO: repo1: 12-2 no archive to remove");
+            "P00   INFO: repo1: 12-2 no archive to remove\n"
+            "P01 DETAIL: repo1: removed 1 expired file(s)/path(s) (50%)\n"
+            "P01 DETAIL: repo1: removed 1 expired file(s)/path(s) (100%)\n"
+            "P00 DETAIL: removed 2 expired file(s)/path(s) in [TIME] ([RATE]/sec)");
 
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("expire latest and resumable");
@@ -1976,7 +2075,10 @@ testRun(void)
             "P00 DETAIL: repo1: 9.4-1 archive retention on backup 20181119-152800F, start = 000000020000000000000002\n"
             "P00   INFO: repo1: 9.4-1 no archive to remove\n"
             "P00 DETAIL: repo1: 12-2 archive retention on backup 20181119-152850F, start = 000000010000000000000002\n"
-            "P00   INFO: repo1: 12-2 no archive to remove");
+            "P00   INFO: repo1: 12-2 no archive to remove\n"
+            "P01 DETAIL: repo1: removed 1 expired file(s)/path(s) (50%)\n"
+            "P01 DETAIL: repo1: removed 1 expired file(s)/path(s) (100%)\n"
+            "P00 DETAIL: removed 2 expired file(s)/path(s) in [TIME] ([RATE]/sec)");
         TEST_RESULT_STR(
             storageInfoP(storageRepo(), STRDEF(STORAGE_REPO_BACKUP "/latest")).linkDestination, STRDEF("20181119-152850F"),
             "latest link updated");
@@ -2022,7 +2124,11 @@ testRun(void)
             "P00   INFO: repo1: remove expired backup 20181119-152800F\n"
             "P00   INFO: repo1: remove archive path " TEST_PATH "/repo/archive/db/9.4-1\n"
             "P00 DETAIL: repo1: 12-2 archive retention on backup 20181119-152850F, start = 000000010000000000000002\n"
-            "P00   INFO: repo1: 12-2 no archive to remove");
+            "P00   INFO: repo1: 12-2 no archive to remove\n"
+            "P01 DETAIL: repo1: removed 1 expired file(s)/path(s) (33%)\n"
+            "P01 DETAIL: repo1: removed 1 expired file(s)/path(s) (66%)\n"
+            "P01 DETAIL: repo1: removed 1 expired file(s)/path(s) (100%)\n"
+            "P00 DETAIL: removed 3 expired file(s)/path(s) in [TIME] ([RATE]/sec)");
 
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("error on expire last full backup on disk");
@@ -2090,7 +2196,7 @@ testRun(void)
         const String *adhocBackupLabel = STRDEF("20181119-152850F_20181119-152252D");
         TEST_RESULT_UINT(expireAdhocBackup(infoBackup, adhocBackupLabel, 0), 1, "adhoc expire last dependent backup");
         TEST_RESULT_VOID(
-            removeExpiredBackup(infoBackup, adhocBackupLabel, 0), "code coverage: removeExpireBackup with no manifests");
+            testRemoveExpiredBackup(infoBackup, adhocBackupLabel), "code coverage: removeExpireBackup with no manifests");
         TEST_RESULT_LOG(
             "P00   WARN: [DRY-RUN] repo1: expiring latest backup 20181119-152850F_20181119-152252D - the ability to perform"
             " point-in-time-recovery (PITR) may be affected\n"
@@ -2272,7 +2378,10 @@ testRun(void)
             "P00   INFO: repo2: expire adhoc backup 20181119-152850F_20181119-152252D\n"
             "P00   INFO: repo2: remove expired backup 20181119-152850F_20181119-152252D\n"
             "P00 DETAIL: repo2: 12-2 archive retention on backup 20181119-152850F, start = 000000010000000000000002\n"
-            "P00   INFO: repo2: 12-2 no archive to remove");
+            "P00   INFO: repo2: 12-2 no archive to remove\n"
+            "P01 DETAIL: repo1: removed 1 expired file(s)/path(s) (50%)\n"
+            "P01 DETAIL: repo2: removed 1 expired file(s)/path(s) (100%)\n"
+            "P00 DETAIL: removed 2 expired file(s)/path(s) in [TIME] ([RATE]/sec)");
 
         TEST_RESULT_STR(
             storageInfoP(storageRepoIdx(1), STRDEF(STORAGE_REPO_BACKUP "/latest")).linkDestination, STRDEF("20181119-152850F"),
@@ -2342,6 +2451,8 @@ testRun(void)
 
         // Set the log level to detail so archive expiration messages are seen
         harnessLogLevelSet(logLevelDetail);
+        hrnLogReplaceAdd(" in [0-9]+ms \\(", "[0-9]+ms", "TIME", false);
+        hrnLogReplaceAdd("\\([0-9]+/sec\\)", "[0-9]+", "RATE", false);
 
         TEST_ASSIGN(infoBackup, infoBackupNewLoad(ioBufferReadNew(backupInfoBase)), "get backup.info");
         TEST_RESULT_VOID(cmdExpire(), "repo-retention-full not set for time-based");
@@ -2389,7 +2500,9 @@ testRun(void)
             .comment = "no archives expired");
         TEST_RESULT_LOG(
             "P00 DETAIL: repo1: 9.4-1 archive retention on backup 20181119-152138F, start = 000000010000000000000002\n"
-            "P00   INFO: repo1: 9.4-1 remove archive, start = 000000010000000000000001, stop = 000000010000000000000001");
+            "P00   INFO: repo1: 9.4-1 remove archive, start = 000000010000000000000001, stop = 000000010000000000000001\n"
+            "P01 DETAIL: repo1: removed 1 expired file(s)/path(s) (100%)\n"
+            "P00 DETAIL: removed 1 expired file(s)/path(s) in [TIME] ([RATE]/sec)");
 
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("oldest backup not expired (and no WAL before it)");
@@ -2493,7 +2606,10 @@ testRun(void)
         TEST_RESULT_LOG(
             "P00   INFO: repo1: remove expired backup 20181119-152138F\n"
             "P00 DETAIL: repo1: 9.4-1 archive retention on backup 20181119-152800F, start = 000000010000000000000004\n"
-            "P00   INFO: repo1: 9.4-1 remove archive, start = 000000010000000000000002, stop = 000000010000000000000003");
+            "P00   INFO: repo1: 9.4-1 remove archive, start = 000000010000000000000002, stop = 000000010000000000000003\n"
+            "P01 DETAIL: repo1: removed 1 expired file(s)/path(s) (33%)\n"
+            "P01 DETAIL: repo1: removed 2 expired file(s)/path(s) (100%)\n"
+            "P00 DETAIL: removed 3 expired file(s)/path(s) in [TIME] ([RATE]/sec)");
 
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("newest backup - retention met but must keep one");
@@ -2510,7 +2626,12 @@ testRun(void)
             "P00   INFO: repo1: remove expired backup 20181119-152800F_20181119-152152D\n"
             "P00   INFO: repo1: remove expired backup 20181119-152800F\n"
             "P00 DETAIL: repo1: 9.4-1 archive retention on backup 20181119-152900F, start = 000000010000000000000009\n"
-            "P00   INFO: repo1: 9.4-1 remove archive, start = 000000010000000000000004, stop = 000000010000000000000008");
+            "P00   INFO: repo1: 9.4-1 remove archive, start = 000000010000000000000004, stop = 000000010000000000000008\n"
+            "P01 DETAIL: repo1: removed 1 expired file(s)/path(s) (12%)\n"
+            "P01 DETAIL: repo1: removed 1 expired file(s)/path(s) (25%)\n"
+            "P01 DETAIL: repo1: removed 1 expired file(s)/path(s) (37%)\n"
+            "P01 DETAIL: repo1: removed 5 expired file(s)/path(s) (100%)\n"
+            "P00 DETAIL: removed 8 expired file(s)/path(s) in [TIME] ([RATE]/sec)");
 
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("add repo2 to ensure options are applied correctly");
@@ -2555,7 +2676,10 @@ testRun(void)
             "P00   INFO: repo2: expire time-based backup 20181119-152138F\n"
             "P00   INFO: repo2: remove expired backup 20181119-152138F\n"
             "P00 DETAIL: repo2: 9.4-1 archive retention on backup 20181119-152800F, start = 000000010000000000000004\n"
-            "P00   INFO: repo2: 9.4-1 remove archive, start = 000000010000000000000001, stop = 000000010000000000000003");
+            "P00   INFO: repo2: 9.4-1 remove archive, start = 000000010000000000000001, stop = 000000010000000000000003\n"
+            "P01 DETAIL: repo2: removed 1 expired file(s)/path(s) (25%)\n"
+            "P01 DETAIL: repo2: removed 3 expired file(s)/path(s) (100%)\n"
+            "P00 DETAIL: removed 4 expired file(s)/path(s) in [TIME] ([RATE]/sec)");
 
         harnessLogLevelReset();
     }
@@ -258,6 +258,7 @@ testRun(void)
             "  --cmd                               pgBackRest command\n"
             "                                      [default=/path/to/pgbackrest]\n"
             "  --cmd-ssh                           SSH client command [default=ssh]\n"
+            "  --cmd-ssh-control-path              SSH connection multiplexing path\n"
             "  --compress-level-network            network compression level [default=3]\n"
             "  --config                            pgBackRest configuration file\n"
             "                                      [default=/etc/pgbackrest/pgbackrest.conf]\n"
@@ -343,6 +344,8 @@ testRun(void)
             "  --repo-s3-key-secret                S3 repository secret access key\n"
             "  --repo-s3-key-type                  S3 repository key type [default=shared]\n"
             "  --repo-s3-kms-key-id                S3 repository KMS key\n"
+            "  --repo-s3-list-max                  maximum concurrent S3 list requests\n"
+            "                                      [default=1]\n"
             "  --repo-s3-region                    S3 repository region\n"
             "  --repo-s3-role                      S3 repository role\n"
             "  --repo-s3-sse-customer-key          S3 Repository SSE Customer Key\n"
@@ -360,6 +363,8 @@ testRun(void)
             "  --repo-sftp-public-key-file         SFTP public key file\n"
             "  --repo-storage-ca-file              repository storage CA file\n"
             "  --repo-storage-ca-path              repository storage CA path\n"
+            "  --repo-storage-download-max         maximum concurrent range downloads per\n"
+            "                                      file [default=1]\n"
             "  --repo-storage-host                 repository storage host\n"
             "  --repo-storage-port                 repository storage port [default=443]\n"
             "  --repo-storage-tag                  repository storage tag(s)\n"
@@ -2392,6 +2392,42 @@ testRun(void)
             // {uncrustify_on}
             "json - backup set requested, no db and no checksum error");
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("backup set requested, manifest exists but backup is not in backup.info");
+
+        argList2 = strLstDup(argListTextStanzaOpt);
+        hrnCfgArgRawZ(argList2, cfgOptSet, "20181119-152138F_20181119-152159I");
+        hrnCfgArgRawZ(argList2, cfgOptRepo, "1");
+        HRN_CFG_LOAD(cfgCmdInfo, argList2);
+
+        HRN_INFO_PUT(
+            storageRepoWrite(), STORAGE_REPO_BACKUP "/20181119-152138F_20181119-152159I/" BACKUP_MANIFEST_FILE,
+            TEST_MANIFEST_HEADER
+            TEST_MANIFEST_TARGET_NO_LINK
+            TEST_MANIFEST_NO_DB
+            TEST_MANIFEST_FILE_NO_CHECKSUM_ERROR
+            TEST_MANIFEST_FILE_DEFAULT
+            TEST_MANIFEST_LINK
+            TEST_MANIFEST_LINK_DEFAULT
+            TEST_MANIFEST_PATH
+            TEST_MANIFEST_PATH_DEFAULT,
+            .comment = "write manifest for backup not in backup.info");
+
+        TEST_RESULT_STR_Z(
+            infoRender(),
+            "stanza: stanza1\n"
+            "    status: ok\n"
+            "    cipher: none\n"
+            "\n"
+            "    db (prior)\n"
+            "        wal archive min/max (9.4): 000000010000000000000002/000000020000000000000003\n"
+            "\n"
+            "    db (current)\n"
+            "        wal archive min/max (9.5): 000000010000000000000002/000000010000000000000005\n",
+            "text - backup set not in backup.info");
+
+        HRN_STORAGE_PATH_REMOVE(storageRepoWrite(), STORAGE_REPO_BACKUP "/20181119-152138F_20181119-152159I", .recurse = true);
+
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("backup set requested with missing backup lsn stop location");
 
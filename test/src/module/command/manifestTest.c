@@ -133,7 +133,7 @@ testRun(void)
             TEST_RESULT_VOID(hrnCmdBackup(), "backup repo1");
 
             // Munge the pg_control checksum since it will vary by architecture
-            Manifest *manifest = manifestLoadFile(
+            Manifest *manifest = manifestLoadFileP(
                 storageRepo(), STRDEF(STORAGE_REPO_BACKUP "/20191002-070640F_20191003-105320D/" BACKUP_MANIFEST_FILE),
                 cipherTypeNone, NULL);
 
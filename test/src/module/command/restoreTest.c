@@ -222,7 +222,8 @@ testRun(void)
         IoWrite *write = ioBufferWriteNew(destination);
 
         ioFilterGroupAdd(
-            ioWriteFilterGroup(write), blockIncrNew(6, 3, 5, 0, 0, 0, NULL, compressFilterP(compressTypeGz, 1, .raw = true), NULL));
+            ioWriteFilterGroup(write),
+            blockIncrNew(6, 3, 5, 0, 0, 0, NULL, 0, 0, compressFilterP(compressTypeGz, 1, .raw = true), NULL));
         ioWriteOpen(write);
         ioWrite(write, source);
         ioWriteClose(write);
@@ -233,7 +234,7 @@ testRun(void)
             ioBufferReadNewOpen(BUF(bufPtr(destination) + (bufUsed(destination) - (size_t)mapSize), (size_t)mapSize)), 3, 5);
 
         // Perform block delta
-        BlockDelta *blockDelta = blockDeltaNew(blockMap, 3, 5, NULL, cipherTypeNone, NULL, compressTypeGz);
+        BlockDelta *blockDelta = blockDeltaNew(blockMap, 3, 5, NULL, 64 * 1024, cipherTypeNone, NULL, compressTypeGz);
         const BlockDeltaRead *blockDeltaRead = blockDeltaReadGet(blockDelta, 0);
         IoRead *read = ioBufferReadNewOpen(destination);
 
@@ -262,6 +263,40 @@ testRun(void)
             "    block {no: 0, offset: 6}\n"
             "    block {no: 1, offset: 9}\n",
             "check delta");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("super blocks that are not required are skipped");
+
+        destination = bufNew(256);
+        write = ioBufferWriteNew(destination);
+
+        ioFilterGroupAdd(
+            ioWriteFilterGroup(write),
+            blockIncrNew(3, 3, 5, 0, 0, 0, NULL, 0, 0, compressFilterP(compressTypeGz, 1, .raw = true), NULL));
+        ioWriteOpen(write);
+        ioWrite(write, source);
+        ioWriteClose(write);
+
+        mapSize = pckReadU64P(ioFilterGroupResultP(ioWriteFilterGroup(write), BLOCK_INCR_FILTER_TYPE));
+        blockMap = blockMapNewRead(
+            ioBufferReadNewOpen(BUF(bufPtr(destination) + (bufUsed(destination) - (size_t)mapSize), (size_t)mapSize)), 3, 5);
+
+        // Second block is unchanged so the super block is skipped
+        Buffer *blockChecksum = bufNew(5 * 4);
+        memset(bufPtr(blockChecksum), 0, bufSize(blockChecksum));
+        memcpy(bufPtr(blockChecksum) + 5, blockMapGet(blockMap, 1).checksum, 5);
+        bufUsedSet(blockChecksum, bufSize(blockChecksum));
+
+        blockDelta = blockDeltaNew(blockMap, 3, 5, blockChecksum, 64 * 1024, cipherTypeNone, NULL, compressTypeGz);
+        TEST_RESULT_UINT(blockDeltaReadSize(blockDelta), 1, "single read");
+
+        blockDeltaRead = blockDeltaReadGet(blockDelta, 0);
+        read = ioBufferReadNewOpen(destination);
+
+        TEST_RESULT_STR_Z(strNewBuf(blockDeltaNext(blockDelta, blockDeltaRead, read)->block), "123", "read block");
+        TEST_RESULT_STR_Z(strNewBuf(blockDeltaNext(blockDelta, blockDeltaRead, read)->block), "789", "read block after gap");
+        TEST_RESULT_STR_Z(strNewBuf(blockDeltaNext(blockDelta, blockDeltaRead, read)->block), "ABC", "read block");
+        TEST_RESULT_PTR(blockDeltaNext(blockDelta, blockDeltaRead, read), NULL, "no more blocks");
     }
 
     // *****************************************************************************************************************************
@@ -308,10 +343,131 @@ testRun(void)
         TEST_ERROR(
             restoreFile(
                 strNewFmt(STORAGE_REPO_BACKUP "/%s/%s.gz", strZ(repoFileReferenceFull), strZ(repoFile1)), repoIdx, compressTypeGz,
-                0, false, false, false, STRDEF("badpass"), NULL, fileList),
+                0, false, false, false, 0, STRDEF("badpass"), NULL, fileList),
             ChecksumError,
             "error restoring 'normal': actual checksum 'd1cd8a7d11daa26814b93eb604e1d49ab4b43770' does not match expected checksum"
             " 'ffffffffffffffffffffffffffffffffffffffff'");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("read gap max");
+
+        TEST_RESULT_UINT(restoreJobReadGapMax(CFGOPTVAL_REPO_TYPE_AZURE), 1024 * 1024, "azure");
+        TEST_RESULT_UINT(restoreJobReadGapMax(CFGOPTVAL_REPO_TYPE_GCS), 1024 * 1024, "gcs");
+        TEST_RESULT_UINT(restoreJobReadGapMax(CFGOPTVAL_REPO_TYPE_S3), 1024 * 1024, "s3");
+        TEST_RESULT_UINT(restoreJobReadGapMax(CFGOPTVAL_REPO_TYPE_SFTP), 256 * 1024, "sftp");
+        TEST_RESULT_UINT(restoreJobReadGapMax(CFGOPTVAL_REPO_TYPE_CIFS), 64 * 1024, "cifs");
+        TEST_RESULT_UINT(restoreJobReadGapMax(CFGOPTVAL_REPO_TYPE_POSIX), 64 * 1024, "posix");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("bundle with gaps");
+
+        HRN_STORAGE_PUT_Z(storageRepoWrite(), "bundle/1", "aaaaaXXXXXbbbXXXXXXXXXXXXXXXXXXXXXXXXXXXcc");
+
+        fileList = lstNewP(sizeof(RestoreFile));
+
+        lstAdd(
+            fileList,
+            &(RestoreFile){
+                .name = STRDEF("a"), .checksum = cryptoHashOne(hashTypeSha1, BUFSTRDEF("aaaaa")), .size = 5, .mode = 0600,
+                .offset = 0, .limit = VARUINT64(5), .manifestFile = STRDEF("pg_data/a")});
+        lstAdd(
+            fileList,
+            &(RestoreFile){
+                .name = STRDEF("b"), .checksum = cryptoHashOne(hashTypeSha1, BUFSTRDEF("bbb")), .size = 3, .mode = 0600,
+                .offset = 10, .limit = VARUINT64(3), .manifestFile = STRDEF("pg_data/b")});
+        lstAdd(
+            fileList,
+            &(RestoreFile){
+                .name = STRDEF("c"), .checksum = cryptoHashOne(hashTypeSha1, BUFSTRDEF("cc")), .size = 2, .mode = 0600,
+                .offset = 40, .limit = VARUINT64(2), .manifestFile = STRDEF("pg_data/c")});
+        lstAdd(
+            fileList,
+            &(RestoreFile){
+                .name = STRDEF("d"), .checksum = cryptoHashOne(hashTypeSha1, BUFSTRDEF("XXXXX")), .size = 5, .mode = 0600,
+                .offset = 5, .limit = VARUINT64(5), .manifestFile = STRDEF("pg_data/d")});
+
+        List *resultList = NULL;
+
+        TEST_ASSIGN(
+            resultList,
+            restoreFile(STRDEF("bundle/1"), repoIdx, compressTypeNone, 0, false, false, false, 16, NULL, NULL, fileList),
+            "restore");
+        TEST_RESULT_UINT(lstSize(resultList), 4, "check result size");
+        TEST_STORAGE_GET(storagePgWrite(), "a", "aaaaa", .remove = true);
+        TEST_STORAGE_GET(storagePgWrite(), "b", "bbb", .remove = true);
+        TEST_STORAGE_GET(storagePgWrite(), "c", "cc", .remove = true);
+        TEST_STORAGE_GET(storagePgWrite(), "d", "XXXXX", .remove = true);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("read cache");
+
+        const size_t readGapMax = 256 * 1024;
+        Buffer *const readData = bufNew(readGapMax * 20);
+
+        for (unsigned int readIdx = 0; readIdx < bufSize(readData); readIdx++)
+            *(bufPtr(readData) + readIdx) = (unsigned char)(readIdx % 251);
+
+        bufUsedSet(readData, bufSize(readData));
+
+        HRN_STORAGE_PUT(storageRepoWrite(), "read/file1", readData);
+        HRN_STORAGE_PUT_Z(storageRepoWrite(), "read/file2", "0123456789");
+
+        List *const readCache = lstNewP(sizeof(RestoreFileReadCache));
+        IoRead *read = NULL;
+
+        TEST_ASSIGN(read, restoreFileReadCache(readCache, storageRepo(), STRDEF("read/file2"), 2, 3, 8), "read file2");
+        TEST_RESULT_STR_Z(strNewBuf(ioReadBuf(read)), "234", "check read");
+        TEST_RESULT_UINT(lstSize(readCache), 1, "region cached");
+        TEST_RESULT_UINT(bufUsed(((RestoreFileReadCache *)lstGet(readCache, 0))->region), 8, "region size");
+
+        TEST_ASSIGN(read, restoreFileReadCache(readCache, storageRepo(), STRDEF("read/file2"), 5, 5, 5), "read file2 from cache");
+        TEST_RESULT_STR_Z(strNewBuf(ioReadBuf(read)), "56789", "check read");
+        TEST_RESULT_UINT(lstSize(readCache), 1, "region not added");
+
+        TEST_ASSIGN(read, restoreFileReadCache(readCache, storageRepo(), STRDEF("read/file2"), 8, 5, 6), "short read file2");
+        TEST_RESULT_STR_Z(strNewBuf(ioReadBuf(read)), "89", "check read");
+        TEST_RESULT_UINT(lstSize(readCache), 2, "region added");
+
+        TEST_ASSIGN(read, restoreFileReadCache(readCache, storageRepo(), STRDEF("read/file1"), 2, 3, readGapMax), "read file1");
+        TEST_RESULT_UINT(lstSize(readCache), 3, "region added");
+
+        TEST_ASSIGN(
+            read, restoreFileReadCache(readCache, storageRepo(), STRDEF("read/file1"), 100, readGapMax + 1, readGapMax + 1),
+            "read not extended");
+        TEST_RESULT_BOOL(
+            bufEq(ioReadBuf(read), BUF(bufPtrConst(readData) + 100, readGapMax + 1)), true, "check read");
+        TEST_RESULT_UINT(lstSize(readCache), 3, "region not added");
+
+        for (unsigned int readIdx = 1; readIdx < 20; readIdx++)
+        {
+            read = restoreFileReadCache(readCache, storageRepo(), STRDEF("read/file1"), readIdx * readGapMax, 10, readGapMax);
+            TEST_RESULT_BOOL(
+                bufEq(ioReadBuf(read), BUF(bufPtrConst(readData) + readIdx * readGapMax, 10)), true, "check read");
+        }
+
+        TEST_RESULT_UINT(lstSize(readCache), 16, "oldest regions removed");
+        TEST_RESULT_STR_Z(((RestoreFileReadCache *)lstGet(readCache, 0))->repoFile, "read/file1", "oldest region file");
+        TEST_RESULT_UINT(
+            ((RestoreFileReadCache *)lstGet(readCache, 0))->offset, 4 * readGapMax, "oldest region offset");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("read size extended to following reads within the gap");
+
+        BlockMap *const blockMap = blockMapNew();
+
+        blockMapAdd(blockMap, &(BlockMapItem){.reference = 1, .superBlockSize = 8, .offset = 110, .size = 10});
+        blockMapAdd(blockMap, &(BlockMapItem){.reference = 0, .superBlockSize = 8, .offset = 100, .size = 10});
+        blockMapAdd(blockMap, &(BlockMapItem){.reference = 0, .superBlockSize = 8, .offset = 0, .size = 10});
+        blockMapAdd(blockMap, &(BlockMapItem){.reference = 0, .superBlockSize = 8, .offset = 150, .size = 10});
+        blockMapAdd(blockMap, &(BlockMapItem){.reference = 0, .superBlockSize = 8, .offset = 120, .size = 10});
+
+        const BlockDelta *const blockDelta = blockDeltaNew(blockMap, 8, 8, NULL, 100, cipherTypeNone, NULL, compressTypeNone);
+
+        TEST_RESULT_UINT(blockDeltaReadSize(blockDelta), 5, "read total");
+        TEST_RESULT_UINT(restoreFileReadSize(blockDelta, 0, 100), 10, "following reads in another reference");
+        TEST_RESULT_UINT(restoreFileReadSize(blockDelta, 1, 100), 60, "following reads within gap");
+        TEST_RESULT_UINT(restoreFileReadSize(blockDelta, 2, 100), 10, "following reads beyond gap");
+        TEST_RESULT_UINT(restoreFileReadSize(blockDelta, 4, 100), 10, "no following reads");
     }
 
     // *****************************************************************************************************************************
@@ -2161,7 +2317,7 @@ testRun(void)
                 storageNewWriteP(storageRepoIdxWrite(0), STRDEF(STORAGE_REPO_BACKUP "/" TEST_LABEL "/" BACKUP_MANIFEST_FILE))));
 
         // Read the manifest, set a cipher passphrase and store it to the encrypted repo
-        Manifest *manifestEncrypted = manifestLoadFile(
+        Manifest *manifestEncrypted = manifestLoadFileP(
             storageRepoIdxWrite(0), STRDEF(STORAGE_REPO_BACKUP "/" TEST_LABEL "/" BACKUP_MANIFEST_FILE), cipherTypeNone, NULL);
         manifestCipherSubPassSet(manifestEncrypted, STRDEF(TEST_CIPHER_PASS_ARCHIVE));
 
@@ -2682,7 +2838,7 @@ testRun(void)
             bufUsedSet(fileBuffer, bufSize(fileBuffer));
 
             IoWrite *write = storageWriteIo(storageNewWriteP(storageRepoWrite(), STRDEF(TEST_REPO_PATH "base/1/bi-no-ref.pgbi")));
-            ioFilterGroupAdd(ioWriteFilterGroup(write), blockIncrNew(8192, 8192, 11, 3, 0, 0, NULL, NULL, NULL));
+            ioFilterGroupAdd(ioWriteFilterGroup(write), blockIncrNew(8192, 8192, 11, 3, 0, 0, NULL, 0, 0, NULL, NULL));
             ioFilterGroupAdd(ioWriteFilterGroup(write), ioSizeNew());
 
             ioWriteOpen(write);
@@ -2704,7 +2860,7 @@ testRun(void)
 
             Buffer *fileUnusedMap = bufNew(0);
             write = ioBufferWriteNew(fileUnusedMap);
-            ioFilterGroupAdd(ioWriteFilterGroup(write), blockIncrNew(8192, 8192, 11, 0, 0, 0, NULL, NULL, NULL));
+            ioFilterGroupAdd(ioWriteFilterGroup(write), blockIncrNew(8192, 8192, 11, 0, 0, 0, NULL, 0, 0, NULL, NULL));
 
             ioWriteOpen(write);
             ioWrite(write, fileUnused);
@@ -2724,7 +2880,8 @@ testRun(void)
                 ioWriteFilterGroup(write),
                 blockIncrNew(
                     8192, 8192, 11, 3, 0, 0,
-                    BUF(bufPtr(fileUnusedMap) + bufUsed(fileUnusedMap) - fileUnusedMapSize, fileUnusedMapSize), NULL, NULL));
+                    BUF(bufPtr(fileUnusedMap) + bufUsed(fileUnusedMap) - fileUnusedMapSize, fileUnusedMapSize), 0, 0, NULL,
+                    NULL));
             ioFilterGroupAdd(ioWriteFilterGroup(write), ioSizeNew());
 
             ioWriteOpen(write);
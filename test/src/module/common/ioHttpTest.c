@@ -18,6 +18,21 @@ HTTP user agent header
 #define TEST_USER_AGENT                                                                                                            \
     HTTP_HEADER_USER_AGENT ":" PROJECT_NAME "/" PROJECT_VERSION "\r\n"
 
+/***********************************************************************************************************************************
+Start a ranged request for HttpRangeRead
+***********************************************************************************************************************************/
+static HttpRequest *
+testRangeReadRequest(void *const data, const uint64_t offset, const uint64_t size, const HttpHeader *const responseHeader)
+{
+    HttpHeader *const header = httpHeaderPutRange(httpHeaderNew(NULL), offset, VARUINT64(size));
+    const String *const etag = responseHeader == NULL ? NULL : httpHeaderGet(responseHeader, HTTP_HEADER_ETAG_STR);
+
+    if (etag != NULL)
+        httpHeaderAdd(header, HTTP_HEADER_IF_MATCH_STR, etag);
+
+    return httpRequestNewP(data, HTTP_VERB_GET_STR, STRDEF("/file"), .header = header);
+}
+
 /***********************************************************************************************************************************
 Test Run
 ***********************************************************************************************************************************/
@@ -979,5 +994,286 @@ testRun(void)
         TEST_RESULT_PTR_NE(statToJson(), NULL, "check");
     }
 
+    // *****************************************************************************************************************************
+    if (testBegin("HttpRangeRead"))
+    {
+        HRN_FORK_BEGIN()
+        {
+            const unsigned int testPort = hrnServerPortNext();
+
+            HRN_FORK_CHILD_BEGIN(.prefix = "test server", .timeout = 5000)
+            {
+                // Start HTTP test server
+                TEST_RESULT_VOID(hrnServerRunP(HRN_FORK_CHILD_READ(), hrnServerProtocolSocket, testPort), "http server");
+            }
+            HRN_FORK_CHILD_END();
+
+            HRN_FORK_PARENT_BEGIN()
+            {
+                IoWrite *http = hrnServerScriptBegin(HRN_FORK_PARENT_WRITE(0));
+                HttpClient *client = httpClientNew(sckClientNew(hrnServerHost(), testPort, 5000, 5000), 5000);
+                HttpRangeRead *rangeRead = NULL;
+                Buffer *buffer = bufNew(16);
+
+                // Every response closes the connection so each request in progress gets a new session
+                hrnServerScriptAccept(http);
+
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("missing object");
+
+                hrnServerScriptExpectZ(http, "GET /file HTTP/1.1\r\n" TEST_USER_AGENT "range:bytes=0-3\r\n\r\n");
+                hrnServerScriptReplyZ(http, "HTTP/1.1 404 Not Found\r\nconnection:close\r\n\r\n");
+                hrnServerScriptClose(http);
+
+                TEST_ASSIGN(rangeRead, httpRangeReadNew(testRangeReadRequest, client, 0, NULL, 4, 2), "new range read");
+                TEST_RESULT_BOOL(httpRangeReadOpen(rangeRead), false, "open");
+                TEST_RESULT_BOOL(httpRangeReadEof(rangeRead), true, "eof");
+
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("empty object");
+
+                hrnServerScriptAccept(http);
+                hrnServerScriptExpectZ(http, "GET /file HTTP/1.1\r\n" TEST_USER_AGENT "range:bytes=0-3\r\n\r\n");
+                hrnServerScriptReplyZ(http, "HTTP/1.1 416 Range Not Satisfiable\r\nconnection:close\r\n\r\n");
+                hrnServerScriptClose(http);
+
+                TEST_ASSIGN(rangeRead, httpRangeReadNew(testRangeReadRequest, client, 0, NULL, 4, 2), "new range read");
+                TEST_RESULT_BOOL(httpRangeReadOpen(rangeRead), true, "open");
+                TEST_RESULT_UINT(httpRangeReadContent(rangeRead, buffer), 0, "read");
+                TEST_RESULT_BOOL(httpRangeReadEof(rangeRead), true, "eof");
+
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("offset past end of object");
+
+                hrnServerScriptAccept(http);
+                hrnServerScriptExpectZ(http, "GET /file HTTP/1.1\r\n" TEST_USER_AGENT "range:bytes=6-9\r\n\r\n");
+                hrnServerScriptReplyZ(http, "HTTP/1.1 416 Range Not Satisfiable\r\nconnection:close\r\n\r\n");
+                hrnServerScriptClose(http);
+
+                TEST_ASSIGN(rangeRead, httpRangeReadNew(testRangeReadRequest, client, 6, NULL, 4, 2), "new range read");
+                TEST_ERROR(
+                    httpRangeReadOpen(rangeRead), ProtocolError,
+                    "HTTP request failed with 416 (Range Not Satisfiable):\n"
+                    "*** Path/Query ***:\n"
+                    "GET /file\n"
+                    "*** Request Headers ***:\n"
+                    "range: bytes=6-9\n"
+                    "*** Response Headers ***:\n"
+                    "connection: close");
+
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("error on first range");
+
+                hrnServerScriptAccept(http);
+                hrnServerScriptExpectZ(http, "GET /file HTTP/1.1\r\n" TEST_USER_AGENT "range:bytes=0-3\r\n\r\n");
+                hrnServerScriptReplyZ(http, "HTTP/1.1 403 Forbidden\r\nconnection:close\r\n\r\n");
+                hrnServerScriptClose(http);
+
+                TEST_ASSIGN(rangeRead, httpRangeReadNew(testRangeReadRequest, client, 0, NULL, 4, 2), "new range read");
+                TEST_ERROR(
+                    httpRangeReadOpen(rangeRead), ProtocolError,
+                    "HTTP request failed with 403 (Forbidden):\n"
+                    "*** Path/Query ***:\n"
+                    "GET /file\n"
+                    "*** Request Headers ***:\n"
+                    "range: bytes=0-3\n"
+                    "*** Response Headers ***:\n"
+                    "connection: close");
+
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("invalid content-range");
+
+                hrnServerScriptAccept(http);
+                hrnServerScriptExpectZ(http, "GET /file HTTP/1.1\r\n" TEST_USER_AGENT "range:bytes=0-3\r\n\r\n");
+                hrnServerScriptReplyZ(
+                    http, "HTTP/1.1 206 Partial Content\r\nconnection:close\r\ncontent-length:4\r\n\r\n0123");
+                hrnServerScriptClose(http);
+
+                TEST_ASSIGN(rangeRead, httpRangeReadNew(testRangeReadRequest, client, 0, NULL, 4, 2), "new range read");
+                TEST_ERROR(
+                    httpRangeReadOpen(rangeRead), FormatError, "invalid content-range header '(null)' in partial content response");
+
+                hrnServerScriptAccept(http);
+                hrnServerScriptExpectZ(http, "GET /file HTTP/1.1\r\n" TEST_USER_AGENT "range:bytes=0-3\r\n\r\n");
+                hrnServerScriptReplyZ(
+                    http,
+                    "HTTP/1.1 206 Partial Content\r\nconnection:close\r\ncontent-length:4\r\ncontent-range:bytes 0-3\r\n\r\n"
+                    "0123");
+                hrnServerScriptClose(http);
+
+                TEST_ASSIGN(rangeRead, httpRangeReadNew(testRangeReadRequest, client, 0, NULL, 4, 2), "new range read");
+                TEST_ERROR(
+                    httpRangeReadOpen(rangeRead), FormatError,
+                    "invalid content-range header 'bytes 0-3' in partial content response");
+
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("range ignored and entire object returned");
+
+                hrnServerScriptAccept(http);
+                hrnServerScriptExpectZ(http, "GET /file HTTP/1.1\r\n" TEST_USER_AGENT "range:bytes=0-3\r\n\r\n");
+                hrnServerScriptReplyZ(http, "HTTP/1.1 200 OK\r\nconnection:close\r\ncontent-length:6\r\n\r\n012345");
+                hrnServerScriptClose(http);
+
+                TEST_ASSIGN(rangeRead, httpRangeReadNew(testRangeReadRequest, client, 0, NULL, 4, 2), "new range read");
+                TEST_RESULT_BOOL(httpRangeReadOpen(rangeRead), true, "open");
+                TEST_RESULT_UINT(httpRangeReadContent(rangeRead, buffer), 6, "read");
+                TEST_RESULT_STR_Z(strNewBuf(buffer), "012345", "check content");
+                TEST_RESULT_BOOL(httpRangeReadEof(rangeRead), true, "eof");
+
+                bufUsedZero(buffer);
+
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("read ranges in order with two in progress");
+
+                hrnServerScriptAccept(http);
+                hrnServerScriptExpectZ(http, "GET /file HTTP/1.1\r\n" TEST_USER_AGENT "range:bytes=0-3\r\n\r\n");
+                hrnServerScriptReplyZ(
+                    http,
+                    "HTTP/1.1 206 Partial Content\r\nconnection:close\r\ncontent-length:4\r\ncontent-range:bytes 0-3/10\r\n\r\n"
+                    "0123");
+                hrnServerScriptClose(http);
+
+                hrnServerScriptAccept(http);
+                hrnServerScriptExpectZ(http, "GET /file HTTP/1.1\r\n" TEST_USER_AGENT "range:bytes=4-7\r\n\r\n");
+                hrnServerScriptReplyZ(
+                    http,
+                    "HTTP/1.1 206 Partial Content\r\nconnection:close\r\ncontent-length:4\r\ncontent-range:bytes 4-7/10\r\n\r\n"
+                    "4567");
+                hrnServerScriptClose(http);
+
+                hrnServerScriptAccept(http);
+                hrnServerScriptExpectZ(http, "GET /file HTTP/1.1\r\n" TEST_USER_AGENT "range:bytes=8-9\r\n\r\n");
+                hrnServerScriptReplyZ(
+                    http,
+                    "HTTP/1.1 206 Partial Content\r\nconnection:close\r\ncontent-length:2\r\ncontent-range:bytes 8-9/10\r\n\r\n"
+                    "89");
+                hrnServerScriptClose(http);
+
+                TEST_ASSIGN(rangeRead, httpRangeReadNew(testRangeReadRequest, client, 0, NULL, 4, 2), "new range read");
+                TEST_RESULT_BOOL(httpRangeReadOpen(rangeRead), true, "open");
+                TEST_RESULT_UINT(lstSize(rangeRead->requestList), 1, "second range in progress");
+                TEST_RESULT_UINT(httpRangeReadContent(rangeRead, bufNew(6)), 6, "read across ranges");
+                TEST_RESULT_UINT(httpRangeReadContent(rangeRead, buffer), 4, "read remaining");
+                TEST_RESULT_STR_Z(strNewBuf(buffer), "6789", "check content");
+                TEST_RESULT_BOOL(httpRangeReadEof(rangeRead), true, "eof");
+                TEST_RESULT_VOID(httpRangeReadFree(rangeRead), "free");
+
+                bufUsedZero(buffer);
+
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("read with offset and limit");
+
+                hrnServerScriptAccept(http);
+                hrnServerScriptExpectZ(http, "GET /file HTTP/1.1\r\n" TEST_USER_AGENT "range:bytes=2-5\r\n\r\n");
+                hrnServerScriptReplyZ(
+                    http,
+                    "HTTP/1.1 206 Partial Content\r\nconnection:close\r\ncontent-length:4\r\ncontent-range:bytes 2-5/10\r\n\r\n"
+                    "2345");
+                hrnServerScriptClose(http);
+
+                hrnServerScriptAccept(http);
+                hrnServerScriptExpectZ(http, "GET /file HTTP/1.1\r\n" TEST_USER_AGENT "range:bytes=6-6\r\n\r\n");
+                hrnServerScriptReplyZ(
+                    http,
+                    "HTTP/1.1 206 Partial Content\r\nconnection:close\r\ncontent-length:1\r\ncontent-range:bytes 6-6/10\r\n\r\n"
+                    "6");
+                hrnServerScriptClose(http);
+
+                TEST_ASSIGN(rangeRead, httpRangeReadNew(testRangeReadRequest, client, 2, VARUINT64(5), 4, 3), "new range read");
+                TEST_RESULT_BOOL(httpRangeReadOpen(rangeRead), true, "open");
+                TEST_RESULT_UINT(httpRangeReadContent(rangeRead, buffer), 5, "read");
+                TEST_RESULT_STR_Z(strNewBuf(buffer), "23456", "check content");
+                TEST_RESULT_BOOL(httpRangeReadEof(rangeRead), true, "eof");
+
+                bufUsedZero(buffer);
+
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("limit smaller than range");
+
+                hrnServerScriptAccept(http);
+                hrnServerScriptExpectZ(http, "GET /file HTTP/1.1\r\n" TEST_USER_AGENT "range:bytes=0-2\r\n\r\n");
+                hrnServerScriptReplyZ(
+                    http,
+                    "HTTP/1.1 206 Partial Content\r\nconnection:close\r\ncontent-length:3\r\ncontent-range:bytes 0-2/10\r\n\r\n"
+                    "012");
+                hrnServerScriptClose(http);
+
+                TEST_ASSIGN(rangeRead, httpRangeReadNew(testRangeReadRequest, client, 0, VARUINT64(3), 4, 2), "new range read");
+                TEST_RESULT_BOOL(httpRangeReadOpen(rangeRead), true, "open");
+                TEST_RESULT_UINT(lstSize(rangeRead->requestList), 0, "no other ranges");
+                TEST_RESULT_UINT(httpRangeReadContent(rangeRead, buffer), 3, "read");
+                TEST_RESULT_STR_Z(strNewBuf(buffer), "012", "check content");
+                TEST_RESULT_BOOL(httpRangeReadEof(rangeRead), true, "eof");
+
+                bufUsedZero(buffer);
+
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("later range missing");
+
+                hrnServerScriptAccept(http);
+                hrnServerScriptExpectZ(http, "GET /file HTTP/1.1\r\n" TEST_USER_AGENT "range:bytes=0-3\r\n\r\n");
+                hrnServerScriptReplyZ(
+                    http,
+                    "HTTP/1.1 206 Partial Content\r\nconnection:close\r\ncontent-length:4\r\ncontent-range:bytes 0-3/6\r\n\r\n"
+                    "0123");
+                hrnServerScriptClose(http);
+
+                hrnServerScriptAccept(http);
+                hrnServerScriptExpectZ(http, "GET /file HTTP/1.1\r\n" TEST_USER_AGENT "range:bytes=4-5\r\n\r\n");
+                hrnServerScriptReplyZ(http, "HTTP/1.1 404 Not Found\r\nconnection:close\r\n\r\n");
+                hrnServerScriptClose(http);
+
+                TEST_ASSIGN(rangeRead, httpRangeReadNew(testRangeReadRequest, client, 0, NULL, 4, 2), "new range read");
+                TEST_RESULT_BOOL(httpRangeReadOpen(rangeRead), true, "open");
+                TEST_ERROR(
+                    httpRangeReadContent(rangeRead, buffer), ProtocolError,
+                    "HTTP request failed with 404 (Not Found):\n"
+                    "*** Path/Query ***:\n"
+                    "GET /file\n"
+                    "*** Request Headers ***:\n"
+                    "range: bytes=4-5\n"
+                    "*** Response Headers ***:\n"
+                    "connection: close");
+
+                bufUsedZero(buffer);
+
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("object changed after first range");
+
+                hrnServerScriptAccept(http);
+                hrnServerScriptExpectZ(http, "GET /file HTTP/1.1\r\n" TEST_USER_AGENT "range:bytes=0-3\r\n\r\n");
+                hrnServerScriptReplyZ(
+                    http,
+                    "HTTP/1.1 206 Partial Content\r\nconnection:close\r\ncontent-length:4\r\ncontent-range:bytes 0-3/6\r\n"
+                    "etag:\"AAA\"\r\n\r\n0123");
+                hrnServerScriptClose(http);
+
+                hrnServerScriptAccept(http);
+                hrnServerScriptExpectZ(
+                    http, "GET /file HTTP/1.1\r\n" TEST_USER_AGENT "if-match:\"AAA\"\r\nrange:bytes=4-5\r\n\r\n");
+                hrnServerScriptReplyZ(http, "HTTP/1.1 412 Precondition Failed\r\nconnection:close\r\n\r\n");
+                hrnServerScriptClose(http);
+
+                TEST_ASSIGN(rangeRead, httpRangeReadNew(testRangeReadRequest, client, 0, NULL, 4, 2), "new range read");
+                TEST_RESULT_BOOL(httpRangeReadOpen(rangeRead), true, "open");
+                TEST_ERROR(
+                    httpRangeReadContent(rangeRead, buffer), ProtocolError,
+                    "HTTP request failed with 412 (Precondition Failed):\n"
+                    "*** Path/Query ***:\n"
+                    "GET /file\n"
+                    "*** Request Headers ***:\n"
+                    "if-match: \"AAA\"\n"
+                    "range: bytes=4-5\n"
+                    "*** Response Headers ***:\n"
+                    "connection: close");
+
+                // -----------------------------------------------------------------------------------------------------------------
+                hrnServerScriptEnd(http);
+            }
+            HRN_FORK_PARENT_END();
+        }
+        HRN_FORK_END();
+    }
+
     FUNCTION_HARNESS_RETURN_VOID();
 }
@@ -40,6 +40,9 @@ testRun(void)
         TEST_RESULT_VOID(lstClear(list), "clear list");
         TEST_RESULT_VOID(FUNCTION_LOG_OBJECT_FORMAT(list, lstToLog, logBuf, sizeof(logBuf)), "bufToLog");
         TEST_RESULT_Z(logBuf, "{size: 0}", "check log");
+        TEST_RESULT_VOID(lstClear(list), "clear cleared list");
+        TEST_RESULT_VOID(lstAdd(list, &ptr), "add item after clear");
+        TEST_RESULT_UINT(lstSize(list), 1, "list size");
 
         TEST_RESULT_VOID(lstFree(list), "free list");
         TEST_RESULT_VOID(lstFree(lstNewP(1)), "free empty list");
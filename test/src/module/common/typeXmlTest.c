@@ -2,6 +2,21 @@
 Test Xml Types
 ***********************************************************************************************************************************/
 
+#include "common/io/bufferRead.h"
+
+/***********************************************************************************************************************************
+Read that always errors
+***********************************************************************************************************************************/
+static size_t
+testXmlReadError(void *const driver, Buffer *const buffer, const bool block)
+{
+    (void)driver;
+    (void)buffer;
+    (void)block;
+
+    THROW(FileReadError, "read failed");
+}
+
 /***********************************************************************************************************************************
 Test Run
 ***********************************************************************************************************************************/
@@ -150,5 +165,125 @@ testRun(void)
             "get xml");
     }
 
+    // *****************************************************************************************************************************
+    if (testBegin("XmlReader"))
+    {
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("read children of the root node");
+
+        // Use a small buffer so the document is read in several parts
+        ioBufferSizeSet(16);
+
+        IoRead *read = ioBufferReadNew(
+            BUFSTRDEF(
+                "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                "<ListBucketResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">\n"
+                "    <Name>bucket</Name>\n"
+                "    <!-- comment -->\n"
+                "    <Prefix/>\n"
+                "    <IsTruncated>false</IsTruncated>\n"
+                "    <Contents>\n"
+                "        <Key>test1.txt</Key>\n"
+                "        <Size>1234</Size>\n"
+                "    </Contents>\n"
+                "    <Contents>\n"
+                "        <Key>test2.txt</Key>\n"
+                "        <Size>4321</Size>\n"
+                "    </Contents>\n"
+                "</ListBucketResult>"));
+        ioReadOpen(read);
+
+        XmlReader *reader = NULL;
+        TEST_ASSIGN(reader, xmlReaderNewP(read), "new reader");
+
+        const XmlNode *node = NULL;
+        TEST_ASSIGN(node, xmlReaderNext(reader), "next");
+        TEST_RESULT_STR_Z(xmlNodeName(node), "Name", "check name");
+        TEST_RESULT_STR_Z(xmlNodeContent(node), "bucket", "check content");
+        TEST_ASSIGN(node, xmlReaderNext(reader), "next");
+        TEST_RESULT_STR_Z(xmlNodeName(node), "Prefix", "check name");
+        TEST_RESULT_STR_Z(xmlNodeContent(node), "", "check content");
+        TEST_ASSIGN(node, xmlReaderNext(reader), "next");
+        TEST_RESULT_STR_Z(xmlNodeName(node), "IsTruncated", "check name");
+        TEST_RESULT_STR_Z(xmlNodeContent(node), "false", "check content");
+        TEST_ASSIGN(node, xmlReaderNext(reader), "next");
+        TEST_RESULT_STR_Z(xmlNodeName(node), "Contents", "check name");
+        TEST_RESULT_STR_Z(xmlNodeContent(xmlNodeChild(node, STRDEF("Key"), true)), "test1.txt", "check key");
+        TEST_RESULT_STR_Z(xmlNodeContent(xmlNodeChild(node, STRDEF("Size"), true)), "1234", "check size");
+        TEST_ASSIGN(node, xmlReaderNext(reader), "next");
+        TEST_RESULT_STR_Z(xmlNodeContent(xmlNodeChild(node, STRDEF("Key"), true)), "test2.txt", "check key");
+        TEST_RESULT_PTR(xmlReaderNext(reader), NULL, "no more children");
+        TEST_RESULT_PTR(xmlReaderNext(reader), NULL, "still no more children");
+
+        TEST_RESULT_VOID(xmlReaderFree(reader), "free reader");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("read children of a container");
+
+        read = ioBufferReadNew(
+            BUFSTRDEF(
+                "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n"
+                "<EnumerationResults>\n"
+                "    <Prefix>path/</Prefix>\n"
+                "    <Blobs>\n"
+                "        <Blob><Name>path/test1.txt</Name></Blob>\n"
+                "        <BlobPrefix><Name>path/sub/</Name></BlobPrefix>\n"
+                "    </Blobs>\n"
+                "    <Other><Blob><Name>skip</Name></Blob></Other>\n"
+                "    <NextMarker>marker</NextMarker>\n"
+                "</EnumerationResults>"));
+        ioReadOpen(read);
+
+        TEST_ASSIGN(reader, xmlReaderNewP(read, .container = STRDEF("Blobs")), "new reader");
+
+        TEST_ASSIGN(node, xmlReaderNext(reader), "next");
+        TEST_RESULT_STR_Z(xmlNodeName(node), "Prefix", "check name");
+        TEST_ASSIGN(node, xmlReaderNext(reader), "next");
+        TEST_RESULT_STR_Z(xmlNodeName(node), "Blob", "check name");
+        TEST_RESULT_STR_Z(xmlNodeContent(xmlNodeChild(node, STRDEF("Name"), true)), "path/test1.txt", "check content");
+        TEST_ASSIGN(node, xmlReaderNext(reader), "next");
+        TEST_RESULT_STR_Z(xmlNodeName(node), "BlobPrefix", "check name");
+        TEST_ASSIGN(node, xmlReaderNext(reader), "next");
+        TEST_RESULT_STR_Z(xmlNodeName(node), "Other", "check name");
+        TEST_ASSIGN(node, xmlReaderNext(reader), "next");
+        TEST_RESULT_STR_Z(xmlNodeName(node), "NextMarker", "check name");
+        TEST_RESULT_STR_Z(xmlNodeContent(node), "marker", "check content");
+        TEST_RESULT_PTR(xmlReaderNext(reader), NULL, "no more children");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("root node without children");
+
+        read = ioBufferReadNew(BUFSTRDEF("<root/>"));
+        ioReadOpen(read);
+
+        TEST_ASSIGN(reader, xmlReaderNewP(read), "new reader");
+        TEST_RESULT_PTR(xmlReaderNext(reader), NULL, "no children");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("invalid xml");
+
+        read = ioBufferReadNew(BUFSTRDEF(BOGUS_STR));
+        ioReadOpen(read);
+
+        TEST_ASSIGN(reader, xmlReaderNewP(read), "new reader");
+        TEST_ERROR(xmlReaderNext(reader), FormatError, "invalid xml");
+
+        read = ioBufferReadNew(BUFSTRDEF("<root><a>1</a><b><c>2</c>"));
+        ioReadOpen(read);
+
+        TEST_ASSIGN(reader, xmlReaderNewP(read), "new reader");
+        TEST_RESULT_STR_Z(xmlNodeContent(xmlReaderNext(reader)), "1", "first child");
+        TEST_ERROR(xmlReaderNext(reader), FormatError, "invalid xml");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("error while reading");
+
+        read = ioReadNewP(strNewZ("driver"), .read = testXmlReadError);
+        ioReadOpen(read);
+
+        TEST_ASSIGN(reader, xmlReaderNewP(read), "new reader");
+        TEST_ERROR(xmlReaderNext(reader), FileReadError, "read failed");
+    }
+
     FUNCTION_HARNESS_RETURN_VOID();
 }
@@ -325,7 +325,7 @@ testRun(void)
             "pg_data={}\n"
             TEST_MANIFEST_PATH_DEFAULT);
 
-        TEST_ASSIGN(manifest, manifestNewLoad(ioBufferReadNew(manifestContent)), "load manifest");
+        TEST_ASSIGN(manifest, manifestNewLoadP(ioBufferReadNew(manifestContent)), "load manifest");
         TEST_RESULT_VOID(infoBackupDataAdd(infoBackup, manifest), "add a backup");
         TEST_RESULT_UINT(infoBackupDataTotal(infoBackup), 1, "backup added to current");
         TEST_ASSIGN(backupData, infoBackupData(infoBackup, 0), "get added backup");
@@ -433,7 +433,7 @@ testRun(void)
             "pg_data/base/65536={\"user\":false}\n"                                                                                \
             TEST_MANIFEST_PATH_DEFAULT
 
-        TEST_ASSIGN(manifest, manifestNewLoad(ioBufferReadNew(harnessInfoChecksumZ(TEST_MANIFEST_INCR))), "load manifest");
+        TEST_ASSIGN(manifest, manifestNewLoadP(ioBufferReadNew(harnessInfoChecksumZ(TEST_MANIFEST_INCR))), "load manifest");
         TEST_RESULT_VOID(infoBackupDataAdd(infoBackup, manifest), "add a backup");
         TEST_RESULT_UINT(infoBackupDataTotal(infoBackup), 2, "backup added to current");
         TEST_ASSIGN(backupData, infoBackupData(infoBackup, 1), "get added backup");
@@ -173,6 +173,12 @@ testRun(void)
         TEST_RESULT_STR_Z(callbackContent, "[c] key=1\n[d] key=1\n", "    check callback content");
         TEST_RESULT_STR(infoCipherPass(info), NULL, "    check cipher pass not set");
 
+        // Key that must be escaped for the checksum
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_ASSIGN(
+            info, infoNewLoad(ioBufferReadNew(harnessInfoChecksumZ("[c]\nkey\"\\=1\n")), harnessInfoLoadNewCallback, strNew()),
+            "info with escaped key");
+
         Buffer *contentSave = bufNew(0);
 
         TEST_RESULT_VOID(infoSave(info, ioBufferWriteNew(contentSave), testInfoSaveCallback, strNewZ("1")), "info save");
@@ -643,6 +643,12 @@ testRun(void)
         // Write a file into the directory pointed to by pg_xlog - contents will not be ignored online or offline
         HRN_STORAGE_PUT_Z(storageTest, "wal/000000020000000000000002", "OLDWAL", .modeFile = 0600, .timeModified = 1565282100);
 
+        // WAL summaries will be ignored online
+        HRN_STORAGE_PATH_CREATE(storagePgWrite, "pg_wal/summaries", .mode = 0700);
+        HRN_STORAGE_PUT_Z(
+            storagePgWrite, "pg_wal/summaries/0000000100000000010000280000000001000100.summary", "SUMMARY", .modeFile = 0600,
+            .timeModified = 1565282100);
+
         // Create backup_manifest and backup_manifest.tmp that will show up for PG12 but will be ignored in PG13
         HRN_STORAGE_PUT_Z(storagePgWrite, PG_FILE_BACKUPMANIFEST, "MANIFEST", .modeFile = 0600, .timeModified = 1565282198);
         HRN_STORAGE_PUT_Z(storagePgWrite, PG_FILE_BACKUPMANIFEST_TMP, "MANIFEST", .modeFile = 0600, .timeModified = 1565282199);
@@ -723,11 +729,14 @@ testRun(void)
                     "pg_data/pg_subtrans={}\n"
                     "pg_data/pg_tblspc={}\n"
                     "pg_data/pg_wal={}\n"
+                    "pg_data/pg_wal/summaries={}\n"
                     "pg_data/pg_xact={}\n"
                     "pg_data/pg_xlog={}\n"
                     TEST_MANIFEST_PATH_DEFAULT)),
             "check manifest");
 
+        HRN_STORAGE_PATH_REMOVE(storagePgWrite, "pg_wal/summaries", .recurse = true);
+
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("run 13, offline, block incr");
 
@@ -1462,7 +1471,7 @@ testRun(void)
 
         MEM_CONTEXT_TEMP_BEGIN()
         {
-            TEST_ASSIGN(manifest, manifestNewLoad(ioBufferReadNew(contentLoad)), "load manifest");
+            TEST_ASSIGN(manifest, manifestNewLoadP(ioBufferReadNew(contentLoad)), "load manifest");
             TEST_RESULT_VOID(manifestMove(manifest, memContextPrior()), "move manifest");
         }
         MEM_CONTEXT_TEMP_END();
@@ -1613,7 +1622,7 @@ testRun(void)
 
         TEST_ASSIGN(
             manifest,
-            manifestNewLoad(
+            manifestNewLoadP(
                 ioBufferReadNew(
                     harnessInfoChecksumZ(
                         "[backup]\n"
@@ -1950,11 +1959,14 @@ testRun(void)
         TEST_TITLE("load validation errors");
 
         TEST_ERROR(
-            manifestNewLoad(ioBufferReadNew(BUFSTRDEF("[target:file]\npg_data/bogus={\"size\":0}"))), FormatError,
+            manifestNewLoadP(ioBufferReadNew(BUFSTRDEF("[target:file]\npg_data/bogus={\"size\":0}"))), FormatError,
             "missing timestamp for file 'pg_data/bogus'");
         TEST_ERROR(
-            manifestNewLoad(ioBufferReadNew(BUFSTRDEF("[target:file]\npg_data/bogus={\"timestamp\":0}"))), FormatError,
+            manifestNewLoadP(ioBufferReadNew(BUFSTRDEF("[target:file]\npg_data/bogus={\"timestamp\":0}"))), FormatError,
             "missing size for file 'pg_data/bogus'");
+        TEST_ERROR(
+            manifestNewLoadP(ioBufferReadNew(BUFSTRDEF("[target:file]\npg_data/bogus={\"checksum\":\"abc\"}"))), FormatError,
+            "invalid checksum 'abc'");
     }
 
     // *****************************************************************************************************************************
@@ -1963,7 +1975,7 @@ testRun(void)
         Manifest *manifest = NULL;
 
         TEST_ERROR(
-            manifestLoadFile(storageTest, BACKUP_MANIFEST_FILE_STR, cipherTypeNone, NULL), FileMissingError,
+            manifestLoadFileP(storageTest, BACKUP_MANIFEST_FILE_STR, cipherTypeNone, NULL), FileMissingError,
             "unable to load backup manifest file '" TEST_PATH "/backup.manifest' or '" TEST_PATH "/backup.manifest.copy':\n"
             "FileMissingError: unable to open missing file '" TEST_PATH "/backup.manifest' for read\n"
             "FileMissingError: unable to open missing file '" TEST_PATH "/backup.manifest.copy' for read");
@@ -2027,15 +2039,27 @@ testRun(void)
             "user=\"user1\"\n"
 
         HRN_INFO_PUT(storageTest, BACKUP_MANIFEST_FILE INFO_COPY_EXT, TEST_MANIFEST_CONTENT, .comment = "write manifest copy");
-        TEST_ASSIGN(manifest, manifestLoadFile(storageTest, STRDEF(BACKUP_MANIFEST_FILE), cipherTypeNone, NULL), "load copy");
+        TEST_ASSIGN(manifest, manifestLoadFileP(storageTest, STRDEF(BACKUP_MANIFEST_FILE), cipherTypeNone, NULL), "load copy");
         TEST_RESULT_UINT(manifestData(manifest)->pgSystemId, 1000000000000000094, "check file loaded");
         TEST_RESULT_STR_Z(manifestData(manifest)->backrestVersion, PROJECT_VERSION, "check backrest version");
 
         HRN_STORAGE_REMOVE(storageTest, BACKUP_MANIFEST_FILE INFO_COPY_EXT, .errorOnMissing = true);
 
         HRN_INFO_PUT(storageTest, BACKUP_MANIFEST_FILE, TEST_MANIFEST_CONTENT, .comment = "write main manifest");
-        TEST_ASSIGN(manifest, manifestLoadFile(storageTest, STRDEF(BACKUP_MANIFEST_FILE), cipherTypeNone, NULL), "load main");
+        TEST_ASSIGN(manifest, manifestLoadFileP(storageTest, STRDEF(BACKUP_MANIFEST_FILE), cipherTypeNone, NULL), "load main");
+        TEST_RESULT_UINT(manifestData(manifest)->pgSystemId, 1000000000000000094, "check file loaded");
+        TEST_RESULT_UINT(manifestFileTotal(manifest), 1, "check file list loaded");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("load manifest without file list");
+
+        TEST_ASSIGN(
+            manifest, manifestLoadFileP(storageTest, STRDEF(BACKUP_MANIFEST_FILE), cipherTypeNone, NULL, .fileSkip = true),
+            "load main");
         TEST_RESULT_UINT(manifestData(manifest)->pgSystemId, 1000000000000000094, "check file loaded");
+        TEST_RESULT_UINT(manifestTargetTotal(manifest), 1, "check target list loaded");
+        TEST_RESULT_UINT(manifestPathTotal(manifest), 1, "check path list loaded");
+        TEST_RESULT_UINT(manifestFileTotal(manifest), 0, "check file list skipped");
 
         TEST_RESULT_VOID(manifestFree(manifest), "free manifest");
         TEST_RESULT_VOID(manifestFree(NULL), "free null manifest");
@@ -302,7 +302,7 @@ testRun(void)
 
         MEM_CONTEXT_BEGIN(testContext)
         {
-            manifest = manifestNewLoad(ioBufferReadNew(contentSave));
+            manifest = manifestNewLoadP(ioBufferReadNew(contentSave));
         }
         MEM_CONTEXT_END();
 
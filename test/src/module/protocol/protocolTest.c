@@ -487,14 +487,17 @@ testRun(void)
         hrnCfgArgKeyRawZ(argList, cfgOptPgPath, 2, "/path/to/2");
         hrnCfgArgKeyRawZ(argList, cfgOptPgHost, 2, "pg2-host");
         hrnCfgArgRawStrId(argList, cfgOptRemoteType, protocolStorageTypePg);
+        hrnCfgArgRawZ(argList, cfgOptCmdSshControlPath, TEST_PATH "/ssh");
         HRN_CFG_LOAD(cfgCmdBackup, argList, .role = cfgCmdRoleLocal, .noStd = true);
 
         TEST_RESULT_STRLST_Z(
             protocolRemoteParamSsh(protocolStorageTypePg, 1),
-            "-o\nLogLevel=error\n-o\nCompression=no\n-o\nPasswordAuthentication=no\npostgres@pg2-host\n"
+            "-o\nLogLevel=error\n-o\nCompression=no\n-o\nPasswordAuthentication=no\n-o\nControlMaster=auto\n"
+            "-o\nControlPath=" TEST_PATH "/ssh/%C\n-o\nControlPersist=60\npostgres@pg2-host\n"
             TEST_PROJECT_EXE " --exec-id=1-test --lock=test1-backup-1.lock --log-level-console=off --log-level-file=off"
             " --log-level-stderr=error --pg1-path=/path/to/2 --process=4 --remote-type=pg --stanza=test1 backup:remote\n",
             "check config");
+        TEST_RESULT_BOOL(storagePathExistsP(storageTest, STRDEF("ssh")), true, "control path created");
 
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("local and remote pg servers, params for remote including additional params");
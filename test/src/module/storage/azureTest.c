@@ -32,6 +32,7 @@ typedef struct TestRequestParam
     VAR_PARAM_HEADER;
     const char *content;
     const char *blobType;
+    const char *ifMatch;
     const char *range;
     const char *tag;
 } TestRequestParam;
@@ -87,6 +88,10 @@ testRequest(IoWrite *write, const char *verb, const char *path, TestRequestParam
     // Add host
     strCatFmt(request, "host:%s\r\n", strZ(hrnServerHost()));
 
+    // Add if-match
+    if (param.ifMatch != NULL)
+        strCatFmt(request, "if-match:%s\r\n", param.ifMatch);
+
     // Add range
     if (param.range != NULL)
         strCatFmt(request, "range:bytes=%s\r\n", param.range);
@@ -209,6 +214,7 @@ testRun(void)
         TEST_RESULT_STR_Z(((StorageAzure *)storageDriver(storage))->host, TEST_ACCOUNT ".blob.core.windows.net", "check host");
         TEST_RESULT_STR_Z(((StorageAzure *)storageDriver(storage))->pathPrefix, "/" TEST_CONTAINER, "check path prefix");
         TEST_RESULT_UINT(((StorageAzure *)storageDriver(storage))->blockSize, 4 * 1024 * 1024, "check block size");
+        TEST_RESULT_UINT(((StorageAzure *)storageDriver(storage))->downloadMax, 1, "check download max");
         TEST_RESULT_BOOL(storageFeature(storage, storageFeaturePath), false, "check path feature");
 
         // -------------------------------------------------------------------------------------------------------------------------
@@ -398,8 +404,8 @@ testRun(void)
             (StorageAzure *)storageDriver(
                 storageAzureNew(
                     STRDEF("/repo"), false, 0, NULL, TEST_CONTAINER_STR, TEST_ACCOUNT_STR, storageAzureKeyTypeShared,
-                    TEST_KEY_SHARED_STR, 16, NULL, STRDEF("blob.core.windows.net"), storageAzureUriStyleHost, 443, 1000, true, NULL,
-                    NULL)),
+                    TEST_KEY_SHARED_STR, 16, 1, NULL, STRDEF("blob.core.windows.net"), storageAzureUriStyleHost, 443, 1000, true,
+                    NULL, NULL)),
             "new azure storage - shared key");
 
         // -------------------------------------------------------------------------------------------------------------------------
@@ -440,7 +446,7 @@ testRun(void)
             (StorageAzure *)storageDriver(
                 storageAzureNew(
                     STRDEF("/repo"), false, 0, NULL, TEST_CONTAINER_STR, TEST_ACCOUNT_STR, storageAzureKeyTypeSas, TEST_KEY_SAS_STR,
-                    16, NULL, STRDEF("blob.core.usgovcloudapi.net"), storageAzureUriStyleHost, 443, 1000, true, NULL, NULL)),
+                    16, 1, NULL, STRDEF("blob.core.usgovcloudapi.net"), storageAzureUriStyleHost, 443, 1000, true, NULL, NULL)),
             "new azure storage - sas key");
 
         query = httpQueryAdd(httpQueryNewP(), STRDEF("a"), STRDEF("b"));
@@ -535,6 +541,34 @@ testRun(void)
                 TEST_RESULT_STR_Z(
                     strNewBuf(storageGetP(storageNewReadP(storage, STRDEF("file0.txt")))), "", "get zero-length file");
 
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("get file in concurrent ranges");
+
+                // Allow two ranges to download concurrently. Range responses close the connection so each range gets a new session.
+                driver->downloadSize = 16;
+                driver->downloadMax = 2;
+
+                testRequestP(service, HTTP_VERB_GET, "/file.txt", .range = "0-15");
+                testResponseP(
+                    service, .code = 206, .header = "connection:close\r\ncontent-range:bytes 0-15/21\r\netag:\"E1\"",
+                    .content = "this is a sample");
+
+                hrnServerScriptClose(service);
+                hrnServerScriptAccept(service);
+
+                testRequestP(service, HTTP_VERB_GET, "/file.txt", .ifMatch = "\"E1\"", .range = "16-20");
+                testResponseP(
+                    service, .code = 206, .header = "connection:close\r\ncontent-range:bytes 16-20/21", .content = " file");
+
+                hrnServerScriptClose(service);
+                hrnServerScriptAccept(service);
+
+                TEST_RESULT_STR_Z(
+                    strNewBuf(storageGetP(storageNewReadP(storage, STRDEF("file.txt")))), "this is a sample file", "get file");
+
+                driver->downloadSize = HTTP_RANGE_READ_SIZE;
+                driver->downloadMax = 1;
+
                 // -----------------------------------------------------------------------------------------------------------------
                 TEST_TITLE("non-404 error");
 
@@ -729,6 +763,7 @@ testRun(void)
                     .content =
                         "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
                         "<EnumerationResults>"
+                        "    <MaxResults>5000</MaxResults>"
                         "    <Blobs>"
                         "        <Blob>"
                         "            <Name>path/to/test_file</Name>"
@@ -1127,6 +1162,21 @@ testRun(void)
 
                 TEST_RESULT_STR_Z(strNewBuf(storageGetP(storageNewReadP(storage, STRDEF("file.txt")))), "123456", "get file");
 
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("get file in concurrent ranges with time limit");
+
+                // The version is found in the list cached by the prior test
+                driver = (StorageAzure *)storageDriver(storage);
+                driver->downloadMax = 2;
+
+                testRequestP(
+                    service, HTTP_VERB_GET, "/file.txt?versionid=2009-10-12T17%3A50%3A30.0000000Z", .range = "0-8388607");
+                testResponseP(service, .code = 206, .header = "content-range:bytes 0-5/6", .content = "123456");
+
+                TEST_RESULT_STR_Z(strNewBuf(storageGetP(storageNewReadP(storage, STRDEF("file.txt")))), "123456", "get file");
+
+                driver->downloadMax = 1;
+
                 // -----------------------------------------------------------------------------------------------------------------
                 TEST_TITLE("get missing file with time limit");
 
@@ -241,6 +241,7 @@ testRun(void)
         TEST_RESULT_STR(((StorageGcs *)storageDriver(storage))->bucket, TEST_BUCKET_STR, "check bucket");
         TEST_RESULT_STR_Z(((StorageGcs *)storageDriver(storage))->endpoint, "storage.googleapis.com", "check endpoint");
         TEST_RESULT_UINT(((StorageGcs *)storageDriver(storage))->chunkSize, 4 * 1024 * 1024, "check chunk size");
+        TEST_RESULT_UINT(((StorageGcs *)storageDriver(storage))->downloadMax, 1, "check download max");
         TEST_RESULT_STR(((StorageGcs *)storageDriver(storage))->token, TEST_TOKEN_STR, "check token");
         TEST_RESULT_BOOL(storageFeature(storage, storageFeaturePath), false, "check path feature");
     }
@@ -260,7 +261,7 @@ testRun(void)
             (StorageGcs *)storageDriver(
                 storageGcsNew(
                     STRDEF("/repo"), false, 0, NULL, TEST_BUCKET_STR, storageGcsKeyTypeService, TEST_KEY_FILE_STR, TEST_CHUNK_SIZE,
-                    NULL, TEST_ENDPOINT_STR, TEST_TIMEOUT, true, NULL, NULL)),
+                    1, NULL, TEST_ENDPOINT_STR, TEST_TIMEOUT, true, NULL, NULL)),
             "read-only gcs storage - service key");
         TEST_RESULT_STR_Z(httpUrlHost(storage->authUrl), "test.com", "check host");
         TEST_RESULT_STR_Z(httpUrlPath(storage->authUrl), "/token", "check path");
@@ -285,7 +286,7 @@ testRun(void)
             (StorageGcs *)storageDriver(
                 storageGcsNew(
                     STRDEF("/repo"), true, 0, NULL, TEST_BUCKET_STR, storageGcsKeyTypeService, TEST_KEY_FILE_STR, TEST_CHUNK_SIZE,
-                    NULL, TEST_ENDPOINT_STR, TEST_TIMEOUT, true, NULL, NULL)),
+                    1, NULL, TEST_ENDPOINT_STR, TEST_TIMEOUT, true, NULL, NULL)),
             "read/write gcs storage - service key");
 
         TEST_RESULT_STR_Z(
@@ -445,6 +446,32 @@ testRun(void)
                     strNewBuf(storageGetP(storageNewReadP(storage, STRDEF("file.txt"), .offset = 1, .limit = VARUINT64(21)))),
                     "this is a sample file", "get file");
 
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("get file in concurrent ranges");
+
+                // Allow two ranges to download concurrently. Range responses close the connection so each range gets a new session.
+                ((StorageGcs *)storageDriver(storage))->downloadSize = 16;
+                ((StorageGcs *)storageDriver(storage))->downloadMax = 2;
+
+                testRequestP(service, HTTP_VERB_GET, .object = "file.txt", .query = "alt=media", .range = "0-15");
+                testResponseP(
+                    service, .code = 206, .header = "connection:close\r\ncontent-range:bytes 0-15/21\r\nx-goog-generation:77",
+                    .content = "this is a sample");
+
+                hrnServerScriptClose(service);
+                hrnServerScriptAccept(service);
+
+                testRequestP(
+                    service, HTTP_VERB_GET, .object = "file.txt", .query = "alt=media&ifGenerationMatch=77", .range = "16-20");
+                testResponseP(
+                    service, .code = 206, .header = "connection:close\r\ncontent-range:bytes 16-20/21", .content = " file");
+
+                hrnServerScriptClose(service);
+                hrnServerScriptAccept(service);
+
+                TEST_RESULT_STR_Z(
+                    strNewBuf(storageGetP(storageNewReadP(storage, STRDEF("file.txt")))), "this is a sample file", "get file");
+
                 // -----------------------------------------------------------------------------------------------------------------
                 TEST_TITLE("switch to auto auth");
 
@@ -1240,6 +1267,21 @@ testRun(void)
 
                 TEST_RESULT_STR_Z(strNewBuf(storageGetP(storageNewReadP(storage, STRDEF("file.txt")))), "123456", "get file");
 
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("get file in concurrent ranges with time limit");
+
+                // The version is found in the list cached by the prior test
+                ((StorageGcs *)storageDriver(storage))->downloadMax = 2;
+
+                testRequestP(
+                    service, HTTP_VERB_GET, .object = "file.txt", .query = "alt=media?generation=1724645450428444",
+                    .range = "0-8388607");
+                testResponseP(service, .code = 206, .header = "content-range:bytes 0-5/6", .content = "123456");
+
+                TEST_RESULT_STR_Z(strNewBuf(storageGetP(storageNewReadP(storage, STRDEF("file.txt")))), "123456", "get file");
+
+                ((StorageGcs *)storageDriver(storage))->downloadMax = 1;
+
                 // -----------------------------------------------------------------------------------------------------------------
                 TEST_TITLE("get missing file with time limit");
 
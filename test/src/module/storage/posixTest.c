@@ -1588,6 +1588,12 @@ testRun(void)
             storagePathP(storage, STRDEF(STORAGE_SPOOL_ARCHIVE_IN "/file.ext")), TEST_PATH "/archive/db/in/file.ext",
             "check spool in file");
 
+        TEST_RESULT_STR_Z(
+            storagePathP(storage, STORAGE_SPOOL_BLOCK_MAP_STR), TEST_PATH "/block-map/db", "check spool block map path");
+        TEST_RESULT_STR_Z(
+            storagePathP(storage, STRDEF(STORAGE_SPOOL_BLOCK_MAP "/file.ext")), TEST_PATH "/block-map/db/file.ext",
+            "check spool block map file");
+
         TEST_ERROR(storagePathP(storage, STRDEF("<" BOGUS_STR ">")), AssertError, "invalid expression '<BOGUS>'");
 
         TEST_ERROR(storageNewWriteP(storage, writeFile), AssertError, "assertion 'this->write' failed");
@@ -297,6 +297,7 @@ testRun(void)
         ((StorageRemote *)storageDriver(storageRepo))->compressLevel = 0;
 
         StorageRead *fileRead = NULL;
+        size_t bufferOld;
         TEST_ASSIGN(fileRead, storageNewReadP(storageRepo, STRDEF("test.txt")), "new file");
         TEST_RESULT_BOOL(bufEq(storageGetP(fileRead), contentBuf), true, "get file");
         TEST_RESULT_BOOL(storageReadIgnoreMissing(fileRead), false, "check ignore missing");
@@ -304,6 +305,38 @@ testRun(void)
         TEST_RESULT_UINT(storageReadRemote(ioReadDriver(storageReadIo(fileRead)), bufNew(32), false), 0, "nothing more to read");
         TEST_RESULT_UINT(((StorageReadRemote *)ioReadDriver(storageReadIo(fileRead)))->protocolReadBytes, bufSize(contentBuf), "check read size");
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("read file with growing block size");
+
+        bufferOld = ioBufferSize();
+        ioBufferSizeSet(16);
+
+        TEST_ASSIGN(fileRead, storageNewReadP(storageRepo, STRDEF("test.txt")), "new file");
+        TEST_RESULT_BOOL(bufEq(storageGetP(fileRead), contentBuf), true, "get file");
+        TEST_RESULT_UINT(((StorageReadRemote *)ioReadDriver(storageReadIo(fileRead)))->blockSize, 128, "check block size max");
+
+        ioBufferSizeSet(bufferOld);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("read file ending on a block boundary");
+
+        Buffer *const contentBlockBuf = bufDup(contentBuf);
+        bufCatSub(contentBlockBuf, contentBuf, 0, bufUsed(contentBuf) / 2);
+        HRN_STORAGE_PUT(storageTest, TEST_PATH "/repo128/test-block.txt", contentBlockBuf);
+
+        TEST_ASSIGN(fileRead, storageNewReadP(storageRepo, STRDEF("test-block.txt")), "new file");
+        TEST_RESULT_BOOL(bufEq(storageGetP(fileRead), contentBlockBuf), true, "get file");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("error on block size larger than the remote allows");
+
+        ioBufferSizeSet(bufferOld * STORAGE_READ_REMOTE_BLOCK_MULTIPLIER_MAX);
+
+        TEST_ASSIGN(fileRead, storageNewReadP(storageRepo, STRDEF("test.txt")), "new file");
+        TEST_ERROR(storageGetP(fileRead), ProtocolError, "raised from remote-0 shim protocol: invalid block size");
+
+        ioBufferSizeSet(bufferOld);
+
         // Enable protocol compression in the storage object
         ((StorageRemote *)storageDriver(storageRepo))->compressLevel = 3;
 
@@ -317,7 +350,7 @@ testRun(void)
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("read partial file then close");
 
-        size_t bufferOld = ioBufferSize();
+        bufferOld = ioBufferSize();
         ioBufferSizeSet(11);
         buffer = bufNew(11);
 
@@ -27,6 +27,7 @@ typedef struct TestRequestParam
     const char *content;
     const char *accessKey;
     const char *securityToken;
+    const char *ifMatch;
     const char *range;
     const char *kms;
     const char *sseC;
@@ -72,6 +73,9 @@ testRequest(IoWrite *write, Storage *s3, const char *verb, const char *path, Tes
 
         strCatZ(request, "host;");
 
+        if (param.ifMatch != NULL)
+            strCatZ(request, "if-match;");
+
         if (param.range != NULL)
             strCatZ(request, "range;");
 
@@ -118,6 +122,10 @@ testRequest(IoWrite *write, Storage *s3, const char *verb, const char *path, Tes
     else
         strCatFmt(request, "host:%s\r\n", strZ(hrnServerHost()));
 
+    // Add if-match
+    if (param.ifMatch != NULL)
+        strCatFmt(request, "if-match:%s\r\n", param.ifMatch);
+
     // Add range
     if (param.range != NULL)
         strCatFmt(request, "range:bytes=%s\r\n", param.range);
@@ -449,6 +457,8 @@ testRun(void)
                 TEST_RESULT_STR(s3->path, path, "check path");
                 TEST_RESULT_BOOL(storageFeature(s3, storageFeaturePath), false, "check path feature");
                 TEST_RESULT_UINT(driver->partSize, 5 * 1024 * 1024, "check part size");
+                TEST_RESULT_UINT(driver->downloadMax, 1, "check download max");
+                TEST_RESULT_UINT(driver->listMax, 1, "check list max");
 
                 // -----------------------------------------------------------------------------------------------------------------
                 TEST_TITLE("coverage for noop functions");
@@ -492,6 +502,50 @@ testRun(void)
 
                 TEST_RESULT_STR_Z(strNewBuf(storageGetP(storageNewReadP(s3, STRDEF("file0.txt")))), "", "get zero-length file");
 
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("get file in concurrent ranges");
+
+                // Allow two ranges to download concurrently. Range responses close the connection so each range gets a new session.
+                driver->downloadSize = 8;
+                driver->downloadMax = 2;
+
+                testRequestP(service, s3, HTTP_VERB_GET, "/file.txt", .range = "0-7");
+                testResponseP(
+                    service, .code = 206, .http = "1.0", .header = "content-range:bytes 0-7/21\r\netag:\"E1\"",
+                    .content = "this is ");
+
+                hrnServerScriptClose(service);
+                hrnServerScriptAccept(service);
+
+                testRequestP(service, s3, HTTP_VERB_GET, "/file.txt", .ifMatch = "\"E1\"", .range = "8-15");
+                testResponseP(service, .code = 206, .http = "1.0", .header = "content-range:bytes 8-15/21", .content = "a sample");
+
+                hrnServerScriptClose(service);
+                hrnServerScriptAccept(service);
+
+                testRequestP(service, s3, HTTP_VERB_GET, "/file.txt", .ifMatch = "\"E1\"", .range = "16-20");
+                testResponseP(service, .code = 206, .http = "1.0", .header = "content-range:bytes 16-20/21", .content = " file");
+
+                hrnServerScriptClose(service);
+                hrnServerScriptAccept(service);
+
+                TEST_RESULT_STR_Z(
+                    strNewBuf(storageGetP(storageNewReadP(s3, STRDEF("file.txt")))), "this is a sample file", "get file");
+
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("ignore missing file in concurrent ranges");
+
+                testRequestP(service, s3, HTTP_VERB_GET, "/file.txt", .range = "0-7");
+                testResponseP(service, .code = 404, .http = "1.0");
+
+                hrnServerScriptClose(service);
+                hrnServerScriptAccept(service);
+
+                TEST_RESULT_PTR(storageGetP(storageNewReadP(s3, STRDEF("file.txt"), .ignoreMissing = true)), NULL, "get file");
+
+                driver->downloadSize = HTTP_RANGE_READ_SIZE;
+                driver->downloadMax = 1;
+
                 // -----------------------------------------------------------------------------------------------------------------
                 TEST_TITLE("switch to temp credentials");
 
@@ -1185,10 +1239,11 @@ testRun(void)
 
                 testRequestP(service, s3, HTTP_VERB_GET, "/?delimiter=%2F&list-type=2&prefix=path%2Fto%2F");
                 testResponseP(
-                    service,
+                    service, .http = "1.0",
                     .content =
                         "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
                         "<ListBucketResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">"
+                        "    <Name>bucket</Name>"
                         "    <IsTruncated>true</IsTruncated>"
                         "    <NextContinuationToken>1ueGcxLPRx1Tr/XYExHnhbYLgveDs2J/wm36Hy4vbOwM=</NextContinuationToken>"
                         "    <Contents>"
@@ -1202,6 +1257,9 @@ testRun(void)
                         "   </CommonPrefixes>"
                         "</ListBucketResult>");
 
+                hrnServerScriptClose(service);
+                hrnServerScriptAccept(service);
+
                 testRequestP(
                     service, s3, HTTP_VERB_GET,
                     "/?continuation-token=1ueGcxLPRx1Tr%2FXYExHnhbYLgveDs2J%2Fwm36Hy4vbOwM%3D&delimiter=%2F&list-type=2"
@@ -1340,7 +1398,7 @@ testRun(void)
 
                 testRequestP(service, s3, HTTP_VERB_GET, "/bucket/?list-type=2&prefix=path%2Fto%2F");
                 testResponseP(
-                    service,
+                    service, .http = "1.0",
                     .content =
                         "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
                         "<ListBucketResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">"
@@ -1354,6 +1412,9 @@ testRun(void)
                         "    </Contents>"
                         "</ListBucketResult>");
 
+                hrnServerScriptClose(service);
+                hrnServerScriptAccept(service);
+
                 testRequestP(service, s3, HTTP_VERB_GET, "/bucket/?continuation-token=continue&list-type=2&prefix=path%2Fto%2F");
                 testResponseP(
                     service,
@@ -1429,6 +1490,203 @@ testRun(void)
 
                 TEST_RESULT_VOID(storagePathRemoveP(s3, STRDEF("/path"), .recurse = true), "remove path");
 
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("remove files in concurrent shards");
+
+                // Allow two shards to be listed concurrently. Shard responses close the connection so each shard gets a new session
+                // except the last, which leaves the session for the delete request. The request for the second shard must be
+                // received before the response for the first shard is sent.
+                driver->listMax = 2;
+                driver->deleteMax = STORAGE_S3_DELETE_MAX;
+
+                testRequestP(service, s3, HTTP_VERB_GET, "/bucket/?delimiter=%2F&list-type=2&prefix=path%2F");
+                testResponseP(
+                    service,
+                    .content =
+                        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                        "<ListBucketResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">"
+                        "    <IsTruncated>false</IsTruncated>"
+                        "    <Contents>"
+                        "        <Key>path/a.txt</Key>"
+                        "    </Contents>"
+                        "    <Contents>"
+                        "        <Key>path/a0.txt</Key>"
+                        "    </Contents>"
+                        "    <Contents>"
+                        "        <Key>path/z.txt</Key>"
+                        "    </Contents>"
+                        "   <CommonPrefixes>"
+                        "       <Prefix>path/a/</Prefix>"
+                        "   </CommonPrefixes>"
+                        "   <CommonPrefixes>"
+                        "       <Prefix>path/b/</Prefix>"
+                        "   </CommonPrefixes>"
+                        "   <CommonPrefixes>"
+                        "       <Prefix>path/c/</Prefix>"
+                        "   </CommonPrefixes>"
+                        "</ListBucketResult>");
+
+                testRequestP(service, s3, HTTP_VERB_GET, "/bucket/?list-type=2&prefix=path%2Fa%2F");
+
+                hrnServerScriptSwap(service);
+                hrnServerScriptAccept(service);
+
+                testRequestP(service, s3, HTTP_VERB_GET, "/bucket/?list-type=2&prefix=path%2Fb%2F");
+
+                hrnServerScriptSwap(service);
+
+                testResponseP(
+                    service, .http = "1.0",
+                    .content =
+                        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                        "<ListBucketResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">"
+                        "    <IsTruncated>false</IsTruncated>"
+                        "    <Contents>"
+                        "        <Key>path/a/1.txt</Key>"
+                        "    </Contents>"
+                        "</ListBucketResult>");
+
+                hrnServerScriptClose(service);
+                hrnServerScriptSwap(service);
+
+                testResponseP(
+                    service, .http = "1.0",
+                    .content =
+                        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                        "<ListBucketResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">"
+                        "    <IsTruncated>false</IsTruncated>"
+                        "    <Contents>"
+                        "        <Key>path/b/1.txt</Key>"
+                        "    </Contents>"
+                        "    <Contents>"
+                        "        <Key>path/b/d/2.txt</Key>"
+                        "    </Contents>"
+                        "</ListBucketResult>");
+
+                hrnServerScriptClose(service);
+                hrnServerScriptAccept(service);
+
+                testRequestP(service, s3, HTTP_VERB_GET, "/bucket/?list-type=2&prefix=path%2Fc%2F");
+                testResponseP(
+                    service,
+                    .content =
+                        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                        "<ListBucketResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">"
+                        "    <IsTruncated>false</IsTruncated>"
+                        "    <Contents>"
+                        "        <Key>path/c/1.txt</Key>"
+                        "    </Contents>"
+                        "</ListBucketResult>");
+
+                testRequestP(
+                    service, s3, HTTP_VERB_POST, "/bucket/?delete=",
+                    .content =
+                        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                        "<Delete><Quiet>true</Quiet>"
+                        "<Object><Key>path/a.txt</Key></Object>"
+                        "<Object><Key>path/a0.txt</Key></Object>"
+                        "<Object><Key>path/z.txt</Key></Object>"
+                        "<Object><Key>path/a/1.txt</Key></Object>"
+                        "<Object><Key>path/b/1.txt</Key></Object>"
+                        "<Object><Key>path/b/d/2.txt</Key></Object>"
+                        "<Object><Key>path/c/1.txt</Key></Object>"
+                        "</Delete>\n");
+                testResponseP(service);
+
+                TEST_RESULT_VOID(storagePathRemoveP(s3, STRDEF("/path"), .recurse = true), "remove path");
+
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("remove files in concurrent shards split at the next level");
+
+                // The top level has fewer paths than the list max so the paths below it are split as well. The paths at the next
+                // level are still too few so they are split concurrently. The request for the second split must be received before
+                // the response for the first split is sent.
+                driver->listMax = 3;
+
+                testRequestP(service, s3, HTTP_VERB_GET, "/bucket/?delimiter=%2F&list-type=2");
+                testResponseP(
+                    service,
+                    .content =
+                        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                        "<ListBucketResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">"
+                        "    <IsTruncated>false</IsTruncated>"
+                        "    <Contents>"
+                        "        <Key>test1.txt</Key>"
+                        "    </Contents>"
+                        "   <CommonPrefixes>"
+                        "       <Prefix>u/</Prefix>"
+                        "   </CommonPrefixes>"
+                        "</ListBucketResult>");
+
+                testRequestP(service, s3, HTTP_VERB_GET, "/bucket/?delimiter=%2F&list-type=2&prefix=u%2F");
+                testResponseP(
+                    service,
+                    .content =
+                        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                        "<ListBucketResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">"
+                        "    <IsTruncated>false</IsTruncated>"
+                        "    <Contents>"
+                        "        <Key>u/1.txt</Key>"
+                        "    </Contents>"
+                        "   <CommonPrefixes>"
+                        "       <Prefix>u/v/</Prefix>"
+                        "   </CommonPrefixes>"
+                        "   <CommonPrefixes>"
+                        "       <Prefix>u/w/</Prefix>"
+                        "   </CommonPrefixes>"
+                        "</ListBucketResult>");
+
+                testRequestP(service, s3, HTTP_VERB_GET, "/bucket/?delimiter=%2F&list-type=2&prefix=u%2Fv%2F");
+
+                hrnServerScriptSwap(service);
+                hrnServerScriptAccept(service);
+
+                testRequestP(service, s3, HTTP_VERB_GET, "/bucket/?delimiter=%2F&list-type=2&prefix=u%2Fw%2F");
+
+                hrnServerScriptSwap(service);
+
+                testResponseP(
+                    service, .http = "1.0",
+                    .content =
+                        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                        "<ListBucketResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">"
+                        "    <IsTruncated>false</IsTruncated>"
+                        "    <Contents>"
+                        "        <Key>u/v/1.txt</Key>"
+                        "    </Contents>"
+                        "</ListBucketResult>");
+
+                hrnServerScriptClose(service);
+                hrnServerScriptSwap(service);
+
+                testResponseP(
+                    service,
+                    .content =
+                        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                        "<ListBucketResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">"
+                        "    <IsTruncated>false</IsTruncated>"
+                        "    <Contents>"
+                        "        <Key>u/w/1.txt</Key>"
+                        "    </Contents>"
+                        "</ListBucketResult>");
+
+                testRequestP(
+                    service, s3, HTTP_VERB_POST, "/bucket/?delete=",
+                    .content =
+                        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                        "<Delete><Quiet>true</Quiet>"
+                        "<Object><Key>test1.txt</Key></Object>"
+                        "<Object><Key>u/1.txt</Key></Object>"
+                        "<Object><Key>u/v/1.txt</Key></Object>"
+                        "<Object><Key>u/w/1.txt</Key></Object>"
+                        "</Delete>\n");
+                testResponseP(service);
+
+                TEST_RESULT_VOID(storagePathRemoveP(s3, STRDEF("/"), .recurse = true), "remove");
+
+                driver->listMax = 1;
+                driver->deleteMax = 2;
+
                 // -----------------------------------------------------------------------------------------------------------------
                 TEST_TITLE("remove file");
 
@@ -1458,12 +1716,13 @@ testRun(void)
 
                 testRequestP(service, s3, HTTP_VERB_GET, "/?delimiter=%2F&prefix=path%2Fto%2F&versions=");
                 testResponseP(
-                    service,
+                    service, .http = "1.0",
                     .content =
                         "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
                         "<ListBucketResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">"
-                        "    <IsTruncated>true</IsTruncated>"
                         "    <NextContinuationToken>1ueG</NextContinuationToken>"
+                        "    <Name>bucket</Name>"
+                        "    <IsTruncated>true</IsTruncated>"
                         "    <DeleteMarker>"
                         "        <Key>path/to/test_file</Key>"
                         "        <LastModified>2024-08-04T02:54:10.000Z</LastModified>"
@@ -1474,6 +1733,9 @@ testRun(void)
                         "    </Version>"
                         "</ListBucketResult>");
 
+                hrnServerScriptClose(service);
+                hrnServerScriptAccept(service);
+
                 testRequestP(service, s3, HTTP_VERB_GET, "/?continuation-token=1ueG&delimiter=%2F&prefix=path%2Fto%2F&versions=");
                 testResponseP(
                     service,
@@ -1537,6 +1799,21 @@ testRun(void)
                 TEST_RESULT_STR_Z(
                     strNewBuf(storageGetP(storageNewReadP(s3, STRDEF("/path/3/test_file")))), "123456", "get file");
 
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("get file in concurrent ranges with time limit");
+
+                // The version is found in the list cached by the prior test
+                driver = (StorageS3 *)storageDriver(s3);
+                driver->downloadMax = 2;
+
+                testRequestP(service, s3, HTTP_VERB_GET, "/path/3/test_file?versionId=bbbb", .range = "0-8388607");
+                testResponseP(service, .code = 206, .header = "content-range:bytes 0-5/6", .content = "123456");
+
+                TEST_RESULT_STR_Z(
+                    strNewBuf(storageGetP(storageNewReadP(s3, STRDEF("/path/3/test_file")))), "123456", "get file");
+
+                driver->downloadMax = 1;
+
                 // -----------------------------------------------------------------------------------------------------------------
                 TEST_TITLE("get missing file with time limit");
 